@@ -0,0 +1,119 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief exact sums of products of `sg14::fixed_point` values, `sg14::accumulator`
+
+#if !defined(SG14_ACCUMULATOR_H)
+#define SG14_ACCUMULATOR_H 1
+
+#include <sg14/auxiliary/batch.h>
+#include <sg14/fixed_point.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/// study group 14 of the C++ working group
+namespace sg14 {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::accumulator
+
+    /// \brief a running sum of products of \ref fixed_point values which cannot overflow
+    ///
+    /// \tparam Element the \ref fixed_point type of the values multiplied
+    /// \tparam MaxTerms the greatest number of products which will be summed
+    ///
+    /// Like the multiplication of \ref elastic_integer values, the width of the sum is
+    /// determined at compile-time: each product has twice the digits of Element,
+    /// plus one to hold the square of its lowest value, and summing MaxTerms of them
+    /// adds ceil(log2(MaxTerms)) more. Products are summed exactly in the rep of the sum
+    /// rather than being narrowed after each operation and the sum is rescaled only once,
+    /// by \ref result. Summing more than MaxTerms products may overflow.
+    ///
+    /// \ref dot uses vector instructions for elements with a 16-bit signed rep.
+    ///
+    /// \par Example
+    ///
+    /// To calculate the dot product of two Q15 arrays:
+    /// \snippet snippets.cpp accumulate a dot product
+
+    template<class Element, std::uintmax_t MaxTerms>
+    class accumulator;
+
+    template<class Rep, int Exponent, std::uintmax_t MaxTerms>
+    class accumulator<fixed_point<Rep, Exponent>, MaxTerms> {
+        static_assert(std::is_integral<Rep>::value, "sg14::accumulator requires a fundamental integer rep");
+        static_assert(MaxTerms>0, "sg14::accumulator must allow at least one term");
+
+    public:
+        /// type of the values multiplied
+        using element_type = fixed_point<Rep, Exponent>;
+
+        /// the greatest number of products which can be summed without overflow
+        static constexpr std::uintmax_t max_terms = MaxTerms;
+
+        /// number of digits of the sum
+        static constexpr int digits = 2*std::numeric_limits<Rep>::digits+std::numeric_limits<Rep>::is_signed
+                                      +_impl::ceil_log2(MaxTerms);
+
+        /// type of the running sum of the reps of the products
+        using rep = set_width_t<Rep, digits+std::numeric_limits<Rep>::is_signed>;
+
+        /// type of the exact sum
+        using value_type = fixed_point<rep, 2*Exponent>;
+
+        /// constructs a zero sum
+        constexpr accumulator() noexcept
+                :_sum(0)
+        {
+        }
+
+        /// adds the product of lhs and rhs to the sum
+        void mac(element_type const& lhs, element_type const& rhs)
+        {
+            _sum += static_cast<rep>(static_cast<rep>(lhs.data())*static_cast<rep>(rhs.data()));
+        }
+
+        /// adds the products of corresponding elements of two arrays to the sum
+        void dot(const element_type* lhs, const element_type* rhs, std::size_t size)
+        {
+            auto done = _batch_impl::dot_kernel<element_type, rep>::run(lhs, rhs, size, _sum);
+            for (auto index = done; index!=size; ++index) {
+                mac(lhs[index], rhs[index]);
+            }
+        }
+
+        /// returns the sum
+        constexpr value_type value() const noexcept
+        {
+            return value_type::from_data(_sum);
+        }
+
+        /// returns the sum converted to Result, with the bits discarded rounded according to RoundingPolicy
+        template<class Result, class RoundingPolicy = round_toward_zero>
+        constexpr Result result(RoundingPolicy rounding = RoundingPolicy{}) const
+        {
+            return Result{value(), rounding};
+        }
+
+        /// sets the sum to zero
+        void clear() noexcept
+        {
+            _sum = 0;
+        }
+
+    private:
+        ////////////////////////////////////////////////////////////////////////////////
+        // variables
+
+        rep _sum;
+    };
+}
+
+#endif  // SG14_ACCUMULATOR_H
@@ -0,0 +1,1658 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief arithmetic over, and conversion of, contiguous arrays of `sg14::fixed_point` values
+
+#if !defined(SG14_BATCH_H)
+#define SG14_BATCH_H 1
+
+#include <sg14/fixed_point.h>
+#include <sg14/auxiliary/integer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/// study group 14 of the C++ working group
+namespace sg14 {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::_batch_impl
+
+    namespace _batch_impl {
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_batch_impl::transform - scalar reference
+
+        // performs the arithmetic operator on each pair of elements and converts the result
+        template<class OperationTag, class Lhs, class Rhs, class Result>
+        void transform(const Lhs* lhs, const Rhs* rhs, Result* result, std::size_t size)
+        {
+            for (auto index = std::size_t{0}; index!=size; ++index) {
+                result[index] = static_cast<Result>(
+                        _fixed_point_impl::operate<_fixed_point_impl::arithmetic_operator_tag, OperationTag>(
+                                lhs[index], rhs[index]));
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_batch_impl::kernel
+
+        // vectorized implementation of a batch operation;
+        // processes as many leading elements as it can and returns their number;
+        // where no vectorized implementation applies, processes nothing
+        template<class OperationTag, class Lhs, class Rhs, class Result, class Enable = void>
+        struct kernel {
+            static std::size_t run(const Lhs*, const Rhs*, Result*, std::size_t)
+            {
+                return 0;
+            }
+        };
+
+        template<class OperationTag, class Lhs, class Rhs, class Result>
+        void apply(const Lhs* lhs, const Rhs* rhs, Result* result, std::size_t size)
+        {
+            auto done = kernel<OperationTag, Lhs, Rhs, Result>::run(lhs, rhs, result, size);
+            transform<OperationTag>(lhs+done, rhs+done, result+done, size-done);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_batch_impl::saturate - scalar floating-point to fixed-point conversion
+
+        // rounds according to RoundingPolicy and clamps to the range of Rep;
+        // NaN becomes the value given by NanPolicy
+        template<class RoundingPolicy, class NanPolicy, class Rep, int Exponent, class Float>
+        fixed_point<Rep, Exponent> saturate(Float from)
+        {
+            static_assert(std::is_integral<Rep>::value, "saturating conversion requires a fundamental integer rep");
+            using result_type = fixed_point<Rep, Exponent>;
+            using wide = typename std::conditional<std::is_signed<Rep>::value, std::int64_t, std::uint64_t>::type;
+
+            auto scaled = from*_fixed_point_impl::pow2<Float, -Exponent>();
+            if (scaled!=scaled) {
+                return result_type::from_data(NanPolicy::template value<Rep>());
+            }
+            if (scaled>=_fixed_point_impl::pow2<Float, std::numeric_limits<Rep>::digits>()) {
+                return result_type::from_data(std::numeric_limits<Rep>::max());
+            }
+            if (scaled<=static_cast<Float>(std::numeric_limits<Rep>::lowest())) {
+                return result_type::from_data(std::numeric_limits<Rep>::lowest());
+            }
+
+            // rounding up may exceed the maximum by one
+            auto truncated = static_cast<wide>(scaled);
+            auto rounded = _fixed_point_impl::round_fraction<RoundingPolicy>(
+                    truncated, scaled-static_cast<Float>(truncated));
+            return result_type::from_data(static_cast<Rep>(
+                    _impl::min<wide>(rounded, std::numeric_limits<Rep>::max())));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_batch_impl::saturate_kernel and sg14::_batch_impl::scale_kernel
+
+        // vectorized conversion from floating-point to fixed-point and back, respectively;
+        // as kernel, each processes as many leading elements as it can and returns their number
+        template<class Float, class Element, class RoundingPolicy, class NanPolicy, class Enable = void>
+        struct saturate_kernel {
+            static std::size_t run(const Float*, Element*, std::size_t)
+            {
+                return 0;
+            }
+        };
+
+        template<class Element, class Float, class Enable = void>
+        struct scale_kernel {
+            static std::size_t run(const Element*, Float*, std::size_t)
+            {
+                return 0;
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_batch_impl::requantize - scalar conversion between fixed-point types
+
+        // least and greatest values of Rep which fit in std::int64_t
+        template<class Rep>
+        constexpr std::int64_t lowest()
+        {
+            return static_cast<std::int64_t>(std::numeric_limits<Rep>::lowest());
+        }
+
+        template<class Rep>
+        constexpr std::int64_t greatest()
+        {
+            return static_cast<std::int64_t>(_impl::min<std::uint64_t>(
+                    std::numeric_limits<Rep>::max(), std::numeric_limits<std::int64_t>::max()));
+        }
+
+        // ceil(value/2^Shift)
+        template<int Shift>
+        constexpr std::int64_t ceil_shift_right(std::int64_t value)
+        {
+            return (value >> Shift)+((value & ((std::int64_t{1} << Shift)-1))!=0);
+        }
+
+        // value*2^-Shift, rounded according to RoundingPolicy and clamped to the range of Rep
+        template<class RoundingPolicy, int Shift, class Rep, typename std::enable_if<(Shift>0), int>::type Dummy = 0>
+        std::int64_t requantize_rep(std::int64_t value)
+        {
+            return _impl::max(_impl::min(RoundingPolicy::template shift_right<Shift>(value), greatest<Rep>()),
+                    lowest<Rep>());
+        }
+
+        template<class RoundingPolicy, int Shift, class Rep, typename std::enable_if<(Shift<=0), int>::type Dummy = 0>
+        std::int64_t requantize_rep(std::int64_t value)
+        {
+            return (value>(greatest<Rep>() >> -Shift))
+                   ? greatest<Rep>()
+                   : (value<ceil_shift_right<-Shift>(lowest<Rep>()))
+                     ? lowest<Rep>()
+                     : value*(std::int64_t{1} << -Shift);
+        }
+
+        template<class RoundingPolicy, class ToRep, int ToExponent, class FromRep, int FromExponent>
+        fixed_point<ToRep, ToExponent> requantize(fixed_point<FromRep, FromExponent> const& from)
+        {
+            static_assert(std::is_integral<FromRep>::value && std::is_integral<ToRep>::value,
+                    "requantization requires fundamental integer reps");
+            static_assert(std::numeric_limits<FromRep>::digits<64, "requantization from 64-bit unsigned reps is not supported");
+            static_assert(ToExponent-FromExponent<63 && FromExponent-ToExponent<63, "exponents differ by too much");
+            return fixed_point<ToRep, ToExponent>::from_data(static_cast<ToRep>(
+                    requantize_rep<RoundingPolicy, ToExponent-FromExponent, ToRep>(static_cast<std::int64_t>(from.data()))));
+        }
+
+        // vectorized requantization; as kernel, processes as many leading elements as it can
+        template<class From, class To, class RoundingPolicy, class Enable = void>
+        struct requantize_kernel {
+            static std::size_t run(const From*, To*, std::size_t)
+            {
+                return 0;
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_batch_impl::dot_kernel
+
+        // adds the sum of the products of the reps of leading elements to total;
+        // as kernel, processes as many leading elements as it can and returns their number
+        template<class Element, class Sum, class Enable = void>
+        struct dot_kernel {
+            static std::size_t run(const Element*, const Element*, std::size_t, Sum&)
+            {
+                return 0;
+            }
+        };
+
+#if defined(__GNUC__)
+        ////////////////////////////////////////////////////////////////////////////////
+        // GCC vector extensions
+
+        // number of bytes in the widest available integer register
+        constexpr int vector_bytes =
+#if defined(__AVX512BW__)
+                64;
+#elif defined(__AVX2__)
+                32;
+#else
+                16;
+#endif
+
+        template<class Element, int Bytes = vector_bytes>
+        struct vector {
+            typedef Element type __attribute__((vector_size(Bytes)));
+        };
+
+        template<class Vector, class Element>
+        Vector load(const Element* from)
+        {
+            Vector v;
+            std::memcpy(&v, static_cast<const void*>(from), sizeof(v));
+            return v;
+        }
+
+        template<class Element, class Vector>
+        void store(Element* to, const Vector& v)
+        {
+            std::memcpy(static_cast<void*>(to), &v, sizeof(v));
+        }
+
+        // true iff T is fixed_point<Rep, Exponent> with one of the given reps
+        template<class T, class ... Reps>
+        struct has_rep : std::false_type {
+        };
+
+        template<class Rep, int Exponent, class Head, class ... Tail>
+        struct has_rep<fixed_point<Rep, Exponent>, Head, Tail...>
+                : std::integral_constant<bool, std::is_same<Rep, Head>::value
+                        || has_rep<fixed_point<Rep, Exponent>, Tail...>::value> {
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_batch_impl::simd - operations which vector extensions cannot express
+
+        template<int Bytes>
+        struct simd {
+        };
+
+#if defined(__SSE2__)
+        template<>
+        struct simd<16> {
+            using s8 = vector<std::int8_t, 16>::type;
+            using u8 = vector<std::uint8_t, 16>::type;
+            using s16 = vector<std::int16_t, 16>::type;
+            using u16 = vector<std::uint16_t, 16>::type;
+            using s32 = vector<std::int32_t, 16>::type;
+            using u32 = vector<std::uint32_t, 16>::type;
+            using s64 = vector<std::int64_t, 16>::type;
+            using u64 = vector<std::uint64_t, 16>::type;
+            using f32 = vector<float, 16>::type;
+
+            // sums and differences of 8- and 16-bit lanes, saturating
+            static s8 adds(s8 lhs, s8 rhs)
+            {
+                return s8(_mm_adds_epi8(__m128i(lhs), __m128i(rhs)));
+            }
+
+            static u8 adds(u8 lhs, u8 rhs)
+            {
+                return u8(_mm_adds_epu8(__m128i(lhs), __m128i(rhs)));
+            }
+
+            static s16 adds(s16 lhs, s16 rhs)
+            {
+                return s16(_mm_adds_epi16(__m128i(lhs), __m128i(rhs)));
+            }
+
+            static u16 adds(u16 lhs, u16 rhs)
+            {
+                return u16(_mm_adds_epu16(__m128i(lhs), __m128i(rhs)));
+            }
+
+            static s8 subs(s8 lhs, s8 rhs)
+            {
+                return s8(_mm_subs_epi8(__m128i(lhs), __m128i(rhs)));
+            }
+
+            static u8 subs(u8 lhs, u8 rhs)
+            {
+                return u8(_mm_subs_epu8(__m128i(lhs), __m128i(rhs)));
+            }
+
+            static s16 subs(s16 lhs, s16 rhs)
+            {
+                return s16(_mm_subs_epi16(__m128i(lhs), __m128i(rhs)));
+            }
+
+            static u16 subs(u16 lhs, u16 rhs)
+            {
+                return u16(_mm_subs_epu16(__m128i(lhs), __m128i(rhs)));
+            }
+
+            // upper halves of 16x16-bit products
+            static s16 mulhi(s16 lhs, s16 rhs)
+            {
+                return s16(_mm_mulhi_epi16(__m128i(lhs), __m128i(rhs)));
+            }
+
+            static u16 mulhi(u16 lhs, u16 rhs)
+            {
+                return u16(_mm_mulhi_epu16(__m128i(lhs), __m128i(rhs)));
+            }
+
+            // quotients of 16-bit lanes with dividends scaled up by 2^Shift,
+            // rounded toward zero and truncated to 16 bits
+            template<int Shift>
+            static s16 divide(s16 lhs, s16 rhs)
+            {
+                auto l = __m128i(lhs);
+                auto r = __m128i(rhs);
+                auto lower = divide(
+                        _mm_slli_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(l, l), 16), Shift),
+                        _mm_srai_epi32(_mm_unpacklo_epi16(r, r), 16));
+                auto upper = divide(
+                        _mm_slli_epi32(_mm_srai_epi32(_mm_unpackhi_epi16(l, l), 16), Shift),
+                        _mm_srai_epi32(_mm_unpackhi_epi16(r, r), 16));
+
+                // packs saturates so sign-extend the lower halves first
+                return s16(_mm_packs_epi32(
+                        _mm_srai_epi32(_mm_slli_epi32(lower, 16), 16),
+                        _mm_srai_epi32(_mm_slli_epi32(upper, 16), 16)));
+            }
+
+            // quotients of 32-bit lanes, rounded toward zero;
+            // exact because the operands convert to double without loss and
+            // a correctly-rounded quotient of numbers below 2^53 never crosses an integer
+            static __m128i divide(__m128i lhs, __m128i rhs)
+            {
+#if defined(__AVX__)
+                return _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(lhs), _mm256_cvtepi32_pd(rhs)));
+#else
+                auto lower = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(lhs), _mm_cvtepi32_pd(rhs)));
+                auto upper = _mm_cvttpd_epi32(_mm_div_pd(
+                        _mm_cvtepi32_pd(_mm_shuffle_epi32(lhs, 0x4e)),
+                        _mm_cvtepi32_pd(_mm_shuffle_epi32(rhs, 0x4e))));
+                return _mm_unpacklo_epi64(lower, upper);
+#endif
+            }
+
+            // conversion between float and 32-bit lanes; truncate rounds toward zero
+            static s32 truncate(f32 from)
+            {
+                return s32(_mm_cvttps_epi32(__m128(from)));
+            }
+
+            static f32 to_float(s32 from)
+            {
+                return f32(_mm_cvtepi32_ps(__m128i(from)));
+            }
+
+            // sums of the products of adjacent pairs of 16-bit lanes, wrapping
+            static s32 madd(s16 lhs, s16 rhs)
+            {
+                return s32(_mm_madd_epi16(__m128i(lhs), __m128i(rhs)));
+            }
+
+            // loads of 32-bit lanes from narrower integers, sign- or zero-extended
+            static s32 widen(const std::int8_t* from)
+            {
+                auto bytes = _mm_cvtsi32_si128(load<std::int32_t>(from));
+                return s32(_mm_srai_epi32(_mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, bytes), _mm_unpacklo_epi8(bytes, bytes)), 24));
+            }
+
+            static s32 widen(const std::uint8_t* from)
+            {
+                auto bytes = _mm_cvtsi32_si128(load<std::int32_t>(from));
+                return s32(_mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, _mm_setzero_si128()), _mm_setzero_si128()));
+            }
+
+            static s32 widen(const std::int16_t* from)
+            {
+                auto words = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(from));
+                return s32(_mm_srai_epi32(_mm_unpacklo_epi16(words, words), 16));
+            }
+
+            static s32 widen(const std::uint16_t* from)
+            {
+                return s32(_mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(from)), _mm_setzero_si128()));
+            }
+
+            static s32 widen(const std::int32_t* from)
+            {
+                return load<s32>(from);
+            }
+
+            // narrowing of two vectors to one, saturating
+            static s16 pack(s32 lower, s32 upper)
+            {
+                return s16(_mm_packs_epi32(__m128i(lower), __m128i(upper)));
+            }
+
+            static s8 pack(s16 lower, s16 upper)
+            {
+                return s8(_mm_packs_epi16(__m128i(lower), __m128i(upper)));
+            }
+
+            static u8 pack_unsigned(s16 lower, s16 upper)
+            {
+                return u8(_mm_packus_epi16(__m128i(lower), __m128i(upper)));
+            }
+        };
+#endif
+
+#if defined(__AVX2__)
+        template<>
+        struct simd<32> {
+            using s8 = vector<std::int8_t, 32>::type;
+            using u8 = vector<std::uint8_t, 32>::type;
+            using s16 = vector<std::int16_t, 32>::type;
+            using u16 = vector<std::uint16_t, 32>::type;
+            using s32 = vector<std::int32_t, 32>::type;
+            using u32 = vector<std::uint32_t, 32>::type;
+            using s64 = vector<std::int64_t, 32>::type;
+            using u64 = vector<std::uint64_t, 32>::type;
+            using f32 = vector<float, 32>::type;
+
+            static s8 adds(s8 lhs, s8 rhs)
+            {
+                return s8(_mm256_adds_epi8(__m256i(lhs), __m256i(rhs)));
+            }
+
+            static u8 adds(u8 lhs, u8 rhs)
+            {
+                return u8(_mm256_adds_epu8(__m256i(lhs), __m256i(rhs)));
+            }
+
+            static s16 adds(s16 lhs, s16 rhs)
+            {
+                return s16(_mm256_adds_epi16(__m256i(lhs), __m256i(rhs)));
+            }
+
+            static u16 adds(u16 lhs, u16 rhs)
+            {
+                return u16(_mm256_adds_epu16(__m256i(lhs), __m256i(rhs)));
+            }
+
+            static s8 subs(s8 lhs, s8 rhs)
+            {
+                return s8(_mm256_subs_epi8(__m256i(lhs), __m256i(rhs)));
+            }
+
+            static u8 subs(u8 lhs, u8 rhs)
+            {
+                return u8(_mm256_subs_epu8(__m256i(lhs), __m256i(rhs)));
+            }
+
+            static s16 subs(s16 lhs, s16 rhs)
+            {
+                return s16(_mm256_subs_epi16(__m256i(lhs), __m256i(rhs)));
+            }
+
+            static u16 subs(u16 lhs, u16 rhs)
+            {
+                return u16(_mm256_subs_epu16(__m256i(lhs), __m256i(rhs)));
+            }
+
+            static s16 mulhi(s16 lhs, s16 rhs)
+            {
+                return s16(_mm256_mulhi_epi16(__m256i(lhs), __m256i(rhs)));
+            }
+
+            static u16 mulhi(u16 lhs, u16 rhs)
+            {
+                return u16(_mm256_mulhi_epu16(__m256i(lhs), __m256i(rhs)));
+            }
+
+            // 64-bit products of the even-numbered 32-bit lanes
+            static s64 mul_even(s32 lhs, s32 rhs)
+            {
+                return s64(_mm256_mul_epi32(__m256i(lhs), __m256i(rhs)));
+            }
+
+            static u64 mul_even(u32 lhs, u32 rhs)
+            {
+                return u64(_mm256_mul_epu32(__m256i(lhs), __m256i(rhs)));
+            }
+
+            static s32 truncate(f32 from)
+            {
+                return s32(_mm256_cvttps_epi32(__m256(from)));
+            }
+
+            static f32 to_float(s32 from)
+            {
+                return f32(_mm256_cvtepi32_ps(__m256i(from)));
+            }
+
+            static s32 madd(s16 lhs, s16 rhs)
+            {
+                return s32(_mm256_madd_epi16(__m256i(lhs), __m256i(rhs)));
+            }
+
+            static s32 widen(const std::int8_t* from)
+            {
+                return s32(_mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(from))));
+            }
+
+            static s32 widen(const std::uint8_t* from)
+            {
+                return s32(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(from))));
+            }
+
+            static s32 widen(const std::int16_t* from)
+            {
+                return s32(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(from))));
+            }
+
+            static s32 widen(const std::uint16_t* from)
+            {
+                return s32(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(from))));
+            }
+
+            static s32 widen(const std::int32_t* from)
+            {
+                return load<s32>(from);
+            }
+
+            // packs interleave the 128-bit halves of their operands; the permutation restores their order
+            static s16 pack(s32 lower, s32 upper)
+            {
+                return s16(_mm256_permute4x64_epi64(_mm256_packs_epi32(__m256i(lower), __m256i(upper)), 0xd8));
+            }
+
+            static s8 pack(s16 lower, s16 upper)
+            {
+                return s8(_mm256_permute4x64_epi64(_mm256_packs_epi16(__m256i(lower), __m256i(upper)), 0xd8));
+            }
+
+            static u8 pack_unsigned(s16 lower, s16 upper)
+            {
+                return u8(_mm256_permute4x64_epi64(_mm256_packus_epi16(__m256i(lower), __m256i(upper)), 0xd8));
+            }
+        };
+#endif
+
+#if defined(__AVX512BW__)
+        template<>
+        struct simd<64> {
+            using s8 = vector<std::int8_t, 64>::type;
+            using u8 = vector<std::uint8_t, 64>::type;
+            using s16 = vector<std::int16_t, 64>::type;
+            using u16 = vector<std::uint16_t, 64>::type;
+            using s32 = vector<std::int32_t, 64>::type;
+            using u32 = vector<std::uint32_t, 64>::type;
+            using s64 = vector<std::int64_t, 64>::type;
+            using u64 = vector<std::uint64_t, 64>::type;
+            using f32 = vector<float, 64>::type;
+
+            static s8 adds(s8 lhs, s8 rhs)
+            {
+                return s8(_mm512_adds_epi8(__m512i(lhs), __m512i(rhs)));
+            }
+
+            static u8 adds(u8 lhs, u8 rhs)
+            {
+                return u8(_mm512_adds_epu8(__m512i(lhs), __m512i(rhs)));
+            }
+
+            static s16 adds(s16 lhs, s16 rhs)
+            {
+                return s16(_mm512_adds_epi16(__m512i(lhs), __m512i(rhs)));
+            }
+
+            static u16 adds(u16 lhs, u16 rhs)
+            {
+                return u16(_mm512_adds_epu16(__m512i(lhs), __m512i(rhs)));
+            }
+
+            static s8 subs(s8 lhs, s8 rhs)
+            {
+                return s8(_mm512_subs_epi8(__m512i(lhs), __m512i(rhs)));
+            }
+
+            static u8 subs(u8 lhs, u8 rhs)
+            {
+                return u8(_mm512_subs_epu8(__m512i(lhs), __m512i(rhs)));
+            }
+
+            static s16 subs(s16 lhs, s16 rhs)
+            {
+                return s16(_mm512_subs_epi16(__m512i(lhs), __m512i(rhs)));
+            }
+
+            static u16 subs(u16 lhs, u16 rhs)
+            {
+                return u16(_mm512_subs_epu16(__m512i(lhs), __m512i(rhs)));
+            }
+
+            static s16 mulhi(s16 lhs, s16 rhs)
+            {
+                return s16(_mm512_mulhi_epi16(__m512i(lhs), __m512i(rhs)));
+            }
+
+            static u16 mulhi(u16 lhs, u16 rhs)
+            {
+                return u16(_mm512_mulhi_epu16(__m512i(lhs), __m512i(rhs)));
+            }
+
+            // zero-masked forms avoid an uninitialized pass-through operand
+            static s64 mul_even(s32 lhs, s32 rhs)
+            {
+                return s64(_mm512_maskz_mul_epi32(0xff, __m512i(lhs), __m512i(rhs)));
+            }
+
+            static u64 mul_even(u32 lhs, u32 rhs)
+            {
+                return u64(_mm512_maskz_mul_epu32(0xff, __m512i(lhs), __m512i(rhs)));
+            }
+
+            static s32 truncate(f32 from)
+            {
+                return s32(_mm512_maskz_cvttps_epi32(0xffff, __m512(from)));
+            }
+
+            static f32 to_float(s32 from)
+            {
+                return f32(_mm512_maskz_cvtepi32_ps(0xffff, __m512i(from)));
+            }
+
+            static s32 madd(s16 lhs, s16 rhs)
+            {
+                return s32(_mm512_madd_epi16(__m512i(lhs), __m512i(rhs)));
+            }
+
+            static s32 widen(const std::int8_t* from)
+            {
+                return s32(_mm512_maskz_cvtepi8_epi32(0xffff, _mm_loadu_si128(reinterpret_cast<const __m128i*>(from))));
+            }
+
+            static s32 widen(const std::uint8_t* from)
+            {
+                return s32(_mm512_maskz_cvtepu8_epi32(0xffff, _mm_loadu_si128(reinterpret_cast<const __m128i*>(from))));
+            }
+
+            static s32 widen(const std::int16_t* from)
+            {
+                return s32(_mm512_maskz_cvtepi16_epi32(0xffff, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from))));
+            }
+
+            static s32 widen(const std::uint16_t* from)
+            {
+                return s32(_mm512_maskz_cvtepu16_epi32(0xffff, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from))));
+            }
+
+            static s32 widen(const std::int32_t* from)
+            {
+                return load<s32>(from);
+            }
+
+            // packs interleave the 128-bit quarters of their operands; the permutation restores their order
+            static s16 pack(s32 lower, s32 upper)
+            {
+                return s16(unpermute(_mm512_packs_epi32(__m512i(lower), __m512i(upper))));
+            }
+
+            static s8 pack(s16 lower, s16 upper)
+            {
+                return s8(unpermute(_mm512_packs_epi16(__m512i(lower), __m512i(upper))));
+            }
+
+            static u8 pack_unsigned(s16 lower, s16 upper)
+            {
+                return u8(unpermute(_mm512_packus_epi16(__m512i(lower), __m512i(upper))));
+            }
+
+        private:
+            static __m512i unpermute(__m512i packed)
+            {
+                return _mm512_maskz_permutexvar_epi64(0xff, _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7), packed);
+            }
+        };
+#endif
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // add and subtract of like types
+
+        // The arithmetic operators widen the sum to int (or wider) and conversion back truncates
+        // so wrapping lane-wise addition of the reps is bit-identical.
+
+        template<class OperationTag>
+        struct additive;
+
+        template<>
+        struct additive<_impl::add_tag> {
+            template<class Vector>
+            static Vector op(Vector lhs, Vector rhs)
+            {
+                return lhs+rhs;
+            }
+        };
+
+        template<>
+        struct additive<_impl::subtract_tag> {
+            template<class Vector>
+            static Vector op(Vector lhs, Vector rhs)
+            {
+                return lhs-rhs;
+            }
+        };
+
+        template<class OperationTag, class Rep, int Exponent>
+        struct kernel<OperationTag, fixed_point<Rep, Exponent>, fixed_point<Rep, Exponent>, fixed_point<Rep, Exponent>,
+                typename std::enable_if<
+                        (std::is_same<OperationTag, _impl::add_tag>::value
+                                || std::is_same<OperationTag, _impl::subtract_tag>::value)
+                        && has_rep<fixed_point<Rep, Exponent>,
+                                std::int8_t, std::uint8_t, std::int16_t, std::uint16_t,
+                                std::int32_t, std::uint32_t, std::int64_t, std::uint64_t>::value>::type> {
+            using element = fixed_point<Rep, Exponent>;
+            using lanes = typename vector<typename std::make_unsigned<Rep>::type>::type;
+            static_assert(sizeof(element)==sizeof(Rep), "fixed_point must have the layout of its rep");
+
+            static std::size_t run(const element* lhs, const element* rhs, element* result, std::size_t size)
+            {
+                constexpr auto stride = sizeof(lanes)/sizeof(element);
+                auto vectorized = size-size%stride;
+                for (auto index = std::size_t{0}; index!=vectorized; index += stride) {
+                    store(result+index, additive<OperationTag>::op(
+                            load<lanes>(lhs+index), load<lanes>(rhs+index)));
+                }
+                return vectorized;
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // add and subtract of like saturated_integer 8- and 16-bit types
+
+        // The arithmetic operators widen the sum to int and conversion back saturates
+        // so saturating lane-wise addition of the reps is bit-identical.
+
+        template<class OperationTag>
+        struct saturated_additive;
+
+        template<>
+        struct saturated_additive<_impl::add_tag> {
+            template<class Simd, class Vector>
+            static auto op(Vector lhs, Vector rhs) -> decltype(Simd::adds(lhs, rhs))
+            {
+                return Simd::adds(lhs, rhs);
+            }
+
+            template<class Vector>
+            static Vector wrapped(Vector lhs, Vector rhs)
+            {
+                return lhs+rhs;
+            }
+        };
+
+        template<>
+        struct saturated_additive<_impl::subtract_tag> {
+            template<class Simd, class Vector>
+            static auto op(Vector lhs, Vector rhs) -> decltype(Simd::subs(lhs, rhs))
+            {
+                return Simd::subs(lhs, rhs);
+            }
+
+            template<class Vector>
+            static Vector wrapped(Vector lhs, Vector rhs)
+            {
+                return lhs-rhs;
+            }
+        };
+
+        template<class OperationTag, class Rep>
+        struct is_saturated_additive : std::integral_constant<bool,
+                (std::is_same<OperationTag, _impl::add_tag>::value
+                        || std::is_same<OperationTag, _impl::subtract_tag>::value)
+                && (std::is_same<Rep, std::int8_t>::value || std::is_same<Rep, std::uint8_t>::value
+                        || std::is_same<Rep, std::int16_t>::value || std::is_same<Rep, std::uint16_t>::value)> {
+        };
+
+        template<class OperationTag, class Rep, int Exponent>
+        struct kernel<OperationTag,
+                fixed_point<saturated_integer<Rep>, Exponent>,
+                fixed_point<saturated_integer<Rep>, Exponent>,
+                fixed_point<saturated_integer<Rep>, Exponent>,
+                typename std::enable_if<is_saturated_additive<OperationTag, Rep>::value>::type> {
+            using element = fixed_point<saturated_integer<Rep>, Exponent>;
+            using lanes = typename vector<Rep>::type;
+            static_assert(sizeof(element)==sizeof(Rep), "fixed_point must have the layout of its rep");
+
+            template<class Simd = simd<vector_bytes>>
+            static auto run(const element* lhs, const element* rhs, element* result, std::size_t size)
+            -> decltype(saturated_additive<OperationTag>::template op<Simd>(
+                    std::declval<lanes>(), std::declval<lanes>()), std::size_t{})
+            {
+                constexpr auto stride = sizeof(lanes)/sizeof(element);
+                auto vectorized = size-size%stride;
+                for (auto index = std::size_t{0}; index!=vectorized; index += stride) {
+                    store(result+index, saturated_additive<OperationTag>::template op<Simd>(
+                            load<lanes>(lhs+index), load<lanes>(rhs+index)));
+                }
+                return vectorized;
+            }
+
+            template<class ... Dummy>
+            static std::size_t run(const element*, const element*, element*, std::size_t, Dummy...)
+            {
+                return 0;
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // add and subtract of like sticky_integer 8- and 16-bit types
+
+        // Lanes whose saturated result differs from the result modulo 2^N overflowed. The differences
+        // are accumulated with OR and the overflow flag is raised at most once per array.
+
+        template<class OperationTag, class Rep, int Exponent>
+        struct kernel<OperationTag,
+                fixed_point<sticky_integer<Rep>, Exponent>,
+                fixed_point<sticky_integer<Rep>, Exponent>,
+                fixed_point<sticky_integer<Rep>, Exponent>,
+                typename std::enable_if<is_saturated_additive<OperationTag, Rep>::value>::type> {
+            using element = fixed_point<sticky_integer<Rep>, Exponent>;
+            using lanes = typename vector<Rep>::type;
+            static_assert(sizeof(element)==sizeof(Rep), "fixed_point must have the layout of its rep");
+
+            template<class Simd = simd<vector_bytes>>
+            static auto run(const element* lhs, const element* rhs, element* result, std::size_t size)
+            -> decltype(saturated_additive<OperationTag>::template op<Simd>(
+                    std::declval<lanes>(), std::declval<lanes>()), std::size_t{})
+            {
+                constexpr auto stride = sizeof(lanes)/sizeof(element);
+                auto vectorized = size-size%stride;
+                auto overflow = lanes{};
+                for (auto index = std::size_t{0}; index!=vectorized; index += stride) {
+                    auto l = load<lanes>(lhs+index);
+                    auto r = load<lanes>(rhs+index);
+                    auto saturated = saturated_additive<OperationTag>::template op<Simd>(l, r);
+                    overflow |= saturated ^ saturated_additive<OperationTag>::wrapped(l, r);
+                    store(result+index, saturated);
+                }
+                for (auto lane = std::size_t{0}; lane!=stride; ++lane) {
+                    if (overflow[lane]) {
+                        _integer_impl::raise_overflow();
+                        break;
+                    }
+                }
+                return vectorized;
+            }
+
+            template<class ... Dummy>
+            static std::size_t run(const element*, const element*, element*, std::size_t, Dummy...)
+            {
+                return 0;
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // multiply of like saturated_integer signed 16-bit types
+
+        // The products are formed in 32-bit lanes, divided by 2^Shift rounding toward zero
+        // as conversion back does and narrowed with saturating packs. The elements are widened
+        // to 32-bit lanes and multiplied with madd, whose second operand has its upper half
+        // cleared so that it contributes nothing, because 32-bit multiplies are slow before SSE4.1.
+
+        template<int Shift, class Vector>
+        Vector truncate_shift_signed(Vector product)
+        {
+            return (product+((product >> 31) & ((1 << Shift)-1))) >> Shift;
+        }
+
+        template<int Exponent>
+        struct kernel<_impl::multiply_tag,
+                fixed_point<saturated_integer<std::int16_t>, Exponent>,
+                fixed_point<saturated_integer<std::int16_t>, Exponent>,
+                fixed_point<saturated_integer<std::int16_t>, Exponent>,
+                typename std::enable_if<(Exponent<=0 && Exponent>=-16)>::type> {
+            using element = fixed_point<saturated_integer<std::int16_t>, Exponent>;
+            using lanes = typename vector<std::int16_t>::type;
+            using wide_lanes = typename vector<std::int32_t>::type;
+            static_assert(sizeof(element)==sizeof(std::int16_t), "fixed_point must have the layout of its rep");
+
+            template<class Simd = simd<vector_bytes>>
+            static auto run(const element* lhs, const element* rhs, element* result, std::size_t size)
+            -> decltype(Simd::pack(Simd::madd(std::declval<lanes>(), std::declval<lanes>()), std::declval<wide_lanes>()),
+                    std::size_t{})
+            {
+                constexpr auto stride = sizeof(lanes)/sizeof(element);
+                auto vectorized = size-size%stride;
+                for (auto index = std::size_t{0}; index!=vectorized; index += stride) {
+                    auto l = reinterpret_cast<const std::int16_t*>(lhs+index);
+                    auto r = reinterpret_cast<const std::int16_t*>(rhs+index);
+                    auto lower = products<Simd>(l, r);
+                    auto upper = products<Simd>(l+stride/2, r+stride/2);
+                    store(result+index, Simd::pack(
+                            truncate_shift_signed<-Exponent>(lower), truncate_shift_signed<-Exponent>(upper)));
+                }
+                return vectorized;
+            }
+
+            template<class Simd>
+            static wide_lanes products(const std::int16_t* lhs, const std::int16_t* rhs)
+            {
+                return Simd::madd(lanes(Simd::widen(lhs)), lanes(Simd::widen(rhs) & 0xffff));
+            }
+
+            template<class ... Dummy>
+            static std::size_t run(const element*, const element*, element*, std::size_t, Dummy...)
+            {
+                return 0;
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // multiply of like 16-bit types
+
+        // The product is exact in 32 bits and conversion back to the input type divides it by 2^Shift,
+        // rounding toward zero, then truncates to 16 bits, i.e. takes bits [Shift, Shift+16) of the
+        // product - plus one if the product is negative and any of the bits below Shift are set.
+
+        // all-ones lanes where a product of signed reps is negative
+        template<class Rep, class Vector, typename std::enable_if<std::is_signed<Rep>::value, int>::type Dummy = 0>
+        Vector negative(Vector product)
+        {
+            using element = typename std::make_signed<typename std::decay<decltype(product[0])>::type>::type;
+            return Vector(typename vector<element, sizeof(Vector)>::type(product)<0);
+        }
+
+        template<class Rep, class Vector, typename std::enable_if<!std::is_signed<Rep>::value, int>::type Dummy = 0>
+        Vector negative(Vector)
+        {
+            return Vector{};
+        }
+
+        template<int Shift, class Rep, class Vector, typename std::enable_if<Shift==0, int>::type Dummy = 0>
+        Vector rescale(Vector lower, Vector)
+        {
+            return lower;
+        }
+
+        template<int Shift, class Rep, class Vector, typename std::enable_if<(Shift>0 && Shift<16), int>::type Dummy = 0>
+        Vector rescale(Vector lower, Vector upper)
+        {
+            auto floor = (upper << (16-Shift)) | (lower >> Shift);
+            auto exact = Vector((lower & ((1u << Shift)-1))==0);
+            return floor-(negative<Rep>(upper) & ~exact);
+        }
+
+        template<int Shift, class Rep, class Vector, typename std::enable_if<Shift==16, int>::type Dummy = 0>
+        Vector rescale(Vector lower, Vector upper)
+        {
+            auto exact = Vector(lower==0);
+            return upper-(negative<Rep>(upper) & ~exact);
+        }
+
+        template<class Rep, int Exponent>
+        struct kernel<_impl::multiply_tag, fixed_point<Rep, Exponent>, fixed_point<Rep, Exponent>, fixed_point<Rep, Exponent>,
+                typename std::enable_if<
+                        has_rep<fixed_point<Rep, Exponent>, std::int16_t, std::uint16_t>::value
+                        && (Exponent<=0 && Exponent>=-16)>::type> {
+            using element = fixed_point<Rep, Exponent>;
+            using lanes = typename vector<Rep>::type;
+            using unsigned_lanes = typename vector<std::uint16_t>::type;
+            static_assert(sizeof(element)==sizeof(Rep), "fixed_point must have the layout of its rep");
+
+            template<class Simd = simd<vector_bytes>>
+            static auto run(const element* lhs, const element* rhs, element* result, std::size_t size)
+            -> decltype(Simd::mulhi(std::declval<lanes>(), std::declval<lanes>()), std::size_t{})
+            {
+                constexpr auto stride = sizeof(lanes)/sizeof(element);
+                auto vectorized = size-size%stride;
+                for (auto index = std::size_t{0}; index!=vectorized; index += stride) {
+                    auto l = load<lanes>(lhs+index);
+                    auto r = load<lanes>(rhs+index);
+                    auto lower = unsigned_lanes(l)*unsigned_lanes(r);
+                    auto upper = unsigned_lanes(Simd::mulhi(l, r));
+                    store(result+index, rescale<-Exponent, Rep>(lower, upper));
+                }
+                return vectorized;
+            }
+
+            template<class ... Dummy>
+            static std::size_t run(const element*, const element*, element*, std::size_t, Dummy...)
+            {
+                return 0;
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // multiply of like 32-bit types
+
+        // as above but the 64-bit products of even and odd lanes are rescaled separately;
+        // with 128-bit vectors, the two widening multiplies and the shuffles between them
+        // are slower than the scalar loop so the kernel requires AVX2 or wider
+
+        template<int Shift, class Rep, class Vector, typename std::enable_if<Shift==0, int>::type Dummy = 0>
+        Vector truncate_shift(Vector product)
+        {
+            return product;
+        }
+
+        template<int Shift, class Rep, class Vector, typename std::enable_if<(Shift>0), int>::type Dummy = 0>
+        Vector truncate_shift(Vector product)
+        {
+            return (product+(negative<Rep>(product) & ((std::uint64_t{1} << Shift)-1))) >> Shift;
+        }
+
+        template<class Rep, int Exponent>
+        struct kernel<_impl::multiply_tag, fixed_point<Rep, Exponent>, fixed_point<Rep, Exponent>, fixed_point<Rep, Exponent>,
+                typename std::enable_if<
+                        has_rep<fixed_point<Rep, Exponent>, std::int32_t, std::uint32_t>::value
+                        && (Exponent<=0 && Exponent>=-32) && (vector_bytes>=32)>::type> {
+            using element = fixed_point<Rep, Exponent>;
+            using lanes = typename vector<Rep>::type;
+            using wide_lanes = typename vector<std::uint64_t>::type;
+            static_assert(sizeof(element)==sizeof(Rep), "fixed_point must have the layout of its rep");
+
+            template<class Simd = simd<vector_bytes>>
+            static auto run(const element* lhs, const element* rhs, element* result, std::size_t size)
+            -> decltype(Simd::mul_even(std::declval<lanes>(), std::declval<lanes>()), std::size_t{})
+            {
+                constexpr auto stride = sizeof(lanes)/sizeof(element);
+                auto vectorized = size-size%stride;
+                for (auto index = std::size_t{0}; index!=vectorized; index += stride) {
+                    auto l = load<lanes>(lhs+index);
+                    auto r = load<lanes>(rhs+index);
+                    auto even = truncate_shift<-Exponent, Rep>(wide_lanes(Simd::mul_even(l, r)));
+                    auto odd = truncate_shift<-Exponent, Rep>(wide_lanes(Simd::mul_even(
+                            lanes(wide_lanes(l) >> 32), lanes(wide_lanes(r) >> 32))));
+                    store(result+index, (even & 0xffffffffu) | (odd << 32));
+                }
+                return vectorized;
+            }
+
+            template<class ... Dummy>
+            static std::size_t run(const element*, const element*, element*, std::size_t, Dummy...)
+            {
+                return 0;
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // divide of like signed 16-bit types
+
+        // The dividend is promoted to 32 bits and scaled up by 2^15; the quotient of the reps
+        // is then scaled down by 2^(15+Exponent), rounding toward zero. The two roundings
+        // compose to a single quotient of the dividend scaled up by 2^-Exponent.
+
+        template<class Rep, int Exponent>
+        struct kernel<_impl::divide_tag, fixed_point<Rep, Exponent>, fixed_point<Rep, Exponent>, fixed_point<Rep, Exponent>,
+                typename std::enable_if<
+                        has_rep<fixed_point<Rep, Exponent>, std::int16_t>::value
+                        && (Exponent<=0 && Exponent>=-15)>::type> {
+            using element = fixed_point<Rep, Exponent>;
+            using lanes = vector<std::int16_t, 16>::type;
+            static_assert(sizeof(element)==sizeof(Rep), "fixed_point must have the layout of its rep");
+
+            template<class Simd = simd<16>>
+            static auto run(const element* lhs, const element* rhs, element* result, std::size_t size)
+            -> decltype(Simd::template divide<-Exponent>(std::declval<lanes>(), std::declval<lanes>()), std::size_t{})
+            {
+                constexpr auto stride = sizeof(lanes)/sizeof(element);
+                auto vectorized = size-size%stride;
+                for (auto index = std::size_t{0}; index!=vectorized; index += stride) {
+                    store(result+index, Simd::template divide<-Exponent>(
+                            load<lanes>(lhs+index), load<lanes>(rhs+index)));
+                }
+                return vectorized;
+            }
+
+            template<class ... Dummy>
+            static std::size_t run(const element*, const element*, element*, std::size_t, Dummy...)
+            {
+                return 0;
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // conversion between float and fixed-point types of up to 32 bits
+
+        // Values are scaled, truncated in 32-bit lanes and then adjusted by the rounding policy
+        // using the fraction discarded, which is exact. NaN and out-of-range lanes are
+        // truncated to garbage and replaced afterward.
+
+        template<class RoundingPolicy>
+        struct rounding_lanes;
+
+        template<>
+        struct rounding_lanes<round_toward_zero> {
+            template<class Int, class Float>
+            static Int adjust(Int, Float)
+            {
+                return Int{};
+            }
+
+            // negative values are biased so that the arithmetic shift rounds them up
+            template<int Shift, class Int>
+            static Int shift_right(Int value)
+            {
+                return (value+((value >> 31) & static_cast<std::int32_t>((1u << Shift)-1))) >> Shift;
+            }
+        };
+
+        // comparisons give -1 in lanes where they hold
+        template<>
+        struct rounding_lanes<round_half_up> {
+            template<class Int, class Float>
+            static Int adjust(Int, Float fraction)
+            {
+                return Int(fraction<-.5f)-Int(fraction>=.5f);
+            }
+
+            template<int Shift, class Int>
+            static Int shift_right(Int value)
+            {
+                return (value >> Shift)+((value >> (Shift-1)) & 1);
+            }
+        };
+
+        template<>
+        struct rounding_lanes<round_half_even> {
+            template<class Int, class Float>
+            static Int adjust(Int truncated, Float fraction)
+            {
+                auto odd = -(truncated & 1);
+                return (Int(fraction<-.5f) | (Int(fraction==-.5f) & odd))
+                       -(Int(fraction>.5f) | (Int(fraction==.5f) & odd));
+            }
+
+            // the half bit rounds up if the result is odd or any lower bit is set
+            template<int Shift, class Int>
+            static Int shift_right(Int value)
+            {
+                auto truncated = value >> Shift;
+                auto sticky = -Int((value & ((1 << (Shift-1))-1))!=0);
+                return truncated+((value >> (Shift-1)) & (truncated | sticky) & 1);
+            }
+        };
+
+        template<class Vector>
+        Vector select(Vector mask, Vector if_true, Vector if_false)
+        {
+            return (if_true & mask) | (if_false & ~mask);
+        }
+
+        template<class Rep, int Exponent, class RoundingPolicy, class NanPolicy>
+        struct saturate_kernel<float, fixed_point<Rep, Exponent>, RoundingPolicy, NanPolicy,
+                typename std::enable_if<
+                        has_rep<fixed_point<Rep, Exponent>,
+                                std::int8_t, std::uint8_t, std::int16_t, std::uint16_t, std::int32_t>::value
+                        && (std::is_same<RoundingPolicy, round_toward_zero>::value
+                                || std::is_same<RoundingPolicy, round_half_up>::value
+                                || std::is_same<RoundingPolicy, round_half_even>::value)>::type> {
+            using element = fixed_point<Rep, Exponent>;
+            using floats = typename vector<float>::type;
+            using ints = typename vector<std::int32_t>::type;
+            using unsigned_ints = typename vector<std::uint32_t>::type;
+            static_assert(sizeof(element)==sizeof(Rep), "fixed_point must have the layout of its rep");
+
+            template<class Simd = simd<vector_bytes>>
+            static auto run(const float* from, element* to, std::size_t size)
+            -> decltype(Simd::truncate(std::declval<floats>()), std::size_t{})
+            {
+                constexpr auto stride = sizeof(floats)/sizeof(float);
+                constexpr auto lowest = std::int32_t{std::numeric_limits<Rep>::lowest()};
+                constexpr auto max = std::int32_t{std::numeric_limits<Rep>::max()};
+                auto const nan_value = static_cast<std::int32_t>(NanPolicy::template value<Rep>());
+                auto vectorized = size-size%stride;
+                for (auto index = std::size_t{0}; index!=vectorized; index += stride) {
+                    auto scaled = load<floats>(from+index)*_fixed_point_impl::pow2<float, -Exponent>();
+                    auto nan = ints(scaled!=scaled);
+                    auto below = ints(scaled<=static_cast<float>(lowest));
+                    auto above = ints(scaled>=_fixed_point_impl::pow2<float, std::numeric_limits<Rep>::digits>());
+
+                    // wrapping addition; NaN and out-of-range lanes truncate to the lowest int
+                    auto truncated = Simd::truncate(scaled);
+                    auto rounded = ints(unsigned_ints(truncated)+unsigned_ints(rounding_lanes<RoundingPolicy>::adjust(
+                            truncated, scaled-Simd::to_float(truncated))));
+                    rounded = select(above | ints(rounded>max), ints{}+max, rounded);
+                    rounded = select(below, ints{}+lowest, rounded);
+                    rounded = select(nan, ints{}+nan_value, rounded);
+                    for (auto lane = std::size_t{0}; lane!=stride; ++lane) {
+                        to[index+lane] = element::from_data(static_cast<Rep>(rounded[lane]));
+                    }
+                }
+                return vectorized;
+            }
+
+            template<class ... Dummy>
+            static std::size_t run(const float*, element*, std::size_t, Dummy...)
+            {
+                return 0;
+            }
+        };
+
+        template<class Rep, int Exponent>
+        struct scale_kernel<fixed_point<Rep, Exponent>, float,
+                typename std::enable_if<
+                        has_rep<fixed_point<Rep, Exponent>,
+                                std::int8_t, std::uint8_t, std::int16_t, std::uint16_t, std::int32_t>::value>::type> {
+            using element = fixed_point<Rep, Exponent>;
+            using ints = typename vector<std::int32_t>::type;
+
+            template<class Simd = simd<vector_bytes>>
+            static auto run(const element* from, float* to, std::size_t size)
+            -> decltype(Simd::to_float(std::declval<ints>()), std::size_t{})
+            {
+                constexpr auto stride = sizeof(ints)/sizeof(std::int32_t);
+                auto vectorized = size-size%stride;
+                for (auto index = std::size_t{0}; index!=vectorized; index += stride) {
+                    ints lanes;
+                    for (auto lane = std::size_t{0}; lane!=stride; ++lane) {
+                        lanes[lane] = from[index+lane].data();
+                    }
+                    store(to+index, Simd::to_float(lanes)*_fixed_point_impl::pow2<float, Exponent>());
+                }
+                return vectorized;
+            }
+
+            template<class ... Dummy>
+            static std::size_t run(const element*, float*, std::size_t, Dummy...)
+            {
+                return 0;
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // requantization between fixed-point types of up to 32 bits
+
+        // Elements are widened to 32-bit lanes, rescaled there and narrowed with saturating packs.
+        // The source is accessed through pointers to its rep; fixed_point has the same layout.
+
+        // 32-bit lanes scaled by 2^-Shift, rounded and, where scaled up, saturated to the range of Rep
+        template<class RoundingPolicy, int Shift, class Rep, class Int, typename std::enable_if<(Shift>0), int>::type Dummy = 0>
+        Int rescale_lanes(Int value)
+        {
+            return rounding_lanes<RoundingPolicy>::template shift_right<Shift>(value);
+        }
+
+        template<class RoundingPolicy, int Shift, class Rep, class Int, typename std::enable_if<(Shift<=0), int>::type Dummy = 0>
+        Int rescale_lanes(Int value)
+        {
+            using unsigned_lanes = typename vector<std::uint32_t, sizeof(Int)>::type;
+            constexpr auto max = static_cast<std::int32_t>(greatest<Rep>());
+            constexpr auto min = static_cast<std::int32_t>(lowest<Rep>());
+            auto scaled = Int(unsigned_lanes(value) << -Shift);
+            scaled = select(Int(value>(max >> -Shift)), Int{}+max, scaled);
+            return select(Int(value<static_cast<std::int32_t>(ceil_shift_right<-Shift>(min))), Int{}+min, scaled);
+        }
+
+        // narrowing of ratio vectors of 32-bit lanes, part(0) to part(ratio-1), to one vector of Rep
+        template<class Rep>
+        struct narrow;
+
+        template<>
+        struct narrow<std::int32_t> {
+            static constexpr int ratio = 1;
+
+            template<class Simd, class Part>
+            static auto pack(Part part)
+            -> decltype(part(0))
+            {
+                return part(0);
+            }
+        };
+
+        template<>
+        struct narrow<std::int16_t> {
+            static constexpr int ratio = 2;
+
+            template<class Simd, class Part>
+            static auto pack(Part part)
+            -> decltype(Simd::pack(part(0), part(1)))
+            {
+                return Simd::pack(part(0), part(1));
+            }
+        };
+
+        template<>
+        struct narrow<std::int8_t> {
+            static constexpr int ratio = 4;
+
+            template<class Simd, class Part>
+            static auto pack(Part part)
+            -> decltype(Simd::pack(Simd::pack(part(0), part(1)), Simd::pack(part(2), part(3))))
+            {
+                return Simd::pack(Simd::pack(part(0), part(1)), Simd::pack(part(2), part(3)));
+            }
+        };
+
+        template<>
+        struct narrow<std::uint8_t> {
+            static constexpr int ratio = 4;
+
+            template<class Simd, class Part>
+            static auto pack(Part part)
+            -> decltype(Simd::pack_unsigned(Simd::pack(part(0), part(1)), Simd::pack(part(2), part(3))))
+            {
+                return Simd::pack_unsigned(Simd::pack(part(0), part(1)), Simd::pack(part(2), part(3)));
+            }
+        };
+
+        template<class FromRep, int FromExponent, class ToRep, int ToExponent, class RoundingPolicy>
+        struct requantize_kernel<fixed_point<FromRep, FromExponent>, fixed_point<ToRep, ToExponent>, RoundingPolicy,
+                typename std::enable_if<
+                        has_rep<fixed_point<FromRep, FromExponent>,
+                                std::int8_t, std::uint8_t, std::int16_t, std::uint16_t, std::int32_t>::value
+                        && has_rep<fixed_point<ToRep, ToExponent>,
+                                std::int8_t, std::uint8_t, std::int16_t, std::int32_t>::value
+                        && (ToExponent-FromExponent>=-31 && ToExponent-FromExponent<=31)
+                        && (std::is_same<RoundingPolicy, round_toward_zero>::value
+                                || std::is_same<RoundingPolicy, round_half_up>::value
+                                || std::is_same<RoundingPolicy, round_half_even>::value)>::type> {
+            using from_type = fixed_point<FromRep, FromExponent>;
+            using to_type = fixed_point<ToRep, ToExponent>;
+            using ints = typename vector<std::int32_t>::type;
+            using narrow = _batch_impl::narrow<ToRep>;
+            static_assert(sizeof(from_type)==sizeof(FromRep) && sizeof(to_type)==sizeof(ToRep),
+                    "fixed_point must have the layout of its rep");
+
+            template<class Simd = simd<vector_bytes>>
+            static auto run(const from_type* from, to_type* to, std::size_t size)
+            -> decltype(narrow::template pack<Simd>(std::declval<ints(*)(int)>()),
+                    Simd::widen(std::declval<const FromRep*>()), std::size_t{})
+            {
+                constexpr auto lanes = sizeof(ints)/sizeof(std::int32_t);
+                constexpr auto stride = lanes*narrow::ratio;
+                auto vectorized = size-size%stride;
+                for (auto index = std::size_t{0}; index!=vectorized; index += stride) {
+                    auto first = reinterpret_cast<const FromRep*>(from+index);
+                    store(to+index, narrow::template pack<Simd>([first](int part) {
+                        return rescale_lanes<RoundingPolicy, ToExponent-FromExponent, ToRep>(
+                                Simd::widen(first+part*lanes));
+                    }));
+                }
+                return vectorized;
+            }
+
+            template<class ... Dummy>
+            static std::size_t run(const from_type*, to_type*, std::size_t, Dummy...)
+            {
+                return 0;
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_batch_impl::pair_sums - exact sums of the results of pmaddwd
+
+        // the same pair of adjacent 16-bit elements in every pair of lanes
+        template<class Element>
+        typename vector<std::int16_t>::type broadcast_pair(const Element* pair)
+        {
+            static_assert(sizeof(Element)==sizeof(std::int16_t), "elements must have the layout of std::int16_t");
+            std::int32_t both;
+            std::memcpy(&both, static_cast<const void*>(pair), sizeof(both));
+            return typename vector<std::int16_t>::type(typename vector<std::int32_t>::type{}+both);
+        }
+
+        // true iff a pair is the only one whose products with another like it overflow a 32-bit sum
+        template<class Element>
+        bool is_corner(const Element* pair)
+        {
+            static_assert(sizeof(Element)==sizeof(std::int16_t), "elements must have the layout of std::int16_t");
+            std::int16_t both[2];
+            std::memcpy(both, static_cast<const void*>(pair), sizeof(both));
+            return both[0]==std::numeric_limits<std::int16_t>::lowest()
+                   && both[1]==std::numeric_limits<std::int16_t>::lowest();
+        }
+
+        // Each lane holds the sum of pair sums modulo 2^32 and the sum of their upper 16 bits.
+        // Their difference is the sum of the lower 16 bits, which is less than 2^32 for fewer than
+        // 2^16 additions, so the sum is recovered exactly. The only pair sum which wraps,
+        // 2*(-2^15)^2 = 2^31, is recovered as 2^32 too little and must be corrected by the caller.
+        struct pair_sums {
+            static constexpr int max_additions = (1 << 16)-1;
+
+            typename vector<std::uint32_t>::type modular;
+            typename vector<std::int32_t>::type upper;
+
+            void add(typename vector<std::int32_t>::type pairs)
+            {
+                modular += typename vector<std::uint32_t>::type(pairs);
+                upper += pairs >> 16;
+            }
+
+            std::int64_t operator[](int lane) const
+            {
+                auto upper_bits = std::int64_t{upper[lane]}*0x10000;
+                return upper_bits+static_cast<std::uint32_t>(modular[lane]-static_cast<std::uint32_t>(upper_bits));
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sum of products of 16-bit types
+
+        // Products are summed in adjacent pairs by pmaddwd. Pair sums are split into upper and
+        // lower halves which accumulate in separate 32-bit lanes and are flushed to the total
+        // before they can overflow. The only pair sum which wraps, 2*(-2^15)^2 = 2^31, becomes
+        // the lowest int and is corrected in the upper half.
+
+        template<int Exponent, class Sum>
+        struct dot_kernel<fixed_point<std::int16_t, Exponent>, Sum> {
+            using element = fixed_point<std::int16_t, Exponent>;
+            using shorts = typename vector<std::int16_t>::type;
+            using ints = typename vector<std::int32_t>::type;
+            static_assert(sizeof(element)==sizeof(std::int16_t), "fixed_point must have the layout of its rep");
+
+            template<class Simd = simd<vector_bytes>>
+            static auto run(const element* lhs, const element* rhs, std::size_t size, Sum& total)
+            -> decltype(Simd::madd(std::declval<shorts>(), std::declval<shorts>()), std::size_t{})
+            {
+                constexpr auto stride = sizeof(shorts)/sizeof(std::int16_t);
+                constexpr auto lanes = sizeof(ints)/sizeof(std::int32_t);
+
+                // each iteration adds less than 2^16 to a lane of lower and at most 2^15 to a lane of upper
+                constexpr auto flush_interval = 1 << 15;
+
+                auto upper = ints{};
+                auto lower = ints{};
+                auto flush = [&]() {
+                    auto block_total = std::int64_t{0};
+                    for (auto lane = std::size_t{0}; lane!=lanes; ++lane) {
+                        block_total += std::int64_t{upper[lane]}*0x10000+lower[lane];
+                    }
+                    total += static_cast<Sum>(block_total);
+                    upper = ints{};
+                    lower = ints{};
+                };
+
+                auto vectorized = size-size%stride;
+                for (auto block = std::size_t{0}; block!=vectorized;) {
+                    auto block_end = block+_impl::min<std::size_t>(vectorized-block, flush_interval*stride);
+                    for (; block!=block_end; block += stride) {
+                        auto pairs = Simd::madd(load<shorts>(lhs+block), load<shorts>(rhs+block));
+                        upper += (pairs >> 16)+(ints(pairs==std::numeric_limits<std::int32_t>::min()) & 0x10000);
+                        lower += pairs & 0xffff;
+                    }
+                    flush();
+                }
+                return vectorized;
+            }
+
+            template<class ... Dummy>
+            static std::size_t run(const element*, const element*, std::size_t, Sum&, Dummy...)
+            {
+                return 0;
+            }
+        };
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // batch arithmetic functions
+
+    /// \brief calculates the sums of corresponding elements of two arrays of \ref fixed_point values
+    ///
+    /// \param lhs, rhs arrays of augends and addends
+    /// \param result array of sums
+    /// \param size number of elements in each array
+    ///
+    /// \note Each element of result is assigned `static_cast<Result>(lhs[i]+rhs[i])`.
+    /// Arrays of like types with built-in integer reps are processed using vector instructions,
+    /// as are those with \ref saturated_integer and \ref sticky_integer reps of 8 and 16 bits,
+    /// using saturating instructions. The overflow flag of `sticky_integer` is raised once per array.
+    /// \note result may be the same array as lhs or rhs but must not otherwise overlap them.
+    ///
+    /// \sa subtract, multiply, divide
+
+    template<class LhsRep, int LhsExponent, class RhsRep, int RhsExponent, class ResultRep, int ResultExponent>
+    void add(
+            const fixed_point<LhsRep, LhsExponent>* lhs,
+            const fixed_point<RhsRep, RhsExponent>* rhs,
+            fixed_point<ResultRep, ResultExponent>* result,
+            std::size_t size)
+    {
+        _batch_impl::apply<_impl::add_tag>(lhs, rhs, result, size);
+    }
+
+    /// \brief calculates the differences of corresponding elements of two arrays of \ref fixed_point values
+    ///
+    /// \param lhs, rhs arrays of minuends and subtrahends
+    /// \param result array of differences
+    /// \param size number of elements in each array
+    ///
+    /// \note Each element of result is assigned `static_cast<Result>(lhs[i]-rhs[i])`.
+    /// Arrays of like types with built-in integer reps are processed using vector instructions,
+    /// as are those with \ref saturated_integer and \ref sticky_integer reps of 8 and 16 bits,
+    /// using saturating instructions. The overflow flag of `sticky_integer` is raised once per array.
+    /// \note result may be the same array as lhs or rhs but must not otherwise overlap them.
+    ///
+    /// \sa add, multiply, divide
+
+    template<class LhsRep, int LhsExponent, class RhsRep, int RhsExponent, class ResultRep, int ResultExponent>
+    void subtract(
+            const fixed_point<LhsRep, LhsExponent>* lhs,
+            const fixed_point<RhsRep, RhsExponent>* rhs,
+            fixed_point<ResultRep, ResultExponent>* result,
+            std::size_t size)
+    {
+        _batch_impl::apply<_impl::subtract_tag>(lhs, rhs, result, size);
+    }
+
+    /// \brief calculates the products of corresponding elements of two arrays of \ref fixed_point values
+    ///
+    /// \param lhs, rhs arrays of factors
+    /// \param result array of products
+    /// \param size number of elements in each array
+    ///
+    /// \note Each element of result is assigned `static_cast<Result>(lhs[i]*rhs[i])`.
+    /// Arrays of like types with 16-bit reps and no integer bits beyond their width
+    /// (e.g. Q15 format) are processed using vector instructions, as are those with
+    /// signed 16-bit \ref saturated_integer reps and, where AVX2 is available, 32-bit reps (e.g. Q31).
+    /// \note result may be the same array as lhs or rhs but must not otherwise overlap them.
+    ///
+    /// \sa add, subtract, divide
+
+    template<class LhsRep, int LhsExponent, class RhsRep, int RhsExponent, class ResultRep, int ResultExponent>
+    void multiply(
+            const fixed_point<LhsRep, LhsExponent>* lhs,
+            const fixed_point<RhsRep, RhsExponent>* rhs,
+            fixed_point<ResultRep, ResultExponent>* result,
+            std::size_t size)
+    {
+        _batch_impl::apply<_impl::multiply_tag>(lhs, rhs, result, size);
+    }
+
+    /// \brief calculates the quotients of corresponding elements of two arrays of \ref fixed_point values
+    ///
+    /// \param lhs, rhs arrays of dividends and divisors
+    /// \param result array of quotients
+    /// \param size number of elements in each array
+    ///
+    /// \note Each element of result is assigned `static_cast<Result>(lhs[i]/rhs[i])`.
+    /// Unlike the two-parameter \ref divide, this widens the dividend as `operator/` does.
+    /// Arrays of like types with signed 16-bit reps are processed using vector instructions.
+    /// \note result may be the same array as lhs or rhs but must not otherwise overlap them.
+    /// \note No element of rhs may be zero.
+    ///
+    /// \sa add, subtract, multiply
+
+    template<class LhsRep, int LhsExponent, class RhsRep, int RhsExponent, class ResultRep, int ResultExponent>
+    void divide(
+            const fixed_point<LhsRep, LhsExponent>* lhs,
+            const fixed_point<RhsRep, RhsExponent>* rhs,
+            fixed_point<ResultRep, ResultExponent>* result,
+            std::size_t size)
+    {
+        _batch_impl::apply<_impl::divide_tag>(lhs, rhs, result, size);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // NaN policies of sg14::convert
+
+    /// \brief converts NaN to zero
+    struct nan_to_zero {
+        template<class Rep>
+        static constexpr Rep value()
+        {
+            return Rep{0};
+        }
+    };
+
+    /// \brief converts NaN to the lowest value of the destination type
+    struct nan_to_lowest {
+        template<class Rep>
+        static constexpr Rep value()
+        {
+            return std::numeric_limits<Rep>::lowest();
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // batch conversion functions
+
+    /// \brief converts an array of floating-point values to an array of \ref fixed_point values
+    ///
+    /// \param from array of floating-point values
+    /// \param to array of fixed-point values
+    /// \param size number of elements in each array
+    /// \param rounding \ref round_toward_zero, \ref round_half_up or \ref round_half_even
+    /// \param nan \ref nan_to_zero or \ref nan_to_lowest
+    ///
+    /// \note Unlike conversion of individual values, out-of-range values saturate
+    /// to the lowest or greatest value of the destination type.
+    /// Conversion from float to reps of up to 32 bits is performed using vector instructions.
+    ///
+    /// \par Example
+    ///
+    /// To convert a frame of samples to Q15:
+    /// \snippet snippets.cpp convert an array of float to Q15
+
+    template<class Float, class Rep, int Exponent, class RoundingPolicy = round_toward_zero, class NanPolicy = nan_to_zero,
+            typename std::enable_if<std::is_floating_point<Float>::value, int>::type Dummy = 0>
+    void convert(
+            const Float* from,
+            fixed_point<Rep, Exponent>* to,
+            std::size_t size,
+            RoundingPolicy = RoundingPolicy{},
+            NanPolicy = NanPolicy{})
+    {
+        auto done = _batch_impl::saturate_kernel<Float, fixed_point<Rep, Exponent>, RoundingPolicy, NanPolicy>::run(
+                from, to, size);
+        for (auto index = done; index!=size; ++index) {
+            to[index] = _batch_impl::saturate<RoundingPolicy, NanPolicy, Rep, Exponent>(from[index]);
+        }
+    }
+
+    /// \brief converts an array of \ref fixed_point values to an array of floating-point values
+    ///
+    /// \param from array of fixed-point values
+    /// \param to array of floating-point values
+    /// \param size number of elements in each array
+    ///
+    /// \note Each element of to is assigned `static_cast<Float>(from[i])`.
+    /// Conversion of reps of up to 32 bits to float is performed using vector instructions.
+
+    template<class Rep, int Exponent, class Float,
+            typename std::enable_if<std::is_floating_point<Float>::value, int>::type Dummy = 0>
+    void convert(const fixed_point<Rep, Exponent>* from, Float* to, std::size_t size)
+    {
+        auto done = _batch_impl::scale_kernel<fixed_point<Rep, Exponent>, Float>::run(from, to, size);
+        for (auto index = done; index!=size; ++index) {
+            to[index] = static_cast<Float>(from[index]);
+        }
+    }
+
+    /// \brief converts an array of \ref fixed_point values to an array of another \ref fixed_point type
+    ///
+    /// \param from array of fixed-point values
+    /// \param to array of fixed-point values
+    /// \param size number of elements in each array
+    /// \param rounding \ref round_toward_zero, \ref round_half_up or \ref round_half_even
+    ///
+    /// \note Values are rounded according to the rounding policy
+    /// and those outside the range of the destination type saturate.
+    /// Conversion between reps of up to 32 bits is performed using vector instructions
+    /// and narrowing uses saturating packs.
+
+    template<class FromRep, int FromExponent, class ToRep, int ToExponent, class RoundingPolicy = round_toward_zero>
+    void requantize(
+            const fixed_point<FromRep, FromExponent>* from,
+            fixed_point<ToRep, ToExponent>* to,
+            std::size_t size,
+            RoundingPolicy = RoundingPolicy{})
+    {
+        auto done = _batch_impl::requantize_kernel<
+                fixed_point<FromRep, FromExponent>, fixed_point<ToRep, ToExponent>, RoundingPolicy>::run(from, to, size);
+
+        // the remainder is addressed from its own start so that its bounds are visible to the optimizer
+        from += done;
+        to += done;
+        for (auto remaining = size-done, index = std::size_t{0}; index!=remaining; ++index) {
+            to[index] = _batch_impl::requantize<RoundingPolicy, ToRep, ToExponent>(from[index]);
+        }
+    }
+}
+
+#endif  // SG14_BATCH_H
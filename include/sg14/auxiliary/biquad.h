@@ -0,0 +1,389 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief cascades of second-order infinite impulse response filters of `sg14::fixed_point` samples,
+/// `sg14::biquad_cascade`
+
+#if !defined(SG14_BIQUAD_H)
+#define SG14_BIQUAD_H 1
+
+#include <sg14/auxiliary/batch.h>
+#include <sg14/fixed_point.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+/// study group 14 of the C++ working group
+namespace sg14 {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // structures of sg14::biquad_cascade sections
+
+    /// \brief the direct form I structure of a \ref biquad_cascade section
+    ///
+    /// The section keeps its last two inputs and outputs as \ref biquad_cascade::state_type
+    /// and rounds the sum of the five products once per sample.
+    struct direct_form_1 {
+    };
+
+    /// \brief the direct form I structure with first-order error feedback
+    ///
+    /// As \ref direct_form_1 except that the sum is truncated toward negative infinity
+    /// and the discarded fraction is added to the sum of the next sample.
+    /// The rounding error is then high-pass shaped, which suppresses the limit cycles
+    /// and low-frequency noise of sections whose poles are close to z=1, e.g. low cut-off low-pass filters.
+    struct direct_form_1_error_feedback {
+    };
+
+    /// \brief the transposed direct form II structure of a \ref biquad_cascade section
+    ///
+    /// The section keeps two partial sums of products, exactly, and rounds only its output.
+    /// Its output is therefore identical to that of \ref direct_form_1
+    /// but it keeps two states rather than four.
+    struct transposed_direct_form_2 {
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::biquad_coefficients
+
+    /// \brief the coefficients of one second-order section of a \ref biquad_cascade
+    ///
+    /// The transfer function of the section is
+    /// H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2), i.e.
+    /// y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2].
+    ///
+    /// \tparam Coefficient the \ref fixed_point type of the coefficients, e.g. `make_fixed<1, 14>`
+    /// which holds the range of a1 of any stable section, (-2, 2)
+
+    template<class Coefficient>
+    struct biquad_coefficients {
+        Coefficient b0, b1, b2, a1, a2;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::_biquad_impl
+
+    namespace _biquad_impl {
+        // number of samples which pass through all sections at a time
+        constexpr std::size_t block_size = 256;
+
+        template<class Coefficient, class State>
+        struct traits;
+
+        template<class CoefficientRep, int CoefficientExponent, class StateRep, int StateExponent>
+        struct traits<fixed_point<CoefficientRep, CoefficientExponent>, fixed_point<StateRep, StateExponent>> {
+            static_assert(std::is_integral<CoefficientRep>::value && std::is_signed<CoefficientRep>::value
+                          && std::is_integral<StateRep>::value && std::is_signed<StateRep>::value,
+                    "sg14::biquad_cascade requires fundamental signed integer reps");
+            static_assert(std::numeric_limits<CoefficientRep>::digits<=31 && std::numeric_limits<StateRep>::digits<=31,
+                    "sg14::biquad_cascade requires reps of up to 32 bits");
+            static_assert(CoefficientExponent<0, "sg14::biquad_cascade requires coefficients with fractional digits");
+
+            // a sum of five products of coefficients and states needs 3 bits more than one product
+            static constexpr int product_digits =
+                    std::numeric_limits<CoefficientRep>::digits+std::numeric_limits<StateRep>::digits;
+#if defined(SG14_INT128_ENABLED)
+            using sum = typename std::conditional<product_digits<=60, std::int64_t, SG14_INT128>::type;
+#else
+            static_assert(product_digits<=60, "sg14::biquad_cascade requires a 128-bit integer for these reps");
+            using sum = std::int64_t;
+#endif
+
+            // the sum of products has the exponent of the state plus that of the coefficients
+            static constexpr int shift = -CoefficientExponent;
+
+            // one comparison in the common case that value is in range
+            static StateRep saturate(sum value)
+            {
+                return (sum{static_cast<StateRep>(value)}==value)
+                       ? static_cast<StateRep>(value)
+                       : (value<0) ? std::numeric_limits<StateRep>::lowest() : std::numeric_limits<StateRep>::max();
+            }
+
+            // the state rep nearest to a sum of products, rounded according to RoundingPolicy and saturated
+            template<class RoundingPolicy>
+            static StateRep quantize(sum value)
+            {
+                return saturate(RoundingPolicy::template shift_right<shift>(value));
+            }
+        };
+
+        // the reps of the coefficients of a section
+        struct coefficients {
+            template<class Coefficient>
+            explicit coefficients(biquad_coefficients<Coefficient> const& from)
+                    :b0(from.b0.data()), b1(from.b1.data()), b2(from.b2.data()), a1(from.a1.data()), a2(from.a2.data())
+            {
+            }
+
+            std::int64_t b0, b1, b2, a1, a2;
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_biquad_impl::section
+
+        // one second-order section and its state;
+        // step filters one sample given a copy of the state which is held in local variables for a block;
+        // states are held in sums so that they are not sign-extended for each product
+        template<class Form, class Coefficient, class State, class RoundingPolicy>
+        class section;
+
+        template<class Coefficient, class State, class RoundingPolicy>
+        class section<direct_form_1, Coefficient, State, RoundingPolicy> {
+            using _traits = traits<Coefficient, State>;
+            using _sum = typename _traits::sum;
+            using _rep = typename State::rep;
+
+        public:
+            struct state {
+                _sum x1, x2, y1, y2;
+            };
+
+            explicit section(biquad_coefficients<Coefficient> const& c)
+                    :_c(c), _state()
+            {
+            }
+
+            _rep step(state& s, _rep x0) const
+            {
+                // the product with the input is added last, as it is the last to be known
+                // when this section follows another in a group
+                auto y0 = _traits::template quantize<RoundingPolicy>(
+                        (_c.b1*s.x1+_c.b2*s.x2-_c.a2*s.y2-_c.a1*s.y1)+_c.b0*_sum{x0});
+                s.x2 = s.x1;
+                s.x1 = x0;
+                s.y2 = s.y1;
+                s.y1 = y0;
+                return y0;
+            }
+
+            state& saved()
+            {
+                return _state;
+            }
+
+        private:
+            coefficients _c;
+            state _state;
+        };
+
+        template<class Coefficient, class State, class RoundingPolicy>
+        class section<direct_form_1_error_feedback, Coefficient, State, RoundingPolicy> {
+            using _traits = traits<Coefficient, State>;
+            using _sum = typename _traits::sum;
+            using _rep = typename State::rep;
+
+        public:
+            struct state {
+                _sum x1, x2, y1, y2;
+
+                // the fraction discarded from the previous sum, in [0, 1) units of the state
+                _sum error;
+            };
+
+            explicit section(biquad_coefficients<Coefficient> const& c)
+                    :_c(c), _state()
+            {
+            }
+
+            _rep step(state& s, _rep x0) const
+            {
+                auto total = (_c.b1*s.x1+_c.b2*s.x2-_c.a2*s.y2-_c.a1*s.y1+s.error)+_c.b0*_sum{x0};
+                auto y0 = _traits::saturate(total >> _traits::shift);
+                s.error = total & ((_sum{1} << _traits::shift)-1);
+                s.x2 = s.x1;
+                s.x1 = x0;
+                s.y2 = s.y1;
+                s.y1 = y0;
+                return y0;
+            }
+
+            state& saved()
+            {
+                return _state;
+            }
+
+        private:
+            coefficients _c;
+            state _state;
+        };
+
+        template<class Coefficient, class State, class RoundingPolicy>
+        class section<transposed_direct_form_2, Coefficient, State, RoundingPolicy> {
+            using _traits = traits<Coefficient, State>;
+            using _sum = typename _traits::sum;
+            using _rep = typename State::rep;
+
+        public:
+            // partial sums of products with the exponent of the state plus that of the coefficients
+            struct state {
+                _sum s1, s2;
+            };
+
+            explicit section(biquad_coefficients<Coefficient> const& c)
+                    :_c(c), _state()
+            {
+            }
+
+            _rep step(state& s, _rep x0) const
+            {
+                auto y0 = _traits::template quantize<RoundingPolicy>(_c.b0*_sum{x0}+s.s1);
+                s.s1 = (_c.b1*_sum{x0}+s.s2)-_c.a1*_sum{y0};
+                s.s2 = _c.b2*_sum{x0}-_c.a2*_sum{y0};
+                return y0;
+            }
+
+            state& saved()
+            {
+                return _state;
+            }
+
+        private:
+            coefficients _c;
+            state _state;
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_biquad_impl::run
+
+        // filters a block of signal in place with each section in turn;
+        // the sections are taken four at a time, then in a pair, then alone,
+        // so that the recursions of a group overlap one another
+        template<class Section, class State>
+        void run(Section* sections, std::size_t count, State* signal, std::size_t size)
+        {
+            auto index = std::size_t{0};
+            for (; index+3<count; index += 4) {
+                auto const& first = sections[index];
+                auto const& second = sections[index+1];
+                auto const& third = sections[index+2];
+                auto const& fourth = sections[index+3];
+                auto first_state = sections[index].saved();
+                auto second_state = sections[index+1].saved();
+                auto third_state = sections[index+2].saved();
+                auto fourth_state = sections[index+3].saved();
+                for (auto sample = std::size_t{0}; sample!=size; ++sample) {
+                    signal[sample] = State::from_data(fourth.step(fourth_state, third.step(third_state,
+                            second.step(second_state, first.step(first_state, signal[sample].data())))));
+                }
+                sections[index].saved() = first_state;
+                sections[index+1].saved() = second_state;
+                sections[index+2].saved() = third_state;
+                sections[index+3].saved() = fourth_state;
+            }
+            if (index+1<count) {
+                auto const& first = sections[index];
+                auto const& second = sections[index+1];
+                auto first_state = sections[index].saved();
+                auto second_state = sections[index+1].saved();
+                for (auto sample = std::size_t{0}; sample!=size; ++sample) {
+                    signal[sample] = State::from_data(
+                            second.step(second_state, first.step(first_state, signal[sample].data())));
+                }
+                sections[index].saved() = first_state;
+                sections[index+1].saved() = second_state;
+                index += 2;
+            }
+            if (index<count) {
+                auto const& last = sections[index];
+                auto last_state = sections[index].saved();
+                for (auto sample = std::size_t{0}; sample!=size; ++sample) {
+                    signal[sample] = State::from_data(last.step(last_state, signal[sample].data()));
+                }
+                sections[index].saved() = last_state;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::biquad_cascade
+
+    /// \brief a series of second-order infinite impulse response filters of \ref fixed_point samples
+    ///
+    /// \tparam Sample the \ref fixed_point type of input and output samples
+    /// \tparam Coefficient the \ref fixed_point type of the coefficients, e.g. `make_fixed<1, 14>`
+    /// \tparam State the \ref fixed_point type of the signal between and within sections, e.g. `make_fixed<3, 28>`
+    /// \tparam Form \ref direct_form_1, \ref direct_form_1_error_feedback or \ref transposed_direct_form_2
+    /// \tparam RoundingPolicy \ref round_toward_zero, \ref round_half_up or \ref round_half_even
+    ///
+    /// Input samples are converted to State, pass through each section in turn and are converted back to Sample.
+    /// Within a section, the reps of the products of coefficients and states are summed exactly,
+    /// in 64 bits or, where that might overflow, 128 bits, and rounded and saturated to State.
+    /// Fractional digits of State beyond those of Sample keep rounding errors, and any limit cycle,
+    /// below the precision of the output; integer digits beyond those of Sample
+    /// give headroom to sections with gain.
+    /// Rounding toward zero, the default, also stops the limit cycles of most sections.
+    ///
+    /// Samples are filtered a block at a time by one group of four sections before the next group;
+    /// two or three sections left over filter the block as a pair and then alone.
+    /// Each sample passes through every section of a group before the next sample,
+    /// so that the recursions of the sections overlap one another
+    /// and their states are held in registers for the length of the block.
+    ///
+    /// \par Example
+    ///
+    /// To filter 16-bit samples with 32-bit state:
+    /// \snippet snippets.cpp filter with a biquad cascade
+
+    template<class Sample, class Coefficient = make_fixed<1, 14>, class State = Sample, class Form = direct_form_1,
+            class RoundingPolicy = round_toward_zero>
+    class biquad_cascade {
+        using _section = _biquad_impl::section<Form, Coefficient, State, RoundingPolicy>;
+
+    public:
+        /// type of input and output samples
+        using sample_type = Sample;
+
+        /// type of the coefficients
+        using coefficient_type = Coefficient;
+
+        /// type of the signal within the cascade
+        using state_type = State;
+
+        /// constructs a cascade of the first size elements of sections, with zero state
+        biquad_cascade(const biquad_coefficients<Coefficient>* sections, std::size_t size)
+                :_sections(sections, sections+size), _signal(_biquad_impl::block_size)
+        {
+        }
+
+        /// number of sections
+        std::size_t sections() const noexcept
+        {
+            return _sections.size();
+        }
+
+        /// filters size input samples, continuing from those previously processed
+        ///
+        /// \note output may be the same array as input but must not otherwise overlap it
+        void process(const Sample* input, Sample* output, std::size_t size)
+        {
+            for (auto first = std::size_t{0}; first<size; first += _biquad_impl::block_size) {
+                auto block = _impl::min(_biquad_impl::block_size, size-first);
+                requantize(input+first, _signal.data(), block, RoundingPolicy{});
+                _biquad_impl::run(_sections.data(), _sections.size(), _signal.data(), block);
+                requantize(_signal.data(), output+first, block, RoundingPolicy{});
+            }
+        }
+
+        /// sets the state of every section to zero
+        void reset()
+        {
+            for (auto& section : _sections) {
+                section.saved() = typename _section::state();
+            }
+        }
+
+    private:
+        std::vector<_section> _sections;
+        std::vector<State> _signal;
+    };
+}
+
+#endif  // SG14_BIQUAD_H
@@ -0,0 +1,356 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief fast Fourier transform of complex `sg14::fixed_point` values with block floating-point scaling,
+/// `sg14::fft`
+
+#if !defined(SG14_FFT_H)
+#define SG14_FFT_H 1
+
+#include <sg14/fixed_point.h>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// study group 14 of the C++ working group
+namespace sg14 {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::_fft_impl
+
+    namespace _fft_impl {
+        template<class Rep>
+        struct traits {
+            static_assert(std::is_integral<Rep>::value && std::is_signed<Rep>::value
+                          && std::numeric_limits<Rep>::digits<=31,
+                    "sg14::fft requires fundamental signed integer reps of up to 32 bits");
+
+            static constexpr int digits = std::numeric_limits<Rep>::digits;
+
+            // a product of a twiddle and the sum of two values whose magnitudes are at most sqrt(2)*2^(digits-headroom)
+            // has a magnitude of at most 2^(2*digits-headroom+1.5) which must fit in std::int64_t
+            static constexpr int product_headroom = _impl::max(2*digits-61, 0);
+
+            // twiddles have the exponent -digits and a rep in which 1 is exact
+            using twiddle_rep = typename std::conditional<(digits<31), std::int32_t, std::int64_t>::type;
+        };
+
+        template<class Rep>
+        struct complex {
+            Rep real, imag;
+        };
+
+        // value/2^shift, rounded half up
+        inline std::int64_t scale(std::int64_t value, int shift)
+        {
+            return (shift>0)
+                   ? (value+(std::int64_t{1} << (shift-1))) >> shift
+                   : value*(std::int64_t{1} << -shift);
+        }
+
+        // (lhs*twiddle)/2^digits, rounded half up
+        template<class Rep>
+        complex<std::int64_t> multiply(complex<std::int64_t> const& lhs,
+                complex<typename traits<Rep>::twiddle_rep> const& twiddle)
+        {
+            constexpr auto half = std::int64_t{1} << (traits<Rep>::digits-1);
+            return complex<std::int64_t>{
+                    (lhs.real*twiddle.real-lhs.imag*twiddle.imag+half) >> traits<Rep>::digits,
+                    (lhs.real*twiddle.imag+lhs.imag*twiddle.real+half) >> traits<Rep>::digits};
+        }
+
+        // e^(-2*pi*i*index/period) with the exponent -digits, rounded to nearest
+        template<class Rep, class TwiddleRep = typename traits<Rep>::twiddle_rep>
+        complex<TwiddleRep> twiddle(std::size_t index, std::size_t period)
+        {
+            constexpr auto scale = static_cast<long double>(std::numeric_limits<Rep>::max())+1;
+            auto angle = -2*3.14159265358979323846264338327950288L*static_cast<long double>(index)/period;
+            return complex<TwiddleRep>{
+                    static_cast<TwiddleRep>(std::llround(std::cos(angle)*scale)),
+                    static_cast<TwiddleRep>(std::llround(std::sin(angle)*scale))};
+        }
+
+        // number of bits of headroom of the greatest magnitude of which bits is the bitwise or
+        template<class Rep>
+        int headroom(std::uint64_t bits)
+        {
+            return _impl::count_leading_zeros(bits)-(64-traits<Rep>::digits);
+        }
+
+        // bits whose or with those of other values tells the headroom of the greatest magnitude
+        inline std::uint64_t magnitude_bits(std::int64_t value)
+        {
+            return static_cast<std::uint64_t>(value<0 ? ~value : value);
+        }
+
+        // the number of bits by which the input and the output of a pass are scaled down, or up if negative
+        struct shifts {
+            int input, output;
+        };
+
+        // the complex value at index of an array of interleaved parts, scaled down by shift bits
+        template<class Element>
+        complex<std::int64_t> load(const Element* data, std::size_t index, int shift)
+        {
+            return complex<std::int64_t>{scale(data[2*index].data(), shift), scale(data[2*index+1].data(), shift)};
+        }
+
+        // stores a value which, scaled down by shift bits, fits in the rep of Element; returns its magnitude bits
+        template<class Element>
+        std::uint64_t store(Element* data, std::size_t index, complex<std::int64_t> const& value, int shift)
+        {
+            using rep = typename Element::rep;
+            auto real = scale(value.real, shift), imag = scale(value.imag, shift);
+            data[2*index] = Element::from_data(static_cast<rep>(real));
+            data[2*index+1] = Element::from_data(static_cast<rep>(imag));
+            return magnitude_bits(real) | magnitude_bits(imag);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fft_impl::radix_2 and sg14::_fft_impl::radix_4
+
+        // the first pass where log2(size) is odd: butterflies of adjacent pairs whose twiddles are all 1;
+        // returns the bitwise or of the magnitude bits of the results
+        template<class Element>
+        std::uint64_t radix_2(Element* data, std::size_t size, shifts shift)
+        {
+            using wide = complex<std::int64_t>;
+            auto bits = std::uint64_t{0};
+            for (auto index = std::size_t{0}; index!=size; index += 2) {
+                auto a = load(data, index, shift.input), b = load(data, index+1, shift.input);
+                bits |= store(data, index, wide{a.real+b.real, a.imag+b.imag}, shift.output)
+                        | store(data, index+1, wide{a.real-b.real, a.imag-b.imag}, shift.output);
+            }
+            return bits;
+        }
+
+        // two radix-2 passes, of butterflies of span quarter then 2*quarter, in one sweep of the data;
+        // each group of four values at a stride of quarter is closed under both passes,
+        // so the intermediate values stay in registers (radix 2^2);
+        // twiddles holds e^(-2*pi*i*k/(2*quarter)) and e^(-2*pi*i*k/(4*quarter)) for each k<quarter
+        template<class Element>
+        std::uint64_t radix_4(Element* data, std::size_t size, std::size_t quarter,
+                const complex<typename traits<typename Element::rep>::twiddle_rep>* twiddles, shifts shift)
+        {
+            using rep = typename Element::rep;
+            using wide = complex<std::int64_t>;
+            auto bits = std::uint64_t{0};
+            for (auto group = std::size_t{0}; group!=size; group += 4*quarter) {
+                for (auto k = std::size_t{0}; k!=quarter; ++k) {
+                    auto index = group+k;
+                    auto x0 = load(data, index, shift.input);
+                    auto x1 = multiply<rep>(load(data, index+quarter, shift.input), twiddles[2*k]);
+                    auto x2 = load(data, index+2*quarter, shift.input);
+                    auto x3 = multiply<rep>(load(data, index+3*quarter, shift.input), twiddles[2*k]);
+
+                    // first pass
+                    auto a0 = wide{x0.real+x1.real, x0.imag+x1.imag};
+                    auto a1 = wide{x0.real-x1.real, x0.imag-x1.imag};
+                    auto a2 = multiply<rep>(wide{x2.real+x3.real, x2.imag+x3.imag}, twiddles[2*k+1]);
+                    auto a3 = multiply<rep>(wide{x2.real-x3.real, x2.imag-x3.imag}, twiddles[2*k+1]);
+
+                    // second pass, in which the twiddle of a3 has an extra factor of -i
+                    bits |= store(data, index, wide{a0.real+a2.real, a0.imag+a2.imag}, shift.output)
+                            | store(data, index+quarter, wide{a1.real+a3.imag, a1.imag-a3.real}, shift.output)
+                            | store(data, index+2*quarter, wide{a0.real-a2.real, a0.imag-a2.imag}, shift.output)
+                            | store(data, index+3*quarter, wide{a1.real-a3.imag, a1.imag+a3.real}, shift.output);
+                }
+            }
+            return bits;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fft_impl::check_size
+
+        // size, which must be a power of two
+        inline std::size_t check_size(std::size_t size)
+        {
+#if defined(SG14_EXCEPTIONS_ENABLED)
+            if (size==0 || (size & (size-1))!=0) {
+                throw std::invalid_argument("sg14::fft requires a size which is a power of two");
+            }
+#else
+            assert(size!=0 && (size & (size-1))==0);
+#endif
+            return size;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fft_impl::plan
+
+        // the bit-reversal permutation and the twiddles of each radix-4 pass, in the order they are used
+        template<class Element>
+        class plan {
+            using _rep = typename Element::rep;
+
+        public:
+            explicit plan(std::size_t size)
+                    :_size(check_size(size)), _odd((_impl::ceil_log2(size)%2)!=0)
+            {
+                auto bits = _impl::ceil_log2(size);
+                for (auto index = std::size_t{0}; index!=size; ++index) {
+                    auto reversed = std::size_t{0};
+                    for (auto bit = 0; bit!=bits; ++bit) {
+                        reversed |= ((index >> bit) & 1) << (bits-1-bit);
+                    }
+                    if (index<reversed) {
+                        _swaps.emplace_back(index, reversed);
+                    }
+                }
+
+                for (auto quarter = std::size_t{_odd ? 2u : 1u}; quarter*4<=size; quarter *= 4) {
+                    for (auto k = std::size_t{0}; k!=quarter; ++k) {
+                        _twiddles.push_back(twiddle<_rep>(k, 2*quarter));
+                        _twiddles.push_back(twiddle<_rep>(k, 4*quarter));
+                    }
+                }
+            }
+
+            std::size_t size() const noexcept
+            {
+                return _size;
+            }
+
+            // transforms data in place and returns the number of bits by which the values were scaled down
+            int run(Element* data) const
+            {
+                for (auto const& swap : _swaps) {
+                    std::swap(data[2*swap.first], data[2*swap.second]);
+                    std::swap(data[2*swap.first+1], data[2*swap.second+1]);
+                }
+
+                auto bits = std::uint64_t{0};
+                for (auto index = std::size_t{0}; index!=2*_size; ++index) {
+                    bits |= magnitude_bits(data[index].data());
+                }
+
+                // each radix-2 butterfly grows a part by up to 1+sqrt(2) and each radix-4 one by (1+sqrt(2))^2,
+                // so the data is scaled as if its inputs to a pass had exactly 2 or 3 bits of headroom respectively:
+                // inputs with more headroom are scaled up so that the rounding of products loses less precision;
+                // otherwise the outputs are scaled down, and the inputs only if their products might overflow
+                auto exponent = 0;
+                auto prepare = [&exponent, &bits](int required) {
+                    if (!bits) {
+                        return shifts{0, 0};
+                    }
+                    auto available = headroom<_rep>(bits);
+                    auto input = (available>required)
+                                 ? required-available
+                                 : _impl::max(traits<_rep>::product_headroom-available, 0);
+                    auto output = _impl::max(required-available-input, 0);
+                    exponent += input+output;
+                    return shifts{input, output};
+                };
+                if (_odd) {
+                    bits = radix_2(data, _size, prepare(2));
+                }
+                auto twiddles = _twiddles.data();
+                for (auto quarter = std::size_t{_odd ? 2u : 1u}; quarter*4<=_size; quarter *= 4) {
+                    bits = radix_4(data, _size, quarter, twiddles, prepare(3));
+                    twiddles += 2*quarter;
+                }
+                return exponent;
+            }
+
+        private:
+            std::size_t _size;
+            bool _odd;
+            std::vector<std::pair<std::size_t, std::size_t>> _swaps;
+            std::vector<complex<typename traits<_rep>::twiddle_rep>> _twiddles;
+        };
+
+        // exchanges the real and imaginary parts of size complex values
+        template<class Element>
+        void exchange_parts(Element* data, std::size_t size)
+        {
+            for (auto index = std::size_t{0}; index!=size; ++index) {
+                std::swap(data[2*index], data[2*index+1]);
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::fft
+
+    /// \brief a fast Fourier transform of complex \ref fixed_point values with block floating-point scaling
+    ///
+    /// \tparam Element the \ref fixed_point type of the real and imaginary parts, with a signed rep of up to 32 bits,
+    /// e.g. `fixed_point<std::int16_t, -15>` or `fixed_point<std::int32_t, -31>`
+    ///
+    /// The data is an array of 2*size() Element values, the real and imaginary parts of each complex value in turn,
+    /// as in an array of `std::complex`, and is transformed in place.
+    /// Before each pass, if the greatest magnitude of the data could overflow, every value is shifted right
+    /// by just enough bits and the count is added to a block exponent which is returned.
+    /// The transform of the input is then the output multiplied by 2 to the power of that exponent.
+    ///
+    /// The input is permuted into bit-reversed order and transformed by passes which each combine two radix-2 passes,
+    /// preceded by one radix-2 pass if log2(size()) is odd.
+    /// Each pass sweeps the data once, in order, reading the twiddle factors of the pass from a precomputed table.
+    /// Products of values and twiddle factors are rounded to the precision of Element.
+    ///
+    /// \par Example
+    ///
+    /// To find the power of the frequencies of a block of samples:
+    /// \snippet snippets.cpp transform a block of samples
+
+    template<class Element>
+    class fft;
+
+    template<class Rep, int Exponent>
+    class fft<fixed_point<Rep, Exponent>> {
+    public:
+        /// type of the real and imaginary parts
+        using element_type = fixed_point<Rep, Exponent>;
+
+        /// prepares a transform of size complex values, where size is a power of two
+        ///
+        /// \throws std::invalid_argument if size is not a power of two and exceptions are enabled;
+        /// otherwise, this is asserted
+        explicit fft(std::size_t size)
+                :_plan(size)
+        {
+        }
+
+        /// number of complex values
+        std::size_t size() const noexcept
+        {
+            return _plan.size();
+        }
+
+        /// replaces data with its discrete Fourier transform, X[k] = sum of x[n]*e^(-2*pi*i*k*n/size());
+        /// returns the exponent by whose power of 2 the output must be multiplied to give X
+        int forward(element_type* data) const
+        {
+            return _plan.run(data);
+        }
+
+        /// replaces data with its inverse discrete Fourier transform, x[n] = sum of X[k]*e^(2*pi*i*k*n/size())/size();
+        /// returns the exponent by whose power of 2 the output must be multiplied to give x
+        ///
+        /// \note The exponent includes the division by size() and so is usually negative.
+        int inverse(element_type* data) const
+        {
+            // the forward transform of the values with their parts exchanged, with the parts exchanged back
+            _fft_impl::exchange_parts(data, size());
+            auto exponent = _plan.run(data);
+            _fft_impl::exchange_parts(data, size());
+            return exponent-_impl::ceil_log2(size());
+        }
+
+    private:
+        _fft_impl::plan<element_type> _plan;
+    };
+}
+
+#endif  // SG14_FFT_H
@@ -0,0 +1,601 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief finite impulse response filters of `sg14::fixed_point` samples, `sg14::fir`
+
+#if !defined(SG14_FIR_H)
+#define SG14_FIR_H 1
+
+#include <sg14/auxiliary/batch.h>
+#include <sg14/fixed_point.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/// study group 14 of the C++ working group
+namespace sg14 {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::_fir_impl
+
+    namespace _fir_impl {
+        // number of input samples which are appended to the history at a time
+        constexpr std::size_t block_size = 256;
+
+        template<class Sample, class Coefficient>
+        struct traits;
+
+        template<class SampleRep, int SampleExponent, class CoefficientRep, int CoefficientExponent>
+        struct traits<fixed_point<SampleRep, SampleExponent>, fixed_point<CoefficientRep, CoefficientExponent>> {
+            static_assert(std::is_integral<SampleRep>::value && std::is_integral<CoefficientRep>::value,
+                    "sg14::fir requires fundamental integer reps");
+            static_assert(std::numeric_limits<SampleRep>::digits+std::numeric_limits<CoefficientRep>::digits<=32,
+                    "sg14::fir requires reps of up to 16 bits");
+
+            // samples and coefficients are stored as their reps so that like reps share a kernel
+            using sample_element = fixed_point<SampleRep, 0>;
+            using coefficient_element = fixed_point<CoefficientRep, 0>;
+
+            // the exact sum of products has at least 31 bits to spare
+            using sum = fixed_point<std::int64_t, SampleExponent+CoefficientExponent>;
+
+            // the sum where it is known to fit in 32 bits
+            using narrow_sum = fixed_point<std::int32_t, SampleExponent+CoefficientExponent>;
+
+            // no sum can exceed 2^digits times the sum of the magnitudes of the coefficients
+            static bool is_narrow(std::int64_t magnitudes)
+            {
+                return magnitudes<(std::int64_t{1} << (31-std::numeric_limits<SampleRep>::digits));
+            }
+        };
+
+        // value, which must not be zero
+        inline std::size_t check_positive(std::size_t value, const char* message)
+        {
+#if defined(SG14_EXCEPTIONS_ENABLED)
+            if (value==0) {
+                throw std::invalid_argument(message);
+            }
+#else
+            static_cast<void>(message);
+            assert(value!=0);
+#endif
+            return value;
+        }
+
+        // adds the sum of the products of the reps of leading elements to total; returns their number
+        template<class Element>
+        std::size_t dot_kernel(const Element* samples, const Element* coefficients, std::size_t size,
+                std::int64_t& total)
+        {
+            return _batch_impl::dot_kernel<Element, std::int64_t>::run(samples, coefficients, size, total);
+        }
+
+        template<class SampleElement, class CoefficientElement>
+        std::size_t dot_kernel(const SampleElement*, const CoefficientElement*, std::size_t, std::int64_t&)
+        {
+            return 0;
+        }
+
+        // sum of the products of the reps of samples and coefficients
+        template<class SampleElement, class CoefficientElement>
+        std::int64_t dot(const SampleElement* samples, const CoefficientElement* coefficients, std::size_t size)
+        {
+            auto total = std::int64_t{0};
+            for (auto index = dot_kernel(samples, coefficients, size, total); index!=size; ++index) {
+                total += std::int64_t{samples[index].data()}*coefficients[index].data();
+            }
+            return total;
+        }
+
+        // Sample, rounded and saturated from the sum of products
+        template<class RoundingPolicy, class Sample, class Coefficient>
+        Sample rescale(std::int64_t total)
+        {
+            return _batch_impl::requantize<RoundingPolicy, typename Sample::rep, Sample::exponent>(
+                    traits<Sample, Coefficient>::sum::from_data(total));
+        }
+
+        // number of coefficients in each polyphase component
+        inline std::size_t phase_length(std::size_t taps, std::size_t factor)
+        {
+            return (taps+factor-1)/factor;
+        }
+
+        // coefficients in reverse order so that each is multiplied by a window of samples in order;
+        // with factor>1, the polyphase components h[phase], h[phase+factor], ...;
+        // each is followed by a zero if needed to make its length even
+        template<class Coefficient>
+        std::vector<typename traits<Coefficient, Coefficient>::coefficient_element> reverse(
+                const Coefficient* coefficients, std::size_t taps, std::size_t factor)
+        {
+            using element = typename traits<Coefficient, Coefficient>::coefficient_element;
+            auto length = phase_length(taps, factor);
+            auto stride = length+length%2;
+            std::vector<element> reversed(stride*factor, element{0});
+            for (auto tap = std::size_t{0}; tap!=taps; ++tap) {
+                auto phase = tap%factor;
+                reversed[phase*stride+length-1-tap/factor] = element::from_data(coefficients[tap].data());
+            }
+            return reversed;
+        }
+
+        // the greatest sum of the magnitudes of the coefficients of any of factor polyphase components
+        template<class Element>
+        std::int64_t greatest_magnitudes(const std::vector<Element>& reversed, std::size_t factor)
+        {
+            auto stride = reversed.size()/factor;
+            auto greatest = std::int64_t{0};
+            for (auto phase = std::size_t{0}; phase!=factor; ++phase) {
+                auto magnitudes = std::int64_t{0};
+                for (auto tap = phase*stride; tap!=(phase+1)*stride; ++tap) {
+                    auto value = static_cast<std::int64_t>(reversed[tap].data());
+                    magnitudes += (value<0) ? -value : value;
+                }
+                greatest = _impl::max(greatest, magnitudes);
+            }
+            return greatest;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fir_impl::kernel and sg14::_fir_impl::narrow_kernel
+
+        // calculates the sums of products of coefficients and consecutive windows of samples;
+        // as batch kernels, processes as many leading windows as it can and returns their number
+        template<class SampleElement, class CoefficientElement, class Enable = void>
+        struct kernel {
+            static std::size_t run(const SampleElement*, const CoefficientElement*, std::size_t, std::size_t,
+                    std::int64_t*)
+            {
+                return 0;
+            }
+        };
+
+        // as kernel but for coefficients which are small enough for the sums to fit in 32 bits
+        template<class SampleElement, class CoefficientElement, class NarrowSum, class Enable = void>
+        struct narrow_kernel {
+            static std::size_t run(const SampleElement*, const CoefficientElement*, std::size_t, std::size_t,
+                    NarrowSum*)
+            {
+                return 0;
+            }
+        };
+
+#if defined(__GNUC__)
+        // Lanes loaded from even and odd offsets of the samples hold adjacent pairs of samples
+        // of the even and odd windows, so each pmaddwd with a pair of coefficients
+        // adds two products to the sums of each of twice as many windows as there are lanes.
+        template<>
+        struct kernel<fixed_point<std::int16_t, 0>, fixed_point<std::int16_t, 0>> {
+            using element = fixed_point<std::int16_t, 0>;
+            using shorts = _batch_impl::vector<std::int16_t>::type;
+
+            template<class Simd = _batch_impl::simd<_batch_impl::vector_bytes>>
+            static auto run(const element* samples, const element* coefficients, std::size_t taps, std::size_t size,
+                    std::int64_t* sums)
+            -> decltype(Simd::madd(std::declval<shorts>(), std::declval<shorts>()), std::size_t{})
+            {
+                using _batch_impl::load;
+                using _batch_impl::pair_sums;
+                constexpr auto lanes = sizeof(shorts)/sizeof(std::int32_t);
+                constexpr auto windows = 2*lanes;
+
+                // coefficients are padded to an even number and samples to one more than the last window
+                auto pairs = (taps+1)/2;
+                auto vectorized = size-size%windows;
+
+                std::fill(sums, sums+vectorized, std::int64_t{0});
+                for (auto first = std::size_t{0}; first<pairs; first += pair_sums::max_additions) {
+                    auto last = _impl::min<std::size_t>(first+pair_sums::max_additions, pairs);
+                    for (auto window = std::size_t{0}; window!=vectorized; window += windows) {
+                        pair_sums even = {}, odd = {};
+                        for (auto pair = first; pair!=last; ++pair) {
+                            auto coefficient = _batch_impl::broadcast_pair(coefficients+pair*2);
+                            even.add(Simd::madd(load<shorts>(samples+window+pair*2), coefficient));
+                            odd.add(Simd::madd(load<shorts>(samples+window+pair*2+1), coefficient));
+                        }
+                        for (auto lane = 0; lane!=int(lanes); ++lane) {
+                            sums[window+lane*2] += even[lane];
+                            sums[window+lane*2+1] += odd[lane];
+                        }
+                    }
+                }
+
+                // 2*(-2^15)^2 wraps to -2^31
+                for (auto pair = std::size_t{0}; pair!=pairs; ++pair) {
+                    if (_batch_impl::is_corner(coefficients+pair*2)) {
+                        for (auto window = std::size_t{0}; window!=vectorized; ++window) {
+                            if (_batch_impl::is_corner(samples+window+pair*2)) {
+                                sums[window] += std::int64_t{1} << 32;
+                            }
+                        }
+                    }
+                }
+                return vectorized;
+            }
+
+            template<class ... Dummy>
+            static std::size_t run(const element*, const element*, std::size_t, std::size_t, std::int64_t*, Dummy...)
+            {
+                return 0;
+            }
+        };
+
+        // For most filters, the sum of the magnitudes of the coefficients is less than 2^16,
+        // so pair sums can be added in 32-bit lanes and no pair sum wraps.
+        template<class NarrowSum>
+        struct narrow_kernel<fixed_point<std::int16_t, 0>, fixed_point<std::int16_t, 0>, NarrowSum> {
+            using element = fixed_point<std::int16_t, 0>;
+            using shorts = _batch_impl::vector<std::int16_t>::type;
+            using ints = _batch_impl::vector<std::int32_t>::type;
+
+            template<class Simd = _batch_impl::simd<_batch_impl::vector_bytes>>
+            static auto run(const element* samples, const element* coefficients, std::size_t taps, std::size_t size,
+                    NarrowSum* sums)
+            -> decltype(Simd::madd(std::declval<shorts>(), std::declval<shorts>()), std::size_t{})
+            {
+                using _batch_impl::load;
+                constexpr auto lanes = sizeof(shorts)/sizeof(std::int32_t);
+                constexpr auto windows = 2*lanes;
+
+                auto pairs = (taps+1)/2;
+                auto vectorized = size-size%windows;
+                for (auto window = std::size_t{0}; window!=vectorized; window += windows) {
+                    ints even = {}, odd = {};
+                    for (auto pair = std::size_t{0}; pair!=pairs; ++pair) {
+                        auto coefficient = _batch_impl::broadcast_pair(coefficients+pair*2);
+                        even += Simd::madd(load<shorts>(samples+window+pair*2), coefficient);
+                        odd += Simd::madd(load<shorts>(samples+window+pair*2+1), coefficient);
+                    }
+                    for (auto lane = 0; lane!=int(lanes); ++lane) {
+                        sums[window+lane*2] = NarrowSum::from_data(even[lane]);
+                        sums[window+lane*2+1] = NarrowSum::from_data(odd[lane]);
+                    }
+                }
+                return vectorized;
+            }
+
+            template<class ... Dummy>
+            static std::size_t run(const element*, const element*, std::size_t, std::size_t, NarrowSum*, Dummy...)
+            {
+                return 0;
+            }
+        };
+#endif
+
+        // filters size consecutive windows of samples into every stride-th element of output;
+        // narrow is traits::is_narrow of the sum of the magnitudes of the coefficients
+        template<class RoundingPolicy, class Sample, class Coefficient, class SampleElement, class CoefficientElement>
+        void filter(
+                const SampleElement* samples, const CoefficientElement* coefficients, std::size_t taps, bool narrow,
+                Sample* output, std::size_t size, std::size_t stride)
+        {
+            using narrow_sum = typename traits<Sample, Coefficient>::narrow_sum;
+            Sample rescaled[block_size];
+
+            // sums which fit in 32 bits are rescaled together...
+            narrow_sum narrow_sums[block_size];
+            auto done = narrow
+                        ? narrow_kernel<SampleElement, CoefficientElement, narrow_sum>::run(
+                                samples, coefficients, taps, size, narrow_sums)
+                        : std::size_t{0};
+            if (done) {
+                requantize(narrow_sums, rescaled, done, RoundingPolicy{});
+            }
+            else {
+                // ...and others one at a time
+                std::int64_t sums[block_size];
+                done = kernel<SampleElement, CoefficientElement>::run(samples, coefficients, taps, size, sums);
+                for (auto index = std::size_t{0}; index!=done; ++index) {
+                    rescaled[index] = rescale<RoundingPolicy, Sample, Coefficient>(sums[index]);
+                }
+            }
+            for (auto index = done; index!=size; ++index) {
+                rescaled[index] = rescale<RoundingPolicy, Sample, Coefficient>(dot(samples+index, coefficients, taps));
+            }
+
+            for (auto index = std::size_t{0}; index!=size; ++index) {
+                output[index*stride] = rescaled[index];
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fir_impl::history
+
+        // the most recent samples followed by a block of new ones, so that every window is contiguous
+        template<class Sample, class Element>
+        class history {
+        public:
+            // one more sample than the windows span may be read and multiplied by a zero coefficient
+            explicit history(std::size_t retained)
+                    :_samples(retained+block_size+1, Element{0}), _retained(retained)
+            {
+            }
+
+            // appends up to block_size samples; returns the start of the window which ends at the first of them
+            const Element* append(const Sample* input, std::size_t size)
+            {
+                std::transform(input, input+size, _samples.begin()+_retained, [](Sample const& sample) {
+                    return Element::from_data(sample.data());
+                });
+                return _samples.data();
+            }
+
+            // discards the oldest size samples
+            void advance(std::size_t size)
+            {
+                std::copy(_samples.begin()+size, _samples.begin()+size+_retained, _samples.begin());
+            }
+
+            void clear()
+            {
+                std::fill(_samples.begin(), _samples.end(), Element{0});
+            }
+
+        private:
+            std::vector<Element> _samples;
+            std::size_t _retained;
+        };
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::fir
+
+    /// \brief a finite impulse response filter of \ref fixed_point samples
+    ///
+    /// \tparam Sample the \ref fixed_point type of input and output samples
+    /// \tparam Coefficient the \ref fixed_point type of the coefficients
+    /// \tparam RoundingPolicy \ref round_toward_zero, \ref round_half_up or \ref round_half_even
+    ///
+    /// Each output sample is the sum of the products of the coefficients and the most recent input samples,
+    /// h[0]*x[n] + h[1]*x[n-1] + ... Rather than converting each product with `operator*`
+    /// and realigning it with `operator+`, the reps of the products are summed exactly in 64 bits
+    /// and the sum is rounded and saturated to Sample once, as by \ref requantize.
+    ///
+    /// The history of input samples is stored in a linear buffer
+    /// which is refilled a block at a time, so that every window of samples is contiguous.
+    /// Where samples and coefficients have 16-bit signed reps, the windows of a block are filtered
+    /// together using vector multiply-add instructions.
+    ///
+    /// \par Example
+    ///
+    /// To smooth a signal with a moving average:
+    /// \snippet snippets.cpp filter a block of samples
+    ///
+    /// \sa fir_decimator, fir_interpolator
+
+    template<class Sample, class Coefficient = Sample, class RoundingPolicy = round_toward_zero>
+    class fir {
+        using _traits = _fir_impl::traits<Sample, Coefficient>;
+
+    public:
+        /// type of input and output samples
+        using sample_type = Sample;
+
+        /// type of the coefficients
+        using coefficient_type = Coefficient;
+
+        /// constructs a filter from the first taps elements of coefficients, with a history of zero samples
+        ///
+        /// \throws std::invalid_argument if taps is zero and exceptions are enabled; otherwise, this is asserted
+        fir(const Coefficient* coefficients, std::size_t taps)
+                :_coefficients(_fir_impl::reverse(
+                        coefficients, _fir_impl::check_positive(taps, "sg14::fir requires at least one tap"), 1)),
+                 _narrow(_traits::is_narrow(_fir_impl::greatest_magnitudes(_coefficients, 1))),
+                 _history(taps-1),
+                 _taps(taps)
+        {
+        }
+
+        /// number of coefficients
+        std::size_t taps() const noexcept
+        {
+            return _taps;
+        }
+
+        /// filters size input samples, continuing from those previously processed
+        ///
+        /// \note output may be the same array as input but must not otherwise overlap it
+        void process(const Sample* input, Sample* output, std::size_t size)
+        {
+            for (auto first = std::size_t{0}; first<size; first += _fir_impl::block_size) {
+                auto block = _impl::min(_fir_impl::block_size, size-first);
+                auto window = _history.append(input+first, block);
+                _fir_impl::filter<RoundingPolicy, Sample, Coefficient>(
+                        window, _coefficients.data(), _taps, _narrow, output+first, block, 1);
+                _history.advance(block);
+            }
+        }
+
+        /// sets the history to zero samples
+        void reset()
+        {
+            _history.clear();
+        }
+
+    private:
+        std::vector<typename _traits::coefficient_element> _coefficients;
+
+        // true if the sums of products fit in 32 bits
+        bool _narrow;
+
+        _fir_impl::history<Sample, typename _traits::sample_element> _history;
+        std::size_t _taps;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::fir_decimator
+
+    /// \brief a finite impulse response filter which outputs one sample for every factor input samples
+    ///
+    /// The output is that of \ref fir for the first input sample and every factor-th one after it;
+    /// the other outputs are not calculated.
+    ///
+    /// \sa fir, fir_interpolator
+
+    template<class Sample, class Coefficient = Sample, class RoundingPolicy = round_toward_zero>
+    class fir_decimator {
+        using _traits = _fir_impl::traits<Sample, Coefficient>;
+
+    public:
+        /// type of input and output samples
+        using sample_type = Sample;
+
+        /// type of the coefficients
+        using coefficient_type = Coefficient;
+
+        /// constructs a filter from the first taps elements of coefficients which keeps one sample in factor
+        ///
+        /// \throws std::invalid_argument if taps or factor is zero and exceptions are enabled;
+        /// otherwise, this is asserted
+        fir_decimator(const Coefficient* coefficients, std::size_t taps, std::size_t factor)
+                :_coefficients(_fir_impl::reverse(
+                        coefficients, _fir_impl::check_positive(taps, "sg14::fir_decimator requires at least one tap"),
+                        1)),
+                 _history(taps-1),
+                 _taps(taps),
+                 _factor(_fir_impl::check_positive(factor, "sg14::fir_decimator requires a positive factor")),
+                 _skip(0)
+        {
+        }
+
+        /// number of coefficients
+        std::size_t taps() const noexcept
+        {
+            return _taps;
+        }
+
+        /// number of input samples per output sample
+        std::size_t factor() const noexcept
+        {
+            return _factor;
+        }
+
+        /// filters size input samples, continuing from those previously processed;
+        /// returns the number of samples written to output, at most (size+factor-1)/factor
+        std::size_t process(const Sample* input, Sample* output, std::size_t size)
+        {
+            auto written = std::size_t{0};
+            for (auto first = std::size_t{0}; first<size; first += _fir_impl::block_size) {
+                auto block = _impl::min(_fir_impl::block_size, size-first);
+                auto window = _history.append(input+first, block);
+                auto index = _skip;
+                for (; index<block; index += _factor) {
+                    output[written++] = _fir_impl::rescale<RoundingPolicy, Sample, Coefficient>(
+                            _fir_impl::dot(window+index, _coefficients.data(), _taps));
+                }
+                _skip = index-block;
+                _history.advance(block);
+            }
+            return written;
+        }
+
+        /// sets the history to zero samples and outputs the next input sample
+        void reset()
+        {
+            _history.clear();
+            _skip = 0;
+        }
+
+    private:
+        std::vector<typename _traits::coefficient_element> _coefficients;
+        _fir_impl::history<Sample, typename _traits::sample_element> _history;
+        std::size_t _taps;
+        std::size_t _factor;
+
+        // number of input samples before the next which is output
+        std::size_t _skip;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::fir_interpolator
+
+    /// \brief a finite impulse response filter which outputs factor samples for every input sample
+    ///
+    /// The output is that of \ref fir given the input with factor-1 zero samples inserted after each sample.
+    /// Those zeros are never multiplied: each output is the product of one polyphase component
+    /// of the coefficients, h[phase], h[phase+factor], ..., and the most recent input samples.
+    ///
+    /// \sa fir, fir_decimator
+
+    template<class Sample, class Coefficient = Sample, class RoundingPolicy = round_toward_zero>
+    class fir_interpolator {
+        using _traits = _fir_impl::traits<Sample, Coefficient>;
+
+    public:
+        /// type of input and output samples
+        using sample_type = Sample;
+
+        /// type of the coefficients
+        using coefficient_type = Coefficient;
+
+        /// constructs a filter from the first taps elements of coefficients which outputs factor samples per input
+        ///
+        /// \throws std::invalid_argument if taps or factor is zero and exceptions are enabled;
+        /// otherwise, this is asserted
+        fir_interpolator(const Coefficient* coefficients, std::size_t taps, std::size_t factor)
+                :_coefficients(_fir_impl::reverse(
+                        coefficients,
+                        _fir_impl::check_positive(taps, "sg14::fir_interpolator requires at least one tap"),
+                        _fir_impl::check_positive(factor, "sg14::fir_interpolator requires a positive factor"))),
+                 _narrow(_traits::is_narrow(_fir_impl::greatest_magnitudes(_coefficients, factor))),
+                 _history(_fir_impl::phase_length(taps, factor)-1),
+                 _length(_fir_impl::phase_length(taps, factor)),
+                 _factor(factor)
+        {
+        }
+
+        /// number of output samples per input sample
+        std::size_t factor() const noexcept
+        {
+            return _factor;
+        }
+
+        /// filters size input samples, continuing from those previously processed,
+        /// and writes size*factor samples to output
+        ///
+        /// \note output must not overlap input
+        void process(const Sample* input, Sample* output, std::size_t size)
+        {
+            auto stride = _coefficients.size()/_factor;
+            for (auto first = std::size_t{0}; first<size; first += _fir_impl::block_size) {
+                auto block = _impl::min(_fir_impl::block_size, size-first);
+                auto window = _history.append(input+first, block);
+                for (auto phase = std::size_t{0}; phase!=_factor; ++phase) {
+                    _fir_impl::filter<RoundingPolicy, Sample, Coefficient>(
+                            window, _coefficients.data()+phase*stride, _length, _narrow, output+first*_factor+phase,
+                            block, _factor);
+                }
+                _history.advance(block);
+            }
+        }
+
+        /// sets the history to zero samples
+        void reset()
+        {
+            _history.clear();
+        }
+
+    private:
+        std::vector<typename _traits::coefficient_element> _coefficients;
+
+        // true if the sums of products of every polyphase component fit in 32 bits
+        bool _narrow;
+
+        _fir_impl::history<Sample, typename _traits::sample_element> _history;
+        std::size_t _length;
+        std::size_t _factor;
+    };
+}
+
+#endif  // SG14_FIR_H
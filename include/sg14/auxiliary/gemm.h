@@ -0,0 +1,437 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief multiplication of matrices of `sg14::fixed_point` values, `sg14::gemm`
+
+#if !defined(SG14_GEMM_H)
+#define SG14_GEMM_H 1
+
+#include <sg14/auxiliary/batch.h>
+#include <sg14/fixed_point.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// study group 14 of the C++ working group
+namespace sg14 {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::_gemm_impl
+
+    namespace _gemm_impl {
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_gemm_impl::shape - dimensions of the register tile and cache blocks
+
+        // number of 32-bit lanes in a vector register
+        constexpr int lanes =
+#if defined(__GNUC__)
+                _batch_impl::vector_bytes/4;
+#else
+                4;
+#endif
+
+        // the elements of both matrices are packed into pairs of std::int16_t along the depth;
+        // the product of a pair of rows and a pair of columns is then a single 32-bit multiply-add
+        template<class Rep>
+        struct shape;
+
+        template<>
+        struct shape<std::int8_t> {
+            // pairs of products of 8-bit values fit easily in 32-bit lanes
+            // but a sum of more products of -128 and -128 than max_depth overflows them
+            using sum_rep = std::int32_t;
+            static constexpr std::uint64_t max_depth = 131071;
+            static constexpr int rows = 6;
+            static constexpr int columns = 2*lanes;
+        };
+
+        template<>
+        struct shape<std::int16_t> {
+            // each 32-bit pair of products is split into two lanes which are later summed in 64 bits
+            using sum_rep = std::int64_t;
+            static constexpr std::uint64_t max_depth = (std::uint64_t{1} << 33)-1;
+            static constexpr int rows = 6;
+            static constexpr int columns = lanes;
+        };
+
+        // elements of the blocks of the matrices which are packed together
+        constexpr std::size_t block_rows = 72;
+        constexpr std::size_t block_columns = 256;
+        constexpr std::size_t block_depth = 256;
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_gemm_impl::pack_lhs, pack_rhs - copies blocks into panels of pairs
+
+        // element (row, column) of a row-major matrix, or zero outside the block
+        template<class Rep, int Exponent>
+        std::int16_t element(
+                const fixed_point<Rep, Exponent>* matrix, std::size_t stride,
+                std::size_t row, std::size_t rows, std::size_t column, std::size_t columns)
+        {
+            return (row<rows && column<columns) ? std::int16_t{matrix[row*stride+column].data()} : std::int16_t{0};
+        }
+
+        // packs rows [row, row+rows) and depth [first, last) of lhs into panels of shape::rows rows;
+        // for each panel, records whether any of its pairs is a corner
+        template<class Rep, int Exponent>
+        void pack_lhs(
+                const fixed_point<Rep, Exponent>* lhs, std::size_t depth,
+                std::size_t row, std::size_t rows, std::size_t first, std::size_t last,
+                std::int16_t* panels, char* corners)
+        {
+            constexpr auto panel_rows = std::size_t{shape<Rep>::rows};
+            auto pairs = (last-first+1)/2;
+            for (auto panel = std::size_t{0}; panel*panel_rows<rows; ++panel) {
+                corners[panel] = false;
+                for (auto pair = std::size_t{0}; pair!=pairs; ++pair) {
+                    for (auto offset = std::size_t{0}; offset!=panel_rows; ++offset) {
+                        auto packed_row = row+panel*panel_rows+offset;
+                        auto column = first+pair*2;
+                        panels[0] = element(lhs, depth, packed_row, row+rows, column, last);
+                        panels[1] = element(lhs, depth, packed_row, row+rows, column+1, last);
+                        corners[panel] |= _batch_impl::is_corner(panels);
+                        panels += 2;
+                    }
+                }
+            }
+        }
+
+        // packs depth [first, last) and columns [column, column+columns) of rhs
+        // into panels of shape::columns columns
+        template<class Rep, int Exponent>
+        void pack_rhs(
+                const fixed_point<Rep, Exponent>* rhs, std::size_t stride,
+                std::size_t first, std::size_t last, std::size_t column, std::size_t columns,
+                std::int16_t* panels, char* corners)
+        {
+            constexpr auto panel_columns = std::size_t{shape<Rep>::columns};
+            auto pairs = (last-first+1)/2;
+            for (auto panel = std::size_t{0}; panel*panel_columns<columns; ++panel) {
+                corners[panel] = false;
+                for (auto pair = std::size_t{0}; pair!=pairs; ++pair) {
+                    for (auto offset = std::size_t{0}; offset!=panel_columns; ++offset) {
+                        auto packed_column = column+panel*panel_columns+offset;
+                        auto row = first+pair*2;
+                        panels[0] = element(rhs, stride, row, last, packed_column, column+columns);
+                        panels[1] = element(rhs, stride, row+1, last, packed_column, column+columns);
+                        corners[panel] |= _batch_impl::is_corner(panels);
+                        panels += 2;
+                    }
+                }
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_gemm_impl::multiply_panels - scalar reference
+
+        // adds the products of a panel of lhs and a panel of rhs to a tile of sums
+        template<class Rep, class Sum>
+        void multiply_panels(const std::int16_t* lhs, const std::int16_t* rhs, std::size_t pairs,
+                Sum* sums, std::size_t stride)
+        {
+            using sum_rep = typename shape<Rep>::sum_rep;
+            constexpr auto rows = std::size_t{shape<Rep>::rows};
+            constexpr auto columns = std::size_t{shape<Rep>::columns};
+            for (auto row = std::size_t{0}; row!=rows; ++row) {
+                for (auto column = std::size_t{0}; column!=columns; ++column) {
+                    auto sum = sum_rep{0};
+                    for (auto pair = std::size_t{0}; pair!=pairs; ++pair) {
+                        auto l = lhs+(pair*rows+row)*2;
+                        auto r = rhs+(pair*columns+column)*2;
+                        sum += sum_rep{l[0]}*r[0]+sum_rep{l[1]}*r[1];
+                    }
+                    auto& tile = sums[row*stride+column];
+                    tile = Sum::from_data(tile.data()+sum);
+                }
+            }
+        }
+
+        // vectorized multiply_panels; the corners flag is set
+        // if both panels may contain pairs of pairs whose products overflow 32 bits
+        template<class Rep, class Sum, class Enable = void>
+        struct kernel {
+            static void run(const std::int16_t* lhs, const std::int16_t* rhs, std::size_t pairs, bool,
+                    Sum* sums, std::size_t stride)
+            {
+                multiply_panels<Rep>(lhs, rhs, pairs, sums, stride);
+            }
+        };
+
+#if defined(__GNUC__)
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_gemm_impl::kernel - GCC vector extensions
+
+        // fully unrolls loops over the register tile so that it is not spilled to memory
+#if defined(__clang__)
+#define SG14_GEMM_UNROLL _Pragma("unroll")
+#elif __GNUC__>=8
+#define SG14_GEMM_UNROLL _Pragma("GCC unroll 8")
+#else
+#define SG14_GEMM_UNROLL
+#endif
+
+        using _batch_impl::broadcast_pair;
+        using _batch_impl::load;
+        using _batch_impl::pair_sums;
+        using _batch_impl::simd;
+        using _batch_impl::store;
+        using _batch_impl::vector_bytes;
+
+        using shorts = _batch_impl::vector<std::int16_t>::type;
+        using ints = _batch_impl::vector<std::int32_t>::type;
+
+        template<int Exponent>
+        struct kernel<std::int8_t, fixed_point<std::int32_t, Exponent>> {
+            using sum = fixed_point<std::int32_t, Exponent>;
+            static constexpr int rows = shape<std::int8_t>::rows;
+            static constexpr int vectors = shape<std::int8_t>::columns/lanes;
+
+            template<class Simd = simd<vector_bytes>>
+            static auto run(const std::int16_t* lhs, const std::int16_t* rhs, std::size_t pairs, bool,
+                    sum* sums, std::size_t stride)
+            -> decltype(Simd::madd(std::declval<shorts>(), std::declval<shorts>()), void())
+            {
+                ints tile[rows][vectors] = {};
+                for (auto pair = std::size_t{0}; pair!=pairs; ++pair) {
+                    shorts columns[vectors];
+                    SG14_GEMM_UNROLL
+                    for (auto v = 0; v!=vectors; ++v) {
+                        columns[v] = load<shorts>(rhs+v*lanes*2);
+                    }
+                    SG14_GEMM_UNROLL
+                    for (auto row = 0; row!=rows; ++row) {
+                        auto both = broadcast_pair(lhs+row*2);
+                        SG14_GEMM_UNROLL
+                        for (auto v = 0; v!=vectors; ++v) {
+                            tile[row][v] += Simd::madd(both, columns[v]);
+                        }
+                    }
+                    lhs += rows*2;
+                    rhs += vectors*lanes*2;
+                }
+
+                SG14_GEMM_UNROLL
+                for (auto row = 0; row!=rows; ++row) {
+                    SG14_GEMM_UNROLL
+                    for (auto v = 0; v!=vectors; ++v) {
+                        auto destination = sums+row*stride+v*lanes;
+                        store(destination, load<ints>(destination)+tile[row][v]);
+                    }
+                }
+            }
+
+            template<class ... Dummy>
+            static void run(const std::int16_t* lhs, const std::int16_t* rhs, std::size_t pairs, bool,
+                    sum* sums, std::size_t stride, Dummy...)
+            {
+                multiply_panels<std::int8_t>(lhs, rhs, pairs, sums, stride);
+            }
+        };
+
+        template<int Exponent>
+        struct kernel<std::int16_t, fixed_point<std::int64_t, Exponent>> {
+            using sum = fixed_point<std::int64_t, Exponent>;
+            static constexpr int rows = shape<std::int16_t>::rows;
+
+            template<class Simd = simd<vector_bytes>>
+            static auto run(const std::int16_t* lhs, const std::int16_t* rhs, std::size_t pairs, bool corners,
+                    sum* sums, std::size_t stride)
+            -> decltype(Simd::madd(std::declval<shorts>(), std::declval<shorts>()), void())
+            {
+                static_assert(block_depth/2<=pair_sums::max_additions, "block of depth is too deep for 32-bit lanes");
+                pair_sums tile[rows] = {};
+                auto first_lhs = lhs;
+                auto first_rhs = rhs;
+                for (auto pair = std::size_t{0}; pair!=pairs; ++pair) {
+                    auto columns = load<shorts>(rhs);
+                    SG14_GEMM_UNROLL
+                    for (auto row = 0; row!=rows; ++row) {
+                        tile[row].add(Simd::madd(broadcast_pair(lhs+row*2), columns));
+                    }
+                    lhs += rows*2;
+                    rhs += lanes*2;
+                }
+
+                SG14_GEMM_UNROLL
+                for (auto row = 0; row!=rows; ++row) {
+                    for (auto lane = 0; lane!=lanes; ++lane) {
+                        auto& destination = sums[row*stride+lane];
+                        destination = sum::from_data(destination.data()+tile[row][lane]);
+                    }
+                }
+
+                // 2*(-2^15)^2 wraps to -2^31
+                if (corners) {
+                    for (auto pair = std::size_t{0}; pair!=pairs; ++pair) {
+                        for (auto row = 0; row!=rows; ++row) {
+                            if (!_batch_impl::is_corner(first_lhs+(pair*rows+row)*2)) {
+                                continue;
+                            }
+                            for (auto lane = 0; lane!=lanes; ++lane) {
+                                if (_batch_impl::is_corner(first_rhs+(pair*lanes+lane)*2)) {
+                                    auto& destination = sums[row*stride+lane];
+                                    destination = sum::from_data(destination.data()+(std::int64_t{1} << 32));
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            template<class ... Dummy>
+            static void run(const std::int16_t* lhs, const std::int16_t* rhs, std::size_t pairs, bool,
+                    sum* sums, std::size_t stride, Dummy...)
+            {
+                multiply_panels<std::int16_t>(lhs, rhs, pairs, sums, stride);
+            }
+        };
+
+#undef SG14_GEMM_UNROLL
+#endif
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_gemm_impl::multiply - blocked matrix multiplication
+
+        // storage used by one thread
+        template<class Rep, class Sum>
+        struct workspace {
+            std::vector<std::int16_t> lhs_panels = std::vector<std::int16_t>(block_rows*(block_depth+1));
+            std::vector<std::int16_t> rhs_panels = std::vector<std::int16_t>((block_depth+1)*block_columns);
+            std::vector<char> lhs_corners = std::vector<char>(block_rows/shape<Rep>::rows);
+            std::vector<char> rhs_corners = std::vector<char>(block_columns/shape<Rep>::columns);
+            std::vector<Sum> sums = std::vector<Sum>(block_rows*block_columns);
+        };
+
+        // calculates the tile of result in rows [row, row+rows) and columns [column, column+columns)
+        template<class RoundingPolicy, class Rep, int LhsExponent, int RhsExponent, class ResultRep, int ResultExponent,
+                class Sum>
+        void multiply_tile(
+                const fixed_point<Rep, LhsExponent>* lhs,
+                const fixed_point<Rep, RhsExponent>* rhs,
+                fixed_point<ResultRep, ResultExponent>* result,
+                std::size_t depth, std::size_t stride,
+                std::size_t row, std::size_t rows, std::size_t column, std::size_t columns,
+                workspace<Rep, Sum>& space)
+        {
+            constexpr auto panel_rows = std::size_t{shape<Rep>::rows};
+            constexpr auto panel_columns = std::size_t{shape<Rep>::columns};
+            static_assert(block_rows%panel_rows==0 && block_columns%panel_columns==0,
+                    "blocks must hold whole panels");
+
+            for (auto& sum : space.sums) {
+                sum = Sum{0};
+            }
+
+            for (auto first = std::size_t{0}; first<depth; first += block_depth) {
+                auto last = _impl::min(first+block_depth, depth);
+                auto pairs = (last-first+1)/2;
+                pack_lhs(lhs, depth, row, rows, first, last, space.lhs_panels.data(), space.lhs_corners.data());
+                pack_rhs(rhs, stride, first, last, column, columns, space.rhs_panels.data(), space.rhs_corners.data());
+
+                for (auto rhs_panel = std::size_t{0}; rhs_panel*panel_columns<columns; ++rhs_panel) {
+                    for (auto lhs_panel = std::size_t{0}; lhs_panel*panel_rows<rows; ++lhs_panel) {
+                        kernel<Rep, Sum>::run(
+                                space.lhs_panels.data()+lhs_panel*pairs*panel_rows*2,
+                                space.rhs_panels.data()+rhs_panel*pairs*panel_columns*2,
+                                pairs,
+                                space.lhs_corners[lhs_panel] && space.rhs_corners[rhs_panel],
+                                space.sums.data()+lhs_panel*panel_rows*block_columns+rhs_panel*panel_columns,
+                                block_columns);
+                    }
+                }
+            }
+
+            // the only rescale of each sum
+            for (auto offset = std::size_t{0}; offset!=rows; ++offset) {
+                requantize(space.sums.data()+offset*block_columns, result+(row+offset)*stride+column, columns,
+                        RoundingPolicy{});
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::gemm
+
+    /// \brief calculates the product of two matrices of \ref fixed_point values
+    ///
+    /// \param lhs row-major matrix of rows x depth elements
+    /// \param rhs row-major matrix of depth x columns elements
+    /// \param result row-major matrix of rows x columns elements
+    /// \param rows, depth, columns dimensions of the matrices
+    /// \param rounding \ref round_toward_zero, \ref round_half_up or \ref round_half_even
+    /// \param threads number of threads among which tiles of result are divided
+    ///
+    /// \note The products of elements with 8-bit reps are summed in 32 bits
+    /// and those with 16-bit reps in 64 bits, so each element of result is the exact sum
+    /// rescaled once to the exponent of result, rounded and saturated as by \ref requantize.
+    /// With 8-bit reps, depth may not exceed 131071.
+    ///
+    /// \throws std::invalid_argument if depth is too great and exceptions are enabled;
+    /// otherwise, this is asserted
+    ///
+    /// \note The matrices are multiplied in blocks which are packed into pairs of 16-bit elements
+    /// and multiplied using vector multiply-add instructions where they are available.
+    /// result must not overlap lhs or rhs.
+
+    template<class Rep, int LhsExponent, int RhsExponent, class ResultRep, int ResultExponent,
+            class RoundingPolicy = round_toward_zero>
+    void gemm(
+            const fixed_point<Rep, LhsExponent>* lhs,
+            const fixed_point<Rep, RhsExponent>* rhs,
+            fixed_point<ResultRep, ResultExponent>* result,
+            std::size_t rows, std::size_t depth, std::size_t columns,
+            RoundingPolicy = RoundingPolicy{},
+            unsigned threads = 1)
+    {
+        static_assert(std::is_same<Rep, std::int8_t>::value || std::is_same<Rep, std::int16_t>::value,
+                "sg14::gemm requires elements with std::int8_t or std::int16_t reps");
+#if defined(SG14_EXCEPTIONS_ENABLED)
+        if (depth>_gemm_impl::shape<Rep>::max_depth) {
+            throw std::invalid_argument("sg14::gemm depth would overflow the sums of products");
+        }
+#else
+        assert(depth<=_gemm_impl::shape<Rep>::max_depth);
+#endif
+        using sum = fixed_point<typename _gemm_impl::shape<Rep>::sum_rep, LhsExponent+RhsExponent>;
+        using _gemm_impl::block_columns;
+        using _gemm_impl::block_rows;
+
+        auto tiles_down = (rows+block_rows-1)/block_rows;
+        auto tiles_across = (columns+block_columns-1)/block_columns;
+        auto tiles = tiles_down*tiles_across;
+        threads = static_cast<unsigned>(_impl::max<std::size_t>(_impl::min<std::size_t>(threads, tiles), 1));
+
+        // tiles are divided among threads in a fixed order
+        auto multiply_tiles = [=](std::size_t first) {
+            _gemm_impl::workspace<Rep, sum> space;
+            for (auto tile = first; tile<tiles; tile += threads) {
+                auto row = (tile/tiles_across)*block_rows;
+                auto column = (tile%tiles_across)*block_columns;
+                _gemm_impl::multiply_tile<RoundingPolicy>(
+                        lhs, rhs, result, depth, columns,
+                        row, _impl::min(block_rows, rows-row), column, _impl::min(block_columns, columns-column),
+                        space);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (auto thread = 1u; thread<threads; ++thread) {
+            pool.emplace_back(multiply_tiles, thread);
+        }
+        multiply_tiles(0);
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+}
+
+#endif  // SG14_GEMM_H
@@ -0,0 +1,889 @@
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief two- and three-dimensional vectors of `sg14::fixed_point` values and batch geometry over them
+
+#if !defined(SG14_GEOMETRY_H)
+#define SG14_GEOMETRY_H 1
+
+#include <sg14/auxiliary/batch.h>
+#include <sg14/fixed_point.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+/// study group 14 of the C++ working group
+namespace sg14 {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::vec2, sg14::vec3, sg14::vec2_array and sg14::vec3_array
+
+    /// \brief a two-dimensional vector of \ref fixed_point or floating-point coordinates
+    ///
+    /// \sa vec3, vec2_array
+
+    template<class T>
+    struct vec2 {
+        T x, y;
+    };
+
+    /// \brief a three-dimensional vector of \ref fixed_point or floating-point coordinates
+    ///
+    /// \sa vec2, vec3_array
+
+    template<class T>
+    struct vec3 {
+        T x, y, z;
+    };
+
+    /// \brief a sequence of \ref vec2 values stored as one array per coordinate
+    ///
+    /// Element i is {x[i], y[i]}. Laid out this way, the batch functions \ref dot, \ref cross,
+    /// \ref distance_squared and \ref intersects load the same coordinate of consecutive elements
+    /// into one vector register.
+    ///
+    /// \note x and y must be kept the same size.
+
+    template<class T>
+    struct vec2_array {
+        using value_type = vec2<T>;
+
+        explicit vec2_array(std::size_t size = 0)
+                : x(size), y(size)
+        {
+        }
+
+        std::size_t size() const
+        {
+            return x.size();
+        }
+
+        void resize(std::size_t size)
+        {
+            x.resize(size);
+            y.resize(size);
+        }
+
+        value_type operator[](std::size_t index) const
+        {
+            return value_type{x[index], y[index]};
+        }
+
+        void set(std::size_t index, value_type const& value)
+        {
+            x[index] = value.x;
+            y[index] = value.y;
+        }
+
+        void push_back(value_type const& value)
+        {
+            x.push_back(value.x);
+            y.push_back(value.y);
+        }
+
+        std::vector<T> x, y;
+    };
+
+    /// \brief a sequence of \ref vec3 values stored as one array per coordinate
+    ///
+    /// Element i is {x[i], y[i], z[i]}.
+    ///
+    /// \note x, y and z must be kept the same size.
+    ///
+    /// \sa vec2_array
+
+    template<class T>
+    struct vec3_array {
+        using value_type = vec3<T>;
+
+        explicit vec3_array(std::size_t size = 0)
+                : x(size), y(size), z(size)
+        {
+        }
+
+        std::size_t size() const
+        {
+            return x.size();
+        }
+
+        void resize(std::size_t size)
+        {
+            x.resize(size);
+            y.resize(size);
+            z.resize(size);
+        }
+
+        value_type operator[](std::size_t index) const
+        {
+            return value_type{x[index], y[index], z[index]};
+        }
+
+        void set(std::size_t index, value_type const& value)
+        {
+            x[index] = value.x;
+            y[index] = value.y;
+            z[index] = value.z;
+        }
+
+        void push_back(value_type const& value)
+        {
+            x.push_back(value.x);
+            y.push_back(value.y);
+            z.push_back(value.z);
+        }
+
+        std::vector<T> x, y, z;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::_geometry_impl
+
+    namespace _geometry_impl {
+        using _impl::ceil_log2;
+        using _impl::signed_rep;
+
+        // the number of digits of the widest signed built-in integer
+#if defined(SG14_INT128_ENABLED)
+        constexpr int max_digits = std::numeric_limits<SG14_INT128>::digits;
+#else
+        constexpr int max_digits = std::numeric_limits<std::int64_t>::digits;
+#endif
+
+        // the rep of a sum of products with the given number of digits;
+        // sums of products of coordinates with 32-bit reps need more than 64 bits
+        template<int Digits>
+        struct sum_rep {
+            static_assert(Digits<=max_digits,
+                    "sg14 geometry on coordinates with reps this wide requires a 128-bit integer; define SG14_USE_INT128");
+            using type = signed_rep<Digits>;
+        };
+
+        // the narrowest unsigned built-in integer with at least the given number of digits
+        template<int Digits>
+        using unsigned_rep = set_width_t<std::uint64_t, Digits>;
+
+        // the rep of T and conversion to and from it; floating-point values are their own reps
+        template<class T>
+        struct rep_of {
+            using type = T;
+
+            static constexpr T to_rep(T value)
+            {
+                return value;
+            }
+
+            static constexpr T from_rep(T value)
+            {
+                return value;
+            }
+        };
+
+        template<class Rep, int Exponent>
+        struct rep_of<fixed_point<Rep, Exponent>> {
+            using type = Rep;
+
+            static constexpr Rep to_rep(fixed_point<Rep, Exponent> const& value)
+            {
+                return value.data();
+            }
+
+            static constexpr fixed_point<Rep, Exponent> from_rep(Rep value)
+            {
+                return fixed_point<Rep, Exponent>::from_data(value);
+            }
+        };
+
+        template<class T>
+        using result_rep = typename rep_of<T>::type;
+
+        template<class T>
+        constexpr result_rep<T> to_rep(T const& value)
+        {
+            return rep_of<T>::to_rep(value);
+        }
+
+        template<class Result>
+        constexpr Result from_rep(result_rep<Result> value)
+        {
+            return rep_of<Result>::from_rep(value);
+        }
+
+        // types of the intermediate and final results of geometric calculations on T;
+        // floating-point values are calculated in T
+        template<class T>
+        struct traits {
+            static_assert(std::is_floating_point<T>::value,
+                    "sg14 geometry requires fixed_point or floating-point coordinates");
+
+            using difference = T;
+
+            template<int Terms>
+            using product_sum = T;
+
+            template<int Terms>
+            using square_sum = T;
+
+            using magnitude_square = T;
+        };
+
+        // fixed-point values are calculated exactly in the narrowest reps which cannot overflow:
+        // the difference of two values has one more digit than either,
+        // the product of two values has one more digit than the sum of theirs
+        // (for the product of two lowest values) and a sum of n terms has ceil(log2(n)) more;
+        // the square of the magnitude of a difference fits in an unsigned rep of twice its digits
+        template<class Rep, int Exponent>
+        struct traits<fixed_point<Rep, Exponent>> {
+            static_assert(std::is_integral<Rep>::value, "sg14 geometry requires fundamental integer reps");
+
+            static constexpr int digits = std::numeric_limits<Rep>::digits;
+
+            using difference = fixed_point<signed_rep<digits+1>, Exponent>;
+
+            template<int Terms>
+            using product_sum = fixed_point<typename sum_rep<2*digits+1+ceil_log2(Terms)>::type, 2*Exponent>;
+
+            template<int Terms>
+            using square_sum = fixed_point<typename sum_rep<2*(digits+1)+1+ceil_log2(Terms)>::type, 2*Exponent>;
+
+            using magnitude_square = unsigned_rep<2*(digits+1)>;
+        };
+
+        template<class T>
+        using difference = typename traits<T>::difference;
+
+        template<class T, int Terms>
+        using product_sum = typename traits<T>::template product_sum<Terms>;
+
+        template<class T, int Terms>
+        using square_sum = typename traits<T>::template square_sum<Terms>;
+
+        template<class T>
+        using magnitude_square = typename traits<T>::magnitude_square;
+
+        // product of the reps of lhs and rhs in the rep of Result
+        template<class Result, class T>
+        constexpr result_rep<Result> multiply(T const& lhs, T const& rhs)
+        {
+            return static_cast<result_rep<Result>>(to_rep(lhs))*to_rep(rhs);
+        }
+
+        // difference of the reps of lhs and rhs in the rep of the difference of T
+        template<class T>
+        constexpr result_rep<difference<T>> subtract(T const& lhs, T const& rhs)
+        {
+            return static_cast<result_rep<difference<T>>>(to_rep(lhs))-to_rep(rhs);
+        }
+
+        // sum of the reps of lhs and rhs in the rep of the difference of T
+        template<class T>
+        constexpr result_rep<difference<T>> add(T const& lhs, T const& rhs)
+        {
+            return static_cast<result_rep<difference<T>>>(to_rep(lhs))+to_rep(rhs);
+        }
+
+        // square of the rep of a difference in the rep of Result
+        template<class Result, class Difference>
+        constexpr result_rep<Result> square(Difference difference)
+        {
+            return static_cast<result_rep<Result>>(difference)*difference;
+        }
+
+        // square of the magnitude of the rep of a difference of T, in the rep of magnitude squares of T
+        template<class T, class Difference>
+        constexpr magnitude_square<T> square_magnitude(Difference difference)
+        {
+            return static_cast<magnitude_square<T>>(
+                    static_cast<magnitude_square<T>>((difference<0) ? -difference : difference)
+                    *static_cast<magnitude_square<T>>((difference<0) ? -difference : difference));
+        }
+
+        // whether the sum of the squares is no greater than limit;
+        // unsigned squares are compared one at a time so that their sum cannot overflow
+        template<class Square, typename std::enable_if<!std::is_floating_point<Square>::value, int>::type Dummy = 0>
+        constexpr bool sum_within(Square limit, Square first, Square second)
+        {
+            return (first<=limit) & (second<=limit-first);
+        }
+
+        template<class Square, typename std::enable_if<!std::is_floating_point<Square>::value, int>::type Dummy = 0>
+        constexpr bool sum_within(Square limit, Square first, Square second, Square third)
+        {
+            return (first<=limit) & (second<=limit-first) & (third<=limit-first-second);
+        }
+
+        template<class Square, typename std::enable_if<std::is_floating_point<Square>::value, int>::type Dummy = 0>
+        constexpr bool sum_within(Square limit, Square first, Square second)
+        {
+            return first+second<=limit;
+        }
+
+        template<class Square, typename std::enable_if<std::is_floating_point<Square>::value, int>::type Dummy = 0>
+        constexpr bool sum_within(Square limit, Square first, Square second, Square third)
+        {
+            return first+second+third<=limit;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_geometry_impl::kernel
+
+        // vectorized implementations of the batch geometry functions on arrays of T;
+        // each processes as many leading elements as it can and returns their number;
+        // where no vectorized implementation applies, it processes nothing
+        template<class T, class Enable = void>
+        struct kernel {
+            template<int Dimensions, class Result>
+            static std::size_t dot(const T* const*, const T* const*, Result*, std::size_t)
+            {
+                return 0;
+            }
+
+            template<class Result>
+            static std::size_t cross(const T* const*, const T* const*, int, int, Result*, std::size_t)
+            {
+                return 0;
+            }
+
+            template<int Dimensions, class Result>
+            static std::size_t distance_squared(const T* const*, const T* const*, Result*, std::size_t)
+            {
+                return 0;
+            }
+
+            template<int Dimensions, class Centres, class Radii>
+            static std::size_t intersects(Centres, Radii, const T* const*, const T*, bool*, std::size_t)
+            {
+                return 0;
+            }
+        };
+
+#if defined(__GNUC__)
+        // Coordinates are widened to 32-bit lanes. The differences, products and sums of 8-bit reps
+        // are exact in them, as are the unsigned squares which intersects compares for 8-bit reps
+        // and signed 16-bit reps. Values which fit in 16 bits are multiplied with pmaddwd,
+        // which SSE2 has and which is cheaper than a multiply of 32-bit lanes. The square of the sum of the radii is truncated to the width
+        // of magnitude_square so that, like the scalar square, it wraps if the radii are negative.
+
+        template<class Rep, int Exponent>
+        struct kernel<fixed_point<Rep, Exponent>, typename std::enable_if<
+                _batch_impl::has_rep<fixed_point<Rep, Exponent>, std::int8_t, std::uint8_t, std::int16_t>::value>::type> {
+            using element = fixed_point<Rep, Exponent>;
+            using shorts = typename _batch_impl::vector<std::int16_t>::type;
+            using ints = typename _batch_impl::vector<std::int32_t>::type;
+            using unsigneds = typename _batch_impl::vector<std::uint32_t>::type;
+            static_assert(sizeof(element)==sizeof(Rep), "fixed_point must have the layout of its rep");
+
+            static constexpr auto lanes = sizeof(ints)/sizeof(std::int32_t);
+
+            // true iff Result is the exact result of a function of 8-bit reps, which fits in 32 bits
+            template<class Result, class Exact>
+            using is_exact = std::integral_constant<bool, sizeof(Rep)==1 && std::is_same<Result, Exact>::value>;
+
+            // lanes of consecutive elements of an array or of one element repeated
+            template<class Simd>
+            static ints widen(const element* from, std::size_t index)
+            {
+                return Simd::widen(reinterpret_cast<const Rep*>(from+index));
+            }
+
+            template<class Simd>
+            static ints widen(element const& value, std::size_t)
+            {
+                return ints{}+value.data();
+            }
+
+            // products of lanes which hold 16-bit values in one multiply-add of 16-bit lanes,
+            // the second operand of which has its upper halves cleared
+            template<class Simd>
+            static ints multiply(ints lhs, ints rhs)
+            {
+                return Simd::madd(shorts(lhs), shorts(rhs & 0xffff));
+            }
+
+            // squares of differences, which fit in 16 bits for 8-bit reps but not for 16-bit reps
+            template<class Simd>
+            static unsigneds square(unsigneds difference, std::true_type)
+            {
+                return unsigneds(multiply<Simd>(ints(difference), ints(difference)));
+            }
+
+            template<class Simd>
+            static unsigneds square(unsigneds difference, std::false_type)
+            {
+                return difference*difference;
+            }
+
+            template<class Simd>
+            static unsigneds square(unsigneds difference)
+            {
+                return square<Simd>(difference, std::integral_constant<bool, sizeof(Rep)==1>{});
+            }
+
+            template<int Dimensions, class Result, class Simd = _batch_impl::simd<_batch_impl::vector_bytes>>
+            static auto dot(const element* const* lhs, const element* const* rhs, Result* result, std::size_t size)
+            -> typename std::enable_if<is_exact<Result, product_sum<element, Dimensions>>::value,
+                    decltype(Simd::madd(std::declval<shorts>(), std::declval<shorts>()), std::size_t{})>::type
+            {
+                auto vectorized = size-size%lanes;
+                for (auto index = std::size_t{0}; index!=vectorized; index += lanes) {
+                    auto sum = ints{};
+                    for (auto dimension = 0; dimension!=Dimensions; ++dimension) {
+                        sum += multiply<Simd>(widen<Simd>(lhs[dimension], index), widen<Simd>(rhs[dimension], index));
+                    }
+                    _batch_impl::store(result+index, sum);
+                }
+                return vectorized;
+            }
+
+            template<int Dimensions, class Result, class ... Dummy>
+            static std::size_t dot(const element* const*, const element* const*, Result*, std::size_t, Dummy...)
+            {
+                return 0;
+            }
+
+            // lhs[first]*rhs[second] - lhs[second]*rhs[first]
+            template<class Result, class Simd = _batch_impl::simd<_batch_impl::vector_bytes>>
+            static auto cross(const element* const* lhs, const element* const* rhs, int first, int second,
+                    Result* result, std::size_t size)
+            -> typename std::enable_if<is_exact<Result, product_sum<element, 2>>::value,
+                    decltype(Simd::madd(std::declval<shorts>(), std::declval<shorts>()), std::size_t{})>::type
+            {
+                auto vectorized = size-size%lanes;
+                for (auto index = std::size_t{0}; index!=vectorized; index += lanes) {
+                    _batch_impl::store(result+index,
+                            multiply<Simd>(widen<Simd>(lhs[first], index), widen<Simd>(rhs[second], index))
+                            -multiply<Simd>(widen<Simd>(lhs[second], index), widen<Simd>(rhs[first], index)));
+                }
+                return vectorized;
+            }
+
+            template<class Result, class ... Dummy>
+            static std::size_t cross(const element* const*, const element* const*, int, int, Result*, std::size_t,
+                    Dummy...)
+            {
+                return 0;
+            }
+
+            template<int Dimensions, class Result, class Simd = _batch_impl::simd<_batch_impl::vector_bytes>>
+            static auto distance_squared(const element* const* lhs, const element* const* rhs, Result* result,
+                    std::size_t size)
+            -> typename std::enable_if<is_exact<Result, square_sum<element, Dimensions>>::value,
+                    decltype(Simd::madd(std::declval<shorts>(), std::declval<shorts>()), std::size_t{})>::type
+            {
+                auto vectorized = size-size%lanes;
+                for (auto index = std::size_t{0}; index!=vectorized; index += lanes) {
+                    auto sum = ints{};
+                    for (auto dimension = 0; dimension!=Dimensions; ++dimension) {
+                        auto difference = widen<Simd>(lhs[dimension], index)-widen<Simd>(rhs[dimension], index);
+                        sum += multiply<Simd>(difference, difference);
+                    }
+                    _batch_impl::store(result+index, sum);
+                }
+                return vectorized;
+            }
+
+            template<int Dimensions, class Result, class ... Dummy>
+            static std::size_t distance_squared(const element* const*, const element* const*, Result*, std::size_t,
+                    Dummy...)
+            {
+                return 0;
+            }
+
+            // centres and radii are arrays or, for one circle or sphere, its coordinates and its radius;
+            // the 32-bit masks of four vectors of lanes are packed into one vector of bools
+            template<int Dimensions, class Centres, class Radii, class Simd = _batch_impl::simd<_batch_impl::vector_bytes>>
+            static auto intersects(Centres centres, Radii radii,
+                    const element* const* other_centres, const element* other_radii, bool* result, std::size_t size)
+            -> decltype(Simd::pack(Simd::pack(Simd::madd(std::declval<shorts>(), std::declval<shorts>()),
+                    std::declval<ints>()), Simd::pack(std::declval<ints>(), std::declval<ints>())), std::size_t{})
+            {
+                constexpr auto limit_mask = std::uint32_t{std::numeric_limits<magnitude_square<element>>::max()};
+                auto within = [&](std::size_t index) {
+                    auto sum = unsigneds(widen<Simd>(radii, index)+widen<Simd>(other_radii, index));
+                    auto remaining = square<Simd>(sum) & limit_mask;
+                    auto mask = ints{}==ints{};
+                    for (auto dimension = 0; dimension!=Dimensions; ++dimension) {
+                        auto difference = unsigneds(widen<Simd>(centres[dimension], index)
+                                                    -widen<Simd>(other_centres[dimension], index));
+                        auto squared = square<Simd>(difference);
+                        mask &= ints(squared<=remaining);
+                        remaining -= squared;
+                    }
+                    return mask;
+                };
+
+                constexpr auto stride = 4*lanes;
+                auto vectorized = size-size%stride;
+                for (auto index = std::size_t{0}; index!=vectorized; index += stride) {
+                    _batch_impl::store(result+index, Simd::pack(
+                            Simd::pack(within(index), within(index+lanes)),
+                            Simd::pack(within(index+2*lanes), within(index+3*lanes))) & 1);
+                }
+                return vectorized;
+            }
+
+            template<int Dimensions, class Centres, class Radii, class ... Dummy>
+            static std::size_t intersects(Centres, Radii, const element* const*, const element*, bool*, std::size_t,
+                    Dummy...)
+            {
+                return 0;
+            }
+        };
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // geometry of individual vectors
+
+    /// \brief calculates the dot product of two \ref vec2 values
+    ///
+    /// \return lhs.x*rhs.x + lhs.y*rhs.y; where the coordinates are \ref fixed_point values,
+    /// the result is exact in the narrowest built-in integer rep which can hold it.
+    ///
+    /// \note The products of coordinates with 32-bit reps need more than 64 bits
+    /// and so require SG14_USE_INT128 and a compiler which supports 128-bit integers.
+
+    template<class T>
+    constexpr auto dot(vec2<T> const& lhs, vec2<T> const& rhs)
+    -> _geometry_impl::product_sum<T, 2>
+    {
+        using result = _geometry_impl::product_sum<T, 2>;
+        return _geometry_impl::from_rep<result>(
+                _geometry_impl::multiply<result>(lhs.x, rhs.x)+_geometry_impl::multiply<result>(lhs.y, rhs.y));
+    }
+
+    /// \brief calculates the dot product of two \ref vec3 values
+    ///
+    /// \return lhs.x*rhs.x + lhs.y*rhs.y + lhs.z*rhs.z, exact as for \ref vec2
+
+    template<class T>
+    constexpr auto dot(vec3<T> const& lhs, vec3<T> const& rhs)
+    -> _geometry_impl::product_sum<T, 3>
+    {
+        using result = _geometry_impl::product_sum<T, 3>;
+        return _geometry_impl::from_rep<result>(
+                _geometry_impl::multiply<result>(lhs.x, rhs.x)+_geometry_impl::multiply<result>(lhs.y, rhs.y)
+                +_geometry_impl::multiply<result>(lhs.z, rhs.z));
+    }
+
+    /// \brief calculates the z coordinate of the cross product of two \ref vec2 values
+    ///
+    /// \return lhs.x*rhs.y - lhs.y*rhs.x, exact as for \ref dot
+
+    template<class T>
+    constexpr auto cross(vec2<T> const& lhs, vec2<T> const& rhs)
+    -> _geometry_impl::product_sum<T, 2>
+    {
+        using result = _geometry_impl::product_sum<T, 2>;
+        return _geometry_impl::from_rep<result>(
+                _geometry_impl::multiply<result>(lhs.x, rhs.y)-_geometry_impl::multiply<result>(lhs.y, rhs.x));
+    }
+
+    /// \brief calculates the cross product of two \ref vec3 values, exact as for \ref dot
+
+    template<class T>
+    constexpr auto cross(vec3<T> const& lhs, vec3<T> const& rhs)
+    -> vec3<_geometry_impl::product_sum<T, 2>>
+    {
+        using result = _geometry_impl::product_sum<T, 2>;
+        return vec3<result>{
+                _geometry_impl::from_rep<result>(
+                        _geometry_impl::multiply<result>(lhs.y, rhs.z)-_geometry_impl::multiply<result>(lhs.z, rhs.y)),
+                _geometry_impl::from_rep<result>(
+                        _geometry_impl::multiply<result>(lhs.z, rhs.x)-_geometry_impl::multiply<result>(lhs.x, rhs.z)),
+                _geometry_impl::from_rep<result>(
+                        _geometry_impl::multiply<result>(lhs.x, rhs.y)-_geometry_impl::multiply<result>(lhs.y, rhs.x))};
+    }
+
+    /// \brief calculates the square of the distance between two \ref vec2 values
+    ///
+    /// \return (lhs.x-rhs.x)^2 + (lhs.y-rhs.y)^2; where the coordinates are \ref fixed_point values,
+    /// the differences and the result are exact in the narrowest built-in integer reps which can hold them.
+    ///
+    /// \note As with \ref dot, coordinates with 32-bit reps require a 128-bit integer.
+
+    template<class T>
+    constexpr auto distance_squared(vec2<T> const& lhs, vec2<T> const& rhs)
+    -> _geometry_impl::square_sum<T, 2>
+    {
+        using result = _geometry_impl::square_sum<T, 2>;
+        return _geometry_impl::from_rep<result>(
+                _geometry_impl::square<result>(_geometry_impl::subtract(lhs.x, rhs.x))
+                +_geometry_impl::square<result>(_geometry_impl::subtract(lhs.y, rhs.y)));
+    }
+
+    /// \brief calculates the square of the distance between two \ref vec3 values, exact as for \ref vec2
+
+    template<class T>
+    constexpr auto distance_squared(vec3<T> const& lhs, vec3<T> const& rhs)
+    -> _geometry_impl::square_sum<T, 3>
+    {
+        using result = _geometry_impl::square_sum<T, 3>;
+        return _geometry_impl::from_rep<result>(
+                _geometry_impl::square<result>(_geometry_impl::subtract(lhs.x, rhs.x))
+                +_geometry_impl::square<result>(_geometry_impl::subtract(lhs.y, rhs.y))
+                +_geometry_impl::square<result>(_geometry_impl::subtract(lhs.z, rhs.z)));
+    }
+
+    /// \brief tests whether two circles touch or overlap
+    ///
+    /// \param centre, other_centre the centres of the circles
+    /// \param radius, other_radius their non-negative radii
+    ///
+    /// \return true iff the distance between the centres is no greater than the sum of the radii;
+    /// where the coordinates are \ref fixed_point values, the comparison is exact
+    ///
+    /// \note Rather than summing the squares of the coordinate differences in the wider rep
+    /// of \ref distance_squared, each square is compared in an unsigned rep of twice the width
+    /// of the differences with what remains of the square of the sum of the radii,
+    /// e.g. in 32 bits for 16-bit coordinates.
+
+    template<class T>
+    constexpr bool intersects(vec2<T> const& centre, T const& radius, vec2<T> const& other_centre, T const& other_radius)
+    {
+        return _geometry_impl::sum_within(
+                _geometry_impl::square_magnitude<T>(_geometry_impl::add(radius, other_radius)),
+                _geometry_impl::square_magnitude<T>(_geometry_impl::subtract(centre.x, other_centre.x)),
+                _geometry_impl::square_magnitude<T>(_geometry_impl::subtract(centre.y, other_centre.y)));
+    }
+
+    /// \brief tests whether two spheres touch or overlap, as for circles
+
+    template<class T>
+    constexpr bool intersects(vec3<T> const& centre, T const& radius, vec3<T> const& other_centre, T const& other_radius)
+    {
+        return _geometry_impl::sum_within(
+                _geometry_impl::square_magnitude<T>(_geometry_impl::add(radius, other_radius)),
+                _geometry_impl::square_magnitude<T>(_geometry_impl::subtract(centre.x, other_centre.x)),
+                _geometry_impl::square_magnitude<T>(_geometry_impl::subtract(centre.y, other_centre.y)),
+                _geometry_impl::square_magnitude<T>(_geometry_impl::subtract(centre.z, other_centre.z)));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // batch geometry of arrays of vectors
+
+    // Each function applies the function of the same name to corresponding elements and converts
+    // the result. Where the coordinates are fixed_point values with 8-bit reps, or 16-bit signed reps
+    // in the case of intersects, and Result is the exact result type, leading elements are calculated
+    // in 32-bit vector lanes by _geometry_impl::kernel and the remainder one at a time.
+
+    /// \brief calculates the dot products of corresponding elements of two \ref vec2_array values
+    ///
+    /// \param lhs, rhs arrays of the same size
+    /// \param result array of lhs.size() elements, each of which is assigned
+    /// `static_cast<Result>(dot(lhs[i], rhs[i]))`
+    ///
+    /// \note To avoid rounding, Result should be the return type of \ref dot of individual vectors.
+
+    template<class T, class Result>
+    void dot(vec2_array<T> const& lhs, vec2_array<T> const& rhs, Result* result)
+    {
+        auto lhs_x = lhs.x.data(), lhs_y = lhs.y.data();
+        auto rhs_x = rhs.x.data(), rhs_y = rhs.y.data();
+        const T* lhs_coordinates[] = {lhs_x, lhs_y};
+        const T* rhs_coordinates[] = {rhs_x, rhs_y};
+        auto size = lhs.size();
+        for (auto index = _geometry_impl::kernel<T>::template dot<2>(lhs_coordinates, rhs_coordinates, result, size);
+             index!=size; ++index) {
+            result[index] = static_cast<Result>(dot(
+                    vec2<T>{lhs_x[index], lhs_y[index]}, vec2<T>{rhs_x[index], rhs_y[index]}));
+        }
+    }
+
+    /// \brief calculates the dot products of corresponding elements of two \ref vec3_array values, as for \ref vec2
+
+    template<class T, class Result>
+    void dot(vec3_array<T> const& lhs, vec3_array<T> const& rhs, Result* result)
+    {
+        auto lhs_x = lhs.x.data(), lhs_y = lhs.y.data(), lhs_z = lhs.z.data();
+        auto rhs_x = rhs.x.data(), rhs_y = rhs.y.data(), rhs_z = rhs.z.data();
+        const T* lhs_coordinates[] = {lhs_x, lhs_y, lhs_z};
+        const T* rhs_coordinates[] = {rhs_x, rhs_y, rhs_z};
+        auto size = lhs.size();
+        for (auto index = _geometry_impl::kernel<T>::template dot<3>(lhs_coordinates, rhs_coordinates, result, size);
+             index!=size; ++index) {
+            result[index] = static_cast<Result>(dot(
+                    vec3<T>{lhs_x[index], lhs_y[index], lhs_z[index]},
+                    vec3<T>{rhs_x[index], rhs_y[index], rhs_z[index]}));
+        }
+    }
+
+    /// \brief calculates the z coordinates of the cross products of corresponding elements
+    /// of two \ref vec2_array values, as for \ref dot
+
+    template<class T, class Result>
+    void cross(vec2_array<T> const& lhs, vec2_array<T> const& rhs, Result* result)
+    {
+        auto lhs_x = lhs.x.data(), lhs_y = lhs.y.data();
+        auto rhs_x = rhs.x.data(), rhs_y = rhs.y.data();
+        const T* lhs_coordinates[] = {lhs_x, lhs_y};
+        const T* rhs_coordinates[] = {rhs_x, rhs_y};
+        auto size = lhs.size();
+        for (auto index = _geometry_impl::kernel<T>::cross(lhs_coordinates, rhs_coordinates, 0, 1, result, size);
+             index!=size; ++index) {
+            result[index] = static_cast<Result>(cross(
+                    vec2<T>{lhs_x[index], lhs_y[index]}, vec2<T>{rhs_x[index], rhs_y[index]}));
+        }
+    }
+
+    /// \brief calculates the cross products of corresponding elements of two \ref vec3_array values
+    ///
+    /// \param lhs, rhs arrays of the same size
+    /// \param result array which is resized to lhs.size() and whose coordinates are assigned
+    /// those of `cross(lhs[i], rhs[i])`, each converted to Result
+
+    template<class T, class Result>
+    void cross(vec3_array<T> const& lhs, vec3_array<T> const& rhs, vec3_array<Result>& result)
+    {
+        result.resize(lhs.size());
+        auto lhs_x = lhs.x.data(), lhs_y = lhs.y.data(), lhs_z = lhs.z.data();
+        auto rhs_x = rhs.x.data(), rhs_y = rhs.y.data(), rhs_z = rhs.z.data();
+        auto result_x = result.x.data(), result_y = result.y.data(), result_z = result.z.data();
+        const T* lhs_coordinates[] = {lhs_x, lhs_y, lhs_z};
+        const T* rhs_coordinates[] = {rhs_x, rhs_y, rhs_z};
+        auto size = lhs.size();
+        _geometry_impl::kernel<T>::cross(lhs_coordinates, rhs_coordinates, 1, 2, result_x, size);
+        _geometry_impl::kernel<T>::cross(lhs_coordinates, rhs_coordinates, 2, 0, result_y, size);
+        for (auto index = _geometry_impl::kernel<T>::cross(lhs_coordinates, rhs_coordinates, 0, 1, result_z, size);
+             index!=size; ++index) {
+            auto product = cross(
+                    vec3<T>{lhs_x[index], lhs_y[index], lhs_z[index]},
+                    vec3<T>{rhs_x[index], rhs_y[index], rhs_z[index]});
+            result_x[index] = static_cast<Result>(product.x);
+            result_y[index] = static_cast<Result>(product.y);
+            result_z[index] = static_cast<Result>(product.z);
+        }
+    }
+
+    /// \brief calculates the squares of the distances between corresponding elements
+    /// of two \ref vec2_array values, as for \ref dot
+
+    template<class T, class Result>
+    void distance_squared(vec2_array<T> const& lhs, vec2_array<T> const& rhs, Result* result)
+    {
+        auto lhs_x = lhs.x.data(), lhs_y = lhs.y.data();
+        auto rhs_x = rhs.x.data(), rhs_y = rhs.y.data();
+        const T* lhs_coordinates[] = {lhs_x, lhs_y};
+        const T* rhs_coordinates[] = {rhs_x, rhs_y};
+        auto size = lhs.size();
+        for (auto index = _geometry_impl::kernel<T>::template distance_squared<2>(
+                lhs_coordinates, rhs_coordinates, result, size); index!=size; ++index) {
+            result[index] = static_cast<Result>(distance_squared(
+                    vec2<T>{lhs_x[index], lhs_y[index]}, vec2<T>{rhs_x[index], rhs_y[index]}));
+        }
+    }
+
+    /// \brief calculates the squares of the distances between corresponding elements
+    /// of two \ref vec3_array values, as for \ref dot
+
+    template<class T, class Result>
+    void distance_squared(vec3_array<T> const& lhs, vec3_array<T> const& rhs, Result* result)
+    {
+        auto lhs_x = lhs.x.data(), lhs_y = lhs.y.data(), lhs_z = lhs.z.data();
+        auto rhs_x = rhs.x.data(), rhs_y = rhs.y.data(), rhs_z = rhs.z.data();
+        const T* lhs_coordinates[] = {lhs_x, lhs_y, lhs_z};
+        const T* rhs_coordinates[] = {rhs_x, rhs_y, rhs_z};
+        auto size = lhs.size();
+        for (auto index = _geometry_impl::kernel<T>::template distance_squared<3>(
+                lhs_coordinates, rhs_coordinates, result, size); index!=size; ++index) {
+            result[index] = static_cast<Result>(distance_squared(
+                    vec3<T>{lhs_x[index], lhs_y[index], lhs_z[index]},
+                    vec3<T>{rhs_x[index], rhs_y[index], rhs_z[index]}));
+        }
+    }
+
+    /// \brief tests whether pairs of circles touch or overlap
+    ///
+    /// \param centres, other_centres arrays of the same size
+    /// \param radii, other_radii arrays of the non-negative radii of the circles in centres and other_centres
+    /// \param result array of centres.size() elements, each of which is assigned
+    /// `intersects(centres[i], radii[i], other_centres[i], other_radii[i])`
+    ///
+    /// \par Example
+    ///
+    /// To find which of a set of objects are hit by their projectiles:
+    /// \snippet snippets.cpp test circles for intersection
+
+    template<class T>
+    void intersects(vec2_array<T> const& centres, const T* radii,
+            vec2_array<T> const& other_centres, const T* other_radii, bool* result)
+    {
+        auto x = centres.x.data(), y = centres.y.data();
+        auto other_x = other_centres.x.data(), other_y = other_centres.y.data();
+        const T* coordinates[] = {x, y};
+        const T* other_coordinates[] = {other_x, other_y};
+        auto size = centres.size();
+        for (auto index = _geometry_impl::kernel<T>::template intersects<2>(
+                static_cast<const T* const*>(coordinates), radii, other_coordinates, other_radii, result, size);
+             index!=size; ++index) {
+            result[index] = intersects(vec2<T>{x[index], y[index]}, radii[index],
+                    vec2<T>{other_x[index], other_y[index]}, other_radii[index]);
+        }
+    }
+
+    /// \brief tests whether one circle touches or overlaps each of an array of circles
+    ///
+    /// \param centre, radius the circle
+    /// \param other_centres, other_radii arrays of the centres and non-negative radii of the other circles
+    /// \param result array of other_centres.size() elements, each of which is assigned
+    /// `intersects(centre, radius, other_centres[i], other_radii[i])`
+
+    template<class T>
+    void intersects(vec2<T> const& centre, T const& radius,
+            vec2_array<T> const& other_centres, const T* other_radii, bool* result)
+    {
+        auto other_x = other_centres.x.data(), other_y = other_centres.y.data();
+        const T coordinates[] = {centre.x, centre.y};
+        const T* other_coordinates[] = {other_x, other_y};
+        auto size = other_centres.size();
+        for (auto index = _geometry_impl::kernel<T>::template intersects<2>(
+                static_cast<const T*>(coordinates), radius, other_coordinates, other_radii, result, size);
+             index!=size; ++index) {
+            result[index] = intersects(centre, radius, vec2<T>{other_x[index], other_y[index]}, other_radii[index]);
+        }
+    }
+
+    /// \brief tests whether pairs of spheres touch or overlap, as for circles
+
+    template<class T>
+    void intersects(vec3_array<T> const& centres, const T* radii,
+            vec3_array<T> const& other_centres, const T* other_radii, bool* result)
+    {
+        auto x = centres.x.data(), y = centres.y.data(), z = centres.z.data();
+        auto other_x = other_centres.x.data(), other_y = other_centres.y.data(), other_z = other_centres.z.data();
+        const T* coordinates[] = {x, y, z};
+        const T* other_coordinates[] = {other_x, other_y, other_z};
+        auto size = centres.size();
+        for (auto index = _geometry_impl::kernel<T>::template intersects<3>(
+                static_cast<const T* const*>(coordinates), radii, other_coordinates, other_radii, result, size);
+             index!=size; ++index) {
+            result[index] = intersects(vec3<T>{x[index], y[index], z[index]}, radii[index],
+                    vec3<T>{other_x[index], other_y[index], other_z[index]}, other_radii[index]);
+        }
+    }
+
+    /// \brief tests whether one sphere touches or overlaps each of an array of spheres, as for circles
+
+    template<class T>
+    void intersects(vec3<T> const& centre, T const& radius,
+            vec3_array<T> const& other_centres, const T* other_radii, bool* result)
+    {
+        auto other_x = other_centres.x.data(), other_y = other_centres.y.data(), other_z = other_centres.z.data();
+        const T coordinates[] = {centre.x, centre.y, centre.z};
+        const T* other_coordinates[] = {other_x, other_y, other_z};
+        auto size = other_centres.size();
+        for (auto index = _geometry_impl::kernel<T>::template intersects<3>(
+                static_cast<const T*>(coordinates), radius, other_coordinates, other_radii, result, size);
+             index!=size; ++index) {
+            result[index] = intersects(centre, radius,
+                    vec3<T>{other_x[index], other_y[index], other_z[index]}, other_radii[index]);
+        }
+    }
+}
+
+#endif  // SG14_GEOMETRY_H
@@ -30,24 +30,27 @@ namespace sg14 {
         using common_type = typename std::common_type<Lhs, Rhs>::type; \
         return static_cast<common_type>(lhs).data() OP static_cast<common_type>(rhs).data(); }
 
-#define SG14_INTEGER_BINARY_ARITHMETIC_DEFINE(OP) \
+#define SG14_INTEGER_BINARY_ARITHMETIC_DEFINE(OP, TAG) \
     template <class LhsRep, class RhsRep, class OverflowPolicy> \
     constexpr auto operator OP (const integer<LhsRep, OverflowPolicy>& lhs, const integer<RhsRep, OverflowPolicy>& rhs) \
     -> integer<decltype(std::declval<LhsRep>() OP std::declval<RhsRep>()), OverflowPolicy> { \
         using Result = integer<decltype(std::declval<LhsRep>() OP std::declval<RhsRep>()), OverflowPolicy>; \
-        return static_cast<Result>(lhs.data() OP rhs.data()); } \
+        return static_cast<Result>(sg14::_integer_impl::arithmetic<sg14::_impl::TAG, OverflowPolicy>::op( \
+                lhs.data(), rhs.data())); } \
     \
     template <class Lhs, class RhsRep, class RhsOverflowPolicy, typename std::enable_if<std::is_integral<Lhs>::value, int>::type dummy = 0> \
     constexpr auto operator OP (const Lhs& lhs, const integer<RhsRep, RhsOverflowPolicy>& rhs) \
     -> integer<decltype(std::declval<Lhs>() OP std::declval<RhsRep>()), RhsOverflowPolicy> { \
         using Result = integer<decltype(std::declval<Lhs>() OP std::declval<RhsRep>()), RhsOverflowPolicy>; \
-        return static_cast<Result>(lhs OP rhs.data()); } \
+        return static_cast<Result>(sg14::_integer_impl::arithmetic<sg14::_impl::TAG, RhsOverflowPolicy>::op( \
+                lhs, rhs.data())); } \
     \
     template <class LhsRep, class LhsOverflowPolicy, class Rhs, typename std::enable_if<std::is_integral<Rhs>::value, int>::type dummy = 0> \
     constexpr auto operator OP (const integer<LhsRep, LhsOverflowPolicy>& lhs, const Rhs& rhs) \
     -> integer<decltype(std::declval<LhsRep>() OP std::declval<Rhs>()), LhsOverflowPolicy> { \
         using Result = integer<decltype(std::declval<LhsRep>() OP std::declval<Rhs>()), LhsOverflowPolicy>; \
-        return static_cast<Result>(lhs.data() OP rhs); } \
+        return static_cast<Result>(sg14::_integer_impl::arithmetic<sg14::_impl::TAG, LhsOverflowPolicy>::op( \
+                lhs.data(), rhs)); } \
     \
     template <class Lhs, class RhsRep, class RhsOverflowPolicy, typename std::enable_if<std::is_floating_point<Lhs>::value, int>::type dummy = 0> \
     constexpr auto operator OP (const Lhs& lhs, const integer<RhsRep, RhsOverflowPolicy>& rhs) \
@@ -63,14 +66,14 @@ namespace sg14 {
     template <class Rhs> \
     auto operator OP (const Rhs& rhs) \
     -> integer& { \
-        _r = static_cast<rep>(_r BIN_OP rhs); \
-        return *this; }
+        return *this = static_cast<integer>(*this BIN_OP rhs); }
 
-#define SG14_INTEGER_BIT_SHIFT_DEFINE(OP) \
+#define SG14_INTEGER_BIT_SHIFT_DEFINE(OP, TAG) \
     template <class LhsRep, class LhsOverflowPolicy, class RhsRep, class RhsOverflowPolicy> \
     constexpr auto operator OP (const integer<LhsRep, LhsOverflowPolicy>& lhs, const integer<RhsRep, RhsOverflowPolicy>& rhs) \
     -> integer<LhsRep, LhsOverflowPolicy> { \
-        return lhs.data() OP rhs.data(); } \
+        return integer<LhsRep, LhsOverflowPolicy>(sg14::_integer_impl::arithmetic<sg14::_impl::TAG, LhsOverflowPolicy>::op( \
+                lhs.data(), rhs.data())); } \
     \
     template <class Lhs, class RhsRep, class RhsOverflowPolicy, typename std::enable_if<std::is_fundamental<Lhs>::value, int>::type dummy = 0> \
     constexpr auto operator OP (const Lhs& lhs, const integer<RhsRep, RhsOverflowPolicy>& rhs) \
@@ -80,7 +83,8 @@ namespace sg14 {
     template <class LhsRep, class LhsOverflowPolicy, class Rhs, typename std::enable_if<std::is_fundamental<Rhs>::value, int>::type dummy = 0> \
     constexpr auto operator OP (const integer<LhsRep, LhsOverflowPolicy>& lhs, const Rhs& rhs) \
     -> integer<LhsRep, LhsOverflowPolicy> { \
-        return integer<LhsRep, LhsOverflowPolicy>(lhs.data() OP rhs); }
+        return integer<LhsRep, LhsOverflowPolicy>(sg14::_integer_impl::arithmetic<sg14::_impl::TAG, LhsOverflowPolicy>::op( \
+                lhs.data(), rhs)); }
 
     ////////////////////////////////////////////////////////////////////////////////
     // forward-declarations
@@ -255,6 +259,576 @@ namespace sg14 {
     };
 
     namespace _integer_impl {
+        // raised by sticky_overflow_policy and lowered only by clear_overflow,
+        // like the floating-point exception flags
+        inline bool& overflow_flag() noexcept
+        {
+            thread_local bool flag = false;
+            return flag;
+        }
+
+        inline void raise_overflow() noexcept
+        {
+            overflow_flag() = true;
+        }
+
+        // ORs overflowed into the flag and returns it
+#if defined(SG14_IS_CONSTANT_EVALUATED_ENABLED)
+        // without a branch, so that a loop can keep the flag in a register and store it once,
+        // except in a constant expression, where the flag cannot be written
+        constexpr bool record_overflow(bool overflowed) noexcept
+        {
+            return (__builtin_is_constant_evaluated() || (overflow_flag() |= overflowed, true)) && overflowed;
+        }
+#else
+        // only on overflow, so that the results of operations which do not overflow
+        // can still be calculated in a constant expression
+        constexpr bool record_overflow(bool overflowed) noexcept
+        {
+            return overflowed && (raise_overflow(), true);
+        }
+#endif
+    }
+
+    /// true iff an \ref integer with a \ref sticky_overflow_policy has overflowed on this thread
+    /// since \ref clear_overflow was last called
+    inline bool test_overflow() noexcept
+    {
+        return _integer_impl::overflow_flag();
+    }
+
+    /// lowers the flag which \ref test_overflow returns for this thread
+    inline void clear_overflow() noexcept
+    {
+        _integer_impl::overflow_flag() = false;
+    }
+
+    // saturates, or wraps with Response = native_overflow_policy, and raises a thread-local flag on overflow
+    // so that code built without exceptions can test a whole block of operations with one call to test_overflow;
+    // a left shift overflows where it loses bits other than copies of the sign bit or shifts out of range
+    template<class Response = saturated_overflow_policy>
+    struct sticky_overflow_policy {
+        static_assert(std::is_same<Response, native_overflow_policy>::value
+                        || std::is_same<Response, saturated_overflow_policy>::value,
+                "sticky_overflow_policy wraps with native_overflow_policy or saturates with saturated_overflow_policy");
+
+        template<typename Lhs, typename Rhs>
+        constexpr Lhs convert(const Rhs& rhs) const
+        {
+            return _integer_impl::record_overflow(
+                    _integer_impl::is_positive_overflow<Lhs>(rhs) || _integer_impl::is_negative_overflow<Lhs>(rhs))
+                   ? Response{}.template convert<Lhs>(rhs)
+                   : static_cast<Lhs>(rhs);
+        }
+    };
+
+    namespace _integer_impl {
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_integer_impl::is_negative - comparison with zero which unsigned types skip
+
+        template<class Rep, typename std::enable_if<std::is_signed<Rep>::value, int>::type dummy = 0>
+        constexpr bool is_negative(const Rep& value)
+        {
+            return value<0;
+        }
+
+        template<class Rep, typename std::enable_if<!std::is_signed<Rep>::value, int>::type dummy = 0>
+        constexpr bool is_negative(const Rep&)
+        {
+            return false;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_integer_impl::add_overflows, subtract_overflows, multiply_overflows, divide_overflows
+        // and shift_left_overflows
+
+        // true iff the result of the operation on two values of Rep exceeds the range of Rep
+
+#if defined(SG14_OVERFLOW_BUILTINS_ENABLED) && defined(__clang__)
+        template<class Rep>
+        SG14_RELAXED_CONSTEXPR bool add_overflows(const Rep& lhs, const Rep& rhs)
+        {
+            Rep result{0};
+            return __builtin_add_overflow(lhs, rhs, &result);
+        }
+
+        template<class Rep>
+        SG14_RELAXED_CONSTEXPR bool subtract_overflows(const Rep& lhs, const Rep& rhs)
+        {
+            Rep result{0};
+            return __builtin_sub_overflow(lhs, rhs, &result);
+        }
+
+        template<class Rep>
+        SG14_RELAXED_CONSTEXPR bool multiply_overflows(const Rep& lhs, const Rep& rhs)
+        {
+            Rep result{0};
+            return __builtin_mul_overflow(lhs, rhs, &result);
+        }
+#elif defined(SG14_OVERFLOW_BUILTINS_ENABLED)
+        template<class Rep>
+        constexpr bool add_overflows(const Rep& lhs, const Rep& rhs)
+        {
+            return __builtin_add_overflow_p(lhs, rhs, Rep{0});
+        }
+
+        template<class Rep>
+        constexpr bool subtract_overflows(const Rep& lhs, const Rep& rhs)
+        {
+            return __builtin_sub_overflow_p(lhs, rhs, Rep{0});
+        }
+
+        template<class Rep>
+        constexpr bool multiply_overflows(const Rep& lhs, const Rep& rhs)
+        {
+            return __builtin_mul_overflow_p(lhs, rhs, Rep{0});
+        }
+#else
+        template<class Rep>
+        constexpr bool add_overflows(const Rep& lhs, const Rep& rhs)
+        {
+            return is_negative(rhs)
+                   ? lhs<std::numeric_limits<Rep>::lowest()-rhs
+                   : lhs>std::numeric_limits<Rep>::max()-rhs;
+        }
+
+        template<class Rep>
+        constexpr bool subtract_overflows(const Rep& lhs, const Rep& rhs)
+        {
+            return is_negative(rhs)
+                   ? lhs>std::numeric_limits<Rep>::max()+rhs
+                   : lhs<std::numeric_limits<Rep>::lowest()+rhs;
+        }
+
+        template<class Rep>
+        constexpr bool multiply_overflows(const Rep& lhs, const Rep& rhs)
+        {
+            return (lhs==0 || rhs==0)
+                   ? false
+                   : is_negative(lhs)
+                     ? (is_negative(rhs)
+                        ? lhs<std::numeric_limits<Rep>::max()/rhs
+                        : lhs<std::numeric_limits<Rep>::lowest()/rhs)
+                     : (is_negative(rhs)
+                        ? rhs<std::numeric_limits<Rep>::lowest()/lhs
+                        : lhs>std::numeric_limits<Rep>::max()/rhs);
+        }
+#endif
+
+        // the only quotient which overflows is that of the lowest value and -1
+        template<class Rep>
+        constexpr bool divide_overflows(const Rep& lhs, const Rep& rhs)
+        {
+            return is_negative(rhs) && rhs+1==0 && lhs==std::numeric_limits<Rep>::lowest();
+        }
+
+        // shifts by a negative number of bits or by the width of Rep or more are undefined
+        template<class Rep, class Shift>
+        constexpr bool shift_out_of_range(const Shift& shift)
+        {
+            return is_negative(shift) || shift>=static_cast<Shift>(width<Rep>::value);
+        }
+
+        // bits shifted out of range overflow unless they are all zero
+        template<class Rep, class Shift>
+        constexpr bool shift_left_overflows(const Rep& lhs, const Shift& shift)
+        {
+            return shift_out_of_range<Rep>(shift)
+                   ? lhs!=0
+                   : lhs>(std::numeric_limits<Rep>::max() >> shift) || lhs<(std::numeric_limits<Rep>::lowest() >> shift);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_integer_impl::saturated_add, saturated_subtract and saturated_multiply
+
+        // The operands are converted to Rep, as they are by the built-in operators, and results
+        // beyond the range of Rep are replaced with the limit in the direction of overflow.
+        // Both the wrapped result and the limit are calculated and one is selected with a mask
+        // so that frequent overflow, e.g. from clipping audio, costs no mispredicted branches.
+
+        template<class Rep>
+        using unsigned_rep = typename make_unsigned<Rep>::type;
+
+        template<class Rep>
+        constexpr Rep saturated_limit(bool negative)
+        {
+            return negative ? std::numeric_limits<Rep>::lowest() : std::numeric_limits<Rep>::max();
+        }
+
+        // if_true where condition is true, otherwise if_false, without a branch
+        template<class Rep>
+        constexpr Rep select(bool condition, const Rep& if_true, const Rep& if_false)
+        {
+            return static_cast<Rep>(
+                    (static_cast<unsigned_rep<Rep>>(if_true) & (unsigned_rep<Rep>{0}-condition))
+                            | (static_cast<unsigned_rep<Rep>>(if_false) & (unsigned_rep<Rep>(condition)-1u)));
+        }
+
+        // results of the operations modulo 2^N, which are defined even when signed operations overflow
+        template<class Rep>
+        constexpr Rep wrapped_add(const Rep& lhs, const Rep& rhs)
+        {
+            return static_cast<Rep>(static_cast<unsigned_rep<Rep>>(lhs)+static_cast<unsigned_rep<Rep>>(rhs));
+        }
+
+        template<class Rep>
+        constexpr Rep wrapped_subtract(const Rep& lhs, const Rep& rhs)
+        {
+            return static_cast<Rep>(static_cast<unsigned_rep<Rep>>(lhs)-static_cast<unsigned_rep<Rep>>(rhs));
+        }
+
+        template<class Rep>
+        constexpr Rep wrapped_multiply(const Rep& lhs, const Rep& rhs)
+        {
+            return static_cast<Rep>(static_cast<unsigned_rep<Rep>>(lhs)*static_cast<unsigned_rep<Rep>>(rhs));
+        }
+
+        template<class Rep>
+        constexpr Rep saturated_add(const Rep& lhs, const Rep& rhs)
+        {
+            return select(add_overflows(lhs, rhs), saturated_limit<Rep>(is_negative(rhs)), wrapped_add(lhs, rhs));
+        }
+
+        template<class Rep>
+        constexpr Rep saturated_subtract(const Rep& lhs, const Rep& rhs)
+        {
+            return select(subtract_overflows(lhs, rhs), saturated_limit<Rep>(!is_negative(rhs)),
+                    wrapped_subtract(lhs, rhs));
+        }
+
+        template<class Rep>
+        constexpr Rep saturated_multiply(const Rep& lhs, const Rep& rhs)
+        {
+            return select(multiply_overflows(lhs, rhs), saturated_limit<Rep>(is_negative(lhs)!=is_negative(rhs)),
+                    wrapped_multiply(lhs, rhs));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_integer_impl::overflow_traits
+
+        // for each operation which can overflow, its test for overflow, the direction of overflow
+        // and its result modulo 2^N
+        template<class OperationTag>
+        struct overflow_traits;
+
+        template<>
+        struct overflow_traits<_impl::add_tag> {
+            template<class Rep>
+            static constexpr bool overflows(const Rep& lhs, const Rep& rhs)
+            {
+                return add_overflows(lhs, rhs);
+            }
+
+            template<class Rep>
+            static constexpr bool negative(const Rep&, const Rep& rhs)
+            {
+                return is_negative(rhs);
+            }
+
+            template<class Rep>
+            static constexpr Rep wrapped(const Rep& lhs, const Rep& rhs)
+            {
+                return wrapped_add(lhs, rhs);
+            }
+        };
+
+        template<>
+        struct overflow_traits<_impl::subtract_tag> {
+            template<class Rep>
+            static constexpr bool overflows(const Rep& lhs, const Rep& rhs)
+            {
+                return subtract_overflows(lhs, rhs);
+            }
+
+            template<class Rep>
+            static constexpr bool negative(const Rep&, const Rep& rhs)
+            {
+                return !is_negative(rhs);
+            }
+
+            template<class Rep>
+            static constexpr Rep wrapped(const Rep& lhs, const Rep& rhs)
+            {
+                return wrapped_subtract(lhs, rhs);
+            }
+        };
+
+        template<>
+        struct overflow_traits<_impl::multiply_tag> {
+            template<class Rep>
+            static constexpr bool overflows(const Rep& lhs, const Rep& rhs)
+            {
+                return multiply_overflows(lhs, rhs);
+            }
+
+            template<class Rep>
+            static constexpr bool negative(const Rep& lhs, const Rep& rhs)
+            {
+                return is_negative(lhs)!=is_negative(rhs);
+            }
+
+            template<class Rep>
+            static constexpr Rep wrapped(const Rep& lhs, const Rep& rhs)
+            {
+                return wrapped_multiply(lhs, rhs);
+            }
+        };
+
+        // the lowest value divided by -1 is one greater than the greatest value and wraps to the lowest value
+        template<>
+        struct overflow_traits<_impl::divide_tag> {
+            template<class Rep>
+            static constexpr bool overflows(const Rep& lhs, const Rep& rhs)
+            {
+                return divide_overflows(lhs, rhs);
+            }
+
+            template<class Rep>
+            static constexpr bool negative(const Rep&, const Rep&)
+            {
+                return false;
+            }
+
+            template<class Rep>
+            static constexpr Rep wrapped(const Rep& lhs, const Rep&)
+            {
+                return lhs;
+            }
+        };
+
+        // the bits of a left shift which are in range; those shifted by the width of Rep or more are all lost
+        template<>
+        struct overflow_traits<_impl::shift_left_tag> {
+            template<class Rep>
+            static constexpr bool overflows(const Rep& lhs, const Rep& rhs)
+            {
+                return shift_left_overflows(lhs, rhs);
+            }
+
+            template<class Rep>
+            static constexpr bool negative(const Rep& lhs, const Rep&)
+            {
+                return is_negative(lhs);
+            }
+
+            template<class Rep>
+            static constexpr Rep wrapped(const Rep& lhs, const Rep& rhs)
+            {
+                return shift_out_of_range<Rep>(rhs)
+                       ? Rep{0}
+                       : static_cast<Rep>(static_cast<unsigned_rep<Rep>>(lhs) << rhs);
+            }
+        };
+
+        // the result of an operation which overflowed, wrapped or saturated
+        template<class Rep>
+        constexpr Rep respond(native_overflow_policy, bool, const Rep& wrapped)
+        {
+            return wrapped;
+        }
+
+        template<class Rep>
+        constexpr Rep respond(saturated_overflow_policy, bool negative, const Rep&)
+        {
+            return saturated_limit<Rep>(negative);
+        }
+
+        template<class OperationTag, class Response, class Rep>
+        constexpr Rep sticky(const Rep& lhs, const Rep& rhs)
+        {
+            using traits = overflow_traits<OperationTag>;
+            return record_overflow(traits::overflows(lhs, rhs))
+                   ? respond(Response{}, traits::negative(lhs, rhs), traits::wrapped(lhs, rhs))
+                   : _impl::op_fn<OperationTag>(lhs, rhs);
+        }
+
+#if defined(SG14_EXCEPTIONS_ENABLED)
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_integer_impl::checked_add, checked_subtract, checked_multiply,
+        // checked_divide, checked_shift_left and checked_shift_right
+
+        // The operands are converted to Rep, as they are by the built-in operators, and results
+        // beyond the range of Rep throw std::overflow_error. With the overflow builtins, the
+        // operation and its test fold into a single instruction followed by a conditional jump
+        // which is never taken in the absence of overflow.
+
+        template<class Rep>
+        constexpr Rep checked_add(const Rep& lhs, const Rep& rhs)
+        {
+            return add_overflows(lhs, rhs)
+                   ? throw std::overflow_error("overflow in addition")
+                   : wrapped_add(lhs, rhs);
+        }
+
+        template<class Rep>
+        constexpr Rep checked_subtract(const Rep& lhs, const Rep& rhs)
+        {
+            return subtract_overflows(lhs, rhs)
+                   ? throw std::overflow_error("overflow in subtraction")
+                   : wrapped_subtract(lhs, rhs);
+        }
+
+        template<class Rep>
+        constexpr Rep checked_multiply(const Rep& lhs, const Rep& rhs)
+        {
+            return multiply_overflows(lhs, rhs)
+                   ? throw std::overflow_error("overflow in multiplication")
+                   : wrapped_multiply(lhs, rhs);
+        }
+
+        template<class Rep>
+        constexpr Rep checked_divide(const Rep& lhs, const Rep& rhs)
+        {
+            return (rhs==0)
+                   ? throw std::domain_error("division by zero")
+                   : divide_overflows(lhs, rhs)
+                     ? throw std::overflow_error("overflow in division")
+                     : static_cast<Rep>(lhs/rhs);
+        }
+
+        template<class Rep, class Shift>
+        constexpr Rep checked_shift_left(const Rep& lhs, const Shift& shift)
+        {
+            return shift_out_of_range<Rep>(shift)
+                   ? throw std::domain_error("shift out of range")
+                   : shift_left_overflows(lhs, shift)
+                     ? throw std::overflow_error("overflow in left shift")
+                     : static_cast<Rep>(static_cast<unsigned_rep<Rep>>(lhs) << shift);
+        }
+
+        template<class Rep, class Shift>
+        constexpr Rep checked_shift_right(const Rep& lhs, const Shift& shift)
+        {
+            return shift_out_of_range<Rep>(shift)
+                   ? throw std::domain_error("shift out of range")
+                   : static_cast<Rep>(lhs >> shift);
+        }
+#endif
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_integer_impl::arithmetic - binary operations on the reps of integer<> operands
+
+        // by default, the built-in operator
+        template<class OperationTag, class OverflowPolicy>
+        struct arithmetic {
+            template<class Lhs, class Rhs>
+            static constexpr auto op(const Lhs& lhs, const Rhs& rhs) -> _impl::op_result<OperationTag, Lhs, Rhs>
+            {
+                return _impl::op_fn<OperationTag>(lhs, rhs);
+            }
+        };
+
+        // saturated_overflow_policy saturates in the type of the result of the built-in operator
+        template<>
+        struct arithmetic<_impl::add_tag, saturated_overflow_policy> {
+            template<class Lhs, class Rhs>
+            static constexpr auto op(const Lhs& lhs, const Rhs& rhs) -> decltype(lhs+rhs)
+            {
+                using result = decltype(lhs+rhs);
+                return saturated_add(static_cast<result>(lhs), static_cast<result>(rhs));
+            }
+        };
+
+        template<>
+        struct arithmetic<_impl::subtract_tag, saturated_overflow_policy> {
+            template<class Lhs, class Rhs>
+            static constexpr auto op(const Lhs& lhs, const Rhs& rhs) -> decltype(lhs-rhs)
+            {
+                using result = decltype(lhs-rhs);
+                return saturated_subtract(static_cast<result>(lhs), static_cast<result>(rhs));
+            }
+        };
+
+        template<>
+        struct arithmetic<_impl::multiply_tag, saturated_overflow_policy> {
+            template<class Lhs, class Rhs>
+            static constexpr auto op(const Lhs& lhs, const Rhs& rhs) -> decltype(lhs*rhs)
+            {
+                using result = decltype(lhs*rhs);
+                return saturated_multiply(static_cast<result>(lhs), static_cast<result>(rhs));
+            }
+        };
+
+#if defined(SG14_EXCEPTIONS_ENABLED)
+        // throwing_overflow_policy checks the result of the built-in operator
+        template<>
+        struct arithmetic<_impl::add_tag, throwing_overflow_policy> {
+            template<class Lhs, class Rhs>
+            static constexpr auto op(const Lhs& lhs, const Rhs& rhs) -> decltype(lhs+rhs)
+            {
+                using result = decltype(lhs+rhs);
+                return checked_add(static_cast<result>(lhs), static_cast<result>(rhs));
+            }
+        };
+
+        template<>
+        struct arithmetic<_impl::subtract_tag, throwing_overflow_policy> {
+            template<class Lhs, class Rhs>
+            static constexpr auto op(const Lhs& lhs, const Rhs& rhs) -> decltype(lhs-rhs)
+            {
+                using result = decltype(lhs-rhs);
+                return checked_subtract(static_cast<result>(lhs), static_cast<result>(rhs));
+            }
+        };
+
+        template<>
+        struct arithmetic<_impl::multiply_tag, throwing_overflow_policy> {
+            template<class Lhs, class Rhs>
+            static constexpr auto op(const Lhs& lhs, const Rhs& rhs) -> decltype(lhs*rhs)
+            {
+                using result = decltype(lhs*rhs);
+                return checked_multiply(static_cast<result>(lhs), static_cast<result>(rhs));
+            }
+        };
+
+        template<>
+        struct arithmetic<_impl::divide_tag, throwing_overflow_policy> {
+            template<class Lhs, class Rhs>
+            static constexpr auto op(const Lhs& lhs, const Rhs& rhs) -> decltype(lhs/rhs)
+            {
+                using result = decltype(lhs/rhs);
+                return checked_divide(static_cast<result>(lhs), static_cast<result>(rhs));
+            }
+        };
+
+        template<>
+        struct arithmetic<_impl::shift_left_tag, throwing_overflow_policy> {
+            template<class Lhs, class Rhs>
+            static constexpr auto op(const Lhs& lhs, const Rhs& rhs) -> decltype(lhs << rhs)
+            {
+                using result = decltype(lhs << rhs);
+                return checked_shift_left(static_cast<result>(lhs), rhs);
+            }
+        };
+
+        template<>
+        struct arithmetic<_impl::shift_right_tag, throwing_overflow_policy> {
+            template<class Lhs, class Rhs>
+            static constexpr auto op(const Lhs& lhs, const Rhs& rhs) -> decltype(lhs >> rhs)
+            {
+                using result = decltype(lhs >> rhs);
+                return checked_shift_right(static_cast<result>(lhs), rhs);
+            }
+        };
+#endif
+
+        // sticky_overflow_policy raises the overflow flag when the result of the built-in operator overflows
+        template<class OperationTag, class Response>
+        struct arithmetic<OperationTag, sticky_overflow_policy<Response>> {
+            template<class Lhs, class Rhs>
+            static constexpr auto op(const Lhs& lhs, const Rhs& rhs) -> _impl::op_result<OperationTag, Lhs, Rhs>
+            {
+                using result = _impl::op_result<OperationTag, Lhs, Rhs>;
+                return sticky<OperationTag, Response>(static_cast<result>(lhs), static_cast<result>(rhs));
+            }
+        };
+
+        // but not right shifts, which do not overflow
+        template<class Response>
+        struct arithmetic<_impl::shift_right_tag, sticky_overflow_policy<Response>>
+                : arithmetic<_impl::shift_right_tag, Response> {
+        };
+
         ////////////////////////////////////////////////////////////////////////////////
         // sg14::_integer_impl::common_type
 
@@ -332,9 +906,10 @@ namespace sg14 {
             return static_cast<LhsRep>(_r);
         }
 
+        // subtracted from zero so that negation of the lowest value overflows according to OverflowPolicy
         constexpr friend integer operator-(const integer& rhs)
         {
-            return integer(-rhs._r);
+            return integer(_integer_impl::arithmetic<_impl::subtract_tag, OverflowPolicy>::op(rep{0}, rhs._r));
         }
 
         SG14_INTEGER_COMPOUND_ASSIGN_DEFINE(+=, +);
@@ -369,17 +944,17 @@ namespace sg14 {
 
     SG14_INTEGER_COMPARISON_DEFINE(>=);
 
-    SG14_INTEGER_BINARY_ARITHMETIC_DEFINE(+);
+    SG14_INTEGER_BINARY_ARITHMETIC_DEFINE(+, add_tag);
 
-    SG14_INTEGER_BINARY_ARITHMETIC_DEFINE(-);
+    SG14_INTEGER_BINARY_ARITHMETIC_DEFINE(-, subtract_tag);
 
-    SG14_INTEGER_BINARY_ARITHMETIC_DEFINE(*);
+    SG14_INTEGER_BINARY_ARITHMETIC_DEFINE(*, multiply_tag);
 
-    SG14_INTEGER_BINARY_ARITHMETIC_DEFINE(/);
+    SG14_INTEGER_BINARY_ARITHMETIC_DEFINE(/, divide_tag);
 
-    SG14_INTEGER_BIT_SHIFT_DEFINE(>>);
+    SG14_INTEGER_BIT_SHIFT_DEFINE(>>, shift_right_tag);
 
-    SG14_INTEGER_BIT_SHIFT_DEFINE(<<);
+    SG14_INTEGER_BIT_SHIFT_DEFINE(<<, shift_left_tag);
 
     ////////////////////////////////////////////////////////////////////////////////
     // integer<> partial specializations
@@ -393,6 +968,9 @@ namespace sg14 {
     template<typename Rep = int>
     using saturated_integer = integer<Rep, saturated_overflow_policy>;
 
+    template<typename Rep = int>
+    using sticky_integer = integer<Rep, sticky_overflow_policy<>>;
+
     ////////////////////////////////////////////////////////////////////////////////
     // sg14::set_width<integer<>, > partial specialization
 
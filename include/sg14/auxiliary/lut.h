@@ -0,0 +1,230 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief function approximation by interpolated lookup table, `sg14::lut_function`
+
+#if !defined(SG14_LUT_H)
+#define SG14_LUT_H 1
+
+#include <sg14/fixed_point.h>
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/// study group 14 of the C++ working group
+namespace sg14 {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::_lut_impl
+
+    namespace _lut_impl {
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_lut_impl::clamp and sg14::_lut_impl::round_to_rep
+
+        // integer value limited to the range of Rep
+        template<class Rep>
+        constexpr std::int64_t clamp(std::int64_t value)
+        {
+            return (value<std::numeric_limits<Rep>::lowest())
+                   ? std::numeric_limits<Rep>::lowest()
+                   : (value>std::numeric_limits<Rep>::max())
+                     ? std::numeric_limits<Rep>::max()
+                     : value;
+        }
+
+        // floating-point value rounded to nearest and saturated to the range of Rep
+        template<class Rep>
+        constexpr Rep round_to_rep(double value)
+        {
+            return (value<=static_cast<double>(std::numeric_limits<Rep>::lowest()))
+                   ? std::numeric_limits<Rep>::lowest()
+                   : (value>=static_cast<double>(std::numeric_limits<Rep>::max()))
+                     ? std::numeric_limits<Rep>::max()
+                     : static_cast<Rep>((value<0) ? value-.5 : value+.5);
+        }
+
+        // divides by 2^Shift, rounding halves upward
+        template<int Shift, typename std::enable_if<(Shift>0), int>::type Dummy = 0>
+        constexpr std::int64_t rounding_shift(std::int64_t value)
+        {
+            return (value+(std::int64_t{1} << (Shift-1))) >> Shift;
+        }
+
+        template<int Shift, typename std::enable_if<(Shift==0), int>::type Dummy = 0>
+        constexpr std::int64_t rounding_shift(std::int64_t value)
+        {
+            return value;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // interpolation policies of sg14::lut_function
+
+    /// \brief straight line between the two samples either side of the input
+    struct linear_interpolation {
+        static constexpr int extra_samples = 1;
+
+        // samples[0] plus fraction/2^Precision of the way to samples[1]
+        template<int Precision, class Rep>
+        static constexpr std::int64_t interpolate(const Rep* samples, std::int64_t fraction)
+        {
+            return samples[0]+_lut_impl::rounding_shift<Precision>(
+                    (std::int64_t{samples[1]}-samples[0])*fraction);
+        }
+    };
+
+    /// \brief parabola through the sample below the input and the two above it
+    struct quadratic_interpolation {
+        static constexpr int extra_samples = 2;
+
+        // Newton's forward difference formula, y0 + t*(d1 - (1-t)/2*d2),
+        // where t is fraction/2^Precision
+        template<int Precision, class Rep>
+        static constexpr std::int64_t interpolate(const Rep* samples, std::int64_t fraction)
+        {
+            return samples[0]+_lut_impl::rounding_shift<Precision>(fraction*(
+                    (std::int64_t{samples[1]}-samples[0])
+                    -_lut_impl::rounding_shift<Precision+1>(
+                            (std::int64_t{samples[2]}-2*std::int64_t{samples[1]}+samples[0])
+                            *((std::int64_t{1} << Precision)-fraction))));
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::lut_function
+
+    /// \brief approximates a function of a fixed-point value using a table of samples
+    ///
+    /// \tparam F function object invoked with, and returning, a `double`
+    /// \tparam Input the \ref fixed_point type of the argument
+    /// \tparam Output the \ref fixed_point type of the result
+    /// \tparam TableBits the input range is divided into 2^TableBits equal intervals
+    /// \tparam Interpolation \ref linear_interpolation or \ref quadratic_interpolation
+    ///
+    /// The table holds the result of F at the boundaries of each interval
+    /// and evaluation uses only integer operations on the rep of the input.
+    /// If F is a literal type with a `constexpr` call operator,
+    /// a `constexpr` lut_function is built at compile time;
+    /// otherwise the table is built once when the object is constructed.
+    /// F is sampled up to Interpolation::extra_samples intervals beyond the largest input.
+    /// Samples outside the range of Output saturate,
+    /// so a curve which reaches the limits of Output is less accurate near them.
+    ///
+    /// \par Example
+    ///
+    /// To approximate a smooth curve at compile time:
+    /// \snippet snippets.cpp define a lut_function
+
+    template<class F, class Input, class Output, int TableBits, class Interpolation = linear_interpolation>
+    class lut_function;
+
+    template<class F, class InputRep, int InputExponent, class OutputRep, int OutputExponent, int TableBits, class Interpolation>
+    class lut_function<F, fixed_point<InputRep, InputExponent>, fixed_point<OutputRep, OutputExponent>, TableBits, Interpolation> {
+    public:
+        /// type of the argument
+        using input_type = fixed_point<InputRep, InputExponent>;
+
+        /// type of the result
+        using output_type = fixed_point<OutputRep, OutputExponent>;
+
+        /// number of entries in the table
+        static constexpr int table_size = (1 << TableBits)+Interpolation::extra_samples;
+
+    private:
+        static constexpr int _input_width = width<InputRep>::value;
+        static constexpr int _output_width = width<OutputRep>::value;
+
+        static_assert(_input_width<=32 && _output_width<=32, "lut_function supports reps of up to 32 bits");
+        static_assert(TableBits>=0 && TableBits<=_input_width, "TableBits exceeds the width of the input");
+
+        // number of input bits between samples
+        static constexpr int _shift = _input_width-TableBits;
+
+        // number of those bits used in interpolation; limited to keep products within 64 bits
+        static constexpr int _precision = _impl::min(_shift, 59-_output_width);
+
+    public:
+        /// constructs the table by sampling the given function
+        explicit constexpr lut_function(F f)
+                :lut_function(f, typename _impl::make_index_sequence<table_size>::type{})
+        {
+        }
+
+        /// returns the approximation of F at the given input
+        constexpr output_type operator()(input_type const& x) const
+        {
+            return output_type::from_data(static_cast<OutputRep>(_lut_impl::clamp<OutputRep>(
+                    Interpolation::template interpolate<_precision>(
+                            _table+(offset(x) >> _shift),
+                            (offset(x) & ((std::int64_t{1} << _shift)-1)) >> (_shift-_precision)))));
+        }
+
+        /// returns the greatest difference in LSBs between the result and the saturated value of F
+        ///
+        /// \note Every input is tested for inputs of up to 20 bits; otherwise 2^20 evenly spaced inputs are tested.
+        double max_error() const
+        {
+            constexpr int step_bits = (_input_width>20) ? _input_width-20 : 0;
+            auto error = 0.;
+            for (auto n = std::int64_t{0}; n!=(std::int64_t{1} << (_input_width-step_bits)); ++n) {
+                auto x = input_type::from_data(static_cast<InputRep>(
+                        std::numeric_limits<InputRep>::lowest()+(n << step_bits)));
+                auto expected = static_cast<double>(_lut_impl::round_to_rep<OutputRep>(
+                        _f(static_cast<double>(x))*_fixed_point_impl::pow2<double, -OutputExponent>()));
+                auto actual = static_cast<double>((*this)(x).data());
+                error = _impl::max(error, (actual>expected) ? actual-expected : expected-actual);
+            }
+            return error;
+        }
+
+    private:
+        template<int... Indices>
+        constexpr lut_function(F f, _impl::index_sequence<Indices...>)
+                :_f(f), _table{sample(f, Indices)...}
+        {
+        }
+
+        // result of F at the lower boundary of the given interval
+        static constexpr OutputRep sample(F const& f, int index)
+        {
+            return _lut_impl::round_to_rep<OutputRep>(
+                    f((static_cast<double>(std::numeric_limits<InputRep>::lowest())
+                       +index*_fixed_point_impl::pow2<double, _shift>())
+                      *_fixed_point_impl::pow2<double, InputExponent>())
+                    *_fixed_point_impl::pow2<double, -OutputExponent>());
+        }
+
+        // distance of the input from the lowest input in LSBs
+        static constexpr std::int64_t offset(input_type const& x)
+        {
+            return std::int64_t{x.data()}-std::numeric_limits<InputRep>::lowest();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // variables
+
+        F _f;
+        OutputRep _table[table_size];
+    };
+
+    /// \brief creates a \ref lut_function which approximates the given function
+    ///
+    /// \tparam Input the \ref fixed_point type of the argument
+    /// \tparam Output the \ref fixed_point type of the result
+    /// \tparam TableBits the input range is divided into 2^TableBits equal intervals
+    /// \tparam Interpolation \ref linear_interpolation or \ref quadratic_interpolation
+    ///
+    /// \param f function object invoked with, and returning, a `double`
+    template<class Input, class Output, int TableBits, class Interpolation = linear_interpolation, class F>
+    constexpr lut_function<F, Input, Output, TableBits, Interpolation> make_lut_function(F f)
+    {
+        return lut_function<F, Input, Output, TableBits, Interpolation>(f);
+    }
+}
+
+#endif  // SG14_LUT_H
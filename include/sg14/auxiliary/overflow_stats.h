@@ -0,0 +1,311 @@
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief `sg14::counting_overflow_policy`, an overflow policy of `sg14::integer` which counts overflow in
+/// thread-local counters, and `sg14::overflow_stats`, the counts of all threads
+
+#if !defined(SG14_OVERFLOW_STATS_H)
+#define SG14_OVERFLOW_STATS_H 1
+
+#include <sg14/auxiliary/integer.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+/// study group 14 of the C++ working group
+namespace sg14 {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::_overflow_stats_impl - counters
+
+    namespace _overflow_stats_impl {
+        // one counter for each pair of signed and unsigned built-in integers of 8 to 128 bits,
+        // for each operation and for each direction
+        constexpr int num_reps = 10;
+        constexpr int num_operations = 6;
+        constexpr int num_directions = 2;
+        constexpr int num_counters = num_reps*num_operations*num_directions;
+
+        template<class Rep>
+        constexpr int rep_index()
+        {
+            static_assert(std::is_integral<Rep>::value, "overflow is counted for built-in integer reps");
+            static_assert(sizeof(Rep)<=16, "overflow is counted for reps of up to 128 bits");
+            return _impl::floor_log2(sizeof(Rep))*2+(std::is_signed<Rep>::value ? 1 : 0);
+        }
+
+        template<class Rep>
+        constexpr int counter_index(int operation, bool negative)
+        {
+            return (rep_index<Rep>()*num_operations+operation)*num_directions+(negative ? 1 : 0);
+        }
+
+        struct thread_counters;
+
+        // the counters of all running threads, and the sums of those of threads which have exited
+        struct registry {
+            std::mutex mutex;
+            std::vector<thread_counters*> threads;
+            std::uint64_t retired[num_counters];
+
+            // the sums at the last call to overflow_stats::reset
+            std::uint64_t baseline[num_counters];
+        };
+
+        // never destroyed so that threads which outlive main can still retire their counts
+        inline registry& get_registry()
+        {
+            static registry& instance = *new registry();
+            return instance;
+        }
+
+        // counters which only their own thread writes, so no increment is a locked read-modify-write,
+        // and which others read atomically
+        struct thread_counters {
+            std::atomic<std::uint64_t> values[num_counters];
+
+            thread_counters()
+            {
+                for (auto& value : values) {
+                    value.store(0, std::memory_order_relaxed);
+                }
+                auto& registry = get_registry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                registry.threads.push_back(this);
+            }
+
+            ~thread_counters()
+            {
+                auto& registry = get_registry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                for (auto index = 0; index!=num_counters; ++index) {
+                    registry.retired[index] += values[index].load(std::memory_order_relaxed);
+                }
+                for (auto thread = registry.threads.begin(); thread!=registry.threads.end(); ++thread) {
+                    if (*thread==this) {
+                        registry.threads.erase(thread);
+                        break;
+                    }
+                }
+            }
+
+            thread_counters(const thread_counters&) = delete;
+            thread_counters& operator=(const thread_counters&) = delete;
+        };
+
+        inline thread_counters& local_counters()
+        {
+            thread_local thread_counters counters;
+            return counters;
+        }
+
+        // the sums of the counters of all threads; registry.mutex must be locked
+        inline void sum(registry& registry, std::uint64_t (& sums)[num_counters])
+        {
+            for (auto index = 0; index!=num_counters; ++index) {
+                sums[index] = registry.retired[index];
+                for (auto thread : registry.threads) {
+                    sums[index] += thread->values[index].load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::overflow_stats
+
+    /// \brief counts of the overflow of \ref integer values with a \ref counting_overflow_policy
+    ///
+    /// \note Counts are broken down by the built-in integer type in which the result overflowed,
+    /// by operation and by direction. The operands of arithmetic are promoted, as they are for built-in types,
+    /// so the sum of two `counting_integer<std::int16_t>` values overflows, if at all, when it is converted back.
+    ///
+    /// \sa counting_overflow_policy
+
+    class overflow_stats {
+    public:
+        /// the operations which can overflow
+        enum class operation {
+            conversion, addition, subtraction, multiplication, division, shift_left
+        };
+
+        /// the direction of overflow; positive if the result is greater than the greatest value of the type
+        enum class direction {
+            positive, negative
+        };
+
+        /// the number of times that an operation overflowed integers of type Rep in the given direction
+        template<class Rep>
+        std::uint64_t count(operation op, direction dir) const
+        {
+            return _counts[_overflow_stats_impl::counter_index<Rep>(static_cast<int>(op), dir==direction::negative)];
+        }
+
+        /// the number of times that an operation overflowed integers of type Rep in either direction
+        template<class Rep>
+        std::uint64_t count(operation op) const
+        {
+            return count<Rep>(op, direction::positive)+count<Rep>(op, direction::negative);
+        }
+
+        /// the number of overflows of any type, operation and direction
+        std::uint64_t total() const
+        {
+            auto sum = std::uint64_t{0};
+            for (auto count : _counts) {
+                sum += count;
+            }
+            return sum;
+        }
+
+        /// \brief the counts of all threads since the last call to \ref reset
+        ///
+        /// \note Overflows which other threads count during the call may or may not be included.
+        static overflow_stats snapshot()
+        {
+            auto& registry = _overflow_stats_impl::get_registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            overflow_stats stats;
+            _overflow_stats_impl::sum(registry, stats._counts);
+            for (auto index = 0; index!=_overflow_stats_impl::num_counters; ++index) {
+                stats._counts[index] -= registry.baseline[index];
+            }
+            return stats;
+        }
+
+        /// \brief sets the counts of all threads back to zero
+        ///
+        /// \note The counters of threads are not written by any other thread, so the counts at the time of the call
+        /// are recorded and subtracted from subsequent snapshots.
+        static void reset()
+        {
+            auto& registry = _overflow_stats_impl::get_registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            _overflow_stats_impl::sum(registry, registry.baseline);
+        }
+
+    private:
+        std::uint64_t _counts[_overflow_stats_impl::num_counters];
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::_overflow_stats_impl - counting
+
+    namespace _overflow_stats_impl {
+        template<class Rep>
+        void count_overflow(overflow_stats::operation operation, bool negative)
+        {
+            auto& counter = local_counters().values[counter_index<Rep>(static_cast<int>(operation), negative)];
+            counter.store(counter.load(std::memory_order_relaxed)+1, std::memory_order_relaxed);
+        }
+
+        // the overflow_stats::operation of each operation which is counted
+        template<class OperationTag>
+        struct counted_operation;
+
+        template<>
+        struct counted_operation<_impl::add_tag> : _integer_impl::overflow_traits<_impl::add_tag> {
+            static constexpr overflow_stats::operation value = overflow_stats::operation::addition;
+        };
+
+        template<>
+        struct counted_operation<_impl::subtract_tag> : _integer_impl::overflow_traits<_impl::subtract_tag> {
+            static constexpr overflow_stats::operation value = overflow_stats::operation::subtraction;
+        };
+
+        template<>
+        struct counted_operation<_impl::multiply_tag> : _integer_impl::overflow_traits<_impl::multiply_tag> {
+            static constexpr overflow_stats::operation value = overflow_stats::operation::multiplication;
+        };
+
+        template<>
+        struct counted_operation<_impl::divide_tag> : _integer_impl::overflow_traits<_impl::divide_tag> {
+            static constexpr overflow_stats::operation value = overflow_stats::operation::division;
+        };
+
+        template<>
+        struct counted_operation<_impl::shift_left_tag> : _integer_impl::overflow_traits<_impl::shift_left_tag> {
+            static constexpr overflow_stats::operation value = overflow_stats::operation::shift_left;
+        };
+
+        // the count is only incremented on overflow so the result of operations which do not overflow
+        // can still be calculated in a constant expression
+        template<class OperationTag, class Response, class Rep>
+        constexpr Rep counted(const Rep& lhs, const Rep& rhs)
+        {
+            using operation = counted_operation<OperationTag>;
+            return operation::overflows(lhs, rhs)
+                   ? (count_overflow<Rep>(operation::value, operation::negative(lhs, rhs)),
+                           _integer_impl::respond(Response{}, operation::negative(lhs, rhs),
+                                   operation::wrapped(lhs, rhs)))
+                   : _impl::op_fn<OperationTag>(lhs, rhs);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::counting_overflow_policy
+
+    /// \brief overflow policy of \ref integer which counts overflow and then wraps or saturates
+    ///
+    /// \tparam Response \ref native_overflow_policy to wrap or \ref saturated_overflow_policy to saturate
+    ///
+    /// \note Conversion, addition, subtraction, multiplication, division and left shifts are counted per thread
+    /// and summed by \ref overflow_stats::snapshot. A left shift overflows where bits which differ from the sign bit
+    /// are shifted out, or where non-zero bits are shifted by a negative number of bits or by the width of the type
+    /// or more, which leaves zero; right shifts, which only discard bits, are not counted. Values which do not overflow cost one test of the result and
+    /// never take a lock or perform an atomic read-modify-write.
+    ///
+    /// \sa overflow_stats, counting_integer
+
+    template<class Response = saturated_overflow_policy>
+    struct counting_overflow_policy {
+        static_assert(std::is_same<Response, native_overflow_policy>::value
+                        || std::is_same<Response, saturated_overflow_policy>::value,
+                "counting_overflow_policy wraps with native_overflow_policy or saturates with saturated_overflow_policy");
+
+        template<typename Lhs, typename Rhs>
+        constexpr Lhs convert(const Rhs& rhs) const
+        {
+            return _integer_impl::is_positive_overflow<Lhs>(rhs)
+                   ? (_overflow_stats_impl::count_overflow<Lhs>(overflow_stats::operation::conversion, false),
+                           Response{}.template convert<Lhs>(rhs))
+                   : _integer_impl::is_negative_overflow<Lhs>(rhs)
+                     ? (_overflow_stats_impl::count_overflow<Lhs>(overflow_stats::operation::conversion, true),
+                             Response{}.template convert<Lhs>(rhs))
+                     : static_cast<Lhs>(rhs);
+        }
+    };
+
+    /// an \ref integer which counts its overflow in \ref overflow_stats and saturates
+    template<typename Rep = int>
+    using counting_integer = integer<Rep, counting_overflow_policy<>>;
+
+    namespace _integer_impl {
+        // counting_overflow_policy counts the overflow of the result of the built-in operator
+        template<class OperationTag, class Response>
+        struct arithmetic<OperationTag, counting_overflow_policy<Response>> {
+            template<class Lhs, class Rhs>
+            static constexpr auto op(const Lhs& lhs, const Rhs& rhs) -> _impl::op_result<OperationTag, Lhs, Rhs>
+            {
+                using result = _impl::op_result<OperationTag, Lhs, Rhs>;
+                return _overflow_stats_impl::counted<OperationTag, Response>(
+                        static_cast<result>(lhs), static_cast<result>(rhs));
+            }
+        };
+
+        // but not that of right shifts, which do not overflow
+        template<class Response>
+        struct arithmetic<_impl::shift_right_tag, counting_overflow_policy<Response>>
+                : arithmetic<_impl::shift_right_tag, Response> {
+        };
+    }
+}
+
+#endif  // SG14_OVERFLOW_STATS_H
@@ -0,0 +1,318 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief array of `sg14::fixed_point` values stored in exactly as many bits as they need, `sg14::packed_array`
+
+#if !defined(SG14_PACKED_ARRAY_H)
+#define SG14_PACKED_ARRAY_H 1
+
+#include <sg14/fixed_point.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/// study group 14 of the C++ working group
+namespace sg14 {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::_packed_array_impl
+
+    namespace _packed_array_impl {
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_packed_array_impl::load and sg14::_packed_array_impl::store
+
+        // the 64 bits starting at the given byte, least significant first
+        inline std::uint64_t load(const unsigned char* bytes)
+        {
+            std::uint64_t window;
+            std::memcpy(&window, bytes, sizeof(window));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__==__ORDER_BIG_ENDIAN__)
+            window = __builtin_bswap64(window);
+#endif
+            return window;
+        }
+
+        inline void store(unsigned char* bytes, std::uint64_t window)
+        {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__==__ORDER_BIG_ENDIAN__)
+            window = __builtin_bswap64(window);
+#endif
+            std::memcpy(bytes, &window, sizeof(window));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_packed_array_impl::field - conversion between an element and its bits
+
+        template<int Bits, bool IsSigned>
+        struct field;
+
+        template<int Bits>
+        struct field<Bits, false> {
+            static constexpr std::uint64_t mask = (std::uint64_t{1} << Bits)-1;
+
+            static constexpr std::uint64_t decode(std::uint64_t bits)
+            {
+                return bits & mask;
+            }
+        };
+
+        template<int Bits>
+        struct field<Bits, true> {
+            static constexpr std::uint64_t mask = (std::uint64_t{1} << Bits)-1;
+
+            // sign-extends the low Bits bits
+            static constexpr std::int64_t decode(std::uint64_t bits)
+            {
+                return static_cast<std::int64_t>(bits << (64-Bits)) >> (64-Bits);
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_packed_array_impl::element - access to the element at a given bit offset
+
+        template<class Element, int Bits>
+        struct element {
+            using rep = typename Element::rep;
+            using field = _packed_array_impl::field<Bits, is_signed<rep>::value>;
+
+            static Element get(const unsigned char* bytes, std::size_t bit)
+            {
+                return Element::from_data(static_cast<rep>(field::decode(load(bytes+bit/8) >> (bit%8))));
+            }
+
+            static void set(unsigned char* bytes, std::size_t bit, Element const& value)
+            {
+                auto window = load(bytes+bit/8);
+                auto shift = bit%8;
+                window &= ~(field::mask << shift);
+                window |= (bits(value) & field::mask) << shift;
+                store(bytes+bit/8, window);
+            }
+
+            static std::uint64_t bits(Element const& value)
+            {
+                return static_cast<std::uint64_t>(static_cast<std::int64_t>(value.data()));
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_packed_array_impl::group - eight elements occupying exactly Bits bytes
+
+        // unrolled so that every byte offset and shift is a constant
+        template<class Element, int Bits, int Index = 0>
+        struct group {
+            using element = _packed_array_impl::element<Element, Bits>;
+            static constexpr int bit = Index*Bits;
+
+            static void unpack(const unsigned char* bytes, Element* values)
+            {
+                values[Index] = Element::from_data(static_cast<typename element::rep>(
+                        element::field::decode(load(bytes+bit/8) >> (bit%8))));
+                group<Element, Bits, Index+1>::unpack(bytes, values);
+            }
+
+            // ORs the elements into zeroed bytes
+            static void pack(unsigned char* bytes, const Element* values)
+            {
+                store(bytes+bit/8, load(bytes+bit/8) | ((element::bits(values[Index]) & element::field::mask) << (bit%8)));
+                group<Element, Bits, Index+1>::pack(bytes, values);
+            }
+        };
+
+        template<class Element, int Bits>
+        struct group<Element, Bits, 8> {
+            static void unpack(const unsigned char*, Element*)
+            {
+            }
+
+            static void pack(unsigned char*, const Element*)
+            {
+            }
+        };
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::packed_array
+
+    /// \brief a dynamically-sized array of \ref fixed_point values, each stored in Bits bits
+    ///
+    /// \tparam T the \ref fixed_point type of the elements
+    /// \tparam Bits the number of bits used to store each element;
+    /// by default, the \ref width of the rep of T which, for \ref elastic types, is exactly the bits they need
+    ///
+    /// Elements are stored back to back regardless of the size of T.
+    /// Individual elements are accessed through proxies;
+    /// `pack` and `unpack` convert whole ranges to and from arrays of T more quickly.
+    /// Values stored in the array must be representable in Bits bits; excess bits are discarded.
+    ///
+    /// \par Example
+    ///
+    /// To store 12-bit values without padding:
+    /// \snippet snippets.cpp define a packed_array
+
+    template<class T, int Bits = width<typename T::rep>::value>
+    class packed_array;
+
+    template<class Rep, int Exponent, int Bits>
+    class packed_array<fixed_point<Rep, Exponent>, Bits> {
+    public:
+        /// type of the elements
+        using value_type = fixed_point<Rep, Exponent>;
+
+        /// type of the number of elements
+        using size_type = std::size_t;
+
+        /// number of bits used to store each element
+        static constexpr int bits = Bits;
+
+    private:
+        static_assert(Bits>0 && Bits<=56, "packed_array supports elements of 1 to 56 bits");
+        static_assert(Bits<=static_cast<int>(width<Rep>::value), "Bits exceeds the width of the rep");
+
+        using _element = _packed_array_impl::element<value_type, Bits>;
+        using _group = _packed_array_impl::group<value_type, Bits>;
+
+        // bytes past the last element which may be read and written as part of a 64-bit window
+        static constexpr size_type _padding = sizeof(std::uint64_t)-1;
+
+    public:
+        /// \brief proxy for an element of a \ref packed_array
+        class reference {
+        public:
+            /// returns the value of the element
+            operator value_type() const
+            {
+                return _element::get(_bytes, _bit);
+            }
+
+            /// assigns a value to the element
+            reference& operator=(value_type const& value)
+            {
+                _element::set(_bytes, _bit, value);
+                return *this;
+            }
+
+            /// assigns the value of another element
+            reference& operator=(reference const& rhs)
+            {
+                return *this = static_cast<value_type>(rhs);
+            }
+
+        private:
+            friend class packed_array;
+
+            reference(unsigned char* bytes, size_type bit)
+                    :_bytes(bytes), _bit(bit)
+            {
+            }
+
+            unsigned char* _bytes;
+            size_type _bit;
+        };
+
+        /// constructs an empty array
+        packed_array()
+                :packed_array(0)
+        {
+        }
+
+        /// constructs an array of the given number of zero-valued elements
+        explicit packed_array(size_type size)
+                :_size(size), _bytes(storage_size(size), 0)
+        {
+        }
+
+        /// returns the number of elements
+        size_type size() const
+        {
+            return _size;
+        }
+
+        /// returns the number of bytes used to store the elements
+        size_type size_in_bytes() const
+        {
+            return _bytes.size()-_padding;
+        }
+
+        /// changes the number of elements; new elements are zero
+        void resize(size_type size)
+        {
+            _bytes.resize(storage_size(size), 0);
+            if (size<_size) {
+                // bits past the last element are kept clear
+                auto used = (size*Bits+7)/8;
+                if ((size*Bits)%8!=0) {
+                    _bytes[used-1] &= static_cast<unsigned char>((1u << (size*Bits)%8)-1);
+                }
+                std::fill(_bytes.begin()+used, _bytes.end(), static_cast<unsigned char>(0));
+            }
+            _size = size;
+        }
+
+        /// returns the element at the given index
+        value_type operator[](size_type index) const
+        {
+            return _element::get(_bytes.data(), index*Bits);
+        }
+
+        /// returns a proxy for the element at the given index
+        reference operator[](size_type index)
+        {
+            return reference(_bytes.data(), index*Bits);
+        }
+
+        /// copies count elements, starting at position, to values
+        void unpack(size_type position, value_type* values, size_type count) const
+        {
+            auto last = position+count;
+            for (; position!=last && position%8!=0; ++position, ++values) {
+                *values = (*this)[position];
+            }
+            for (; last-position>=8; position += 8, values += 8) {
+                _group::unpack(_bytes.data()+position/8*Bits, values);
+            }
+            for (; position!=last; ++position, ++values) {
+                *values = (*this)[position];
+            }
+        }
+
+        /// copies count elements from values to the array, starting at position
+        void pack(size_type position, const value_type* values, size_type count)
+        {
+            auto last = position+count;
+            for (; position!=last && position%8!=0; ++position, ++values) {
+                (*this)[position] = *values;
+            }
+            for (; last-position>=8; position += 8, values += 8) {
+                auto group_bytes = _bytes.data()+position/8*Bits;
+                std::memset(group_bytes, 0, Bits);
+                _group::pack(group_bytes, values);
+            }
+            for (; position!=last; ++position, ++values) {
+                (*this)[position] = *values;
+            }
+        }
+
+    private:
+        static size_type storage_size(size_type size)
+        {
+            return (size*Bits+7)/8+_padding;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // variables
+
+        size_type _size;
+        std::vector<unsigned char> _bytes;
+    };
+}
+
+#endif  // SG14_PACKED_ARRAY_H
@@ -0,0 +1,293 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief division by a loop-invariant `sg14::fixed_point` value, `sg14::reciprocal`
+
+#if !defined(SG14_RECIPROCAL_H)
+#define SG14_RECIPROCAL_H 1
+
+#include <sg14/fixed_point.h>
+
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/// study group 14 of the C++ working group
+namespace sg14 {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::_reciprocal_impl
+
+    namespace _reciprocal_impl {
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_reciprocal_impl::magnitude - absolute value of an integer as std::uint64_t
+
+        template<class Rep, typename std::enable_if<std::is_signed<Rep>::value, int>::type Dummy = 0>
+        constexpr std::uint64_t magnitude(Rep value)
+        {
+            return (value<0) ? std::uint64_t{0}-static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+        }
+
+        template<class Rep, typename std::enable_if<!std::is_signed<Rep>::value, int>::type Dummy = 0>
+        constexpr std::uint64_t magnitude(Rep value)
+        {
+            return static_cast<std::uint64_t>(value);
+        }
+
+        template<class Rep, typename std::enable_if<std::is_signed<Rep>::value, int>::type Dummy = 0>
+        constexpr bool is_negative(Rep value)
+        {
+            return value<0;
+        }
+
+        template<class Rep, typename std::enable_if<!std::is_signed<Rep>::value, int>::type Dummy = 0>
+        constexpr bool is_negative(Rep)
+        {
+            return false;
+        }
+
+        // ceil(2^exponent/divisor) by long division;
+        // bits of the quotient beyond the width of Magic are discarded
+        template<class Magic>
+        Magic ceil_pow2_quotient(int exponent, std::uint64_t divisor)
+        {
+            auto quotient = Magic{0};
+            auto remainder = std::uint64_t{0};
+            for (auto bit = exponent; bit>=0; --bit) {
+                auto carry = (remainder >> 63)!=0;
+                remainder = (remainder << 1) | static_cast<std::uint64_t>(bit==exponent);
+                quotient <<= 1;
+                if (carry || remainder>=divisor) {
+                    remainder -= divisor;
+                    quotient |= 1;
+                }
+            }
+            return quotient+(remainder!=0);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_reciprocal_impl::multiply_shift - (x*magic) >> shift for shift of at least MinShift
+
+        template<int MinShift>
+        struct multiply_shift {
+            static_assert(MinShift<64, "sg14::reciprocal of these types requires a 128-bit integer");
+        };
+
+        // product fits in 64 bits; one multiply
+        template<>
+        struct multiply_shift<0> {
+            using magic_type = std::uint64_t;
+
+            static std::uint64_t apply(std::uint64_t x, magic_type magic, int shift)
+            {
+                return (shift>=64) ? 0 : (x*magic) >> shift;
+            }
+        };
+
+// GCC and Clang provide a 128-bit integer on 64-bit targets whether or not SG14_INT128_ENABLED is defined
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef unsigned __int128 wide_product;
+
+        // x fits in 32 bits; the upper half of one 64x64-bit multiply
+        template<>
+        struct multiply_shift<32> {
+            using magic_type = std::uint64_t;
+
+            static std::uint64_t apply(std::uint64_t x, magic_type magic, int shift)
+            {
+                return static_cast<std::uint64_t>((wide_product{x << 32}*magic) >> 64) >> (shift-32);
+            }
+        };
+
+        // the upper bits of a 64x128-bit product, from two 64x64-bit multiplies
+        template<>
+        struct multiply_shift<64> {
+            using magic_type = wide_product;
+
+            static wide_product apply(std::uint64_t x, magic_type magic, int shift)
+            {
+                return (wide_product{x}*static_cast<std::uint64_t>(magic >> 64)
+                        +((wide_product{x}*static_cast<std::uint64_t>(magic)) >> 64)) >> (shift-64);
+            }
+        };
+#else
+        // x fits in 32 bits; two 32x32-bit multiplies
+        template<>
+        struct multiply_shift<32> {
+            using magic_type = std::uint64_t;
+
+            static std::uint64_t apply(std::uint64_t x, magic_type magic, int shift)
+            {
+                return (x*(magic >> 32)+((x*(magic & 0xffffffffu)) >> 32)) >> (shift-32);
+            }
+        };
+#endif
+
+        // the least MinShift of multiply_shift for which the magic constant has room
+        // given the digits of the dividend and the scale applied to it
+        constexpr int min_shift(int dividend_digits, int scale)
+        {
+            return (dividend_digits+scale+dividend_digits+1<=64)
+                   ? 0
+                   : (dividend_digits<=32 && scale+_impl::max(dividend_digits, 32)+1<=64)
+                     ? 32
+                     : 64;
+        }
+
+        // the result of operator/ where an integer is wide enough to hold its quotient and otherwise void
+        template<class Dividend, class Divisor, bool Representable>
+        struct operator_result {
+            using type = decltype(std::declval<Dividend>()/std::declval<Divisor>());
+        };
+
+        template<class Dividend, class Divisor>
+        struct operator_result<Dividend, Divisor, false> {
+            using type = void;
+        };
+
+#if defined(SG14_INT128_ENABLED)
+        constexpr int max_quotient_width = 128;
+#else
+        constexpr int max_quotient_width = 64;
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::reciprocal
+
+    /// \brief a divisor prepared for repeated division
+    ///
+    /// \tparam Divisor the \ref fixed_point type of the divisor
+    /// \tparam Dividend the \ref fixed_point type of the values to be divided
+    ///
+    /// Construction precomputes a constant with which division
+    /// is performed as a multiply and a shift.
+    /// Results are identical to those of the division operators.
+    /// Each costs a single multiply: a 64-bit one where both reps are 16 bits or narrower
+    /// and otherwise the upper half of a 64x64-bit one (two 32x32-bit multiplies
+    /// on targets without a 128-bit integer). Where either rep is 64 bits,
+    /// it costs two 64x64-bit multiplies and requires a 128-bit integer.
+    /// As with the division operators, division by zero is undefined.
+    ///
+    /// \par Example
+    ///
+    /// To normalize values by their total:
+    /// \snippet snippets.cpp divide by a reciprocal
+
+    template<class Divisor, class Dividend = Divisor>
+    class reciprocal;
+
+    template<class DivisorRep, int DivisorExponent, class DividendRep, int DividendExponent>
+    class reciprocal<fixed_point<DivisorRep, DivisorExponent>, fixed_point<DividendRep, DividendExponent>> {
+    public:
+        /// type of the divisor
+        using divisor_type = fixed_point<DivisorRep, DivisorExponent>;
+
+        /// type of the values to be divided
+        using dividend_type = fixed_point<DividendRep, DividendExponent>;
+
+        /// type returned by `operator/`; void where no integer is wide enough for the quotient,
+        /// e.g. that of 64-bit reps without \ref SG14_INT128_ENABLED, in which case use \ref reciprocal::divide
+        using result_type = typename _reciprocal_impl::operator_result<dividend_type, divisor_type,
+                std::numeric_limits<DividendRep>::digits+std::numeric_limits<DivisorRep>::digits
+                +(std::is_signed<DividendRep>::value || std::is_signed<DivisorRep>::value)
+                <=_reciprocal_impl::max_quotient_width>::type;
+
+        /// type returned by \ref reciprocal::divide
+        using divide_result_type = decltype(sg14::divide(std::declval<dividend_type>(), std::declval<divisor_type>()));
+
+    private:
+        static_assert(std::is_integral<DivisorRep>::value && std::is_integral<DividendRep>::value,
+                "sg14::reciprocal requires fundamental integer reps");
+
+        // operator/ scales the dividend by 2^_scale before dividing
+        static constexpr int _scale = std::numeric_limits<DivisorRep>::digits;
+
+        // dividend magnitudes are no greater than 2^_dividend_digits
+        static constexpr int _dividend_digits = std::numeric_limits<DividendRep>::digits;
+
+        using _multiply_shift = _reciprocal_impl::multiply_shift<
+                _reciprocal_impl::min_shift(_dividend_digits, _scale)>;
+        using _magic_type = typename _multiply_shift::magic_type;
+
+        static_assert(_scale+_impl::max(_dividend_digits, _reciprocal_impl::min_shift(_dividend_digits, _scale))+1
+                      <=static_cast<int>(sizeof(_magic_type)*CHAR_BIT), "sg14::reciprocal does not support these types");
+
+    public:
+        /// precomputes the reciprocal of the given divisor
+        explicit reciprocal(divisor_type const& divisor)
+                :_divisor(divisor),
+                 _shift(shift(_reciprocal_impl::magnitude(divisor.data()))),
+                 _magic(_reciprocal_impl::ceil_pow2_quotient<_magic_type>(
+                         _scale+_shift, _reciprocal_impl::magnitude(divisor.data())))
+        {
+        }
+
+        /// returns the divisor
+        divisor_type divisor() const
+        {
+            return _divisor;
+        }
+
+        /// \brief divides by the divisor without widening
+        ///
+        /// \return `sg14::divide(dividend, divisor())`
+        divide_result_type divide(dividend_type const& dividend) const
+        {
+            static_assert(std::is_signed<typename divide_result_type::rep>::value || !std::is_signed<DivisorRep>::value,
+                    "dividing an unsigned value by a signed one converts the divisor to unsigned");
+            return divide_result_type::from_data(quotient<typename divide_result_type::rep>(dividend, _scale));
+        }
+
+        template<class Divisor, class Rep, int Exponent>
+        friend typename reciprocal<Divisor, fixed_point<Rep, Exponent>>::result_type
+        operator/(fixed_point<Rep, Exponent> const& lhs, reciprocal<Divisor, fixed_point<Rep, Exponent>> const& rhs);
+
+    private:
+        // the precision with which the magic constant is computed;
+        // sufficient for all dividends: x*(magic*divisor-2^(_scale+_shift)) < 2^_shift
+        static int shift(std::uint64_t divisor)
+        {
+            return _impl::max(_dividend_digits+_impl::ceil_log2(divisor),
+                    _reciprocal_impl::min_shift(_dividend_digits, _scale));
+        }
+
+        // trunc(dividend*2^(_scale-descale)/divisor)
+        template<class ResultRep>
+        ResultRep quotient(dividend_type const& dividend, int descale) const
+        {
+            auto magnitude = _multiply_shift::apply(
+                    _reciprocal_impl::magnitude(dividend.data()), _magic, _shift+descale);
+            return (_reciprocal_impl::is_negative(dividend.data())!=_reciprocal_impl::is_negative(_divisor.data()))
+                   ? static_cast<ResultRep>(decltype(magnitude){0}-magnitude)
+                   : static_cast<ResultRep>(magnitude);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // variables
+
+        divisor_type _divisor;
+        int _shift;
+        _magic_type _magic;
+    };
+
+    /// \brief divides by a \ref reciprocal
+    ///
+    /// \return `lhs/rhs.divisor()`
+    template<class Divisor, class Rep, int Exponent>
+    typename reciprocal<Divisor, fixed_point<Rep, Exponent>>::result_type
+    operator/(fixed_point<Rep, Exponent> const& lhs, reciprocal<Divisor, fixed_point<Rep, Exponent>> const& rhs)
+    {
+        using result_type = typename reciprocal<Divisor, fixed_point<Rep, Exponent>>::result_type;
+        static_assert(!std::is_void<result_type>::value,
+                "the quotient of these types requires SG14_INT128_ENABLED; use reciprocal::divide");
+        return result_type::from_data(rhs.template quotient<typename result_type::rep>(lhs, 0));
+    }
+}
+
+#endif  // SG14_RECIPROCAL_H
@@ -0,0 +1,447 @@
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief multi-threaded reductions of arrays of `sg14::fixed_point` values whose results do not depend on
+/// the number of threads
+
+#if !defined(SG14_REDUCE_H)
+#define SG14_REDUCE_H 1
+
+#include <sg14/fixed_point.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// study group 14 of the C++ working group
+namespace sg14 {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::_reduce_impl
+
+    namespace _reduce_impl {
+        // number of elements which are summed in a narrow rep before being added to a wide one
+        constexpr int block_digits = 12;
+        constexpr std::size_t block_size = std::size_t{1} << block_digits;
+
+        // number of digits by which sums exceed their terms; sums of up to 2^32 terms cannot overflow
+        constexpr int headroom = 32;
+
+        using _impl::signed_rep;
+
+        template<class Element>
+        struct traits;
+
+        template<class Rep, int Exponent>
+        struct traits<fixed_point<Rep, Exponent>> {
+            static_assert(std::is_integral<Rep>::value, "sg14 reductions require fundamental integer reps");
+
+            static constexpr int digits = std::numeric_limits<Rep>::digits;
+
+            // sum of a block of elements, which is calculated with vector instructions, and of a whole array
+            using block_sum = signed_rep<digits+block_digits>;
+            using sum = fixed_point<signed_rep<digits+headroom>, Exponent>;
+        };
+
+        // kept apart from traits so that sums of elements too wide to square exactly can still be calculated
+        template<class Element>
+        struct square_traits {
+            static constexpr int digits = traits<Element>::digits;
+
+            using block_sum = signed_rep<2*digits+1+block_digits>;
+            using sum = fixed_point<signed_rep<2*digits+1+headroom>, 2*Element::exponent>;
+        };
+
+        // the result of one range; wrapped so that a std::vector<bool> is never written by two threads
+        template<class Result>
+        struct range_result {
+            Result value;
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_reduce_impl::thread_pool - threads which persist from one reduction to the next
+
+        // Creating and joining a thread costs tens of microseconds, about as much as reading a megabyte,
+        // so a reduction on dozens of threads would otherwise spend much of its time starting them.
+        // The pool grows to the largest number of threads requested and its threads wait for work in between.
+        class thread_pool {
+        public:
+            static thread_pool& instance()
+            {
+                static thread_pool pool;
+                return pool;
+            }
+
+            // calls task(0) on the calling thread and task(1), ... task(count-1) on threads of the pool,
+            // and returns once all have returned; like an uncaught exception in a std::thread,
+            // one thrown by a task terminates the program
+            template<class Task>
+            void run(unsigned count, Task const& task)
+            {
+                batch tasks(count-1);
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    while (_workers.size()+1<count) {
+                        _workers.emplace_back([this] { work(); });
+                    }
+                    for (auto index = 1u; index<count; ++index) {
+                        _jobs.push_back(job{&invoke<Task>, &task, index, &tasks});
+                    }
+                }
+                _work_available.notify_all();
+
+                invoke<Task>(&task, 0);
+
+                // jobs still queued are run here rather than waited for, so that a reduction
+                // which is nested in a task of another cannot wait for threads which are all waiting
+                std::unique_lock<std::mutex> lock(_mutex);
+                while (tasks.remaining!=0) {
+                    if (_jobs.empty()) {
+                        tasks.done.wait(lock);
+                    }
+                    else {
+                        execute(lock);
+                    }
+                }
+            }
+
+            ~thread_pool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _stopping = true;
+                }
+                _work_available.notify_all();
+                for (auto& worker : _workers) {
+                    worker.join();
+                }
+            }
+
+        private:
+            thread_pool() = default;
+
+            // the tasks of one call to run which have yet to return
+            struct batch {
+                explicit batch(unsigned count)
+                        :remaining(count)
+                {
+                }
+
+                unsigned remaining;
+                std::condition_variable done;
+            };
+
+            struct job {
+                void (* invoke)(void const*, unsigned);
+                void const* task;
+                unsigned index;
+                batch* tasks;
+            };
+
+            template<class Task>
+            static void invoke(void const* task, unsigned index) noexcept
+            {
+                (*static_cast<Task const*>(task))(index);
+            }
+
+            // runs the first queued job with _mutex unlocked
+            void execute(std::unique_lock<std::mutex>& lock)
+            {
+                auto next = _jobs.front();
+                _jobs.pop_front();
+                lock.unlock();
+                next.invoke(next.task, next.index);
+                lock.lock();
+                if (--next.tasks->remaining==0) {
+                    next.tasks->done.notify_all();
+                }
+            }
+
+            void work()
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                for (;;) {
+                    _work_available.wait(lock, [this] { return _stopping || !_jobs.empty(); });
+                    if (_jobs.empty()) {
+                        return;
+                    }
+                    execute(lock);
+                }
+            }
+
+            std::mutex _mutex;
+            std::condition_variable _work_available;
+            std::deque<job> _jobs;
+            std::vector<std::thread> _workers;
+            bool _stopping = false;
+        };
+
+        // divides [0, size) into contiguous ranges of whole blocks, one per thread,
+        // and returns the result of reduce_range(first, last) for each range, in order
+        template<class Result, class ReduceRange>
+        std::vector<range_result<Result>> partition(std::size_t size, unsigned threads, ReduceRange reduce_range)
+        {
+            auto blocks = (size+block_size-1)/block_size;
+            threads = static_cast<unsigned>(_impl::max<std::size_t>(_impl::min<std::size_t>(threads, blocks), 1));
+            auto range_size = _impl::max<std::size_t>((blocks+threads-1)/threads, 1)*block_size;
+            threads = static_cast<unsigned>(_impl::max<std::size_t>((size+range_size-1)/range_size, 1));
+
+            std::vector<range_result<Result>> results(threads);
+            auto reduce = [&](unsigned thread) {
+                auto first = thread*range_size;
+                results[thread].value = reduce_range(first, _impl::min(first+range_size, size));
+            };
+
+            if (threads==1) {
+                reduce(0);
+            }
+            else {
+                thread_pool::instance().run(threads, reduce);
+            }
+            return results;
+        }
+
+        // exact sums of the reps of the elements, and of their squares, in [first, last)
+        template<class Rep, int Exponent>
+        typename traits<fixed_point<Rep, Exponent>>::sum::rep sum(
+                const fixed_point<Rep, Exponent>* data, std::size_t first, std::size_t last)
+        {
+            using element_traits = traits<fixed_point<Rep, Exponent>>;
+            using block_sum = typename element_traits::block_sum;
+            auto total = typename element_traits::sum::rep{0};
+            for (auto block = first; block<last; block += block_size) {
+                auto partial = block_sum{0};
+                for (auto index = block, end = _impl::min(block+block_size, last); index!=end; ++index) {
+                    partial = static_cast<block_sum>(partial+data[index].data());
+                }
+                total += partial;
+            }
+            return total;
+        }
+
+        template<class Rep, int Exponent>
+        typename square_traits<fixed_point<Rep, Exponent>>::sum::rep sum_of_squares(
+                const fixed_point<Rep, Exponent>* data, std::size_t first, std::size_t last)
+        {
+            using element_traits = square_traits<fixed_point<Rep, Exponent>>;
+            using block_square_sum = typename element_traits::block_sum;
+            auto total = typename element_traits::sum::rep{0};
+            for (auto block = first; block<last; block += block_size) {
+                auto partial = block_square_sum{0};
+                for (auto index = block, end = _impl::min(block+block_size, last); index!=end; ++index) {
+                    partial += static_cast<block_square_sum>(data[index].data())*data[index].data();
+                }
+                total += partial;
+            }
+            return total;
+        }
+
+        // least and greatest reps of the elements in [first, last), or the greatest and least reps if it is empty
+        template<class Rep, int Exponent>
+        Rep min(const fixed_point<Rep, Exponent>* data, std::size_t first, std::size_t last)
+        {
+            auto least = std::numeric_limits<Rep>::max();
+            for (auto index = first; index!=last; ++index) {
+                least = (data[index].data()<least) ? data[index].data() : least;
+            }
+            return least;
+        }
+
+        template<class Rep, int Exponent>
+        Rep max(const fixed_point<Rep, Exponent>* data, std::size_t first, std::size_t last)
+        {
+            auto greatest = std::numeric_limits<Rep>::lowest();
+            for (auto index = first; index!=last; ++index) {
+                greatest = (data[index].data()>greatest) ? data[index].data() : greatest;
+            }
+            return greatest;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // reductions of arrays of fixed_point values
+
+    // Each function divides the array into one contiguous range per thread and combines the results
+    // of the ranges in order. The calling thread reduces the first range and threads which persist
+    // between calls reduce the others. Sums are exact so, unlike those of floating-point values, they do not
+    // depend on how the array is divided and so are identical for any number of threads.
+
+    /// \brief combines the elements of an array using a binary operation
+    ///
+    /// \param data array of elements
+    /// \param size number of elements in data
+    /// \param init value with which the elements are combined
+    /// \param op binary operation which combines two values of type Result
+    /// \param threads number of threads among which the array is divided
+    ///
+    /// \return op(... op(op(init, r0), r1) ..., rn) where r0, r1, ... rn are the results of the ranges of data
+    /// in order and each is, in turn, the combination of its elements converted to Result, in order;
+    /// init if size is zero
+    ///
+    /// \note Where op is associative, such as the addition of integers which wraps on overflow,
+    /// or \ref min and \ref max, the result does not depend on threads.
+    ///
+    /// \sa sum
+
+    template<class Element, class Result, class BinaryOperation>
+    Result reduce(const Element* data, std::size_t size, Result init, BinaryOperation op, unsigned threads = 1)
+    {
+        if (size==0) {
+            return init;
+        }
+        auto results = _reduce_impl::partition<Result>(size, threads, [&](std::size_t first, std::size_t last) {
+            auto result = static_cast<Result>(data[first]);
+            for (auto index = first+1; index!=last; ++index) {
+                result = op(result, static_cast<Result>(data[index]));
+            }
+            return result;
+        });
+        for (auto const& result : results) {
+            init = op(init, result.value);
+        }
+        return init;
+    }
+
+    /// \brief calculates the exact sum of an array of \ref fixed_point values
+    ///
+    /// \param data array of elements
+    /// \param size number of elements in data, which must not exceed 2^32
+    /// \param threads number of threads among which the array is divided
+    ///
+    /// \return sum of the elements; its rep is the narrowest signed integer with 32 more digits than that of the elements,
+    /// e.g. std::int64_t for elements with signed reps of up to 32 bits or unsigned reps of up to 16 bits;
+    /// the sum of elements with std::uint32_t reps requires a 128-bit integer
+    ///
+    /// \note Each range of 4096 elements is summed in the narrowest rep which cannot overflow,
+    /// e.g. in 32 bits for elements with 16-bit reps, using vector instructions where the compiler allows.
+    ///
+    /// \par Example
+    ///
+    /// To calculate the mean and variance of an array of Q15 samples in the same way on any number of threads:
+    /// \snippet snippets.cpp calculate the mean and variance of samples
+    ///
+    /// \sa sum_of_squares, mean, reduce
+
+    template<class Rep, int Exponent>
+    auto sum(const fixed_point<Rep, Exponent>* data, std::size_t size, unsigned threads = 1)
+    -> typename _reduce_impl::traits<fixed_point<Rep, Exponent>>::sum
+    {
+        using result_type = typename _reduce_impl::traits<fixed_point<Rep, Exponent>>::sum;
+        auto results = _reduce_impl::partition<typename result_type::rep>(size, threads,
+                [data](std::size_t first, std::size_t last) {
+                    return _reduce_impl::sum(data, first, last);
+                });
+        auto total = typename result_type::rep{0};
+        for (auto const& result : results) {
+            total += result.value;
+        }
+        return result_type::from_data(total);
+    }
+
+    /// \brief calculates the exact sum of the squares of an array of \ref fixed_point values
+    ///
+    /// \param data array of elements
+    /// \param size number of elements in data, which must not exceed 2^32
+    /// \param threads number of threads among which the array is divided
+    ///
+    /// \return sum of the squares of the elements; its rep has 33 more digits than twice those of the elements
+    /// and its exponent is twice theirs, e.g. std::int64_t for elements with 8-bit or signed 16-bit reps;
+    /// elements with 32-bit reps require 128-bit integer support
+    ///
+    /// \sa sum
+
+    template<class Rep, int Exponent>
+    auto sum_of_squares(const fixed_point<Rep, Exponent>* data, std::size_t size, unsigned threads = 1)
+    -> typename _reduce_impl::square_traits<fixed_point<Rep, Exponent>>::sum
+    {
+        using result_type = typename _reduce_impl::square_traits<fixed_point<Rep, Exponent>>::sum;
+        auto results = _reduce_impl::partition<typename result_type::rep>(size, threads,
+                [data](std::size_t first, std::size_t last) {
+                    return _reduce_impl::sum_of_squares(data, first, last);
+                });
+        auto total = typename result_type::rep{0};
+        for (auto const& result : results) {
+            total += result.value;
+        }
+        return result_type::from_data(total);
+    }
+
+    /// \brief calculates the mean of an array of \ref fixed_point values
+    ///
+    /// \param data array of elements
+    /// \param size number of elements in data, which must not exceed 2^32
+    /// \param threads number of threads among which the array is divided
+    /// \param rounding \ref round_toward_zero, \ref round_half_up or \ref round_half_even
+    ///
+    /// \return the exact \ref sum divided by size and rounded once according to RoundingPolicy,
+    /// or zero if size is zero
+    ///
+    /// \sa sum
+
+    template<class Rep, int Exponent, class RoundingPolicy = round_toward_zero>
+    fixed_point<Rep, Exponent> mean(const fixed_point<Rep, Exponent>* data, std::size_t size,
+            unsigned threads = 1, RoundingPolicy = RoundingPolicy{})
+    {
+        using sum_rep = typename _reduce_impl::traits<fixed_point<Rep, Exponent>>::sum::rep;
+        return fixed_point<Rep, Exponent>::from_data(static_cast<Rep>((size==0) ? sum_rep{0}
+                : _fixed_point_impl::round_quotient<RoundingPolicy>(
+                        sum(data, size, threads).data(), static_cast<sum_rep>(size))));
+    }
+
+    /// \brief finds the least of an array of \ref fixed_point values
+    ///
+    /// \param data array of elements
+    /// \param size number of elements in data
+    /// \param threads number of threads among which the array is divided
+    ///
+    /// \return the least element or, if size is zero, the greatest value of the element type
+    ///
+    /// \sa max
+
+    template<class Rep, int Exponent>
+    fixed_point<Rep, Exponent> min(const fixed_point<Rep, Exponent>* data, std::size_t size, unsigned threads = 1)
+    {
+        auto results = _reduce_impl::partition<Rep>(size, threads, [data](std::size_t first, std::size_t last) {
+            return _reduce_impl::min(data, first, last);
+        });
+        auto least = std::numeric_limits<Rep>::max();
+        for (auto const& result : results) {
+            least = _impl::min(least, result.value);
+        }
+        return fixed_point<Rep, Exponent>::from_data(least);
+    }
+
+    /// \brief finds the greatest of an array of \ref fixed_point values
+    ///
+    /// \param data array of elements
+    /// \param size number of elements in data
+    /// \param threads number of threads among which the array is divided
+    ///
+    /// \return the greatest element or, if size is zero, the lowest value of the element type
+    ///
+    /// \sa min
+
+    template<class Rep, int Exponent>
+    fixed_point<Rep, Exponent> max(const fixed_point<Rep, Exponent>* data, std::size_t size, unsigned threads = 1)
+    {
+        auto results = _reduce_impl::partition<Rep>(size, threads, [data](std::size_t first, std::size_t last) {
+            return _reduce_impl::max(data, first, last);
+        });
+        auto greatest = std::numeric_limits<Rep>::lowest();
+        for (auto const& result : results) {
+            greatest = _impl::max(greatest, result.value);
+        }
+        return fixed_point<Rep, Exponent>::from_data(greatest);
+    }
+}
+
+#endif  // SG14_REDUCE_H
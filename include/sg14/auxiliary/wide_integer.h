@@ -0,0 +1,1140 @@
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief `sg14::wide_integer`, a two's complement integer of any multiple of 64 bits
+/// which allocates no memory and can be used as the Rep of `sg14::fixed_point`
+
+#if !defined(SG14_WIDE_INTEGER_H)
+#define SG14_WIDE_INTEGER_H 1
+
+#include <sg14/fixed_point.h>
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/// study group 14 of the C++ working group
+namespace sg14 {
+    template<_width_type Bits, class Signedness>
+    class wide_integer;
+
+    namespace _wide_integer_impl {
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_wide_integer_impl::limb - the unit of storage and of arithmetic
+
+        using limb = std::uint64_t;
+
+        constexpr int limb_width = 64;
+        constexpr limb limb_max = ~limb{0};
+        constexpr limb sign_bit = limb{1} << (limb_width-1);
+
+        // the number of limbs above which products are calculated using Karatsuba's method
+        // rather than schoolbook multiplication
+        constexpr int karatsuba_threshold = 8;
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_wide_integer_impl::is_wide_integer
+
+        template<class T>
+        struct is_wide_integer : std::false_type {
+        };
+
+        template<_width_type Bits, class Signedness>
+        struct is_wide_integer<wide_integer<Bits, Signedness>> : std::true_type {
+        };
+
+        // the width of the narrowest wide_integer with at least the given number of bits
+        constexpr _width_type round_up_width(_width_type bits)
+        {
+            return (bits>limb_width) ? (bits+limb_width-1)/limb_width*limb_width : limb_width;
+        }
+
+        // tag of the constructor which fills the limbs of a wide_integer
+        struct fill_tag {
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // conversion to and from built-in types
+
+        // the number of bits in a built-in integer, including bool
+        template<class Integer>
+        constexpr int integer_width()
+        {
+            return std::numeric_limits<Integer>::digits+std::numeric_limits<Integer>::is_signed;
+        }
+
+        template<class Integer, typename std::enable_if<std::numeric_limits<Integer>::is_signed, int>::type Dummy = 0>
+        constexpr bool is_negative(const Integer& value)
+        {
+            return value<0;
+        }
+
+        template<class Integer, typename std::enable_if<!std::numeric_limits<Integer>::is_signed, int>::type Dummy = 0>
+        constexpr bool is_negative(const Integer&)
+        {
+            return false;
+        }
+
+        // the limb of a built-in integer with the given index, sign-extended
+        template<class Integer>
+        constexpr limb integer_limb(const Integer& value, int index)
+        {
+            return (index*limb_width<integer_width<Integer>())
+                   ? static_cast<limb>(value >> (index*limb_width))
+                   : is_negative(value) ? limb_max : limb{0};
+        }
+
+        // the low bits of an array of limbs as an unsigned built-in integer
+        template<class Unsigned>
+        constexpr Unsigned limbs_to_integer(const limb* limbs, int size, int index = 0)
+        {
+            return (index==size || index*limb_width>=integer_width<Unsigned>())
+                   ? Unsigned{0}
+                   : static_cast<Unsigned>(static_cast<Unsigned>(static_cast<Unsigned>(limbs[index]) << (index*limb_width))
+                           | limbs_to_integer<Unsigned>(limbs, size, index+1));
+        }
+
+        // 2^64
+        template<class Float>
+        constexpr Float radix()
+        {
+            return static_cast<Float>(limb{1} << (limb_width/2))*static_cast<Float>(limb{1} << (limb_width/2));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // operations on single limbs
+
+        struct limb_pair {
+            limb low;
+            limb high;
+        };
+
+        struct limb_division {
+            limb quotient;
+            limb remainder;
+        };
+
+// GCC and Clang provide a 128-bit integer on 64-bit targets whether or not SG14_INT128_ENABLED is defined
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef unsigned __int128 double_limb;
+
+        constexpr limb_pair multiply(limb lhs, limb rhs)
+        {
+            return limb_pair{
+                    static_cast<limb>(double_limb{lhs}*rhs),
+                    static_cast<limb>((double_limb{lhs}*rhs) >> limb_width)};
+        }
+
+        // the remainder is found from the quotient to avoid a second double-width division
+        constexpr limb_division make_division(limb quotient, limb low, limb divisor)
+        {
+            return limb_division{quotient, low-quotient*divisor};
+        }
+
+        // high:low divided by divisor, where high<divisor
+        constexpr limb_division divide(limb high, limb low, limb divisor)
+        {
+            return make_division(
+                    static_cast<limb>(((double_limb{high} << limb_width) | low)/divisor), low, divisor);
+        }
+
+        // sets sum to the low limb of multiplier*multiplicand+sum+carry, which cannot overflow two limbs,
+        // and returns the high limb
+        SG14_RELAXED_CONSTEXPR limb multiply_add(limb& sum, limb multiplier, limb multiplicand, limb carry)
+        {
+            auto result = double_limb{multiplier}*multiplicand+sum+carry;
+            sum = static_cast<limb>(result);
+            return static_cast<limb>(result >> limb_width);
+        }
+#else
+        constexpr limb half_mask = limb_max >> (limb_width/2);
+        constexpr limb half_radix = limb{1} << (limb_width/2);
+
+        SG14_RELAXED_CONSTEXPR limb_pair multiply(limb lhs, limb rhs)
+        {
+            auto low_low = (lhs & half_mask)*(rhs & half_mask);
+            auto low_high = (lhs & half_mask)*(rhs >> (limb_width/2));
+            auto high_low = (lhs >> (limb_width/2))*(rhs & half_mask);
+            auto high_high = (lhs >> (limb_width/2))*(rhs >> (limb_width/2));
+            auto middle = (low_low >> (limb_width/2))+(low_high & half_mask)+(high_low & half_mask);
+            return limb_pair{
+                    (middle << (limb_width/2)) | (low_low & half_mask),
+                    high_high+(low_high >> (limb_width/2))+(high_low >> (limb_width/2))+(middle >> (limb_width/2))};
+        }
+
+        // high:low divided by divisor, where high<divisor, by normalized long division of 32-bit digits
+        SG14_RELAXED_CONSTEXPR limb_division divide(limb high, limb low, limb divisor)
+        {
+            auto shift = _impl::count_leading_zeros(divisor);
+            divisor <<= shift;
+            auto divisor_high = divisor >> (limb_width/2);
+            auto divisor_low = divisor & half_mask;
+            auto numerator_high = shift ? (high << shift) | (low >> (limb_width-shift)) : high;
+            auto numerator_low = low << shift;
+
+            auto quotient_high = numerator_high/divisor_high;
+            auto remainder = numerator_high-quotient_high*divisor_high;
+            while (quotient_high>=half_radix
+                   || quotient_high*divisor_low>((remainder << (limb_width/2)) | (numerator_low >> (limb_width/2)))) {
+                --quotient_high;
+                remainder += divisor_high;
+                if (remainder>=half_radix) {
+                    break;
+                }
+            }
+
+            auto partial = (numerator_high << (limb_width/2))+(numerator_low >> (limb_width/2))-quotient_high*divisor;
+            auto quotient_low = partial/divisor_high;
+            remainder = partial-quotient_low*divisor_high;
+            while (quotient_low>=half_radix
+                   || quotient_low*divisor_low>((remainder << (limb_width/2)) | (numerator_low & half_mask))) {
+                --quotient_low;
+                remainder += divisor_high;
+                if (remainder>=half_radix) {
+                    break;
+                }
+            }
+
+            return limb_division{
+                    (quotient_high << (limb_width/2))+quotient_low,
+                    ((partial << (limb_width/2))+(numerator_low & half_mask)-quotient_low*divisor) >> shift};
+        }
+
+        SG14_RELAXED_CONSTEXPR limb multiply_add(limb& sum, limb multiplier, limb multiplicand, limb carry)
+        {
+            auto product = multiply(multiplier, multiplicand);
+            auto low = product.low+sum;
+            auto high = product.high+(low<sum);
+            sum = low+carry;
+            return high+(sum<carry);
+        }
+#endif
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // operations on arrays of limbs, least significant first
+
+        // sum[0..size) = lhs+rhs+carry; returns the carry out
+        SG14_RELAXED_CONSTEXPR limb add(limb* sum, const limb* lhs, const limb* rhs, int size, limb carry = 0)
+        {
+            for (auto index = 0; index!=size; ++index) {
+                auto partial = lhs[index]+carry;
+                carry = partial<carry;
+                sum[index] = partial+rhs[index];
+                carry += sum[index]<partial;
+            }
+            return carry;
+        }
+
+        // difference[0..size) = lhs-rhs-borrow; returns the borrow out
+        SG14_RELAXED_CONSTEXPR limb subtract(limb* difference, const limb* lhs, const limb* rhs, int size, limb borrow = 0)
+        {
+            for (auto index = 0; index!=size; ++index) {
+                auto partial = lhs[index]-borrow;
+                borrow = partial>lhs[index];
+                difference[index] = partial-rhs[index];
+                borrow += difference[index]>partial;
+            }
+            return borrow;
+        }
+
+        // adds addend[0..addend_size) to sum[0..sum_size), discarding the carry out of the top limb
+        SG14_RELAXED_CONSTEXPR void accumulate(limb* sum, int sum_size, const limb* addend, int addend_size)
+        {
+            auto carry = add(sum, sum, addend, addend_size);
+            for (auto index = addend_size; carry && index!=sum_size; ++index) {
+                carry = ++sum[index]==0;
+            }
+        }
+
+        SG14_RELAXED_CONSTEXPR void negate(limb* value, int size)
+        {
+            limb carry = 1;
+            for (auto index = 0; index!=size; ++index) {
+                value[index] = ~value[index]+carry;
+                carry &= value[index]==0;
+            }
+        }
+
+        // -1, 0 or 1 as unsigned lhs is less than, equal to or greater than unsigned rhs
+        SG14_RELAXED_CONSTEXPR int compare(const limb* lhs, const limb* rhs, int size)
+        {
+            for (auto index = size; index--;) {
+                if (lhs[index]!=rhs[index]) {
+                    return (lhs[index]<rhs[index]) ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+
+        constexpr bool equal(const limb* lhs, const limb* rhs, int size)
+        {
+            return size==0 || (lhs[0]==rhs[0] && equal(lhs+1, rhs+1, size-1));
+        }
+
+        // whether lhs is less than rhs, where the sign bit of the top limb is flipped to compare signed values
+        constexpr bool less(const limb* lhs, const limb* rhs, int size, limb flip)
+        {
+            return ((lhs[size-1]^flip)!=(rhs[size-1]^flip))
+                   ? (lhs[size-1]^flip)<(rhs[size-1]^flip)
+                   : size>1 && less(lhs, rhs, size-1, 0);
+        }
+
+        constexpr bool any(const limb* value, int size)
+        {
+            return size!=0 && (value[0] || any(value+1, size-1));
+        }
+
+        // the number of limbs below the most significant non-zero limb, inclusive
+        SG14_RELAXED_CONSTEXPR int significant_limbs(const limb* value, int size)
+        {
+            while (size && !value[size-1]) {
+                --size;
+            }
+            return size;
+        }
+
+        // result[0..size) = value << shift, where result can be value
+        SG14_RELAXED_CONSTEXPR void shift_left(limb* result, const limb* value, int size, int shift)
+        {
+            auto limbs = shift/limb_width;
+            auto bits = shift%limb_width;
+            for (auto index = size; index--;) {
+                auto source = index-limbs;
+                result[index] = (source<0) ? limb{0}
+                        : (bits && source) ? (value[source] << bits) | (value[source-1] >> (limb_width-bits))
+                        : value[source] << bits;
+            }
+        }
+
+        // result[0..size) = value >> shift, shifting in copies of fill, where result can be value
+        SG14_RELAXED_CONSTEXPR void shift_right(limb* result, const limb* value, int size, int shift, limb fill)
+        {
+            auto limbs = shift/limb_width;
+            auto bits = shift%limb_width;
+            for (auto index = 0; index!=size; ++index) {
+                auto source = index+limbs;
+                auto low = (source<size) ? value[source] : fill;
+                auto high = (source+1<size) ? value[source+1] : fill;
+                result[index] = bits ? (low >> bits) | (high << (limb_width-bits)) : low;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // schoolbook multiplication, unrolled by template recursion
+
+        // product[0..Size) += multiplier*multiplicand[0..Size)+carry; returns the limb carried out of the top
+        template<int Size>
+        struct multiply_row {
+            static SG14_RELAXED_CONSTEXPR limb apply(limb* product, limb multiplier, const limb* multiplicand, limb carry)
+            {
+                return multiply_row<Size-1>::apply(product+1, multiplier, multiplicand+1,
+                        multiply_add(product[0], multiplier, multiplicand[0], carry));
+            }
+        };
+
+        template<>
+        struct multiply_row<0> {
+            static constexpr limb apply(limb*, limb, const limb*, limb carry)
+            {
+                return carry;
+            }
+        };
+
+        // as multiply_row but the carry out of the top limb is discarded
+        // so the top limb only needs the low half of its product
+        template<int Size>
+        struct multiply_row_low {
+            static SG14_RELAXED_CONSTEXPR void apply(limb* product, limb multiplier, const limb* multiplicand, limb carry)
+            {
+                multiply_row_low<Size-1>::apply(product+1, multiplier, multiplicand+1,
+                        multiply_add(product[0], multiplier, multiplicand[0], carry));
+            }
+        };
+
+        template<>
+        struct multiply_row_low<1> {
+            static SG14_RELAXED_CONSTEXPR void apply(limb* product, limb multiplier, const limb* multiplicand, limb carry)
+            {
+                product[0] += multiplier*multiplicand[0]+carry;
+            }
+        };
+
+        // long multiplication of Rows limbs by Columns limbs into a product which is zero on entry
+        template<int Rows, int Columns>
+        struct schoolbook {
+            // product[0..Rows+Columns) = multiplier*multiplicand
+            static SG14_RELAXED_CONSTEXPR void full(limb* product, const limb* multiplier, const limb* multiplicand)
+            {
+                product[Columns] = multiply_row<Columns>::apply(product, multiplier[0], multiplicand, 0);
+                schoolbook<Rows-1, Columns>::full(product+1, multiplier+1, multiplicand);
+            }
+
+            // product[0..Rows) = the low Rows limbs of multiplier*multiplicand
+            static SG14_RELAXED_CONSTEXPR void low(limb* product, const limb* multiplier, const limb* multiplicand)
+            {
+                multiply_row_low<Rows>::apply(product, multiplier[0], multiplicand, 0);
+                schoolbook<Rows-1, Columns>::low(product+1, multiplier+1, multiplicand);
+            }
+        };
+
+        template<int Columns>
+        struct schoolbook<0, Columns> {
+            static SG14_RELAXED_CONSTEXPR void full(limb*, const limb*, const limb*)
+            {
+            }
+
+            static SG14_RELAXED_CONSTEXPR void low(limb*, const limb*, const limb*)
+            {
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_wide_integer_impl::multiplication - multiplication of two Size-limb values
+
+        template<int Size>
+        struct multiplication {
+            static constexpr int low_size = Size/2;
+            static constexpr int high_size = Size-low_size;
+
+            using karatsuba = std::integral_constant<bool, (Size>karatsuba_threshold)>;
+
+            // product[0..2*Size) = multiplier*multiplicand, where product is zero on entry
+            static SG14_RELAXED_CONSTEXPR void full(limb* product, const limb* multiplier, const limb* multiplicand)
+            {
+                full(product, multiplier, multiplicand, karatsuba{});
+            }
+
+            // product[0..Size) = the low Size limbs of multiplier*multiplicand, where product is zero on entry
+            static SG14_RELAXED_CONSTEXPR void low(limb* product, const limb* multiplier, const limb* multiplicand)
+            {
+                low(product, multiplier, multiplicand, karatsuba{});
+            }
+
+        private:
+            static SG14_RELAXED_CONSTEXPR void full(
+                    limb* product, const limb* multiplier, const limb* multiplicand, std::false_type)
+            {
+                schoolbook<Size, Size>::full(product, multiplier, multiplicand);
+            }
+
+            static SG14_RELAXED_CONSTEXPR void low(
+                    limb* product, const limb* multiplier, const limb* multiplicand, std::false_type)
+            {
+                schoolbook<Size, Size>::low(product, multiplier, multiplicand);
+            }
+
+            // the low limbs of a value zero-extended to high_size limbs
+            static SG14_RELAXED_CONSTEXPR void extend(limb* extended, const limb* value)
+            {
+                for (auto index = 0; index!=low_size; ++index) {
+                    extended[index] = value[index];
+                }
+            }
+
+            // difference[0..high_size) = |minuend-subtrahend|; returns true iff minuend<subtrahend
+            static SG14_RELAXED_CONSTEXPR bool absolute_difference(
+                    limb* difference, const limb* minuend, const limb* subtrahend)
+            {
+                auto negative = compare(minuend, subtrahend, high_size)<0;
+                if (negative) {
+                    subtract(difference, subtrahend, minuend, high_size);
+                }
+                else {
+                    subtract(difference, minuend, subtrahend, high_size);
+                }
+                return negative;
+            }
+
+            // with operands split into high and low halves,
+            // the middle term, high*low'+low*high', is low*low'+high*high'+(high-low)*(low'-high')
+            // so three half-size multiplications are performed rather than four
+            static SG14_RELAXED_CONSTEXPR void full(
+                    limb* product, const limb* multiplier, const limb* multiplicand, std::true_type)
+            {
+                multiplication<low_size>::full(product, multiplier, multiplicand);
+                multiplication<high_size>::full(product+2*low_size, multiplier+low_size, multiplicand+low_size);
+
+                limb multiplier_low[high_size] = {};
+                limb multiplicand_low[high_size] = {};
+                extend(multiplier_low, multiplier);
+                extend(multiplicand_low, multiplicand);
+
+                limb multiplier_difference[high_size] = {};
+                limb multiplicand_difference[high_size] = {};
+                auto negative = absolute_difference(multiplier_difference, multiplier+low_size, multiplier_low)
+                        !=absolute_difference(multiplicand_difference, multiplicand_low, multiplicand+low_size);
+
+                limb difference_product[2*high_size] = {};
+                multiplication<high_size>::full(difference_product, multiplier_difference, multiplicand_difference);
+
+                limb middle[2*high_size+1] = {};
+                accumulate(middle, 2*high_size+1, product+2*low_size, 2*high_size);
+                accumulate(middle, 2*high_size+1, product, 2*low_size);
+                if (negative) {
+                    middle[2*high_size] -= subtract(middle, middle, difference_product, 2*high_size);
+                }
+                else {
+                    accumulate(middle, 2*high_size+1, difference_product, 2*high_size);
+                }
+
+                accumulate(product+low_size, 2*Size-low_size, middle, 2*high_size+1);
+            }
+
+            // only the low half of the middle term contributes to the low half of the product
+            static SG14_RELAXED_CONSTEXPR void low(
+                    limb* product, const limb* multiplier, const limb* multiplicand, std::true_type)
+            {
+                multiplication<low_size>::full(product, multiplier, multiplicand);
+
+                // and when Size is odd, so does the low limb of high*high'
+                if (Size%2) {
+                    product[Size-1] = multiplier[low_size]*multiplicand[low_size];
+                }
+
+                limb multiplier_low[high_size] = {};
+                limb multiplicand_low[high_size] = {};
+                extend(multiplier_low, multiplier);
+                extend(multiplicand_low, multiplicand);
+
+                limb middle[high_size] = {};
+                multiplication<high_size>::low(middle, multiplier+low_size, multiplicand_low);
+                accumulate(product+low_size, high_size, middle, high_size);
+
+                limb other_middle[high_size] = {};
+                multiplication<high_size>::low(other_middle, multiplier_low, multiplicand+low_size);
+                accumulate(product+low_size, high_size, other_middle, high_size);
+            }
+        };
+
+        // product[0..Size) = the low Size limbs of multiplier*multiplicand, where product is zero on entry
+        template<int Size>
+        SG14_RELAXED_CONSTEXPR void multiply_low(
+                limb* product, const limb* multiplier, const limb* multiplicand, bool, std::false_type)
+        {
+            multiplication<Size>::low(product, multiplier, multiplicand);
+        }
+
+        // whether the high half of a value only extends its low half
+        template<int Size>
+        SG14_RELAXED_CONSTEXPR bool is_narrow(const limb* value, bool is_signed)
+        {
+            auto fill = (is_signed && (value[Size/2-1] & sign_bit)) ? limb_max : limb{0};
+            for (auto index = Size/2; index!=Size; ++index) {
+                if (value[index]!=fill) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // values whose high halves are zero or extend the sign, such as those widened by fixed_point multiplication,
+        // need only the full product of their low halves, less each low half which the other's sign multiplies
+        template<int Size>
+        SG14_RELAXED_CONSTEXPR void multiply_low(
+                limb* product, const limb* multiplier, const limb* multiplicand, bool is_signed, std::true_type)
+        {
+            constexpr auto half = Size/2;
+            if (!is_narrow<Size>(multiplier, is_signed) || !is_narrow<Size>(multiplicand, is_signed)) {
+                multiplication<Size>::low(product, multiplier, multiplicand);
+                return;
+            }
+
+            multiplication<half>::full(product, multiplier, multiplicand);
+            if (is_signed && (multiplier[half-1] & sign_bit)) {
+                subtract(product+half, product+half, multiplicand, half);
+            }
+            if (is_signed && (multiplicand[half-1] & sign_bit)) {
+                subtract(product+half, product+half, multiplier, half);
+            }
+        }
+
+        template<int Size>
+        SG14_RELAXED_CONSTEXPR void multiply_low(
+                limb* product, const limb* multiplier, const limb* multiplicand, bool is_signed)
+        {
+            multiply_low<Size>(product, multiplier, multiplicand, is_signed,
+                    std::integral_constant<bool, (Size%2==0)>{});
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_wide_integer_impl::divide - long division of Size-limb unsigned values
+
+        // quotient[0..Size) and remainder[0..Size) of dividend and non-zero divisor,
+        // using Knuth's Algorithm D, where quotient and remainder are zero on entry
+        template<int Size>
+        SG14_RELAXED_CONSTEXPR void divide(limb* quotient, limb* remainder, const limb* dividend, const limb* divisor)
+        {
+            auto dividend_size = significant_limbs(dividend, Size);
+            auto divisor_size = significant_limbs(divisor, Size);
+            if (dividend_size<divisor_size
+                || (dividend_size==divisor_size && compare(dividend, divisor, divisor_size)<0)) {
+                for (auto index = 0; index!=dividend_size; ++index) {
+                    remainder[index] = dividend[index];
+                }
+                return;
+            }
+
+            if (divisor_size<=1) {
+                limb partial_remainder = 0;
+                for (auto index = dividend_size; index--;) {
+                    auto division = _wide_integer_impl::divide(partial_remainder, dividend[index], divisor[0]);
+                    quotient[index] = division.quotient;
+                    partial_remainder = division.remainder;
+                }
+                remainder[0] = partial_remainder;
+                return;
+            }
+
+            // normalize so that the top bit of the divisor is set and quotient limbs are estimated to within two;
+            // bits shifted out of a limb are shifted right in two steps so that a shift of zero is well-defined
+            auto shift = _impl::count_leading_zeros(divisor[divisor_size-1]);
+            limb normalized_divisor[Size] = {};
+            for (auto index = divisor_size; --index;) {
+                normalized_divisor[index] = (divisor[index] << shift)
+                        | (divisor[index-1] >> 1 >> (limb_width-1-shift));
+            }
+            normalized_divisor[0] = divisor[0] << shift;
+            limb normalized_dividend[Size+1] = {};
+            normalized_dividend[dividend_size] = dividend[dividend_size-1] >> 1 >> (limb_width-1-shift);
+            for (auto index = dividend_size; --index;) {
+                normalized_dividend[index] = (dividend[index] << shift)
+                        | (dividend[index-1] >> 1 >> (limb_width-1-shift));
+            }
+            normalized_dividend[0] = dividend[0] << shift;
+
+            auto top = normalized_divisor[divisor_size-1];
+            auto next = normalized_divisor[divisor_size-2];
+            for (auto position = dividend_size-divisor_size; position>=0; --position) {
+                auto window = normalized_dividend+position;
+
+                // estimate the quotient limb from the top two limbs of the partial remainder
+                auto estimate = limb_max;
+                auto estimate_remainder = window[divisor_size-1]+top;
+                auto overflow = estimate_remainder<top;
+                if (window[divisor_size]<top) {
+                    auto division = _wide_integer_impl::divide(window[divisor_size], window[divisor_size-1], top);
+                    estimate = division.quotient;
+                    estimate_remainder = division.remainder;
+                    overflow = false;
+                }
+                while (!overflow) {
+                    auto product = multiply(estimate, next);
+                    if (product.high<estimate_remainder
+                        || (product.high==estimate_remainder && product.low<=window[divisor_size-2])) {
+                        break;
+                    }
+                    --estimate;
+                    estimate_remainder += top;
+                    overflow = estimate_remainder<top;
+                }
+
+                // subtract the multiple of the divisor
+                limb carry = 0;
+                limb borrow = 0;
+                for (auto index = 0; index!=divisor_size; ++index) {
+                    limb product = 0;
+                    carry = multiply_add(product, estimate, normalized_divisor[index], carry);
+                    auto partial = window[index]-borrow;
+                    borrow = partial>window[index];
+                    window[index] = partial-product;
+                    borrow += window[index]>partial;
+                }
+                auto partial = window[divisor_size]-borrow;
+                borrow = partial>window[divisor_size];
+                window[divisor_size] = partial-carry;
+                borrow += window[divisor_size]>partial;
+
+                // the estimate was one too great
+                if (borrow) {
+                    --estimate;
+                    window[divisor_size] += add(window, window, normalized_divisor, divisor_size);
+                }
+
+                quotient[position] = estimate;
+            }
+
+            // the remainder is less than the divisor and so occupies no more than divisor_size limbs
+            for (auto index = 0; index!=divisor_size; ++index) {
+                remainder[index] = (normalized_dividend[index] >> shift)
+                        | (normalized_dividend[index+1] << 1 << (limb_width-1-shift));
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::wide_integer
+
+    /// \brief a fixed-width integer of any multiple of 64 bits, stored in an array of 64-bit limbs
+    ///
+    /// \tparam Bits the width of the integer, including any sign bit
+    /// \tparam Signedness `signed` for a two's complement integer or `unsigned` for an unsigned integer
+    ///
+    /// \note Like the built-in integers, \ref wide_integer is trivially copyable, never allocates memory
+    /// and wraps on overflow. Construction from built-in integers is constexpr; arithmetic, comparison of
+    /// order and conversion to and from floating-point types are constexpr from C++14 onwards.
+    /// Products of up to 512 bits are calculated by unrolled long multiplication and wider products
+    /// using Karatsuba's method.
+    ///
+    /// \par Example
+    ///
+    /// A 256-bit value with 128 fractional bits:
+    /// \snippet snippets.cpp define a fixed_point value with a wide_integer rep
+
+    template<_width_type Bits, class Signedness = signed>
+    class wide_integer {
+        static_assert(Bits>0 && Bits%_wide_integer_impl::limb_width==0,
+                "the width of wide_integer must be a multiple of 64 bits");
+        static_assert(std::is_integral<Signedness>::value, "Signedness must be signed or unsigned");
+
+        using limb = _wide_integer_impl::limb;
+
+        template<_width_type, class>
+        friend class wide_integer;
+
+    public:
+        /// the number of 64-bit limbs in which the value is stored
+        static constexpr int num_limbs = static_cast<int>(Bits/_wide_integer_impl::limb_width);
+
+        /// true iff the integer is signed
+        static constexpr bool is_signed = std::is_signed<Signedness>::value;
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // functions
+
+        /// default constructor; like a built-in integer, the value is uninitialized
+        wide_integer() = default;
+
+        /// constructor taking a built-in integer
+        template<class Integer, typename std::enable_if<
+                is_integral<Integer>::value && !_wide_integer_impl::is_wide_integer<Integer>::value,
+                int>::type Dummy = 0>
+        constexpr wide_integer(const Integer& value)
+                : wide_integer(value, typename _impl::make_index_sequence<num_limbs>::type{})
+        {
+        }
+
+        /// constructor taking a narrower wide_integer
+        template<_width_type FromBits, class FromSignedness, typename std::enable_if<
+                (FromBits<Bits),
+                int>::type Dummy = 0>
+        constexpr wide_integer(const wide_integer<FromBits, FromSignedness>& value)
+                : wide_integer(value, typename _impl::make_index_sequence<num_limbs>::type{})
+        {
+        }
+
+        /// constructor taking a wide_integer of the same or greater width; the high bits are discarded
+        template<_width_type FromBits, class FromSignedness, typename std::enable_if<
+                !(FromBits<Bits) && !std::is_same<wide_integer<FromBits, FromSignedness>, wide_integer>::value,
+                int>::type Dummy = 0>
+        explicit constexpr wide_integer(const wide_integer<FromBits, FromSignedness>& value)
+                : wide_integer(value, typename _impl::make_index_sequence<num_limbs>::type{})
+        {
+        }
+
+        /// constructor taking a floating-point value, which is truncated toward zero
+        template<class Float, typename std::enable_if<std::is_floating_point<Float>::value, int>::type Dummy = 0>
+        explicit SG14_RELAXED_CONSTEXPR wide_integer(Float value)
+                : _limbs{}
+        {
+            constexpr auto radix = _wide_integer_impl::radix<Float>();
+
+            // scale the magnitude down to below 2^64, exactly, and then peel off one limb at a time;
+            // as with built-in integers, values which are out of range are undefined
+            auto scaled = (value<0) ? -value : value;
+            auto top = 0;
+            for (; scaled>=radix && top!=num_limbs-1; ++top) {
+                scaled /= radix;
+            }
+            for (auto index = top; index>=0; --index) {
+                auto digit = static_cast<limb>(scaled);
+                _limbs[index] = digit;
+                scaled = (scaled-static_cast<Float>(digit))*radix;
+            }
+            if (value<0) {
+                _wide_integer_impl::negate(_limbs, num_limbs);
+            }
+        }
+
+        /// constructor taking the top limb and the limb with which the rest are filled
+        constexpr wide_integer(_wide_integer_impl::fill_tag, limb top, limb fill)
+                : wide_integer(top, fill, typename _impl::make_index_sequence<num_limbs>::type{})
+        {
+        }
+
+        /// returns the low bits of the value as a built-in integer
+        template<class Integer, typename std::enable_if<
+                is_integral<Integer>::value && !_wide_integer_impl::is_wide_integer<Integer>::value
+                        && !std::is_same<Integer, bool>::value,
+                int>::type Dummy = 0>
+        explicit constexpr operator Integer() const
+        {
+            return static_cast<Integer>(_wide_integer_impl::limbs_to_integer<typename make_unsigned<Integer>::type>(
+                    _limbs, num_limbs));
+        }
+
+        /// returns the value as a floating-point type, rounded
+        template<class Float, typename std::enable_if<std::is_floating_point<Float>::value, int>::type Dummy = 0>
+        explicit SG14_RELAXED_CONSTEXPR operator Float() const
+        {
+            auto magnitude = is_negative() ? -*this : *this;
+            auto result = Float{0};
+            for (auto index = num_limbs; index--;) {
+                result = result*_wide_integer_impl::radix<Float>()+static_cast<Float>(magnitude._limbs[index]);
+            }
+            return is_negative() ? -result : result;
+        }
+
+        /// returns non-zeroness represented as boolean
+        explicit constexpr operator bool() const
+        {
+            return _wide_integer_impl::any(_limbs, num_limbs);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // arithmetic
+
+        SG14_RELAXED_CONSTEXPR wide_integer& operator+=(const wide_integer& rhs)
+        {
+            _wide_integer_impl::add(_limbs, _limbs, rhs._limbs, num_limbs);
+            return *this;
+        }
+
+        SG14_RELAXED_CONSTEXPR wide_integer& operator-=(const wide_integer& rhs)
+        {
+            _wide_integer_impl::subtract(_limbs, _limbs, rhs._limbs, num_limbs);
+            return *this;
+        }
+
+        SG14_RELAXED_CONSTEXPR wide_integer& operator*=(const wide_integer& rhs)
+        {
+            // the low limbs of the product of two's complement values are those of the unsigned product
+            limb product[num_limbs] = {};
+            _wide_integer_impl::multiply_low<num_limbs>(product, _limbs, rhs._limbs, is_signed);
+            for (auto index = 0; index!=num_limbs; ++index) {
+                _limbs[index] = product[index];
+            }
+            return *this;
+        }
+
+        SG14_RELAXED_CONSTEXPR wide_integer& operator/=(const wide_integer& rhs)
+        {
+            return *this = divide(*this, rhs, false);
+        }
+
+        SG14_RELAXED_CONSTEXPR wide_integer& operator%=(const wide_integer& rhs)
+        {
+            return *this = divide(*this, rhs, true);
+        }
+
+        SG14_RELAXED_CONSTEXPR wide_integer& operator&=(const wide_integer& rhs)
+        {
+            for (auto index = 0; index!=num_limbs; ++index) {
+                _limbs[index] &= rhs._limbs[index];
+            }
+            return *this;
+        }
+
+        SG14_RELAXED_CONSTEXPR wide_integer& operator|=(const wide_integer& rhs)
+        {
+            for (auto index = 0; index!=num_limbs; ++index) {
+                _limbs[index] |= rhs._limbs[index];
+            }
+            return *this;
+        }
+
+        SG14_RELAXED_CONSTEXPR wide_integer& operator^=(const wide_integer& rhs)
+        {
+            for (auto index = 0; index!=num_limbs; ++index) {
+                _limbs[index] ^= rhs._limbs[index];
+            }
+            return *this;
+        }
+
+        /// shifts left; the shift must be less than the width of the integer
+        SG14_RELAXED_CONSTEXPR wide_integer& operator<<=(int shift)
+        {
+            _wide_integer_impl::shift_left(_limbs, _limbs, num_limbs, shift);
+            return *this;
+        }
+
+        /// shifts right, extending the sign of signed values; the shift must be less than the width of the integer
+        SG14_RELAXED_CONSTEXPR wide_integer& operator>>=(int shift)
+        {
+            _wide_integer_impl::shift_right(_limbs, _limbs, num_limbs, shift,
+                    is_negative() ? _wide_integer_impl::limb_max : limb{0});
+            return *this;
+        }
+
+        SG14_RELAXED_CONSTEXPR wide_integer& operator++()
+        {
+            return *this += 1;
+        }
+
+        SG14_RELAXED_CONSTEXPR wide_integer& operator--()
+        {
+            return *this -= 1;
+        }
+
+        SG14_RELAXED_CONSTEXPR wide_integer operator++(int)
+        {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        SG14_RELAXED_CONSTEXPR wide_integer operator--(int)
+        {
+            auto previous = *this;
+            --*this;
+            return previous;
+        }
+
+        // the operators are found by argument-dependent lookup
+        // and built-in integer operands are converted implicitly, as they are between built-in integers
+
+        friend SG14_RELAXED_CONSTEXPR wide_integer operator-(wide_integer rhs)
+        {
+            _wide_integer_impl::negate(rhs._limbs, num_limbs);
+            return rhs;
+        }
+
+        friend constexpr wide_integer operator+(const wide_integer& rhs)
+        {
+            return rhs;
+        }
+
+        friend SG14_RELAXED_CONSTEXPR wide_integer operator~(wide_integer rhs)
+        {
+            for (auto& bits : rhs._limbs) {
+                bits = ~bits;
+            }
+            return rhs;
+        }
+
+        friend SG14_RELAXED_CONSTEXPR wide_integer operator+(wide_integer lhs, const wide_integer& rhs)
+        {
+            return lhs += rhs;
+        }
+
+        friend SG14_RELAXED_CONSTEXPR wide_integer operator-(wide_integer lhs, const wide_integer& rhs)
+        {
+            return lhs -= rhs;
+        }
+
+        friend SG14_RELAXED_CONSTEXPR wide_integer operator*(wide_integer lhs, const wide_integer& rhs)
+        {
+            return lhs *= rhs;
+        }
+
+        friend SG14_RELAXED_CONSTEXPR wide_integer operator/(const wide_integer& lhs, const wide_integer& rhs)
+        {
+            return divide(lhs, rhs, false);
+        }
+
+        friend SG14_RELAXED_CONSTEXPR wide_integer operator%(const wide_integer& lhs, const wide_integer& rhs)
+        {
+            return divide(lhs, rhs, true);
+        }
+
+        friend SG14_RELAXED_CONSTEXPR wide_integer operator&(wide_integer lhs, const wide_integer& rhs)
+        {
+            return lhs &= rhs;
+        }
+
+        friend SG14_RELAXED_CONSTEXPR wide_integer operator|(wide_integer lhs, const wide_integer& rhs)
+        {
+            return lhs |= rhs;
+        }
+
+        friend SG14_RELAXED_CONSTEXPR wide_integer operator^(wide_integer lhs, const wide_integer& rhs)
+        {
+            return lhs ^= rhs;
+        }
+
+        friend SG14_RELAXED_CONSTEXPR wide_integer operator<<(wide_integer lhs, int rhs)
+        {
+            return lhs <<= rhs;
+        }
+
+        friend SG14_RELAXED_CONSTEXPR wide_integer operator>>(wide_integer lhs, int rhs)
+        {
+            return lhs >>= rhs;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // comparison
+
+        friend constexpr bool operator==(const wide_integer& lhs, const wide_integer& rhs)
+        {
+            return _wide_integer_impl::equal(lhs._limbs, rhs._limbs, num_limbs);
+        }
+
+        friend constexpr bool operator!=(const wide_integer& lhs, const wide_integer& rhs)
+        {
+            return !(lhs==rhs);
+        }
+
+        friend constexpr bool operator<(const wide_integer& lhs, const wide_integer& rhs)
+        {
+            return _wide_integer_impl::less(lhs._limbs, rhs._limbs, num_limbs,
+                    is_signed ? _wide_integer_impl::sign_bit : limb{0});
+        }
+
+        friend constexpr bool operator>(const wide_integer& lhs, const wide_integer& rhs)
+        {
+            return rhs<lhs;
+        }
+
+        friend constexpr bool operator<=(const wide_integer& lhs, const wide_integer& rhs)
+        {
+            return !(rhs<lhs);
+        }
+
+        friend constexpr bool operator>=(const wide_integer& lhs, const wide_integer& rhs)
+        {
+            return !(lhs<rhs);
+        }
+
+    private:
+        template<class Integer, int ... Indices>
+        constexpr wide_integer(const Integer& value, _impl::index_sequence<Indices...>)
+                : _limbs{_wide_integer_impl::integer_limb(value, Indices)...}
+        {
+        }
+
+        template<_width_type FromBits, class FromSignedness, int ... Indices>
+        constexpr wide_integer(const wide_integer<FromBits, FromSignedness>& value,
+                _impl::index_sequence<Indices...>)
+                : _limbs{((Indices<wide_integer<FromBits, FromSignedness>::num_limbs) ? value._limbs[Indices]
+                        : value.is_negative() ? _wide_integer_impl::limb_max : limb{0})...}
+        {
+        }
+
+        template<int ... Indices>
+        constexpr wide_integer(limb top, limb fill, _impl::index_sequence<Indices...>)
+                : _limbs{((Indices==num_limbs-1) ? top : fill)...}
+        {
+        }
+
+        constexpr bool is_negative() const
+        {
+            return is_signed && (_limbs[num_limbs-1] & _wide_integer_impl::sign_bit);
+        }
+
+        // the quotient or remainder of division, truncated toward zero, as for built-in integers
+        static SG14_RELAXED_CONSTEXPR wide_integer divide(const wide_integer& lhs, const wide_integer& rhs, bool remainder)
+        {
+            auto dividend = lhs.is_negative() ? -lhs : lhs;
+            auto divisor = rhs.is_negative() ? -rhs : rhs;
+            wide_integer quotient = 0;
+            wide_integer modulus = 0;
+            _wide_integer_impl::divide<num_limbs>(quotient._limbs, modulus._limbs, dividend._limbs, divisor._limbs);
+            return remainder
+                   ? (lhs.is_negative() ? -modulus : modulus)
+                   : (lhs.is_negative()!=rhs.is_negative() ? -quotient : quotient);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // variables
+
+        limb _limbs[num_limbs];
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////////////////////////////////
+    // type trait specializations of sg14::wide_integer
+    //
+    // These are the definitions needed to use sg14::wide_integer as the Rep of sg14::fixed_point
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::is_signed
+
+    template<_width_type Bits, class Signedness>
+    struct is_signed<wide_integer<Bits, Signedness>> : std::is_signed<Signedness> {
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::is_unsigned
+
+    template<_width_type Bits, class Signedness>
+    struct is_unsigned<wide_integer<Bits, Signedness>> : std::is_unsigned<Signedness> {
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::make_signed
+
+    template<_width_type Bits, class Signedness>
+    struct make_signed<wide_integer<Bits, Signedness>> {
+        using type = wide_integer<Bits, signed>;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::make_unsigned
+
+    template<_width_type Bits, class Signedness>
+    struct make_unsigned<wide_integer<Bits, Signedness>> {
+        using type = wide_integer<Bits, unsigned>;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::is_integral
+
+    template<_width_type Bits, class Signedness>
+    struct is_integral<wide_integer<Bits, Signedness>> : std::true_type {
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::set_width
+
+    // rounds up to a whole number of limbs
+    template<_width_type Bits, class Signedness, _width_type MinNumBits>
+    struct set_width<wide_integer<Bits, Signedness>, MinNumBits> {
+        using type = wide_integer<_wide_integer_impl::round_up_width(MinNumBits), Signedness>;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sg14::width
+
+    template<_width_type Bits, class Signedness>
+    struct width<wide_integer<Bits, Signedness>> : std::integral_constant<_width_type, Bits> {
+    };
+}
+
+namespace std {
+    ////////////////////////////////////////////////////////////////////////////////
+    // std::numeric_limits<sg14::wide_integer>
+
+    template<sg14::_width_type Bits, class Signedness>
+    struct numeric_limits<sg14::wide_integer<Bits, Signedness>>
+            : numeric_limits<typename std::conditional<std::is_signed<Signedness>::value, long long, unsigned long long>::type> {
+        using _value_type = sg14::wide_integer<Bits, Signedness>;
+        using _fill = sg14::_wide_integer_impl::fill_tag;
+
+        static constexpr int digits = static_cast<int>(Bits)-std::is_signed<Signedness>::value;
+        static constexpr int digits10 = static_cast<int>(digits*30103LL/100000);
+
+        static constexpr _value_type min()
+        {
+            return std::is_signed<Signedness>::value
+                   ? _value_type(_fill{}, sg14::_wide_integer_impl::sign_bit, 0)
+                   : _value_type(_fill{}, 0, 0);
+        }
+
+        static constexpr _value_type max()
+        {
+            return std::is_signed<Signedness>::value
+                   ? _value_type(_fill{}, ~sg14::_wide_integer_impl::sign_bit, sg14::_wide_integer_impl::limb_max)
+                   : _value_type(_fill{}, sg14::_wide_integer_impl::limb_max, sg14::_wide_integer_impl::limb_max);
+        }
+
+        static constexpr _value_type lowest()
+        {
+            return min();
+        }
+    };
+}
+
+#endif  // SG14_WIDE_INTEGER_H
@@ -9,6 +9,9 @@
 #if !defined(SG14_COMMON_H)
 #define SG14_COMMON_H 1
 
+#include "../type_traits.h"
+
+#include <cstdint>
 #include <limits>
 
 namespace sg14 {
@@ -31,6 +34,51 @@ namespace sg14 {
             return (a<b) ? a : b;
         }
 
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_impl::count_leading_zeros - number of leading zero bits in a 64-bit value
+
+        // portable fallback: binary search over the lowest Bits bits of n
+        constexpr int count_leading_zeros(std::uint64_t n, int bits)
+        {
+            return (bits==1)
+                   ? 1-static_cast<int>(n)
+                   : (n >> (bits/2))
+                     ? count_leading_zeros(n >> (bits/2), bits-bits/2)
+                     : bits-bits/2+count_leading_zeros(n, bits/2);
+        }
+
+        constexpr int count_leading_zeros(std::uint64_t n)
+        {
+#if defined(__GNUG__) || defined(__clang__)
+            return n ? __builtin_clzll(n) : 64;
+#else
+            return count_leading_zeros(n, 64);
+#endif
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_impl::floor_log2 and sg14::_impl::ceil_log2 - integer logarithms
+
+        // exponent of the largest power of two which is not greater than n, where n is positive
+        constexpr int floor_log2(std::uint64_t n)
+        {
+            return 63-count_leading_zeros(n);
+        }
+
+        // exponent of the smallest power of two which is not less than n;
+        // also the number of digits by which a sum of n terms can exceed its largest term
+        constexpr int ceil_log2(std::uint64_t n)
+        {
+            return (n<=1) ? 0 : 64-count_leading_zeros(n-1);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_impl::signed_rep
+
+        // the narrowest signed built-in integer with at least the given number of digits
+        template<int Digits>
+        using signed_rep = set_width_t<std::int64_t, Digits+1>;
+
         ////////////////////////////////////////////////////////////////////////////////
         // sg14::_impl::common_type_t
 
@@ -58,6 +106,39 @@ namespace sg14 {
                 std::numeric_limits<T>::is_integer || std::is_floating_point<T>::value> {
         };
 
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_impl::index_sequence - C++11 equivalent of std::index_sequence
+
+        template<int... Indices>
+        struct index_sequence {
+        };
+
+        template<class Lhs, class Rhs>
+        struct concat_sequence;
+
+        template<int... LhsIndices, int... RhsIndices>
+        struct concat_sequence<index_sequence<LhsIndices...>, index_sequence<RhsIndices...>> {
+            using type = index_sequence<LhsIndices..., (sizeof...(LhsIndices)+RhsIndices)...>;
+        };
+
+        // halves the sequence at each step to keep instantiation depth logarithmic
+        template<int Size>
+        struct make_index_sequence
+                : concat_sequence<
+                        typename make_index_sequence<Size/2>::type,
+                        typename make_index_sequence<Size-Size/2>::type> {
+        };
+
+        template<>
+        struct make_index_sequence<0> {
+            using type = index_sequence<>;
+        };
+
+        template<>
+        struct make_index_sequence<1> {
+            using type = index_sequence<0>;
+        };
+
         ////////////////////////////////////////////////////////////////////////////////
         ////////////////////////////////////////////////////////////////////////////////
         // operator helpers
@@ -75,6 +156,10 @@ namespace sg14 {
 
         struct divide_tag;
 
+        struct shift_left_tag;
+
+        struct shift_right_tag;
+
         ////////////////////////////////////////////////////////////////////////////////
         // sg14::_impl::op
 
@@ -121,6 +206,22 @@ namespace sg14 {
             }
         };
 
+        template<class Lhs, class Rhs>
+        struct op<shift_left_tag, Lhs, Rhs> {
+            constexpr auto operator()(const Lhs& lhs, const Rhs& rhs) const -> decltype(lhs << rhs)
+            {
+                return lhs << rhs;
+            }
+        };
+
+        template<class Lhs, class Rhs>
+        struct op<shift_right_tag, Lhs, Rhs> {
+            constexpr auto operator()(const Lhs& lhs, const Rhs& rhs) const -> decltype(lhs >> rhs)
+            {
+                return lhs >> rhs;
+            }
+        };
+
         ////////////////////////////////////////////////////////////////////////////////
         // sg14::_impl::rep_op_fn
 
@@ -44,4 +44,57 @@ using SG14_UINT128 = unsigned __int128;
 #define SG14_EXCEPTIONS_ENABLED
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+// SG14_OVERFLOW_BUILTINS_ENABLED macro definition
+
+#if defined(SG14_OVERFLOW_BUILTINS_ENABLED)
+#error SG14_OVERFLOW_BUILTINS_ENABLED already defined
+#endif
+
+// GCC 7 and above detect overflow of integer arithmetic, including in constant expressions,
+// with __builtin_add_overflow_p, __builtin_sub_overflow_p and __builtin_mul_overflow_p;
+// Clang detects it with __builtin_add_overflow, __builtin_sub_overflow and __builtin_mul_overflow,
+// which store the result in a variable and so can only be used in constant expressions from C++14 onwards
+#if defined(__clang__)
+#if defined(__has_builtin) && (__cplusplus >= 201402L)
+#if __has_builtin(__builtin_add_overflow) && __has_builtin(__builtin_sub_overflow) && __has_builtin(__builtin_mul_overflow)
+#define SG14_OVERFLOW_BUILTINS_ENABLED
+#endif
+#endif
+#elif defined(__GNUG__) && (__GNUC__>=7)
+#define SG14_OVERFLOW_BUILTINS_ENABLED
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// SG14_IS_CONSTANT_EVALUATED_ENABLED macro definition
+
+#if defined(SG14_IS_CONSTANT_EVALUATED_ENABLED)
+#error SG14_IS_CONSTANT_EVALUATED_ENABLED already defined
+#endif
+
+// GCC 9 and above and Clang 9 and above tell whether a function is being evaluated in a constant expression
+// with __builtin_is_constant_evaluated in any language mode
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define SG14_IS_CONSTANT_EVALUATED_ENABLED
+#endif
+#elif defined(__GNUG__) && !defined(__clang__) && (__GNUC__>=9)
+#define SG14_IS_CONSTANT_EVALUATED_ENABLED
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// SG14_RELAXED_CONSTEXPR macro definition
+
+#if defined(SG14_RELAXED_CONSTEXPR)
+#error SG14_RELAXED_CONSTEXPR already defined
+#endif
+
+// functions containing loops, local variables and assignments can be constexpr from C++14 onwards;
+// before then, they are inline
+#if (__cplusplus >= 201402L)
+#define SG14_RELAXED_CONSTEXPR constexpr
+#else
+#define SG14_RELAXED_CONSTEXPR inline
+#endif
+
 #endif // SG14_CONFIG_H
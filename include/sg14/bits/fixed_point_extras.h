@@ -13,6 +13,7 @@
 #define SG14_FIXED_POINT_EXTRAS_H 1
 
 #include <cmath>
+#include <cstdint>
 #include <istream>
 #include <limits>
 
@@ -71,72 +72,311 @@ namespace sg14 {
         {
             return sqrt_solve3<Rep>(n, sqrt_bit<Rep>(n), Rep{0});
         }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // fast integer square root
+        //
+        // The operand is shifted left by an even number of bits so that it lies in [2^62, 2^64).
+        // Linear interpolation in a table indexed by its top nine bits seeds h, 1/(2*sqrt(n)),
+        // to within 2^-17 and the root is estimated as g = 2*n*h. A Newton-Raphson iteration,
+        // g*(1+(1/2-g*h)), doubles the precision of g; operands of up to 32 bits need no iteration.
+        // Shifted back, the estimate is within one of the result. An operand of up to 128 bits
+        // extends the root of its upper half by a single Newton step whose division is of 64 bits.
+
+        // 1/(2*sqrt(n)) over each interval, [i/512, (i+1)/512), in [1/4, 1) as a line
+        // from base, Q0.32, falling by slope, Q0.24, with the least relative error
+        template<class Dummy = void>
+        struct rsqrt_seeds {
+            static constexpr std::uint32_t base[384] = {
+                    0xffffd077, 0xff014ee5, 0xfe05be89, 0xfd0d10fc, 0xfc17383a, 0xfb24269c, 0xfa33ced8, 0xf94623fa,
+                    0xf85b1967, 0xf772a2d3, 0xf68cb445, 0xf5a94210, 0xf4c840d0, 0xf3e9a56d, 0xf30d6513, 0xf2337532,
+                    0xf15bcb7d, 0xf0865de6, 0xefb3229c, 0xeee2100b, 0xee131cd9, 0xed463fe5, 0xec7b7042, 0xebb2a53b,
+                    0xeaebd64e, 0xea26fb28, 0xe9640baa, 0xe8a2ffe3, 0xe7e3d00f, 0xe7267497, 0xe66ae60e, 0xe5b11d32,
+                    0xe4f912eb, 0xe442c045, 0xe38e1e75, 0xe2db26d5, 0xe229d2e5, 0xe17a1c44, 0xe0cbfcb8, 0xe01f6e26,
+                    0xdf746a94, 0xdecaec28, 0xde22ed27, 0xdd7c67f4, 0xdcd7570f, 0xdc33b514, 0xdb917cbd, 0xdaf0a8dd,
+                    0xda513461, 0xd9b31a52, 0xd91655d0, 0xd87ae214, 0xd7e0ba6f, 0xd747da4a, 0xd6b03d22, 0xd619de8e,
+                    0xd584ba36, 0xd4f0cbdc, 0xd45e0f52, 0xd3cc8081, 0xd33c1b64, 0xd2acdc0a, 0xd21ebe93, 0xd191bf35,
+                    0xd105da32, 0xd07b0be3, 0xcff150ad, 0xcf68a50b, 0xcee10582, 0xce5a6eac, 0xcdd4dd2f, 0xcd504dc3,
+                    0xccccbd2b, 0xcc4a283d, 0xcbc88bd9, 0xcb47e4ef, 0xcac8307c, 0xca496b89, 0xc9cb932f, 0xc94ea491,
+                    0xc8d29cde, 0xc8577953, 0xc7dd3737, 0xc763d3de, 0xc6eb4ca7, 0xc6739efb, 0xc5fcc84f, 0xc586c623,
+                    0xc51195ff, 0xc49d3579, 0xc429a22d, 0xc3b6d9c3, 0xc344d9ec, 0xc2d3a063, 0xc2632aec, 0xc1f37753,
+                    0xc184836d, 0xc1164d19, 0xc0a8d23d, 0xc03c10c9, 0xbfd006b3, 0xbf64b1f9, 0xbefa10a4, 0xbe9020c1,
+                    0xbe26e067, 0xbdbe4db2, 0xbd5666c7, 0xbcef29d2, 0xbc889506, 0xbc22a69b, 0xbbbd5cd3, 0xbb58b5f3,
+                    0xbaf4b04a, 0xba914a29, 0xba2e81ec, 0xb9cc55f1, 0xb96ac49e, 0xb909cc60, 0xb8a96ba7, 0xb849a0ea,
+                    0xb7ea6aa6, 0xb78bc75d, 0xb72db596, 0xb6d033de, 0xb67340c6, 0xb616dae6, 0xb5bb00da, 0xb55fb141,
+                    0xb504eac2, 0xb4aaac07, 0xb450f3bf, 0xb3f7c09c, 0xb39f1158, 0xb346e4ae, 0xb2ef3960, 0xb2980e31,
+                    0xb24161eb, 0xb1eb335c, 0xb1958154, 0xb1404aa9, 0xb0eb8e35, 0xb0974ad3, 0xb0437f64, 0xaff02ace,
+                    0xaf9d4bf8, 0xaf4ae1ce, 0xaef8eb3f, 0xaea7673e, 0xae5654c0, 0xae05b2c1, 0xadb5803b, 0xad65bc30,
+                    0xad1665a3, 0xacc77b99, 0xac78fd1d, 0xac2ae93b, 0xabdd3f03, 0xab8ffd87, 0xab4323dc, 0xaaf6b11b,
+                    0xaaaaa45f, 0xaa5efcc6, 0xaa13b971, 0xa9c8d982, 0xa97e5c20, 0xa9344073, 0xa8ea85a6, 0xa8a12ae8,
+                    0xa8582f67, 0xa80f9258, 0xa7c752ee, 0xa77f7061, 0xa737e9eb, 0xa6f0bec8, 0xa6a9ee36, 0xa6637776,
+                    0xa61d59ca, 0xa5d79478, 0xa59226c6, 0xa54d0ffe, 0xa5084f6b, 0xa4c3e45a, 0xa47fce1b, 0xa43c0bfe,
+                    0xa3f89d58, 0xa3b5817d, 0xa372b7c4, 0xa3303f87, 0xa2ee1820, 0xa2ac40ec, 0xa26ab94a, 0xa2298099,
+                    0xa1e8963c, 0xa1a7f996, 0xa167aa0d, 0xa127a708, 0xa0e7efef, 0xa0a8842e, 0xa069632f, 0xa02a8c61,
+                    0x9febff33, 0x9fadbb15, 0x9f6fbf79, 0x9f320bd4, 0x9ef49f9a, 0x9eb77a42, 0x9e7a9b44, 0x9e3e021a,
+                    0x9e01ae3e, 0x9dc59f2e, 0x9d89d465, 0x9d4e4d64, 0x9d1309ab, 0x9cd808bb, 0x9c9d4a17, 0x9c62cd44,
+                    0x9c2891c7, 0x9bee9727, 0x9bb4dceb, 0x9b7b629d, 0x9b4227c7, 0x9b092bf5, 0x9ad06eb3, 0x9a97ef8f,
+                    0x9a5fae18, 0x9a27a9df, 0x99efe274, 0x99b8576a, 0x99810854, 0x9949f4c7, 0x99131c57, 0x98dc7e9d,
+                    0x98a61b2e, 0x986ff1a5, 0x983a0199, 0x98044aa7, 0x97cecc69, 0x9799867c, 0x9764787d, 0x972fa20b,
+                    0x96fb02c5, 0x96c69a4c, 0x96926840, 0x965e6c44, 0x962aa5fa, 0x95f71506, 0x95c3b90e, 0x959091b6,
+                    0x955d9ea4, 0x952adf81, 0x94f853f4, 0x94c5fba6, 0x9493d640, 0x9461e36d, 0x943022d9, 0x93fe942e,
+                    0x93cd371b, 0x939c0b4c, 0x936b106f, 0x933a4635, 0x9309ac4b, 0x92d94264, 0x92a9082f, 0x9278fd60,
+                    0x924921a8, 0x921974bb, 0x91e9f64c, 0x91baa611, 0x918b83be, 0x915c8f0a, 0x912dc7ab, 0x90ff2d59,
+                    0x90d0bfca, 0x90a27eb9, 0x907469dd, 0x904680f1, 0x9018c3af, 0x8feb31d2, 0x8fbdcb16, 0x8f908f36,
+                    0x8f637def, 0x8f3696ff, 0x8f09da24, 0x8edd471c, 0x8eb0dda5, 0x8e849d80, 0x8e58866d, 0x8e2c982c,
+                    0x8e00d27e, 0x8dd53526, 0x8da9bfe5, 0x8d7e727d, 0x8d534cb3, 0x8d284e4a, 0x8cfd7707, 0x8cd2c6ad,
+                    0x8ca83d02, 0x8c7dd9cc, 0x8c539cd2, 0x8c2985d9, 0x8bff94a9, 0x8bd5c90a, 0x8bac22c3, 0x8b82a19d,
+                    0x8b594561, 0x8b300dd9, 0x8b06face, 0x8ade0c0b, 0x8ab54159, 0x8a8c9a86, 0x8a64175b, 0x8a3bb7a5,
+                    0x8a137b31, 0x89eb61cb, 0x89c36b40, 0x899b975e, 0x8973e5f3, 0x894c56ce, 0x8924e9bd, 0x88fd9e8f,
+                    0x88d67514, 0x88af6d1c, 0x88888678, 0x8861c0f7, 0x883b1c6b, 0x881498a6, 0x87ee3578, 0x87c7f2b5,
+                    0x87a1d02f, 0x877bcdb8, 0x8755eb24, 0x87302846, 0x870a84f3, 0x86e500fd, 0x86bf9c3b, 0x869a5680,
+                    0x86752fa2, 0x86502776, 0x862b3dd3, 0x8606728d, 0x85e1c57d, 0x85bd3678, 0x8598c556, 0x857471ed,
+                    0x85503c17, 0x852c23a9, 0x8508287e, 0x84e44a6d, 0x84c0894f, 0x849ce4fe, 0x84795d53, 0x8455f227,
+                    0x8432a355, 0x840f70b6, 0x83ec5a26, 0x83c95f7f, 0x83a6809c, 0x8383bd58, 0x83611590, 0x833e891e,
+                    0x831c17e0, 0x82f9c1b1, 0x82d7866f, 0x82b565f5, 0x82936022, 0x827174d2, 0x824fa3e3, 0x822ded34,
+                    0x820c50a2, 0x81eace0b, 0x81c9654e, 0x81a8164a, 0x8186e0df, 0x8165c4ea, 0x8144c24d, 0x8123d8e6,
+                    0x81030895, 0x80e2513b, 0x80c1b2b9, 0x80a12cee, 0x8080bfbc, 0x80606b03, 0x80402ea5, 0x80200a84};
+
+            static constexpr std::uint16_t slope[384] = {
+                    0xfe82, 0xfb91, 0xf8ae, 0xf5da, 0xf312, 0xf059, 0xedac, 0xeb0b, 0xe877, 0xe5ef, 0xe373, 0xe102,
+                    0xde9c, 0xdc41, 0xd9f1, 0xd7aa, 0xd56e, 0xd33c, 0xd113, 0xcef4, 0xccde, 0xcad0, 0xc8cc, 0xc6cf,
+                    0xc4dc, 0xc2f0, 0xc10c, 0xbf30, 0xbd5c, 0xbb8f, 0xb9c9, 0xb80b, 0xb653, 0xb4a2, 0xb2f8, 0xb154,
+                    0xafb7, 0xae20, 0xac8f, 0xab04, 0xa97f, 0xa7ff, 0xa686, 0xa511, 0xa3a2, 0xa239, 0xa0d4, 0x9f75,
+                    0x9e1a, 0x9cc5, 0x9b74, 0x9a28, 0x98e0, 0x979d, 0x965f, 0x9525, 0x93ef, 0x92bd, 0x918f, 0x9065,
+                    0x8f40, 0x8e1e, 0x8d00, 0x8be5, 0x8acf, 0x89bb, 0x88ac, 0x87a0, 0x8697, 0x8592, 0x8490, 0x8391,
+                    0x8295, 0x819d, 0x80a7, 0x7fb5, 0x7ec5, 0x7dd9, 0x7cef, 0x7c08, 0x7b24, 0x7a42, 0x7964, 0x7887,
+                    0x77ae, 0x76d7, 0x7602, 0x7530, 0x7461, 0x7393, 0x72c9, 0x7200, 0x713a, 0x7076, 0x6fb4, 0x6ef4,
+                    0x6e36, 0x6d7b, 0x6cc2, 0x6c0a, 0x6b55, 0x6aa1, 0x69f0, 0x6940, 0x6893, 0x67e7, 0x673d, 0x6695,
+                    0x65ef, 0x654a, 0x64a7, 0x6406, 0x6366, 0x62c8, 0x622c, 0x6191, 0x60f8, 0x6061, 0x5fcb, 0x5f36,
+                    0x5ea3, 0x5e12, 0x5d82, 0x5cf3, 0x5c66, 0x5bda, 0x5b50, 0x5ac7, 0x5a3f, 0x59b8, 0x5933, 0x58af,
+                    0x582d, 0x57ab, 0x572b, 0x56ac, 0x562f, 0x55b2, 0x5537, 0x54bd, 0x5443, 0x53cb, 0x5355, 0x52df,
+                    0x526a, 0x51f7, 0x5184, 0x5113, 0x50a2, 0x5033, 0x4fc4, 0x4f57, 0x4eea, 0x4e7f, 0x4e14, 0x4daa,
+                    0x4d42, 0x4cda, 0x4c73, 0x4c0d, 0x4ba8, 0x4b43, 0x4ae0, 0x4a7d, 0x4a1c, 0x49bb, 0x495b, 0x48fc,
+                    0x489d, 0x483f, 0x47e3, 0x4787, 0x472b, 0x46d1, 0x4677, 0x461e, 0x45c5, 0x456e, 0x4517, 0x44c1,
+                    0x446b, 0x4416, 0x43c2, 0x436f, 0x431c, 0x42ca, 0x4278, 0x4227, 0x41d7, 0x4188, 0x4139, 0x40ea,
+                    0x409d, 0x4050, 0x4003, 0x3fb7, 0x3f6c, 0x3f21, 0x3ed7, 0x3e8d, 0x3e44, 0x3dfc, 0x3db4, 0x3d6c,
+                    0x3d25, 0x3cdf, 0x3c99, 0x3c54, 0x3c0f, 0x3bcb, 0x3b87, 0x3b44, 0x3b01, 0x3abf, 0x3a7d, 0x3a3c,
+                    0x39fb, 0x39ba, 0x397a, 0x393b, 0x38fc, 0x38bd, 0x387f, 0x3841, 0x3804, 0x37c7, 0x378b, 0x374f,
+                    0x3714, 0x36d8, 0x369e, 0x3663, 0x362a, 0x35f0, 0x35b7, 0x357e, 0x3546, 0x350e, 0x34d6, 0x349f,
+                    0x3468, 0x3432, 0x33fc, 0x33c6, 0x3391, 0x335c, 0x3327, 0x32f3, 0x32bf, 0x328c, 0x3258, 0x3225,
+                    0x31f3, 0x31c1, 0x318f, 0x315d, 0x312c, 0x30fb, 0x30ca, 0x309a, 0x306a, 0x303a, 0x300b, 0x2fdc,
+                    0x2fad, 0x2f7e, 0x2f50, 0x2f22, 0x2ef5, 0x2ec7, 0x2e9a, 0x2e6e, 0x2e41, 0x2e15, 0x2de9, 0x2dbd,
+                    0x2d92, 0x2d67, 0x2d3c, 0x2d11, 0x2ce7, 0x2cbd, 0x2c93, 0x2c69, 0x2c40, 0x2c17, 0x2bee, 0x2bc6,
+                    0x2b9d, 0x2b75, 0x2b4d, 0x2b26, 0x2afe, 0x2ad7, 0x2ab0, 0x2a8a, 0x2a63, 0x2a3d, 0x2a17, 0x29f1,
+                    0x29cc, 0x29a6, 0x2981, 0x295c, 0x2938, 0x2913, 0x28ef, 0x28cb, 0x28a7, 0x2883, 0x2860, 0x283c,
+                    0x2819, 0x27f7, 0x27d4, 0x27b1, 0x278f, 0x276d, 0x274b, 0x2729, 0x2708, 0x26e7, 0x26c6, 0x26a5,
+                    0x2684, 0x2663, 0x2643, 0x2623, 0x2602, 0x25e3, 0x25c3, 0x25a3, 0x2584, 0x2565, 0x2546, 0x2527,
+                    0x2508, 0x24ea, 0x24cb, 0x24ad, 0x248f, 0x2471, 0x2453, 0x2436, 0x2418, 0x23fb, 0x23de, 0x23c1,
+                    0x23a4, 0x2388, 0x236b, 0x234f, 0x2333, 0x2317, 0x22fb, 0x22df, 0x22c3, 0x22a8, 0x228c, 0x2271,
+                    0x2256, 0x223b, 0x2220, 0x2206, 0x21eb, 0x21d1, 0x21b7, 0x219d, 0x2183, 0x2169, 0x214f, 0x2135,
+                    0x211c, 0x2103, 0x20e9, 0x20d0, 0x20b7, 0x209f, 0x2086, 0x206d, 0x2055, 0x203c, 0x2024, 0x200c};
+        };
+
+        template<class Dummy>
+        constexpr std::uint32_t rsqrt_seeds<Dummy>::base[384];
+        template<class Dummy>
+        constexpr std::uint16_t rsqrt_seeds<Dummy>::slope[384];
+
+        // 1/(2*sqrt(n)) as Q0.24 given n as Q0.64 in [1/4, 1), interpolated with the 16 bits below the index
+        constexpr std::uint64_t rsqrt_interpolated(std::uint64_t n)
+        {
+            return (rsqrt_seeds<>::base[(n >> 55)-128]
+                    -((rsqrt_seeds<>::slope[(n >> 55)-128]*((n >> 39) & 0xffffu)) >> 8)) >> 8;
+        }
+
+        // estimates of sqrt(n) and 1/(2*sqrt(n)) as Q0.32 given n as Q0.64 in [1/4, 1)
+        // and h, 1/(2*sqrt(n)) as Q0.24
+        struct sqrt_estimate {
+            std::uint64_t root;
+            std::uint64_t half_reciprocal;
+        };
+
+        constexpr sqrt_estimate sqrt_seed(std::uint64_t n, std::uint64_t h)
+        {
+            return sqrt_estimate{((n >> 24)*h) >> 31, h << 8};
+        }
+
+        // g+g*e given e, 1/2-g*h, as signed Q0.44
+        constexpr std::uint64_t sqrt_iterate(std::uint64_t g, std::int64_t e)
+        {
+            return static_cast<std::uint64_t>(static_cast<std::int64_t>(g)+((static_cast<std::int64_t>(g)*e) >> 44));
+        }
+
+        constexpr std::uint64_t sqrt_iterate(const sqrt_estimate& s)
+        {
+            return sqrt_iterate(s.root, static_cast<std::int64_t>((std::uint64_t{1} << 63)-s.root*s.half_reciprocal) >> 20);
+        }
+
+        // the root of n in [2^62, 2^64) and floor(sqrt(n)) given r, the estimate shifted back;
+        // the seed alone is within one and, after an iteration, the estimate is at most one less
+        template<int Digits, typename std::enable_if<(Digits<=32), int>::type Dummy = 0>
+        constexpr std::uint64_t isqrt_estimate(std::uint64_t n)
+        {
+            return sqrt_seed(n, rsqrt_interpolated(n)).root;
+        }
+
+        template<int Digits, typename std::enable_if<(Digits<=32), int>::type Dummy = 0>
+        constexpr std::uint64_t isqrt_floor(std::uint64_t n, std::uint64_t r)
+        {
+            return (r*r>n) ? r-1 : ((r+1)*(r+1)-1<n) ? r+1 : r;
+        }
+
+        template<int Digits, typename std::enable_if<(Digits>32), int>::type Dummy = 0>
+        constexpr std::uint64_t isqrt_estimate(std::uint64_t n)
+        {
+            return sqrt_iterate(sqrt_seed(n, rsqrt_interpolated(n)));
+        }
+
+        template<int Digits, typename std::enable_if<(Digits>32), int>::type Dummy = 0>
+        constexpr std::uint64_t isqrt_floor(std::uint64_t n, std::uint64_t r)
+        {
+            return ((r+1)*(r+1)-1<n) ? r+1 : r;
+        }
+
+        template<int Digits>
+        constexpr std::uint64_t isqrt_shifted(std::uint64_t n, int shift)
+        {
+            return isqrt_floor<Digits>(n, isqrt_estimate<Digits>(n << shift) >> (shift/2));
+        }
+
+        // floor(sqrt(n)) where n has no more than Digits digits
+        template<int Digits = 64>
+        constexpr std::uint64_t isqrt(std::uint64_t n)
+        {
+            return (n!=0) ? isqrt_shifted<Digits>(n, _impl::count_leading_zeros(n) & ~1) : 0;
+        }
+
+        // floor(sqrt(n)) where n = upper*2^64+lower and upper is in [2^62, 2^64);
+        // the root of upper, s, is extended by q = (r*2^32+lower/2^32)/(2s) where r = upper-s*s
+        // and is one too large if the remainder, (r*2^32+lower/2^32)%(2s)*2^32+lower%2^32-q*q, is negative
+
+        // a*2^32+b < q*q given q no greater than 2^32
+        constexpr bool isqrt_wide_overshoots(std::uint64_t a, std::uint64_t b, std::uint64_t q)
+        {
+            return (a >> 32)<(q >> 32) || ((a >> 32)==(q >> 32) && ((a << 32) | b)<q*q);
+        }
+
+        constexpr std::uint64_t isqrt_wide_correct(std::uint64_t s, std::uint64_t q, std::uint64_t u, std::uint64_t lower)
+        {
+            return (s << 32)+q-isqrt_wide_overshoots(u, lower & 0xffffffffu, q);
+        }
+
+        // halves the numerator and divisor, (r*2^32+lower/2^32) and 2s, to keep them within 64 bits
+        constexpr std::uint64_t isqrt_wide_divide(std::uint64_t s, std::uint64_t half_numerator, std::uint64_t lower)
+        {
+            return isqrt_wide_correct(s, half_numerator/s, ((half_numerator%s) << 1) | ((lower >> 32) & 1), lower);
+        }
+
+        constexpr std::uint64_t isqrt_wide_extend(std::uint64_t upper, std::uint64_t lower, std::uint64_t s)
+        {
+            return isqrt_wide_divide(s, ((upper-s*s) << 31) | (lower >> 33), lower);
+        }
+
+        constexpr std::uint64_t isqrt_wide_shifted(std::uint64_t upper, std::uint64_t lower, int shift)
+        {
+            return isqrt_wide_extend(
+                    (upper << shift) | ((lower >> 1) >> (63-shift)),
+                    lower << shift,
+                    isqrt((upper << shift) | ((lower >> 1) >> (63-shift)))) >> (shift/2);
+        }
+
+        // floor(sqrt(upper*2^64+lower))
+        constexpr std::uint64_t isqrt(std::uint64_t upper, std::uint64_t lower)
+        {
+            return (upper!=0)
+                   ? isqrt_wide_shifted(upper, lower, _impl::count_leading_zeros(upper) & ~1)
+                   : isqrt(lower);
+        }
+
+        // shifts left by a non-negative amount or right by the negation of a negative amount
+        constexpr std::uint64_t shift_left(std::uint64_t n, int shift)
+        {
+            return (shift>=0) ? n << shift : n >> -shift;
+        }
+
+        // upper and lower halves of n*2^shift as a 128-bit value given shift in (0, 128)
+        constexpr std::uint64_t shift_left_upper(std::uint64_t n, int shift)
+        {
+            return (shift>=64) ? n << (shift-64) : n >> (64-shift);
+        }
+
+        constexpr std::uint64_t shift_left_lower(std::uint64_t n, int shift)
+        {
+            return (shift>=64) ? 0 : n << shift;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fixed_point_impl::sqrt
+        //
+        // fundamental reps up to 64 bits wide use the fast path where the integer whose root
+        // is the result, x.data()*2^-Exponent, has up to 128 digits; all other reps use the
+        // bit-wise solution in the widened type
+
+        template<class Rep, int Exponent>
+        constexpr int sqrt_digits()
+        {
+            return static_cast<int>(width<Rep>::value)-Exponent;
+        }
+
+        template<class Rep, int Exponent>
+        struct has_fast_sqrt : std::integral_constant<bool,
+                std::is_integral<Rep>::value && (width<Rep>::value<=64)
+                && (sqrt_digits<Rep, Exponent>()>0) && (sqrt_digits<Rep, Exponent>()<=128)> {
+        };
+
+        template<class Rep, int Exponent, typename std::enable_if<
+                has_fast_sqrt<Rep, Exponent>::value && (sqrt_digits<Rep, Exponent>()<=64), int>::type Dummy = 0>
+        constexpr fixed_point<Rep, Exponent> sqrt(const fixed_point<Rep, Exponent>& x)
+        {
+            return fixed_point<Rep, Exponent>::from_data(static_cast<Rep>(
+                    (x.data()>0)
+                    ? isqrt<sqrt_digits<Rep, Exponent>()>(shift_left(static_cast<std::uint64_t>(x.data()), -Exponent))
+                    : 0));
+        }
+
+        template<class Rep, int Exponent, typename std::enable_if<
+                has_fast_sqrt<Rep, Exponent>::value && (sqrt_digits<Rep, Exponent>()>64), int>::type Dummy = 0>
+        constexpr fixed_point<Rep, Exponent> sqrt(const fixed_point<Rep, Exponent>& x)
+        {
+            return fixed_point<Rep, Exponent>::from_data(static_cast<Rep>(
+                    (x.data()>0)
+                    ? isqrt(shift_left_upper(static_cast<std::uint64_t>(x.data()), -Exponent),
+                            shift_left_lower(static_cast<std::uint64_t>(x.data()), -Exponent))
+                    : 0));
+        }
+
+        template<class Rep, int Exponent, typename std::enable_if<!has_fast_sqrt<Rep, Exponent>::value, int>::type Dummy = 0>
+        constexpr fixed_point<Rep, Exponent> sqrt(const fixed_point<Rep, Exponent>& x)
+        {
+            using widened_type = fixed_point<set_width_t<Rep, width<Rep>::value*2>, Exponent*2>;
+            return fixed_point<Rep, Exponent>::from_data(
+                    static_cast<Rep>(sqrt_solve1(widened_type{x}.data())));
+        }
     }
 
     ////////////////////////////////////////////////////////////////////////////////
     // sg14::sqrt
 
+    // result is rounded down;
     // https://en.wikipedia.org/wiki/Methods_of_computing_square_roots#Binary_numeral_system_.28base_2.29
-    // placeholder implementation; slow when calculated at run-time?
+    // is used where the fast path (above) does not apply
     template<class Rep, int Exponent>
     constexpr fixed_point <Rep, Exponent>
     sqrt(const fixed_point <Rep, Exponent>& x)
     {
-        using widened_type = fixed_point<set_width_t<Rep, width<Rep>::value*2>, Exponent*2>;
         return
 #if defined(SG14_FIXED_POINT_EXCEPTIONS_ENABLED)
                 (x<fixed_point<Rep, Exponent>(0))
                 ? throw std::invalid_argument("cannot represent square root of negative value") :
 #endif
-                fixed_point<Rep, Exponent>::from_data(
-                        static_cast<Rep>(_fixed_point_impl::sqrt_solve1(widened_type{x}.data())));
+                _fixed_point_impl::sqrt(x);
     }
 
     ////////////////////////////////////////////////////////////////////////////////
-    // sg14::trig
+    // sg14::rsqrt, sg14::sin, sg14::cos, sg14::tan, sg14::atan, sg14::asin, sg14::acos,
+    // sg14::log, sg14::exp, sg14::pow
     //
-    // Placeholder implementations fall back on <cmath> functions which is slow
-    // due to conversion to and from floating-point types; also inconvenient as
-    // many <cmath> functions are not constexpr.
-
-    namespace _fixed_point_impl {
-        template<class Rep, int Exponent, float_of_same_size<Rep>(* F)(
-                float_of_same_size<Rep>)>
-        constexpr fixed_point <Rep, Exponent>
-        crib(const fixed_point <Rep, Exponent>& x) noexcept
-        {
-            using floating_point = float_of_same_size<Rep>;
-            return static_cast<fixed_point<Rep, Exponent>>(F(static_cast<floating_point>(x)));
-        }
-    }
-
-    template<class Rep, int Exponent>
-    constexpr fixed_point <Rep, Exponent>
-    sin(const fixed_point <Rep, Exponent>& x) noexcept
-    {
-        return _fixed_point_impl::crib<Rep, Exponent, std::sin>(x);
-    }
-
-    template<class Rep, int Exponent>
-    constexpr fixed_point <Rep, Exponent>
-    cos(const fixed_point <Rep, Exponent>& x) noexcept
-    {
-        return _fixed_point_impl::crib<Rep, Exponent, std::cos>(x);
-    }
-
-    template<class Rep, int Exponent>
-    constexpr fixed_point <Rep, Exponent>
-    exp(const fixed_point <Rep, Exponent>& x) noexcept
-    {
-        return _fixed_point_impl::crib<Rep, Exponent, std::exp>(x);
-    }
-
-    template<class Rep, int Exponent>
-    constexpr fixed_point <Rep, Exponent>
-    pow(const fixed_point <Rep, Exponent>& x) noexcept
-    {
-        return _fixed_point_impl::crib<Rep, Exponent, std::pow>(x);
-    }
+    // (defined in fixed_point_math.h)
 
     ////////////////////////////////////////////////////////////////////////////////
     // sg14::is_signed<fixed_point<>>
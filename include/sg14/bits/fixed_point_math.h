@@ -11,18 +11,15 @@
 #define FIXED_POINT_MATH_H_
 
 #include <sg14/fixed_point.h>
+
+#include <cstdint>
 #include <type_traits>
+#include <utility>
 
 namespace sg14 {
 
     namespace _fixed_point_impl {
 
-        template<class FixedPoint>
-        constexpr FixedPoint rounding_conversion(double d) {
-            using one_longer = make_fixed<FixedPoint::integer_digits, FixedPoint::fractional_digits + 1>;
-            return FixedPoint::from_data(static_cast<typename FixedPoint::rep>((one_longer{ d }.data() + 1) >> 1));
-        }
-
         template<class FixedPoint>
         using unsigned_rep = typename std::make_unsigned<typename FixedPoint::rep>::type;
 
@@ -31,59 +28,128 @@ namespace sg14 {
 
         static_assert(std::is_same<make_largest_ufraction<fixed_point<int32_t, -15>>, fixed_point<uint32_t, -32>>::value, "");
 
-        //TODO: template magic to get the coefficients automatically
-        //from the number of bits of precision
-        //Define the coefficients as constexpr,
-        //to make sure they're converted to fp
-        //at compile time
-        template<class CoeffType>
+        // minimax coefficients, a1...aN, of polynomials of degree N,
+        // a1*x+a2*x^2+...+aN*x^N, which approximate 2^x-1 for x in [0, 1),
+        // as Q0.64 values and the number of bits to which each polynomial is accurate;
+        // the degree-7 set is biased towards x=1 to offset truncation in 32-bit evaluation
+        template<class Dummy = void>
+        struct exp2m1_minimax {
+            static constexpr int max_degree = 13;
+
+            static constexpr int precision[max_degree+1] = {0, 4, 8, 12, 17, 23, 28, 33, 39, 45, 51, 57, 63, 70};
+
+            static constexpr std::uint64_t a[max_degree+1][max_degree] = {
+                    {0},
+                    {0xf12c7661217c1000},
+                    {0xa94b6d9dfa4cd800, 0x55ef3801a8ce1000},
+                    {0xb210039e34cdd800, 0x39e682e24c1cd800, 0x1401592aedfe9900},
+                    {0xb169a98fd323f000, 0x3dcf5f6013347800, 0x0d4ca19689ac6b00,
+                     0x037a0f873302ba20},
+                    {0xb17270bc1b58e800, 0x3d7aa786a7b30000, 0x0e4b4367d55c6f80,
+                     0x024c144fdc9ce3a0, 0x007b8e0abebbfafc},
+                    {0xb1721500eda1a800, 0x3d7fb4e5bcc7d200, 0x0e3419a87aff4e80,
+                     0x027a7711d21e09a0, 0x00515cc937152418, 0x000e488973e0c54c},
+                    {0xb172180f8b719000, 0x3d7f79f192346c00, 0x0e3595809e896f00,
+                     0x02761070a8387a20, 0x0057f771bf87d800, 0x000967eb33c5f500,
+                     0x000168b07c13e1d6},
+                    {0xb17217f74d9fd800, 0x3d7f7c0fa0717a00, 0x0e3583b52673a080,
+                     0x02765934cf5475a0, 0x005756f476c24288, 0x000a2afec766ccf2,
+                     0x0000edb8511fd115, 0x00001f638b923c98},
+                    {0xb17217f7d49fd000, 0x3d7f7bfe95645000, 0x0e35847184a88680,
+                     0x0276554599ff87a0, 0x00576298b338ca40, 0x000a16eb184c12c6,
+                     0x000101ceb5073b5e, 0x00001495081f6e57, 0x0000026aeea2931b},
+                    {0xb17217f7d1c1d000, 0x3d7f7bff08206e00, 0x0e35846b5712c900,
+                     0x0276556f5d5ba5e0, 0x005761f8f8c9525c, 0x000a185c154072b0,
+                     0x0000ffc1942a7a6c, 0x0000165754476c24, 0x0000019593fa1669,
+                     0x0000002ae7397d93},
+                    {0xb17217f7d1cfb59c, 0x3d7f7bff057d9bcd, 0x0e35846b835f2658,
+                     0x0276556decb7e669, 0x005761ffdb7b9342, 0x000a1847b85aa0b4,
+                     0x0000ffe8125a51ca, 0x00001628b9cd8219, 0x000001b88ad96fab,
+                     0x0000001c19aa11fd, 0x00000002b41a1801},
+                    {0xb17217f7d1cf78bd, 0x3d7f7bff058b5cb4, 0x0e35846b824a84de,
+                     0x0276556df78f3721, 0x005761ff9c47c6e3, 0x000a1848a012df15,
+                     0x0000ffe5e5bdb2dc, 0x0000162c3309845f, 0x000001b4e26ed96f,
+                     0x0000001e8a1d8a42, 0x00000001c522fed8, 0x0000000027fa2ed5},
+                    {0xb17217f7d1cf79af, 0x3d7f7bff058b1c43, 0x0e35846b82507cc9,
+                     0x0276556df7483ca5, 0x005761ff9e3674c2, 0x000a1848977ff98a,
+                     0x0000ffe5ff1b0cc5, 0x0000162bffd8f954, 0x000001b5293046da,
+                     0x0000001e48346f7e, 0x00000001ecb13739, 0x000000001a2aa379,
+                     0x000000000221ab2f}};
+        };
+
+        template<class Dummy>
+        constexpr int exp2m1_minimax<Dummy>::precision[max_degree+1];
+        template<class Dummy>
+        constexpr std::uint64_t exp2m1_minimax<Dummy>::a[max_degree+1][max_degree];
+
+        // lowest degree of polynomial accurate to the given number of bits
+        constexpr int exp2m1_degree(int digits, int degree = 1)
+        {
+            return (degree==exp2m1_minimax<>::max_degree || exp2m1_minimax<>::precision[degree]>=digits)
+                   ? degree
+                   : exp2m1_degree(digits, degree+1);
+        }
+
+        // converts a Q0.64 value to an unsigned fraction type, rounding to nearest
+        template<class FixedPoint, typename std::enable_if<(FixedPoint::fractional_digits==64), int>::type Dummy = 0>
+        constexpr FixedPoint rounding_conversion(std::uint64_t c) {
+            return FixedPoint::from_data(c);
+        }
+
+        template<class FixedPoint, typename std::enable_if<(FixedPoint::fractional_digits<64), int>::type Dummy = 0>
+        constexpr FixedPoint rounding_conversion(std::uint64_t c) {
+            return FixedPoint::from_data(static_cast<typename FixedPoint::rep>(
+                    ((c >> (63-FixedPoint::fractional_digits))+1) >> 1));
+        }
+
+        // coefficients of the polynomial which is accurate to the digits of CoeffType
+        // less ErrorBudget bits; narrower types evaluate fewer terms
+        template<class CoeffType, int ErrorBudget = 0>
         struct poly_coeffs {
-            static constexpr CoeffType a1 { rounding_conversion<CoeffType>(0.6931471860838825) };
-            static constexpr CoeffType a2 { rounding_conversion<CoeffType>(0.2402263846181129) };
-            static constexpr CoeffType a3 { rounding_conversion<CoeffType>(
-                    0.055505126858894846) };
-            static constexpr CoeffType a4 { rounding_conversion<CoeffType>(
-                    0.009614017013719252) };
-            static constexpr CoeffType a5 { rounding_conversion<CoeffType>(
-                    0.0013422634797558564) };
-            static constexpr CoeffType a6 { rounding_conversion<CoeffType>(
-                    0.00014352314226313836) };
-            static constexpr CoeffType a7 { rounding_conversion<CoeffType>(
-                    0.000021498763160402416) };
+            static constexpr int degree = exp2m1_degree(CoeffType::digits-ErrorBudget);
+
+            //Define the coefficients as constexpr,
+            //to make sure they're converted to fp
+            //at compile time
+            template<int Index>
+            struct a {
+                static constexpr CoeffType value{
+                        rounding_conversion<CoeffType>(exp2m1_minimax<>::a[degree][Index])};
+            };
         };
 
-        template<class CoeffType>
-        constexpr CoeffType poly_coeffs<CoeffType>::a1;
-        template<class CoeffType>
-        constexpr CoeffType poly_coeffs<CoeffType>::a2;
-        template<class CoeffType>
-        constexpr CoeffType poly_coeffs<CoeffType>::a3;
-        template<class CoeffType>
-        constexpr CoeffType poly_coeffs<CoeffType>::a4;
-        template<class CoeffType>
-        constexpr CoeffType poly_coeffs<CoeffType>::a5;
-        template<class CoeffType>
-        constexpr CoeffType poly_coeffs<CoeffType>::a6;
-        template<class CoeffType>
-        constexpr CoeffType poly_coeffs<CoeffType>::a7;
+        template<class CoeffType, int ErrorBudget>
+        template<int Index>
+        constexpr CoeffType poly_coeffs<CoeffType, ErrorBudget>::a<Index>::value;
 
-        template<class Rep, int Exponent>
-        constexpr inline fixed_point<Rep, Exponent> evaluate_polynomial(
-                fixed_point<Rep, Exponent> xf) {
+        // Horner's method from the term of the given index
+        template<class Coeffs, int Index, class Rep, int Exponent, typename std::enable_if<
+                (Index+1==Coeffs::degree), int>::type Dummy = 0>
+        constexpr fixed_point<Rep, Exponent> horner(fixed_point<Rep, Exponent> xf) {
             using fp = fixed_point<Rep, Exponent>;
+            return fp{fp{Coeffs::template a<Index>::value}*xf};
+        }
 
+        template<class Coeffs, int Index, class Rep, int Exponent, typename std::enable_if<
+                (Index+1<Coeffs::degree), int>::type Dummy = 0>
+        constexpr fixed_point<Rep, Exponent> horner(fixed_point<Rep, Exponent> xf) {
+            using fp = fixed_point<Rep, Exponent>;
+            return fp{xf*(Coeffs::template a<Index>::value+horner<Coeffs, Index+1>(xf))};
+        }
+
+        template<int ErrorBudget, class Rep, int Exponent>
+        constexpr inline fixed_point<Rep, Exponent> evaluate_polynomial(
+                fixed_point<Rep, Exponent> xf) {
             //Use a polynomial min-max approximation to generate the exponential of
             //the fractional part. Note that the constant 1 of the polynomial is added later,
             //this gives us one more bit of precision here for free
-            using coeffs = poly_coeffs<fp>;
-            return fp{xf*(coeffs::a1+fp{xf*(coeffs::a2+fp{xf*(coeffs::a3+fp{xf*(coeffs::a4
-                    +fp{xf*(coeffs::a5+fp{xf*(coeffs::a6+fp{fp{coeffs::a7}*fp{xf}})})})})})})};
+            return horner<poly_coeffs<fixed_point<Rep, Exponent>, ErrorBudget>, 0>(xf);
         }
 
         //Computes 2^x - 1 for a number x between 0 and 1, strictly less than 1
         //If the exponent is not negative, there is no fractional part,
         //so this is always zero
-        template<class Rep, int Exponent, typename std::enable_if<
+        template<int ErrorBudget, class Rep, int Exponent, typename std::enable_if<
                 (Exponent >= 0), int>::type dummy = 0>
         inline constexpr make_largest_ufraction<fixed_point<Rep, Exponent>> exp2m1_0to1(
                 fixed_point<Rep, Exponent>) {
@@ -91,7 +157,7 @@ namespace sg14 {
                     0); //Cannot construct from 0, since that would be a shift by more than width of type!
         }
         //for a positive exponent, some work needs to be done
-        template<class Rep, int Exponent, typename std::enable_if<
+        template<int ErrorBudget, class Rep, int Exponent, typename std::enable_if<
                 (Exponent < 0), int>::type dummy = 0>
         constexpr inline make_largest_ufraction<fixed_point<Rep, Exponent>> exp2m1_0to1(
                 fixed_point<Rep, Exponent> x) {
@@ -102,12 +168,12 @@ namespace sg14 {
             using im = make_largest_ufraction<fixed_point<Rep, Exponent>>;
             //The intermediate value type
 
-            return evaluate_polynomial(im{x}); //Important: convert the type once, to keep every multiply from costing a cast
+            return evaluate_polynomial<ErrorBudget>(im{x}); //Important: convert the type once, to keep every multiply from costing a cast
         }
 
         template<class Rep, int Exponent>
         constexpr inline Rep floor(fixed_point<Rep, Exponent> x) {
-            return Rep { (x.data()) >> -Exponent };
+            return static_cast<Rep>((x.data()) >> -Exponent);
         }
 
     } // namespace _fixed_point_impl
@@ -115,11 +181,15 @@ namespace sg14 {
     /// Calculates exp2(x), i.e. 2^x
     ///
     /// Accurate to 1LSB for up to 32 bit underlying representation.
+    /// The fractional part is evaluated as a polynomial whose degree is the lowest
+    /// that is accurate to the digits of the representation.
     ///
+    /// \tparam ErrorBudget number of low-order bits of the polynomial which may be
+    /// inaccurate; a positive value trades accuracy for fewer terms, e.g. `exp2<Rep, Exponent, 4>(x)`
     /// \tparam x the input value as a fixed_point
     ///
     /// \return the result of the exponential, in the same representation as x
-    template<class Rep, int Exponent>
+    template<class Rep, int Exponent, int ErrorBudget = 0>
     constexpr fixed_point<Rep, Exponent> exp2(fixed_point<Rep, Exponent> x) {
         using namespace _fixed_point_impl;
 
@@ -134,11 +204,1518 @@ namespace sg14 {
                     typename im::rep{1}//return immediately if the shift would result in all bits being shifted out
                                      :
                     	//Do the shifts manually. Once the branch with shift operators is merged, could use those
-                    (exp2m1_0to1<Rep, Exponent>(static_cast<out_type>(x - floor(x))).data()//Calculate the exponent of the fractional part
+                    (exp2m1_0to1<ErrorBudget>(static_cast<out_type>(x - floor(x))).data()//Calculate the exponent of the fractional part
                     >> (-im::exponent + Exponent - floor(x)))//shift it to the right place
                     + (Rep { 1 } << (floor(x) - Exponent))); //The constant term must be one, to make integer powers correct
     }
 
+    namespace _fixed_point_impl {
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fixed_point_impl::wide_multiply - 64x64->128-bit unsigned multiplication
+
+        struct wide_uint64 {
+            std::uint64_t upper;
+            std::uint64_t lower;
+        };
+
+#if defined(SG14_INT128_ENABLED)
+        constexpr wide_uint64 wide_multiply(std::uint64_t a, std::uint64_t b)
+        {
+            return wide_uint64{
+                    static_cast<std::uint64_t>((static_cast<SG14_UINT128>(a)*b) >> 64),
+                    static_cast<std::uint64_t>(static_cast<SG14_UINT128>(a)*b)};
+        }
+#else
+        // schoolbook multiplication of 32-bit halves
+        constexpr wide_uint64 wide_multiply_combine(
+                std::uint64_t p00, std::uint64_t p01, std::uint64_t p10, std::uint64_t p11, std::uint64_t middle)
+        {
+            return wide_uint64{
+                    p11+(p01 >> 32)+(p10 >> 32)+(middle >> 32),
+                    (middle << 32) | (p00 & 0xffffffffu)};
+        }
+
+        constexpr wide_uint64 wide_multiply_partial(
+                std::uint64_t p00, std::uint64_t p01, std::uint64_t p10, std::uint64_t p11)
+        {
+            return wide_multiply_combine(
+                    p00, p01, p10, p11,
+                    (p00 >> 32)+(p01 & 0xffffffffu)+(p10 & 0xffffffffu));
+        }
+
+        constexpr wide_uint64 wide_multiply(std::uint64_t a, std::uint64_t b)
+        {
+            return wide_multiply_partial(
+                    (a & 0xffffffffu)*(b & 0xffffffffu),
+                    (a & 0xffffffffu)*(b >> 32),
+                    (a >> 32)*(b & 0xffffffffu),
+                    (a >> 32)*(b >> 32));
+        }
+#endif
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fixed_point_impl::multiply_upper - upper half of unsigned product
+
+        constexpr std::uint32_t multiply_upper(std::uint32_t a, std::uint32_t b)
+        {
+            return static_cast<std::uint32_t>((static_cast<std::uint64_t>(a)*b) >> 32);
+        }
+
+        constexpr std::uint64_t multiply_upper(std::uint64_t a, std::uint64_t b)
+        {
+            return wide_multiply(a, b).upper;
+        }
+
+        // upper half of unsigned product, rounded to nearest
+        constexpr std::uint32_t multiply_round(std::uint32_t a, std::uint32_t b)
+        {
+            return static_cast<std::uint32_t>((static_cast<std::uint64_t>(a)*b+(std::uint64_t{1} << 31)) >> 32);
+        }
+
+        constexpr std::uint64_t multiply_round(wide_uint64 p)
+        {
+            return p.upper+(p.lower >> 63);
+        }
+
+        constexpr std::uint64_t multiply_round(std::uint64_t a, std::uint64_t b)
+        {
+            return multiply_round(wide_multiply(a, b));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fixed_point_impl::divide_fraction - floor((n << width) / d) given n < d
+
+#if !defined(SG14_INT128_ENABLED)
+        constexpr std::uint64_t divide_fraction_step(std::uint64_t n, std::uint64_t d, std::uint64_t q, int bits)
+        {
+            return (bits==0)
+                   ? q
+                   : ((n >> 63) || ((n << 1) >= d))
+                     ? divide_fraction_step((n << 1)-d, d, (q << 1) | 1u, bits-1)
+                     : divide_fraction_step(n << 1, d, q << 1, bits-1);
+        }
+#endif
+
+        constexpr std::uint32_t divide_fraction(std::uint32_t n, std::uint32_t d)
+        {
+            return static_cast<std::uint32_t>((static_cast<std::uint64_t>(n) << 32)/d);
+        }
+
+        constexpr std::uint64_t divide_fraction(std::uint64_t n, std::uint64_t d)
+        {
+#if defined(SG14_INT128_ENABLED)
+            return static_cast<std::uint64_t>((static_cast<SG14_UINT128>(n) << 64)/d);
+#else
+            // restoring long division; one quotient bit per step
+            return divide_fraction_step(n, d, 0, 64);
+#endif
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fixed_point_impl::extract_bits - 64 bits of a 192-bit value, starting at bit, pos
+
+        constexpr std::uint64_t limb(std::uint64_t r2, std::uint64_t r1, std::uint64_t r0, int index)
+        {
+            return (index==0) ? r0 : (index==1) ? r1 : (index==2) ? r2 : 0;
+        }
+
+        constexpr std::uint64_t extract_bits(std::uint64_t r2, std::uint64_t r1, std::uint64_t r0, int pos)
+        {
+            return (pos<=-64)
+                   ? 0
+                   : (pos<0)
+                     ? r0 << -pos
+                     : (limb(r2, r1, r0, pos/64) >> (pos%64))
+                       | ((pos%64) ? limb(r2, r1, r0, pos/64+1) << (64-pos%64) : 0);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fixed_point_impl::combine_products - sum of two 128-bit products
+        // where the first is worth 2^64 times the second
+
+        struct wide_uint192 {
+            std::uint64_t r2;
+            std::uint64_t r1;
+            std::uint64_t r0;
+        };
+
+        constexpr wide_uint192 combine_products(wide_uint64 upper_product, wide_uint64 lower_product)
+        {
+            return wide_uint192{
+                    upper_product.upper+(upper_product.lower+lower_product.upper<upper_product.lower),
+                    upper_product.lower+lower_product.upper,
+                    lower_product.lower};
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fixed_point_impl::round_shift - shifts a 192-bit value right, rounding to nearest;
+        // saturates if the result does not fit in 64 bits
+
+        // true iff any bits of a 192-bit value at or above bit, pos, are set
+        constexpr bool any_bits_from(std::uint64_t r2, std::uint64_t r1, std::uint64_t r0, int pos)
+        {
+            return (pos<=0)
+                   ? (r2 | r1 | r0)!=0
+                   : (extract_bits(r2, r1, r0, pos) | extract_bits(r2, r1, r0, pos+64)
+                           | extract_bits(r2, r1, r0, pos+128))!=0;
+        }
+
+        constexpr std::uint64_t round_up(std::uint64_t truncated, bool half)
+        {
+            return (half && truncated!=~std::uint64_t{0}) ? truncated+1 : truncated;
+        }
+
+        constexpr std::uint64_t round_shift(std::uint64_t r2, std::uint64_t r1, std::uint64_t r0, int shift)
+        {
+            return any_bits_from(r2, r1, r0, shift+64)
+                   ? ~std::uint64_t{0}
+                   : round_up(
+                           extract_bits(r2, r1, r0, shift),
+                           (shift>0) && (extract_bits(r2, r1, r0, shift-1) & 1u));
+        }
+
+        constexpr std::uint64_t round_shift(std::uint64_t upper, std::uint64_t lower, int shift)
+        {
+            return round_shift(0, upper, lower, shift);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fixed_point_impl::magnitude_of / is_negative - sign-magnitude view of a rep
+
+        template<class Rep, typename std::enable_if<is_signed<Rep>::value, int>::type Dummy = 0>
+        constexpr bool is_negative(const Rep& r)
+        {
+            return static_cast<std::int64_t>(r)<0;
+        }
+
+        template<class Rep, typename std::enable_if<!is_signed<Rep>::value, int>::type Dummy = 0>
+        constexpr bool is_negative(const Rep&)
+        {
+            return false;
+        }
+
+        template<class Rep, typename std::enable_if<is_signed<Rep>::value, int>::type Dummy = 0>
+        constexpr std::uint64_t magnitude_of(const Rep& r)
+        {
+            return (static_cast<std::int64_t>(r)<0)
+                   ? 0-static_cast<std::uint64_t>(static_cast<std::int64_t>(r))
+                   : static_cast<std::uint64_t>(static_cast<std::int64_t>(r));
+        }
+
+        template<class Rep, typename std::enable_if<!is_signed<Rep>::value, int>::type Dummy = 0>
+        constexpr std::uint64_t magnitude_of(const Rep& r)
+        {
+            return static_cast<std::uint64_t>(r);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fixed_point_impl::from_magnitude - inverse of magnitude_of; saturates
+
+        template<class Rep>
+        constexpr std::uint64_t max_magnitude()
+        {
+            return static_cast<std::uint64_t>(std::numeric_limits<Rep>::max());
+        }
+
+        template<class Rep>
+        constexpr std::uint64_t lowest_magnitude()
+        {
+            return is_signed<Rep>::value ? max_magnitude<Rep>()+1 : 0;
+        }
+
+        template<class Rep>
+        constexpr Rep from_magnitude(bool negative, std::uint64_t magnitude)
+        {
+            return (magnitude==0)
+                   ? Rep(0)
+                   : negative
+                     ? (magnitude>=lowest_magnitude<Rep>())
+                       ? std::numeric_limits<Rep>::lowest()
+                       : static_cast<Rep>(-static_cast<std::int64_t>(magnitude-1)-1)
+                     : (magnitude>max_magnitude<Rep>())
+                       ? std::numeric_limits<Rep>::max()
+                       : static_cast<Rep>(magnitude);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // unsigned integer type used to evaluate a transcendental function with
+        // the given number of result digits; 32-bit words are used for up to 26
+        // digits and 64-bit words otherwise, which leaves at least 5 guard bits
+        // below the LSB of the result for up to 58 digits
+        template<int Digits>
+        using math_word = typename std::conditional<(Digits<=26), std::uint32_t, std::uint64_t>::type;
+
+        // narrows a 64-bit coefficient to the precision of Word, rounding to nearest
+        template<class Word, typename std::enable_if<(width<Word>::value==64), int>::type Dummy = 0>
+        constexpr Word round_coefficient(std::uint64_t c)
+        {
+            return c;
+        }
+
+        template<class Word, typename std::enable_if<(width<Word>::value==32), int>::type Dummy = 0>
+        constexpr Word round_coefficient(std::uint64_t c)
+        {
+            return static_cast<Word>((c+(std::uint64_t{1} << 31)) >> 32);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // trigonometric function engine
+        //
+        // The argument is reduced to a quadrant and a fraction of a quarter turn
+        // using a 128-bit approximation of 2/pi. The fraction is then folded into
+        // the first octant and sine or cosine is evaluated as a polynomial in the
+        // square of the fraction. All arithmetic is performed on a math_word chosen
+        // by the number of fractional digits of the result, which bounds the error
+        // to 1 LSB for results of up to 58 fractional digits.
+
+        // Taylor coefficients of sin(v*pi/2)/v and cos(v*pi/2) in terms of v^2 as Q1.(N-1) words;
+        // enough terms are used for the truncation error to fall below the LSB of Word
+        template<class Word>
+        struct trig_coeffs {
+            static constexpr int num_sin_terms = (width<Word>::value>32) ? 10 : 6;
+            static constexpr int num_cos_terms = (width<Word>::value>32) ? 10 : 7;
+
+            static constexpr Word sin[10] = {
+                    round_coefficient<Word>(0xc90fdaa22168c235), round_coefficient<Word>(0x52aef39896f94afb),
+                    round_coefficient<Word>(0x0a335e33bad570e9), round_coefficient<Word>(0x009969667315ec2e),
+                    round_coefficient<Word>(0x000541e0d21fb9e0), round_coefficient<Word>(0x00001e3074fde887),
+                    round_coefficient<Word>(0x0000007a3d0d3406), round_coefficient<Word>(0x000000016fadb9f1),
+                    round_coefficient<Word>(0x000000000355d865), round_coefficient<Word>(0x0000000000062901)};
+
+            static constexpr Word cos[10] = {
+                    round_coefficient<Word>(0x8000000000000000), round_coefficient<Word>(0x9de9e64df22ef2d2),
+                    round_coefficient<Word>(0x20783e1036b58767), round_coefficient<Word>(0x02aba78fc797ff40),
+                    round_coefficient<Word>(0x001e1f506891babb), round_coefficient<Word>(0x0000d368f9510254),
+                    round_coefficient<Word>(0x000003f3a7146ec8), round_coefficient<Word>(0x0000000db7127a26),
+                    round_coefficient<Word>(0x000000002418c586), round_coefficient<Word>(0x00000000004a8316)};
+        };
+
+        template<class Word>
+        constexpr Word trig_coeffs<Word>::sin[10];
+        template<class Word>
+        constexpr Word trig_coeffs<Word>::cos[10];
+
+        // evaluates c[0] - x*(c[1] - x*(c[2] - ...)) where x is Q0.N and c[] are Q1.(N-1)
+        template<int Index, int NumTerms, class Word, typename std::enable_if<(Index+1==NumTerms), int>::type Dummy = 0>
+        constexpr Word alternating_polynomial(const Word* c, Word)
+        {
+            return c[Index];
+        }
+
+        template<int Index, int NumTerms, class Word, typename std::enable_if<(Index+1<NumTerms), int>::type Dummy = 0>
+        constexpr Word alternating_polynomial(const Word* c, Word x)
+        {
+            return static_cast<Word>(c[Index]-multiply_upper(x, alternating_polynomial<Index+1, NumTerms>(c, x)));
+        }
+
+        // sin(v*pi/2) and cos(v*pi/2) as Q1.(N-1) given Q0.N, v, in range [0, 1/2]
+        template<class Word>
+        constexpr Word sin_octant(Word v)
+        {
+            using coeffs = trig_coeffs<Word>;
+            return multiply_upper(v, alternating_polynomial<0, coeffs::num_sin_terms>(coeffs::sin, multiply_upper(v, v)));
+        }
+
+        template<class Word>
+        constexpr Word cos_octant(Word v)
+        {
+            using coeffs = trig_coeffs<Word>;
+            return alternating_polynomial<0, coeffs::num_cos_terms>(coeffs::cos, multiply_upper(v, v));
+        }
+
+        // sin(u*pi/2) and cos(u*pi/2) as Q1.(N-1) given Q0.N, u, in range [0, 1)
+        template<class Word>
+        constexpr Word sin_quarter(Word u)
+        {
+            return (u >> (width<Word>::value-1))
+                   ? cos_octant(static_cast<Word>(0-u))
+                   : sin_octant(u);
+        }
+
+        template<class Word>
+        constexpr Word cos_quarter(Word u)
+        {
+            return (u >> (width<Word>::value-1))
+                   ? sin_octant(static_cast<Word>(0-u))
+                   : cos_octant(u);
+        }
+
+        // an angle expressed as a number of quarter turns
+        template<class Word>
+        struct quarter_turns {
+            // integer part, modulo 4
+            unsigned quadrant;
+
+            // fractional part, Q0.N
+            Word fraction;
+
+            // sign of the original angle
+            bool negative;
+        };
+
+        // 2/pi as a Q0.128 value
+        constexpr std::uint64_t two_over_pi_upper = 0xa2f9836e4e441529;
+        constexpr std::uint64_t two_over_pi_lower = 0xfc2757d1f534ddc1;
+
+        template<class Word, int Exponent>
+        constexpr quarter_turns<Word> make_quarter_turns(const wide_uint192& r, bool negative)
+        {
+            // the binary point of the product of a Q(Exponent) value and a Q0.128 value is at bit, 128-Exponent
+            return quarter_turns<Word>{
+                    static_cast<unsigned>(extract_bits(r.r2, r.r1, r.r0, 128-Exponent) & 3u),
+                    static_cast<Word>(extract_bits(r.r2, r.r1, r.r0, 128-Exponent-64) >> (64-width<Word>::value)),
+                    negative};
+        }
+
+        template<class Word, int Exponent>
+        constexpr quarter_turns<Word> reduce_product(wide_uint64 upper_product, wide_uint64 lower_product, bool negative)
+        {
+            return make_quarter_turns<Word, Exponent>(combine_products(upper_product, lower_product), negative);
+        }
+
+        template<class Word, class Rep, int Exponent>
+        constexpr quarter_turns<Word> reduce_angle(const fixed_point<Rep, Exponent>& x)
+        {
+            static_assert(width<Rep>::value<=64, "trigonometric functions require a rep no wider than 64 bits");
+            return reduce_product<Word, Exponent>(
+                    wide_multiply(magnitude_of(x.data()), two_over_pi_upper),
+                    wide_multiply(magnitude_of(x.data()), two_over_pi_lower),
+                    is_negative(x.data()));
+        }
+
+        // converts a Q1.(N-1) result to the given format, rounding to nearest
+        template<class Rep, int Exponent, class Word>
+        constexpr fixed_point<Rep, Exponent> trig_result(bool negative, Word magnitude)
+        {
+            return fixed_point<Rep, Exponent>::from_data(from_magnitude<Rep>(
+                    negative,
+                    round_shift(0, magnitude, static_cast<int>(width<Word>::value)-1+Exponent)));
+        }
+
+        // sin and cos of an angle; quadrants are mapped as follows:
+        //   0: sin = +S, cos = +C
+        //   1: sin = +C, cos = -S
+        //   2: sin = -S, cos = -C
+        //   3: sin = -C, cos = +S
+        template<class Word>
+        constexpr Word sin_magnitude(const quarter_turns<Word>& a)
+        {
+            return (a.quadrant & 1u) ? cos_quarter(a.fraction) : sin_quarter(a.fraction);
+        }
+
+        template<class Word>
+        constexpr bool sin_negative(const quarter_turns<Word>& a)
+        {
+            return ((a.quadrant & 2u)!=0)!=a.negative;
+        }
+
+        template<class Word>
+        constexpr Word cos_magnitude(const quarter_turns<Word>& a)
+        {
+            return (a.quadrant & 1u) ? sin_quarter(a.fraction) : cos_quarter(a.fraction);
+        }
+
+        template<class Word>
+        constexpr bool cos_negative(const quarter_turns<Word>& a)
+        {
+            return ((a.quadrant+1u) & 2u)!=0;
+        }
+
+        template<class Rep, int Exponent, class Word>
+        constexpr fixed_point<Rep, Exponent> sin(const quarter_turns<Word>& a)
+        {
+            return trig_result<Rep, Exponent>(sin_negative(a), sin_magnitude(a));
+        }
+
+        template<class Rep, int Exponent, class Word>
+        constexpr fixed_point<Rep, Exponent> cos(const quarter_turns<Word>& a)
+        {
+            return trig_result<Rep, Exponent>(cos_negative(a), cos_magnitude(a));
+        }
+
+        // tan as the quotient of the sin and cos magnitudes; a zero denominator saturates
+        template<class Rep, int Exponent, class Word>
+        constexpr fixed_point<Rep, Exponent> tan_quotient(bool negative, Word numerator, Word denominator)
+        {
+            return fixed_point<Rep, Exponent>::from_data(from_magnitude<Rep>(
+                    negative,
+                    (denominator==0)
+                    ? ~std::uint64_t{0}
+                    : round_shift(
+                            numerator/denominator,
+                            static_cast<std::uint64_t>(divide_fraction(
+                                    static_cast<Word>(numerator%denominator), denominator))
+                                    << (64-width<Word>::value),
+                            64+Exponent)));
+        }
+
+        template<class Rep, int Exponent, class Word>
+        constexpr fixed_point<Rep, Exponent> tan(const quarter_turns<Word>& a)
+        {
+            return tan_quotient<Rep, Exponent>(sin_negative(a)!=cos_negative(a), sin_magnitude(a), cos_magnitude(a));
+        }
+
+        template<class Rep, int Exponent, class Word>
+        constexpr std::pair<fixed_point<Rep, Exponent>, fixed_point<Rep, Exponent>> sincos(const quarter_turns<Word>& a)
+        {
+            return std::pair<fixed_point<Rep, Exponent>, fixed_point<Rep, Exponent>>(
+                    sin<Rep, Exponent>(a),
+                    cos<Rep, Exponent>(a));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // inverse trigonometric function engine
+        //
+        // atan2 folds its arguments into the first octant so that it evaluates
+        // atan(a/b) for 0 <= a <= b. With k/8 the nearest eighth to a/b,
+        // atan(a/b) = atan(k/8) + atan(s) where s = (8a-kb)/(8b+ka) and |s| <= 1/16,
+        // so a table of nine angles and a short odd series suffice. acos(x) is
+        // evaluated as 2*atan2(sqrt(1-x), sqrt(1+x)) and asin(x) as pi/2-acos(x).
+        // Angles are held as Q2.62 radians. As with the trigonometric functions,
+        // the series is evaluated on a math_word chosen by the digits of the result.
+
+        // atan(k/8) for k in [0, 8] and coefficients, 1, 1/3, 1/5..., of the series for atan(s)/s
+        // as Q1.(N-1) words; enough terms are used for the truncation error to fall below the LSB of Word
+        template<class Word>
+        struct atan_coeffs {
+            static constexpr int num_terms = (width<Word>::value>32) ? 8 : 4;
+
+            static constexpr Word table[9] = {
+                    round_coefficient<Word>(0x0000000000000000), round_coefficient<Word>(0x0feadd4d5617b6e3),
+                    round_coefficient<Word>(0x1f5b75f92c80dd63), round_coefficient<Word>(0x2dec3283c9bde11d),
+                    round_coefficient<Word>(0x3b58ce0ac3769ed1), round_coefficient<Word>(0x47802eaf7bfacfce),
+                    round_coefficient<Word>(0x525e3e8c9a7b8492), round_coefficient<Word>(0x5c029f15e118cf3a),
+                    round_coefficient<Word>(0x6487ed5110b4611a)};
+
+            static constexpr Word c[8] = {
+                    round_coefficient<Word>(0x8000000000000000), round_coefficient<Word>(0x2aaaaaaaaaaaaaab),
+                    round_coefficient<Word>(0x199999999999999a), round_coefficient<Word>(0x1249249249249249),
+                    round_coefficient<Word>(0x0e38e38e38e38e39), round_coefficient<Word>(0x0ba2e8ba2e8ba2e9),
+                    round_coefficient<Word>(0x09d89d89d89d89d9), round_coefficient<Word>(0x0888888888888889)};
+        };
+
+        template<class Word>
+        constexpr Word atan_coeffs<Word>::table[9];
+        template<class Word>
+        constexpr Word atan_coeffs<Word>::c[8];
+
+        // pi and pi/2 as Q2.62 values
+        constexpr std::uint64_t half_turn = 0xc90fdaa22168c235;
+        constexpr std::uint64_t quarter_turn = 0x6487ed5110b4611a;
+
+        // a Q1.(N-1) angle as a Q2.62 angle
+        template<class Word>
+        constexpr std::uint64_t angle_q62(Word a)
+        {
+            return shift_left(a, 63-static_cast<int>(width<Word>::value));
+        }
+
+        // atan(s) as Q1.(N-1) given Q0.N, s, in range [0, 1/16]
+        template<class Word>
+        constexpr Word atan_series(Word s)
+        {
+            using coeffs = atan_coeffs<Word>;
+            return multiply_upper(s, alternating_polynomial<0, coeffs::num_terms>(coeffs::c, multiply_upper(s, s)));
+        }
+
+        // atan(k/8)+atan(s) or atan(k/8)-atan(s)
+        template<class Word>
+        constexpr std::uint64_t atan_sum(std::uint64_t k, bool negative, Word s)
+        {
+            return angle_q62<Word>(negative
+                                   ? static_cast<Word>(atan_coeffs<Word>::table[k]-atan_series(s))
+                                   : static_cast<Word>(atan_coeffs<Word>::table[k]+atan_series(s)));
+        }
+
+        template<class Word>
+        constexpr std::uint64_t atan_reduced(std::uint64_t a, std::uint64_t b, std::uint64_t k)
+        {
+            return atan_sum<Word>(k, (a << 3)<k*b, divide_fraction(
+                    static_cast<Word>(((a << 3)<k*b) ? k*b-(a << 3) : (a << 3)-k*b),
+                    static_cast<Word>((b << 3)+k*a)));
+        }
+
+        // a and b are normalized so that 8b+ka fits in Word
+        template<class Word>
+        constexpr std::uint64_t atan_normalized(std::uint64_t a, std::uint64_t b)
+        {
+            return atan_reduced<Word>(a, b, ((static_cast<Word>(a << 4)/static_cast<Word>(b))+1u) >> 1);
+        }
+
+        // atan(a/b) as Q2.62 given 0 <= a <= b and 0 < b
+        template<class Word>
+        constexpr std::uint64_t atan_octant(std::uint64_t a, std::uint64_t b)
+        {
+            return atan_normalized<Word>(
+                    shift_left(a, _impl::count_leading_zeros(b)-68+static_cast<int>(width<Word>::value)),
+                    shift_left(b, _impl::count_leading_zeros(b)-68+static_cast<int>(width<Word>::value)));
+        }
+
+        // magnitude of atan2 of y and x as Q2.62 given the magnitudes of y and x
+        template<class Word>
+        constexpr std::uint64_t atan2_magnitude(std::uint64_t y, std::uint64_t x, bool x_negative)
+        {
+            return (y==0 && x==0)
+                   ? 0
+                   : x_negative
+                     ? half_turn-atan2_magnitude<Word>(y, x, false)
+                     : (y>x)
+                       ? quarter_turn-atan_octant<Word>(x, y)
+                       : atan_octant<Word>(y, x);
+        }
+
+        // m*2^shift, saturating
+        constexpr std::uint64_t scale_magnitude(std::uint64_t m, int shift)
+        {
+            return (shift<0)
+                   ? (shift>-64) ? m >> -shift : 0
+                   : (m!=0 && _impl::count_leading_zeros(m)<shift)
+                     ? ~std::uint64_t{0}
+                     : (shift<64) ? m << shift : 0;
+        }
+
+        // magnitude of a fixed_point value as Q2.62, saturating
+        template<class Rep, int Exponent>
+        constexpr std::uint64_t magnitude_q62(const fixed_point<Rep, Exponent>& x)
+        {
+            return scale_magnitude(magnitude_of(x.data()), 62+Exponent);
+        }
+
+        // converts a Q2.62 angle to the given format, rounding to nearest
+        template<class Rep, int Exponent>
+        constexpr fixed_point<Rep, Exponent> angle_result(bool negative, std::uint64_t a)
+        {
+            return fixed_point<Rep, Exponent>::from_data(from_magnitude<Rep>(
+                    negative,
+                    round_shift(0, a, 62+Exponent)));
+        }
+
+        // square root of a Q2.62 value with the precision of Word
+        template<class Word, typename std::enable_if<(width<Word>::value==32), int>::type Dummy = 0>
+        constexpr std::uint64_t unit_root(std::uint64_t n)
+        {
+            return isqrt(n);
+        }
+
+        template<class Word, typename std::enable_if<(width<Word>::value==64), int>::type Dummy = 0>
+        constexpr std::uint64_t unit_root(std::uint64_t n)
+        {
+            return isqrt(n, 0);
+        }
+
+        // acos of a Q2.62 value, x, in range [-1, 1]
+        template<class Word>
+        constexpr std::uint64_t acos_magnitude(bool negative, std::uint64_t x)
+        {
+            return atan2_magnitude<Word>(
+                    unit_root<Word>(negative ? (std::uint64_t{1} << 62)+x : (std::uint64_t{1} << 62)-x),
+                    unit_root<Word>(negative ? (std::uint64_t{1} << 62)-x : (std::uint64_t{1} << 62)+x),
+                    false) << 1;
+        }
+
+        template<class Rep, int Exponent>
+        constexpr bool in_unit_interval(const fixed_point<Rep, Exponent>& x)
+        {
+            return magnitude_q62(x)<=(std::uint64_t{1} << 62);
+        }
+
+        // the result of an inverse trigonometric function;
+        // a given fixed_point specialization, or that of the argument if void
+        template<class Result, class Argument>
+        using angle_t = typename std::conditional<std::is_same<Result, void>::value, Argument, Result>::type;
+
+        // atan(x) is atan2(x, 1) where x and 1 are scaled by a common power of two, 2^shift,
+        // such that both are integers and both fit in 64 bits
+        template<int Exponent>
+        constexpr int atan_shift()
+        {
+            return (Exponent>0) ? Exponent : _impl::min(0, 62+Exponent);
+        }
+
+        template<class Result, class Rep, int Exponent>
+        constexpr Result atan(const fixed_point<Rep, Exponent>& x)
+        {
+            return angle_result<typename Result::rep, Result::exponent>(is_negative(x.data()), atan2_magnitude<
+                    math_word<-Result::exponent>>(
+                    scale_magnitude(magnitude_of(x.data()), atan_shift<Exponent>()),
+                    std::uint64_t{1} << (atan_shift<Exponent>()-Exponent),
+                    false));
+        }
+
+        template<class Result, class Rep, int Exponent>
+        constexpr Result atan2(const fixed_point<Rep, Exponent>& y, const fixed_point<Rep, Exponent>& x)
+        {
+            static_assert(width<Rep>::value<=64, "inverse trigonometric functions require a rep no wider than 64 bits");
+            return angle_result<typename Result::rep, Result::exponent>(is_negative(y.data()), atan2_magnitude<
+                    math_word<-Result::exponent>>(magnitude_of(y.data()), magnitude_of(x.data()), is_negative(x.data())));
+        }
+
+        template<class Result, class Rep, int Exponent>
+        constexpr Result acos(const fixed_point<Rep, Exponent>& x)
+        {
+            return angle_result<typename Result::rep, Result::exponent>(false, acos_magnitude<
+                    math_word<-Result::exponent>>(
+                    is_negative(x.data()),
+                    _impl::min(magnitude_q62(x), std::uint64_t{1} << 62)));
+        }
+
+        template<class Result, class Rep, int Exponent>
+        constexpr Result asin(const fixed_point<Rep, Exponent>& x)
+        {
+            return angle_result<typename Result::rep, Result::exponent>(is_negative(x.data()), quarter_turn-_impl::min(
+                    acos_magnitude<math_word<-Result::exponent>>(false, _impl::min(magnitude_q62(x), std::uint64_t{1} << 62)),
+                    quarter_turn));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // logarithm and exponential engine
+        //
+        // log2 normalizes its argument with a count of leading zeros to m*2^k where
+        // m lies in [1/sqrt(2), sqrt(2)) and evaluates log2(m) = 2*atanh(s)/ln(2)
+        // as an odd series in s = (m-1)/(m+1). e^x is evaluated as 2^y where
+        // y = x*log2(e) is calculated to 128 bits. As with exp2, 2^f-1 is evaluated
+        // with the exp2m1_minimax polynomial in the fractional part, f, of y and the
+        // constant 1 is added later. Intermediate results are held as a sign and a 128-bit
+        // magnitude with 64 integer and 64 fractional bits.
+
+        // a signed Q64.64 value
+        struct wide_value {
+            bool negative;
+            std::uint64_t upper;
+            std::uint64_t lower;
+        };
+
+        // integer+fraction or integer-fraction as a wide_value given Q0.64, fraction
+        constexpr wide_value make_wide_value(int integer, bool fraction_negative, std::uint64_t fraction)
+        {
+            return (fraction_negative==(integer<0) || fraction==0)
+                   ? wide_value{
+                            integer<0 || (integer==0 && fraction_negative),
+                            static_cast<std::uint64_t>((integer<0) ? -integer : integer),
+                            fraction}
+                   : (integer==0)
+                     ? wide_value{fraction_negative, 0, fraction}
+                     : wide_value{
+                              integer<0,
+                              static_cast<std::uint64_t>((integer<0) ? -integer : integer)-1,
+                              0-fraction};
+        }
+
+        // converts a wide_value to the given format, rounding to nearest
+        template<class Rep, int Exponent>
+        constexpr fixed_point<Rep, Exponent> wide_result(const wide_value& v)
+        {
+            return fixed_point<Rep, Exponent>::from_data(from_magnitude<Rep>(
+                    v.negative,
+                    round_shift(v.upper, v.lower, 64+Exponent)));
+        }
+
+        // converts the product of a wide_value and a Q0.64 constant to the given format
+        template<class Rep, int Exponent>
+        constexpr fixed_point<Rep, Exponent> scaled_result(bool negative, const wide_uint192& r)
+        {
+            return fixed_point<Rep, Exponent>::from_data(from_magnitude<Rep>(
+                    negative,
+                    round_shift(r.r2, r.r1, r.r0, 128+Exponent)));
+        }
+
+        template<class Rep, int Exponent>
+        constexpr fixed_point<Rep, Exponent> scaled_result(const wide_value& v, std::uint64_t c)
+        {
+            return scaled_result<Rep, Exponent>(
+                    v.negative,
+                    combine_products(wide_multiply(v.upper, c), wide_multiply(v.lower, c)));
+        }
+
+        // a+b, saturating at the maximum value of Word
+        template<class Word>
+        constexpr Word saturating_add(Word a, Word b)
+        {
+            return (static_cast<Word>(a+b)<a) ? ~Word{0} : static_cast<Word>(a+b);
+        }
+
+        // evaluates c[0] + x*(c[1] + x*(c[2] + ...)) where x and c[] are Q0.N;
+        // products are rounded to nearest and the result saturates below 1
+        template<int Index, int NumTerms, class Word, typename std::enable_if<(Index+1==NumTerms), int>::type Dummy = 0>
+        constexpr Word positive_polynomial(const Word* c, Word)
+        {
+            return c[Index];
+        }
+
+        template<int Index, int NumTerms, class Word, typename std::enable_if<(Index+1<NumTerms), int>::type Dummy = 0>
+        constexpr Word positive_polynomial(const Word* c, Word x)
+        {
+            return saturating_add(c[Index], multiply_round(x, positive_polynomial<Index+1, NumTerms>(c, x)));
+        }
+
+        // coefficients, 1/3, 1/5, 1/7..., of the series for atanh(s)/s-1 in terms of s^2
+        // as Q0.N words; enough terms are used for the truncation error to fall below
+        // the LSB of Word for s no greater than 3-2*sqrt(2)
+        template<class Word>
+        struct log_coeffs {
+            static constexpr int num_terms = (width<Word>::value>32) ? 11 : 5;
+
+            static constexpr Word c[11] = {
+                    static_cast<Word>(~Word{0}/3u), static_cast<Word>(~Word{0}/5u),
+                    static_cast<Word>(~Word{0}/7u), static_cast<Word>(~Word{0}/9u),
+                    static_cast<Word>(~Word{0}/11u), static_cast<Word>(~Word{0}/13u),
+                    static_cast<Word>(~Word{0}/15u), static_cast<Word>(~Word{0}/17u),
+                    static_cast<Word>(~Word{0}/19u), static_cast<Word>(~Word{0}/21u),
+                    static_cast<Word>(~Word{0}/23u)};
+        };
+
+        template<class Word>
+        constexpr Word log_coeffs<Word>::c[11];
+
+        // coefficients of the exp2 polynomial, poly_coeffs, which is accurate to the
+        // width of Word as an array of Q0.N words
+        template<class Word, class Coeffs = poly_coeffs<fixed_point<Word, -std::numeric_limits<Word>::digits>>,
+                class Indices = typename _impl::make_index_sequence<Coeffs::degree>::type>
+        struct exp2m1_coeffs;
+
+        template<class Word, class Coeffs, int... Indices>
+        struct exp2m1_coeffs<Word, Coeffs, _impl::index_sequence<Indices...>> {
+            static constexpr int num_terms = Coeffs::degree;
+
+            static constexpr Word c[num_terms] = {Coeffs::template a<Indices>::value.data()...};
+        };
+
+        template<class Word, class Coeffs, int... Indices>
+        constexpr Word exp2m1_coeffs<Word, Coeffs, _impl::index_sequence<Indices...>>::c[num_terms];
+
+        // sqrt(2) as a Q1.63 value
+        constexpr std::uint64_t sqrt_two = 0xb504f333f9de6484;
+
+        // 1/(2*ln(2)) as a Q0.64 value
+        constexpr std::uint64_t half_log2_e = 0xb8aa3b295c17f0bc;
+
+        // ln(2) and log10(2) as Q0.64 values
+        constexpr std::uint64_t ln_two = 0xb17217f7d1cf79ac;
+        constexpr std::uint64_t log10_two = 0x4d104d427de7fbcc;
+
+        // log2(e) as a Q1.127 value
+        constexpr std::uint64_t log2_e_upper = 0xb8aa3b295c17f0bb;
+        constexpr std::uint64_t log2_e_lower = 0xbe87fed0691d3e88;
+
+        // s = |m-1|/(m+1) as Q0.N given Q2.(N-2) values, m and one
+        template<class Word>
+        constexpr Word log2_quotient(Word m, Word one, bool centered)
+        {
+            return divide_fraction(static_cast<Word>(centered ? one-m : m-one), static_cast<Word>(m+one));
+        }
+
+        // s given a Q1.63 mantissa in range [1, 2) which is halved if centered
+        template<class Word>
+        constexpr Word log2_quotient(std::uint64_t mantissa, bool centered)
+        {
+            return log2_quotient(
+                    static_cast<Word>(mantissa >> (65-width<Word>::value+centered)),
+                    static_cast<Word>(Word{1} << (width<Word>::value-2)),
+                    centered);
+        }
+
+        // 2*r/ln(2) as Q0.64 given Q0.N, r, less than ln(2)/4; 1/(2*ln(2)) as Q0.64 is 2/ln(2) as Q2.62
+        constexpr std::uint64_t log2_scale(wide_uint64 product)
+        {
+            return (product.upper << 2) | (product.lower >> 62);
+        }
+
+        constexpr std::uint64_t log2_scale(std::uint64_t r)
+        {
+            return log2_scale(wide_multiply(r, half_log2_e));
+        }
+
+        constexpr std::uint64_t log2_scale(std::uint32_t r)
+        {
+            return (static_cast<std::uint64_t>(r)*round_coefficient<std::uint32_t>(half_log2_e)) << 2;
+        }
+
+        // |log2(m)| = 2*(s + s^3/3 + s^5/5 + ...)/ln(2) as Q0.64 given s and t = s^2
+        template<class Word>
+        constexpr std::uint64_t log2_series(Word s, Word t)
+        {
+            using coeffs = log_coeffs<Word>;
+            return log2_scale(static_cast<Word>(
+                    s+multiply_round(s, multiply_round(t, positive_polynomial<0, coeffs::num_terms>(coeffs::c, t)))));
+        }
+
+        template<class Word>
+        constexpr wide_value log2_normalized(int integer, bool centered, std::uint64_t mantissa)
+        {
+            return make_wide_value(
+                    integer+centered,
+                    centered,
+                    log2_series(log2_quotient<Word>(mantissa, centered), multiply_upper(
+                            log2_quotient<Word>(mantissa, centered),
+                            log2_quotient<Word>(mantissa, centered))));
+        }
+
+        // the logarithm of zero
+        constexpr wide_value log2_zero()
+        {
+            return wide_value{true, ~std::uint64_t{0}, ~std::uint64_t{0}};
+        }
+
+        // log2(magnitude*2^Exponent); the logarithm of zero saturates to lowest
+        template<class Word, int Exponent>
+        constexpr wide_value log2_magnitude(std::uint64_t magnitude)
+        {
+            return (magnitude==0)
+                   ? log2_zero()
+                   : log2_normalized<Word>(
+                           Exponent+63-_impl::count_leading_zeros(magnitude),
+                           (magnitude << _impl::count_leading_zeros(magnitude))>=sqrt_two,
+                           magnitude << _impl::count_leading_zeros(magnitude));
+        }
+
+        // log2(x); the logarithm of a non-positive value saturates to lowest
+        template<class Word, class Rep, int Exponent>
+        constexpr wide_value log2_value(const fixed_point<Rep, Exponent>& x)
+        {
+            static_assert(width<Rep>::value<=64, "logarithmic functions require a rep no wider than 64 bits");
+            return is_negative(x.data())
+                   ? log2_zero()
+                   : log2_magnitude<Word, Exponent>(magnitude_of(x.data()));
+        }
+
+        // an exponent of two separated into integer and fractional parts
+        template<class Word>
+        struct binary_exponent {
+            // integer part, rounded toward negative infinity
+            int integer;
+
+            // fractional part, Q0.N
+            Word fraction;
+        };
+
+        // exponents beyond this magnitude saturate
+        constexpr int max_binary_exponent = 1 << 16;
+
+        template<class Word>
+        constexpr binary_exponent<Word> make_binary_exponent(bool negative, std::uint64_t integer, std::uint64_t fraction)
+        {
+            return (negative && fraction)
+                   ? binary_exponent<Word>{
+                            -static_cast<int>(integer)-1,
+                            static_cast<Word>((0-fraction) >> (64-width<Word>::value))}
+                   : binary_exponent<Word>{
+                            negative ? -static_cast<int>(integer) : static_cast<int>(integer),
+                            static_cast<Word>(fraction >> (64-width<Word>::value))};
+        }
+
+        // a binary_exponent given a 192-bit magnitude with its binary point at bit, point
+        template<class Word>
+        constexpr binary_exponent<Word> make_binary_exponent(bool negative, const wide_uint192& r, int point)
+        {
+            return any_bits_from(r.r2, r.r1, r.r0, point+16)
+                   ? binary_exponent<Word>{negative ? -max_binary_exponent : max_binary_exponent, 0}
+                   : make_binary_exponent<Word>(
+                            negative,
+                            extract_bits(r.r2, r.r1, r.r0, point),
+                            extract_bits(r.r2, r.r1, r.r0, point-64));
+        }
+
+        // x*log2(e) as a binary_exponent
+        template<class Word, class Rep, int Exponent>
+        constexpr binary_exponent<Word> exp_exponent(const fixed_point<Rep, Exponent>& x)
+        {
+            static_assert(width<Rep>::value<=64, "exponential functions require a rep no wider than 64 bits");
+            // the binary point of the product of a Q(Exponent) value and a Q1.127 value is at bit, 127-Exponent
+            return make_binary_exponent<Word>(
+                    is_negative(x.data()),
+                    combine_products(
+                            wide_multiply(magnitude_of(x.data()), log2_e_upper),
+                            wide_multiply(magnitude_of(x.data()), log2_e_lower)),
+                    127-Exponent);
+        }
+
+        // 2^f-1 as Q0.64 given Q0.N, f, in range [0, 1)
+        template<class Word>
+        constexpr std::uint64_t exp2m1_fraction(Word f)
+        {
+            using coeffs = exp2m1_coeffs<Word>;
+            return static_cast<std::uint64_t>(multiply_round(f, positive_polynomial<0, coeffs::num_terms>(coeffs::c, f)))
+                    << (64-width<Word>::value);
+        }
+
+        // 2^y, or -2^y if negative, converted to the given format
+        template<class Rep, int Exponent, class Word>
+        constexpr fixed_point<Rep, Exponent> exp2_result(const binary_exponent<Word>& y, bool negative = false)
+        {
+            return fixed_point<Rep, Exponent>::from_data(from_magnitude<Rep>(
+                    negative,
+                    round_shift(1, exp2m1_fraction(y.fraction), 64+Exponent-y.integer)));
+        }
+
+        // 1-fraction as a negative wide_value
+        constexpr wide_value one_minus(std::uint64_t fraction)
+        {
+            return wide_value{true, fraction==0, 0-fraction};
+        }
+
+        // 2^integer*(1+fraction)-1 as a wide_value given integer no greater than 62
+        constexpr wide_value exp2m1_value(int integer, std::uint64_t fraction)
+        {
+            return (integer>0)
+                   ? wide_value{
+                            false,
+                            ((std::uint64_t{1} << integer) | (fraction >> (64-integer)))-1,
+                            fraction << integer}
+                   : (integer==0)
+                     ? wide_value{false, 0, fraction}
+                     : (integer>-64)
+                       ? one_minus((std::uint64_t{1} << (64+integer)) | (fraction >> -integer))
+                       : one_minus((integer==-64) ? 1u : 0u);
+        }
+
+        // 2^y-1 converted to the given format; beyond 2^62 the constant term is below
+        // the precision of the result
+        template<class Rep, int Exponent, class Word>
+        constexpr fixed_point<Rep, Exponent> expm1_result(const binary_exponent<Word>& y)
+        {
+            return (y.integer>62)
+                   ? exp2_result<Rep, Exponent>(y)
+                   : wide_result<Rep, Exponent>(exp2m1_value(y.integer, exp2m1_fraction(y.fraction)));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // power engine
+        //
+        // Integer powers are evaluated by square-and-multiply on a normalized
+        // mantissa and a separate binary exponent. The mantissa is twice the width
+        // of the rep, or at least 32 and at most 64 bits, which keeps rounding error
+        // in the intermediate results below the LSB of the result. Other powers are
+        // evaluated as 2^(y*log2(x)) using the logarithm and exponential engine.
+
+        // unsigned integer type used to evaluate integer powers of Rep
+        template<class Rep>
+        using power_word = set_width_t<
+                std::uint32_t,
+                _impl::max(32, _impl::min(static_cast<int>(width<Rep>::value)*2, 64))>;
+
+        // a positive value, mantissa*2^(exponent-N+1), where the top bit of mantissa is set
+        template<class Word>
+        struct normalized_word {
+            Word mantissa;
+            int exponent;
+        };
+
+        template<class Word>
+        constexpr normalized_word<Word> normalized_one()
+        {
+            return normalized_word<Word>{static_cast<Word>(Word{1} << (width<Word>::value-1)), 0};
+        }
+
+        // magnitude*2^Exponent as a normalized_word given non-zero magnitude
+        template<class Word, int Exponent>
+        constexpr normalized_word<Word> normalize(std::uint64_t magnitude)
+        {
+            return normalized_word<Word>{
+                    static_cast<Word>((magnitude << _impl::count_leading_zeros(magnitude)) >> (64-width<Word>::value)),
+                    Exponent+63-_impl::count_leading_zeros(magnitude)};
+        }
+
+        // limits the exponent of an intermediate result;
+        // exponents of a series of powers only grow in one direction
+        constexpr int clamp_exponent(int exponent)
+        {
+            return _impl::max(-max_binary_exponent, _impl::min(exponent, max_binary_exponent));
+        }
+
+        // rounds mantissa up by half, carrying into the exponent
+        template<class Word>
+        constexpr normalized_word<Word> round_normalized(Word mantissa, bool half, int exponent)
+        {
+            return (half && mantissa==static_cast<Word>(~Word{0}))
+                   ? normalized_word<Word>{static_cast<Word>(Word{1} << (width<Word>::value-1)), clamp_exponent(exponent+1)}
+                   : normalized_word<Word>{static_cast<Word>(mantissa+half), clamp_exponent(exponent)};
+        }
+
+        // normalizes the 2N-bit product, upper:lower, of two normalized mantissas, rounding to nearest
+        template<class Word>
+        constexpr normalized_word<Word> normalize_product(Word upper, Word lower, int exponent)
+        {
+            return (upper >> (width<Word>::value-1))
+                   ? round_normalized(upper, (lower >> (width<Word>::value-1))!=0, exponent+1)
+                   : round_normalized(
+                            static_cast<Word>((upper << 1) | (lower >> (width<Word>::value-1))),
+                            ((lower >> (width<Word>::value-2)) & 1u)!=0,
+                            exponent);
+        }
+
+        constexpr normalized_word<std::uint32_t> normalize_product(std::uint64_t product, int exponent)
+        {
+            return normalize_product(
+                    static_cast<std::uint32_t>(product >> 32),
+                    static_cast<std::uint32_t>(product),
+                    exponent);
+        }
+
+        constexpr normalized_word<std::uint64_t> normalize_product(wide_uint64 product, int exponent)
+        {
+            return normalize_product(product.upper, product.lower, exponent);
+        }
+
+        constexpr normalized_word<std::uint32_t> multiply(
+                const normalized_word<std::uint32_t>& a, const normalized_word<std::uint32_t>& b)
+        {
+            return normalize_product(static_cast<std::uint64_t>(a.mantissa)*b.mantissa, a.exponent+b.exponent);
+        }
+
+        constexpr normalized_word<std::uint64_t> multiply(
+                const normalized_word<std::uint64_t>& a, const normalized_word<std::uint64_t>& b)
+        {
+            return normalize_product(wide_multiply(a.mantissa, b.mantissa), a.exponent+b.exponent);
+        }
+
+        // 1/a; a mantissa of 2^(N-1) is a power of two and has an exact reciprocal
+        template<class Word>
+        constexpr normalized_word<Word> reciprocal(const normalized_word<Word>& a)
+        {
+            return (a.mantissa==normalized_one<Word>().mantissa)
+                   ? normalized_word<Word>{a.mantissa, -a.exponent}
+                   : normalized_word<Word>{
+                            divide_fraction(normalized_one<Word>().mantissa, a.mantissa),
+                            -a.exponent-1};
+        }
+
+        // accumulator*base^n by square-and-multiply
+        template<class Word>
+        constexpr normalized_word<Word> power(
+                const normalized_word<Word>& accumulator, const normalized_word<Word>& base, std::uint64_t n)
+        {
+            return (n==0)
+                   ? accumulator
+                   : (n==1)
+                     ? multiply(accumulator, base)
+                     : power((n & 1u) ? multiply(accumulator, base) : accumulator, multiply(base, base), n >> 1);
+        }
+
+        // a normalized_word converted to the given format, rounding to nearest
+        template<class Rep, int Exponent, class Word>
+        constexpr fixed_point<Rep, Exponent> normalized_result(bool negative, const normalized_word<Word>& a)
+        {
+            return fixed_point<Rep, Exponent>::from_data(from_magnitude<Rep>(
+                    negative,
+                    round_shift(0, a.mantissa, static_cast<int>(width<Word>::value)-1+Exponent-a.exponent)));
+        }
+
+        // base^n given non-zero base
+        template<class Word>
+        constexpr normalized_word<Word> integer_power(const normalized_word<Word>& base, bool inverse, std::uint64_t n)
+        {
+            return inverse
+                   ? reciprocal(power(normalized_one<Word>(), base, n))
+                   : power(normalized_one<Word>(), base, n);
+        }
+
+        // x^n where n = -magnitude if inverse, otherwise magnitude;
+        // zero to a negative power saturates
+        template<class Rep, int Exponent>
+        constexpr fixed_point<Rep, Exponent> integer_power(
+                const fixed_point<Rep, Exponent>& x, bool inverse, std::uint64_t n)
+        {
+            static_assert(width<Rep>::value<=64, "power functions require a rep no wider than 64 bits");
+            return (magnitude_of(x.data())==0)
+                   ? (n==0)
+                     ? normalized_result<Rep, Exponent>(false, normalized_one<power_word<Rep>>())
+                     : fixed_point<Rep, Exponent>::from_data(from_magnitude<Rep>(
+                             false,
+                             inverse ? ~std::uint64_t{0} : 0))
+                   : normalized_result<Rep, Exponent>(
+                           is_negative(x.data()) && (n & 1u),
+                           integer_power(
+                                   normalize<power_word<Rep>, Exponent>(magnitude_of(x.data())),
+                                   inverse,
+                                   n));
+        }
+
+        // bits of magnitude below bit, bits
+        constexpr std::uint64_t low_bits(std::uint64_t magnitude, int bits)
+        {
+            return (bits<=0) ? 0 : (bits>=64) ? magnitude : magnitude & ((std::uint64_t{1} << bits)-1);
+        }
+
+        template<class Rep, int Exponent>
+        constexpr bool is_integer(const fixed_point<Rep, Exponent>& x)
+        {
+            return low_bits(magnitude_of(x.data()), -Exponent)==0;
+        }
+
+        // true iff x is an integer small enough to be evaluated with integer_power
+        template<class Rep, int Exponent>
+        constexpr bool is_small_integer(const fixed_point<Rep, Exponent>& x)
+        {
+            return is_integer(x) && !any_bits_from(0, 0, magnitude_of(x.data()), 62-Exponent);
+        }
+
+        // magnitude of the integer part of x
+        template<class Rep, int Exponent>
+        constexpr std::uint64_t integer_magnitude(const fixed_point<Rep, Exponent>& x)
+        {
+            return extract_bits(0, 0, magnitude_of(x.data()), -Exponent);
+        }
+
+        // y*log2(x) as a binary_exponent given l = log2(x)
+        template<class Word, class YRep, int YExponent>
+        constexpr binary_exponent<Word> power_exponent(const wide_value& l, const fixed_point<YRep, YExponent>& y)
+        {
+            // the binary point of the product of a Q64.64 value and a Q(YExponent) value is at bit, 64-YExponent
+            return make_binary_exponent<Word>(
+                    l.negative!=is_negative(y.data()),
+                    combine_products(
+                            wide_multiply(l.upper, magnitude_of(y.data())),
+                            wide_multiply(l.lower, magnitude_of(y.data()))),
+                    64-YExponent);
+        }
+
+        // x^y; for negative x, y must be an integer
+        template<class Rep, int Exponent, class YRep, int YExponent>
+        constexpr fixed_point<Rep, Exponent> real_power(
+                const fixed_point<Rep, Exponent>& x, const fixed_point<YRep, YExponent>& y)
+        {
+            static_assert(width<YRep>::value<=64, "power functions require an exponent no wider than 64 bits");
+            return is_small_integer(y)
+                   ? integer_power(x, is_negative(y.data()), integer_magnitude(y))
+                   : exp2_result<Rep, Exponent>(
+                           power_exponent<math_word<_impl::max(std::numeric_limits<Rep>::digits, -Exponent)>>(
+                                   log2_magnitude<std::uint64_t, Exponent>(magnitude_of(x.data())),
+                                   y),
+                           is_negative(x.data()) && is_integer(y) && (integer_magnitude(y) & 1u));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // reciprocal square root
+        //
+        // For x = d * 2^E, 1/sqrt(x) = sqrt(2^(-3E) / d) * 2^E, so the result's rep is the
+        // integer square root of a single quotient.
+
+        // floor(2^n / d) for non-zero d; saturates
+        constexpr std::uint64_t divide_power_of_two(int n, std::uint64_t d)
+        {
+            return (n<0)
+                   ? 0
+                   : (n<64)
+                     ? (std::uint64_t{1} << n)/d
+                     : (n<128 && (std::uint64_t{1} << (n-64))<d)
+                       ? divide_fraction(std::uint64_t{1} << (n-64), d)
+                       : ~std::uint64_t{0};
+        }
+
+        template<class Rep, int Exponent>
+        constexpr fixed_point<Rep, Exponent> rsqrt(const fixed_point<Rep, Exponent>& x)
+        {
+            static_assert(has_fast_sqrt<Rep, Exponent>::value,
+                    "rsqrt requires a fundamental rep no wider than 32 bits with no more than 32 fractional digits");
+            return fixed_point<Rep, Exponent>::from_data((static_cast<std::int64_t>(x.data())>0)
+                   ? from_magnitude<Rep>(false, isqrt(divide_power_of_two(-3*Exponent, magnitude_of(x.data()))))
+                   : std::numeric_limits<Rep>::max());
+        }
+    }
+
+    /// Calculates 1/sqrt(x)
+    ///
+    /// Rounded down, as is sqrt, but from a single integer square root,
+    /// so more accurate than dividing by the result of sqrt.
+    /// Calculated without conversion to floating-point.
+    ///
+    /// \tparam x the input value as a fixed_point
+    ///
+    /// \return the reciprocal of the square root of x, in the same representation as x;
+    /// results which cannot be represented saturate
+    ///
+    /// \throws std::invalid_argument if x is not positive and exceptions are enabled;
+    /// otherwise, the result saturates to the maximum representable value
+    template<class Rep, int Exponent>
+    constexpr fixed_point<Rep, Exponent>
+    rsqrt(const fixed_point<Rep, Exponent>& x)
+    {
+        return
+#if defined(SG14_FIXED_POINT_EXCEPTIONS_ENABLED)
+                (x.data()<=Rep{0})
+                ? throw std::invalid_argument("cannot represent reciprocal square root of non-positive value") :
+#endif
+                _fixed_point_impl::rsqrt(x);
+    }
+
+    /// Calculates sin(x)
+    ///
+    /// Accurate to 1LSB for results with up to 58 fractional digits.
+    /// Calculated without conversion to floating-point.
+    ///
+    /// \tparam x the input value in radians as a fixed_point
+    ///
+    /// \return the sine of x, in the same representation as x;
+    /// results which cannot be represented saturate
+    template<class Rep, int Exponent>
+    constexpr fixed_point<Rep, Exponent>
+    sin(const fixed_point<Rep, Exponent>& x) noexcept
+    {
+        using word = _fixed_point_impl::math_word<-Exponent>;
+        return _fixed_point_impl::sin<Rep, Exponent>(_fixed_point_impl::reduce_angle<word>(x));
+    }
+
+    /// Calculates cos(x)
+    ///
+    /// \sa sin
+    template<class Rep, int Exponent>
+    constexpr fixed_point<Rep, Exponent>
+    cos(const fixed_point<Rep, Exponent>& x) noexcept
+    {
+        using word = _fixed_point_impl::math_word<-Exponent>;
+        return _fixed_point_impl::cos<Rep, Exponent>(_fixed_point_impl::reduce_angle<word>(x));
+    }
+
+    /// Calculates tan(x)
+    ///
+    /// Evaluated as the quotient of sine and cosine, so relative error grows
+    /// as x approaches an odd multiple of pi/2.
+    ///
+    /// \sa sin
+    template<class Rep, int Exponent>
+    constexpr fixed_point<Rep, Exponent>
+    tan(const fixed_point<Rep, Exponent>& x) noexcept
+    {
+        using word = _fixed_point_impl::math_word<-Exponent>;
+        return _fixed_point_impl::tan<Rep, Exponent>(_fixed_point_impl::reduce_angle<word>(x));
+    }
+
+    /// Calculates sin(x) and cos(x) from a single range reduction
+    ///
+    /// \return pair of sine and cosine of x
+    ///
+    /// \sa sin, cos
+    template<class Rep, int Exponent>
+    constexpr std::pair<fixed_point<Rep, Exponent>, fixed_point<Rep, Exponent>>
+    sincos(const fixed_point<Rep, Exponent>& x) noexcept
+    {
+        using word = _fixed_point_impl::math_word<-Exponent>;
+        return _fixed_point_impl::sincos<Rep, Exponent>(_fixed_point_impl::reduce_angle<word>(x));
+    }
+
+
+    /// Calculates atan(x)
+    ///
+    /// Accurate to 1LSB for results with up to 58 fractional digits.
+    /// Calculated without conversion to floating-point.
+    ///
+    /// \tparam Result the fixed_point specialization of the result;
+    /// defaults to that of x
+    /// \tparam x the input value as a fixed_point
+    ///
+    /// \return the arc tangent of x in radians, in range [-pi/2, pi/2];
+    /// results which cannot be represented saturate
+    template<class Result = void, class Rep, int Exponent>
+    constexpr _fixed_point_impl::angle_t<Result, fixed_point<Rep, Exponent>>
+    atan(const fixed_point<Rep, Exponent>& x) noexcept
+    {
+        return _fixed_point_impl::atan<_fixed_point_impl::angle_t<Result, fixed_point<Rep, Exponent>>>(x);
+    }
+
+    /// Calculates atan2(y, x)
+    ///
+    /// \tparam Result the fixed_point specialization of the result;
+    /// defaults to that of y and x
+    /// \tparam y the ordinate as a fixed_point
+    /// \tparam x the abscissa as a fixed_point of the same type as y
+    ///
+    /// \return the angle of the point, (x, y), in radians, in range [-pi, pi];
+    /// zero if both x and y are zero
+    ///
+    /// \sa atan
+    template<class Result = void, class Rep, int Exponent>
+    constexpr _fixed_point_impl::angle_t<Result, fixed_point<Rep, Exponent>>
+    atan2(const fixed_point<Rep, Exponent>& y, const fixed_point<Rep, Exponent>& x) noexcept
+    {
+        return _fixed_point_impl::atan2<_fixed_point_impl::angle_t<Result, fixed_point<Rep, Exponent>>>(y, x);
+    }
+
+    /// Calculates asin(x)
+    ///
+    /// Evaluated as pi/2-acos(x).
+    ///
+    /// \return the arc sine of x in radians, in range [-pi/2, pi/2]
+    ///
+    /// \throws std::invalid_argument if x is outside [-1, 1] and exceptions are enabled;
+    /// otherwise, x is clamped to that range
+    ///
+    /// \sa acos, atan
+    template<class Result = void, class Rep, int Exponent>
+    constexpr _fixed_point_impl::angle_t<Result, fixed_point<Rep, Exponent>>
+    asin(const fixed_point<Rep, Exponent>& x)
+    {
+        return
+#if defined(SG14_FIXED_POINT_EXCEPTIONS_ENABLED)
+                !_fixed_point_impl::in_unit_interval(x)
+                ? throw std::invalid_argument("cannot represent arc sine of value outside [-1, 1]") :
+#endif
+                _fixed_point_impl::asin<_fixed_point_impl::angle_t<Result, fixed_point<Rep, Exponent>>>(x);
+    }
+
+    /// Calculates acos(x)
+    ///
+    /// Evaluated as 2*atan2(sqrt(1-x), sqrt(1+x)).
+    ///
+    /// \return the arc cosine of x in radians, in range [0, pi]
+    ///
+    /// \throws std::invalid_argument if x is outside [-1, 1] and exceptions are enabled;
+    /// otherwise, x is clamped to that range
+    ///
+    /// \sa asin, atan
+    template<class Result = void, class Rep, int Exponent>
+    constexpr _fixed_point_impl::angle_t<Result, fixed_point<Rep, Exponent>>
+    acos(const fixed_point<Rep, Exponent>& x)
+    {
+        return
+#if defined(SG14_FIXED_POINT_EXCEPTIONS_ENABLED)
+                !_fixed_point_impl::in_unit_interval(x)
+                ? throw std::invalid_argument("cannot represent arc cosine of value outside [-1, 1]") :
+#endif
+                _fixed_point_impl::acos<_fixed_point_impl::angle_t<Result, fixed_point<Rep, Exponent>>>(x);
+    }
+
+    /// Calculates log2(x)
+    ///
+    /// Accurate to 1LSB for 8-, 16- and 32-bit reps and for 64-bit reps
+    /// with up to 58 fractional digits; accurate to 2LSB beyond that.
+    /// Calculated without conversion to floating-point.
+    ///
+    /// \tparam x the input value as a fixed_point
+    ///
+    /// \return the base-2 logarithm of x, in the same representation as x
+    ///
+    /// \throws std::invalid_argument if x is not positive and exceptions are enabled;
+    /// otherwise, the result saturates to the lowest representable value
+    template<class Rep, int Exponent>
+    constexpr fixed_point<Rep, Exponent>
+    log2(const fixed_point<Rep, Exponent>& x)
+    {
+        using word = _fixed_point_impl::math_word<-Exponent>;
+        return
+#if defined(SG14_FIXED_POINT_EXCEPTIONS_ENABLED)
+                (x<=fixed_point<Rep, Exponent>(0))
+                ? throw std::invalid_argument("cannot represent logarithm of non-positive value") :
+#endif
+                _fixed_point_impl::wide_result<Rep, Exponent>(_fixed_point_impl::log2_value<word>(x));
+    }
+
+    /// Calculates the natural logarithm, log(x)
+    ///
+    /// \sa log2
+    template<class Rep, int Exponent>
+    constexpr fixed_point<Rep, Exponent>
+    log(const fixed_point<Rep, Exponent>& x)
+    {
+        using word = _fixed_point_impl::math_word<-Exponent>;
+        return
+#if defined(SG14_FIXED_POINT_EXCEPTIONS_ENABLED)
+                (x<=fixed_point<Rep, Exponent>(0))
+                ? throw std::invalid_argument("cannot represent logarithm of non-positive value") :
+#endif
+                _fixed_point_impl::scaled_result<Rep, Exponent>(
+                        _fixed_point_impl::log2_value<word>(x),
+                        _fixed_point_impl::ln_two);
+    }
+
+    /// Calculates log10(x)
+    ///
+    /// \sa log2
+    template<class Rep, int Exponent>
+    constexpr fixed_point<Rep, Exponent>
+    log10(const fixed_point<Rep, Exponent>& x)
+    {
+        using word = _fixed_point_impl::math_word<-Exponent>;
+        return
+#if defined(SG14_FIXED_POINT_EXCEPTIONS_ENABLED)
+                (x<=fixed_point<Rep, Exponent>(0))
+                ? throw std::invalid_argument("cannot represent logarithm of non-positive value") :
+#endif
+                _fixed_point_impl::scaled_result<Rep, Exponent>(
+                        _fixed_point_impl::log2_value<word>(x),
+                        _fixed_point_impl::log10_two);
+    }
+
+    /// Calculates exp(x), i.e. e^x
+    ///
+    /// Accurate to 1LSB for 8-, 16- and 32-bit reps and for signed 64-bit reps;
+    /// accurate to 3LSB for unsigned 64-bit reps.
+    /// Calculated without conversion to floating-point.
+    ///
+    /// \tparam x the input value as a fixed_point
+    ///
+    /// \return the exponential of x, in the same representation as x;
+    /// results which cannot be represented saturate
+    template<class Rep, int Exponent>
+    constexpr fixed_point<Rep, Exponent>
+    exp(const fixed_point<Rep, Exponent>& x) noexcept
+    {
+        using word = _fixed_point_impl::math_word<_impl::max(std::numeric_limits<Rep>::digits, -Exponent)>;
+        return _fixed_point_impl::exp2_result<Rep, Exponent>(_fixed_point_impl::exp_exponent<word>(x));
+    }
+
+    /// Calculates expm1(x), i.e. e^x-1
+    ///
+    /// Unlike exp(x)-1, retains the precision of the result for x close to zero.
+    ///
+    /// \sa exp
+    template<class Rep, int Exponent>
+    constexpr fixed_point<Rep, Exponent>
+    expm1(const fixed_point<Rep, Exponent>& x) noexcept
+    {
+        using word = _fixed_point_impl::math_word<_impl::max(std::numeric_limits<Rep>::digits, -Exponent)>;
+        return _fixed_point_impl::expm1_result<Rep, Exponent>(_fixed_point_impl::exp_exponent<word>(x));
+    }
+
+    /// Calculates x^n for an integer, n
+    ///
+    /// Evaluated by square-and-multiply on a normalized mantissa twice the width
+    /// of Rep. Accurate to 1LSB for 8-, 16- and 32-bit reps; for 64-bit reps,
+    /// error grows with the number of multiplications.
+    /// Calculated without conversion to floating-point.
+    ///
+    /// \tparam x the base as a fixed_point
+    /// \tparam n the exponent as an integer
+    ///
+    /// \return x to the power of n, in the same representation as x;
+    /// results which cannot be represented saturate
+    template<class Rep, int Exponent, class Integer, typename std::enable_if<
+            std::numeric_limits<Integer>::is_integer, int>::type Dummy = 0>
+    constexpr fixed_point<Rep, Exponent>
+    pow(const fixed_point<Rep, Exponent>& x, Integer n) noexcept
+    {
+        return _fixed_point_impl::integer_power(
+                x,
+                _fixed_point_impl::is_negative(n),
+                _fixed_point_impl::magnitude_of(n));
+    }
+
+    /// Calculates x^y
+    ///
+    /// Integer values of y are evaluated as by pow(x, n); other values are
+    /// evaluated as exp2(y*log2(x)) with 64-bit intermediate results.
+    /// Accurate to 1LSB for 8-, 16- and 32-bit reps; for 64-bit reps,
+    /// relative error grows with the magnitude of y.
+    /// Calculated without conversion to floating-point.
+    ///
+    /// \tparam x the base as a fixed_point
+    /// \tparam y the exponent as a fixed_point
+    ///
+    /// \return x to the power of y, in the same representation as x;
+    /// results which cannot be represented saturate
+    ///
+    /// \throws std::invalid_argument if x is negative, y is not an integer and exceptions are enabled;
+    /// otherwise, the result is calculated as if x were positive
+    template<class Rep, int Exponent, class YRep, int YExponent>
+    constexpr fixed_point<Rep, Exponent>
+    pow(const fixed_point<Rep, Exponent>& x, const fixed_point<YRep, YExponent>& y)
+    {
+        return
+#if defined(SG14_FIXED_POINT_EXCEPTIONS_ENABLED)
+                (x<fixed_point<Rep, Exponent>(0) && !_fixed_point_impl::is_integer(y))
+                ? throw std::invalid_argument("cannot represent non-integer power of negative value") :
+#endif
+                _fixed_point_impl::real_power(x, y);
+    }
 }
 
 #endif /* FIXED_POINT_MATH_H_ */
@@ -225,6 +225,185 @@ namespace sg14 {
         };
     }
 
+    ////////////////////////////////////////////////////////////////////////////////
+    // rounding policies of fixed_point conversion and of sg14::multiply and sg14::divide
+    //
+    // shift_right<Shift>(value) returns value/2^Shift, rounded;
+    // adjust(truncated, negative, half) rounds a result which was truncated toward zero
+    // given whether the discarded fraction is negative and whether its magnitude
+    // is less than (-1), equal to (0) or greater than (1) one half;
+    // a result which is already the lowest or highest value of Rep is not rounded past it
+
+    /// \brief discards the fractional bits of a result; the default behavior of \ref fixed_point
+    struct round_toward_zero {
+        template<int Shift, class Rep>
+        static constexpr Rep shift_right(Rep value)
+        {
+            return static_cast<Rep>(value/(Rep{1} << Shift));
+        }
+
+        template<class Rep>
+        static constexpr Rep adjust(Rep truncated, bool, int)
+        {
+            return truncated;
+        }
+    };
+
+    /// \brief rounds a result to nearest with ties rounded toward positive infinity
+    struct round_half_up {
+        template<int Shift, class Rep, typename std::enable_if<Shift==1, int>::type Dummy = 0>
+        static constexpr Rep shift_right(Rep value)
+        {
+            return static_cast<Rep>((value >> 1)+(value & 1));
+        }
+
+        // one extra add between two shifts; cannot overflow
+        template<int Shift, class Rep, typename std::enable_if<(Shift>1), int>::type Dummy = 0>
+        static constexpr Rep shift_right(Rep value)
+        {
+            return static_cast<Rep>(((value >> (Shift-1))+1) >> 1);
+        }
+
+        template<class Rep>
+        static constexpr Rep adjust(Rep truncated, bool negative, int half)
+        {
+            return negative
+                   ? static_cast<Rep>(truncated-(half>0 && truncated!=std::numeric_limits<Rep>::lowest()))
+                   : static_cast<Rep>(truncated+(half>=0 && truncated!=std::numeric_limits<Rep>::max()));
+        }
+    };
+
+    /// \brief rounds a result to nearest with ties rounded to even
+    struct round_half_even {
+        template<int Shift, class Rep, typename std::enable_if<Shift==1, int>::type Dummy = 0>
+        static constexpr Rep shift_right(Rep value)
+        {
+            return static_cast<Rep>((value >> 1)+(value & (value >> 1) & 1));
+        }
+
+        // as round_half_up except that an exact tie adds nothing to an even result
+        template<int Shift, class Rep, typename std::enable_if<(Shift>1), int>::type Dummy = 0>
+        static constexpr Rep shift_right(Rep value)
+        {
+            return static_cast<Rep>(((value >> (Shift-1))
+                    +(((value >> Shift) & 1) | ((value & ((Rep{1} << (Shift-1))-1))!=0))) >> 1);
+        }
+
+        template<class Rep>
+        static constexpr Rep adjust(Rep truncated, bool negative, int half)
+        {
+            return ((half>0 || (half==0 && (truncated & 1)))
+                    && truncated!=(negative ? std::numeric_limits<Rep>::lowest() : std::numeric_limits<Rep>::max()))
+                   ? static_cast<Rep>(negative ? truncated-1 : truncated+1)
+                   : truncated;
+        }
+    };
+
+    namespace _fixed_point_impl {
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fixed_point_impl::clamp_carry
+
+        // given a result truncated toward zero and the same result rounded away from it,
+        // a value which rounding carried past the highest or lowest value of a narrower Output is clamped to it;
+        // other values, including those truncated to outside the range of Output, are converted as by static_cast
+        template<class Output, class Larger>
+        constexpr Output clamp_carry(Larger rounded, Larger truncated)
+        {
+            return ((truncated==static_cast<Larger>(std::numeric_limits<Output>::max()) && truncated<rounded)
+                    || (truncated==static_cast<Larger>(std::numeric_limits<Output>::lowest()) && rounded<truncated))
+                   ? static_cast<Output>(truncated)
+                   : static_cast<Output>(rounded);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fixed_point_impl::rounding_shift_right
+
+        // as shift_right but bits shifted out are rounded according to RoundingPolicy
+        template<
+                class RoundingPolicy,
+                int Exponent,
+                class Output,
+                class Input,
+                typename std::enable_if<
+                        (Exponent<=0),
+                        int>::type Dummy = 0>
+        constexpr Output rounding_shift_right(Input i)
+        {
+            // no bits are lost
+            return shift_right<Exponent, Output>(i);
+        }
+
+        template<
+                class RoundingPolicy,
+                int Exponent,
+                class Output,
+                class Input,
+                typename std::enable_if<
+                        !(Exponent<=0),
+                        int>::type Dummy = 0>
+        constexpr Output rounding_shift_right(Input i)
+        {
+            using larger = typename std::conditional<
+                    width<Input>::value<=width<Output>::value,
+                    Output, Input>::type;
+            return clamp_carry<Output>(
+                    RoundingPolicy::template shift_right<Exponent>(static_cast<larger>(i)),
+                    shift_right<Exponent, larger>(i));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fixed_point_impl::round_fraction, sg14::_fixed_point_impl::round_quotient
+        // and sg14::_fixed_point_impl::clamped_quotient
+
+        // given a floating-point value truncated toward zero and the fraction discarded,
+        // returns the value rounded according to RoundingPolicy
+        template<class RoundingPolicy, class Rep, class S>
+        constexpr Rep round_fraction(Rep truncated, S fraction)
+        {
+            return RoundingPolicy::adjust(truncated, fraction<0,
+                    (fraction<S(-.5) || fraction>S(.5)) ? 1 : (fraction==S(-.5) || fraction==S(.5)) ? 0 : -1);
+        }
+
+        template<class Rep>
+        constexpr typename make_unsigned<Rep>::type magnitude(Rep value)
+        {
+            using unsigned_rep = typename make_unsigned<Rep>::type;
+            return (value<0) ? static_cast<unsigned_rep>(unsigned_rep{0}-static_cast<unsigned_rep>(value))
+                             : static_cast<unsigned_rep>(value);
+        }
+
+        // compares the magnitude of a remainder with half the magnitude of the divisor
+        template<class Unsigned>
+        constexpr int compare_half(Unsigned remainder, Unsigned divisor)
+        {
+            return (remainder>divisor-remainder) ? 1 : (remainder==divisor-remainder) ? 0 : -1;
+        }
+
+        template<class RoundingPolicy, class Rep>
+        constexpr Rep round_remainder(Rep quotient, Rep remainder, Rep divisor)
+        {
+            return RoundingPolicy::adjust(quotient, remainder!=0 && (remainder<0)!=(divisor<0),
+                    compare_half(magnitude(remainder), magnitude(divisor)));
+        }
+
+        // quotient of signed integers rounded according to RoundingPolicy
+        template<class RoundingPolicy, class Rep>
+        constexpr Rep round_quotient(Rep dividend, Rep divisor)
+        {
+            static_assert(std::is_signed<Rep>::value, "Rep must be signed");
+            return round_remainder<RoundingPolicy>(
+                    static_cast<Rep>(dividend/divisor), static_cast<Rep>(dividend%divisor), divisor);
+        }
+
+        // as round_quotient but converted to a narrower Output without rounding past its range
+        template<class Output, class RoundingPolicy, class Rep>
+        constexpr Output clamped_quotient(Rep dividend, Rep divisor)
+        {
+            return clamp_carry<Output>(
+                    round_quotient<RoundingPolicy>(dividend, divisor), static_cast<Rep>(dividend/divisor));
+        }
+    }
+
     /// \brief literal real number approximation that uses fixed-point arithmetic
     ///
     /// \tparam Rep the underlying type used to represent the value
@@ -297,6 +476,36 @@ namespace sg14 {
         {
         }
 
+        /// constructor taking an integer type and a rounding policy,
+        /// \ref round_toward_zero, \ref round_half_up or \ref round_half_even
+        ///
+        /// \note A value which rounds to one past the highest or lowest value of rep is clamped to it
+        /// rather than wrapping, consistent with the saturation of \ref requantize.
+        template<class S, class RoundingPolicy, typename std::enable_if<std::numeric_limits<S>::is_integer, int>::type Dummy = 0>
+        explicit constexpr fixed_point(S s, RoundingPolicy rounding)
+                :_r(integral_to_rep(s, rounding))
+        {
+        }
+
+        /// constructor taking a floating-point type and a rounding policy
+        template<class S, class RoundingPolicy, typename std::enable_if<std::is_floating_point<S>::value, int>::type Dummy = 0>
+        explicit constexpr fixed_point(S s, RoundingPolicy rounding)
+                :_r(floating_point_to_rep(s, rounding))
+        {
+        }
+
+        /// constructor taking a fixed-point type and a rounding policy
+        ///
+        /// \par Example
+        ///
+        /// To convert a value to a type with fewer fractional digits, rounding to nearest:
+        /// \snippet snippets.cpp convert with rounding
+        template<class FromRep, int FromExponent, class RoundingPolicy>
+        explicit constexpr fixed_point(const fixed_point<FromRep, FromExponent>& rhs, RoundingPolicy rounding)
+                :_r(fixed_point_to_rep(rhs, rounding))
+        {
+        }
+
         /// copy assignment operator taking an integer type
         template<class S, typename std::enable_if<is_integral<S>::value, int>::type Dummy = 0>
         fixed_point& operator=(S s)
@@ -387,6 +596,14 @@ namespace sg14 {
             return _fixed_point_impl::shift_right<exponent, rep>(s);
         }
 
+        template<class S, class RoundingPolicy>
+        static constexpr rep integral_to_rep(S s, RoundingPolicy)
+        {
+            static_assert(std::numeric_limits<S>::is_integer, "S must be unsigned integral type");
+
+            return _fixed_point_impl::rounding_shift_right<RoundingPolicy, exponent, rep>(s);
+        }
+
         template<class S>
         static constexpr S rep_to_integral(rep r)
         {
@@ -402,6 +619,14 @@ namespace sg14 {
             return static_cast<rep>(s*one<S>());
         }
 
+        template<class S, class RoundingPolicy>
+        static constexpr rep floating_point_to_rep(S s, RoundingPolicy)
+        {
+            static_assert(std::is_floating_point<S>::value, "S must be floating-point type");
+            return _fixed_point_impl::round_fraction<RoundingPolicy>(
+                    static_cast<rep>(s*one<S>()), s*one<S>()-static_cast<S>(static_cast<rep>(s*one<S>())));
+        }
+
         template<class S>
         static constexpr S rep_to_floating_point(rep r)
         {
@@ -415,6 +640,12 @@ namespace sg14 {
             return _fixed_point_impl::shift_right<(exponent-FromExponent), rep>(rhs.data());
         }
 
+        template<class FromRep, int FromExponent, class RoundingPolicy>
+        static constexpr rep fixed_point_to_rep(const fixed_point<FromRep, FromExponent>& rhs, RoundingPolicy)
+        {
+            return _fixed_point_impl::rounding_shift_right<RoundingPolicy, (exponent-FromExponent), rep>(rhs.data());
+        }
+
         ////////////////////////////////////////////////////////////////////////////////
         // variables
 
@@ -902,6 +1133,78 @@ namespace sg14 {
                 rhs);
     }
 
+    /// \brief calculates the product of two \ref fixed_point factors as a given type
+    ///
+    /// \tparam Result the \ref fixed_point type of the result
+    /// \param lhs, rhs the factors
+    /// \param rounding \ref round_toward_zero, \ref round_half_up or \ref round_half_even
+    ///
+    /// \return product: lhs * rhs, rounded to the precision of Result
+    ///
+    /// \note The exact product is formed in a widened rep and rounding
+    /// adds at most one operation to its conversion to Result.
+    ///
+    /// \par Example
+    ///
+    /// To multiply Q15 values:
+    /// \snippet snippets.cpp multiply with rounding
+
+    template<class Result, class RoundingPolicy, class Lhs, class Rhs>
+    constexpr Result multiply(const Lhs& lhs, const Rhs& rhs, RoundingPolicy rounding)
+    {
+        return Result(
+                _fixed_point_impl::operate<_fixed_point_impl::arithmetic_operator_tag, _impl::multiply_tag>(lhs, rhs),
+                rounding);
+    }
+
+    namespace _fixed_point_impl {
+        ////////////////////////////////////////////////////////////////////////////////
+        // sg14::_fixed_point_impl::rounding_divide_params
+
+        template<class Result, class Lhs, class Rhs>
+        struct rounding_divide_params {
+            using _binary_pair = binary_pair<Lhs, Rhs>;
+            using lhs_type = typename _binary_pair::lhs_type;
+            using rhs_type = typename _binary_pair::rhs_type;
+
+            // the dividend, or else the divisor, is scaled so that the quotient has the exponent of Result
+            static constexpr int scale = lhs_type::exponent-rhs_type::exponent-Result::exponent;
+            static constexpr int lhs_shift = _impl::max(scale, 0);
+            static constexpr int rhs_shift = _impl::max(-scale, 0);
+
+            using rep_op_result = _impl::op_result<_impl::multiply_tag, typename lhs_type::rep, typename rhs_type::rep>;
+            static constexpr int width = _impl::max<int>(
+                    _impl::max(lhs_type::digits+lhs_shift, rhs_type::digits+rhs_shift)+1,
+                    sg14::width<rep_op_result>::value);
+
+            // always signed so that the remainder may be compared with the divisor
+            using rep = set_width_t<_impl::make_signed_t<rep_op_result, true>, width>;
+        };
+    }
+
+    /// \brief calculates the quotient of two \ref fixed_point values as a given type
+    ///
+    /// \tparam Result the \ref fixed_point type of the result
+    /// \param lhs, rhs dividend and divisor
+    /// \param rounding \ref round_toward_zero, \ref round_half_up or \ref round_half_even
+    ///
+    /// \return quotient: lhs / rhs, rounded to the precision of Result
+    ///
+    /// \note Rounding is decided from the remainder of the same integer division.
+
+    template<class Result, class RoundingPolicy, class Lhs, class Rhs>
+    constexpr Result divide(const Lhs& lhs, const Rhs& rhs, RoundingPolicy)
+    {
+        using params = _fixed_point_impl::rounding_divide_params<Result, Lhs, Rhs>;
+        using rep = typename params::rep;
+        return Result::from_data(
+                _fixed_point_impl::clamped_quotient<typename Result::rep, RoundingPolicy>(
+                        _fixed_point_impl::shift_left<params::lhs_shift, rep>(
+                                static_cast<typename params::lhs_type>(lhs).data()),
+                        _fixed_point_impl::shift_left<params::rhs_shift, rep>(
+                                static_cast<typename params::rhs_type>(rhs).data())));
+    }
+
     ////////////////////////////////////////////////////////////////////////////////
     // (fixed_point @ fixed_point) comparison operators
 
@@ -1291,5 +1594,6 @@ namespace sg14 {
 }
 
 #include "bits/fixed_point_extras.h"
+#include "bits/fixed_point_math.h"
 
 #endif	// SG14_FIXED_POINT_H
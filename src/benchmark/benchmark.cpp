@@ -6,10 +6,33 @@
 
 #include "sample_functions.h"
 
+#include <sg14/auxiliary/accumulator.h>
+#include <sg14/auxiliary/batch.h>
+#include <sg14/auxiliary/biquad.h>
+#include <sg14/auxiliary/fft.h>
+#include <sg14/auxiliary/fir.h>
+#include <sg14/auxiliary/gemm.h>
+#include <sg14/auxiliary/geometry.h>
+#include <sg14/auxiliary/integer.h>
+#include <sg14/auxiliary/lut.h>
+#include <sg14/auxiliary/overflow_stats.h>
+#include <sg14/auxiliary/packed_array.h>
+#include <sg14/auxiliary/reciprocal.h>
+#include <sg14/auxiliary/reduce.h>
+#include <sg14/auxiliary/wide_integer.h>
 #include <sg14/bits/int128.h>
 
+#if defined(SG14_BOOST_ENABLED)
+#include <sg14/auxiliary/multiprecision.h>
+#endif
+
 #include <benchmark/benchmark.h>
 
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
 #define ESCAPE(X) escape_cppcon2015(&X)
 //#define ESCAPE(X) escape_codedive2015(&X)
 //#define ESCAPE(x) benchmark::DoNotOptimize(x)
@@ -113,6 +136,33 @@ static void div(benchmark::State& state)
     }
 }
 
+// multiplication and division without widening, as in sg14::multiply and sg14::divide
+template<typename T>
+static void bm_multiply(benchmark::State& state)
+{
+    auto factor1 = static_cast<T>(numeric_limits<T>::max()/int8_t{5});
+    auto factor2 = static_cast<T>(numeric_limits<T>::max()/int8_t{3});
+    while (state.KeepRunning()) {
+        ESCAPE(factor1);
+        ESCAPE(factor2);
+        auto value = sg14::multiply(factor1, factor2);
+        ESCAPE(value);
+    }
+}
+
+template<typename T>
+static void bm_divide(benchmark::State& state)
+{
+    auto nume = static_cast<T>(numeric_limits<T>::max()/int8_t{5});
+    auto denom = static_cast<T>(numeric_limits<T>::max()/int8_t{3});
+    while (state.KeepRunning()) {
+        ESCAPE(nume);
+        ESCAPE(denom);
+        auto value = sg14::divide(nume, denom);
+        ESCAPE(value);
+    }
+}
+
 template<typename T>
 static void bm_sqrt(benchmark::State& state)
 {
@@ -124,6 +174,749 @@ static void bm_sqrt(benchmark::State& state)
     }
 }
 
+// floating-point equivalent of sg14::rsqrt
+template<typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type Dummy = 0>
+static T rsqrt(T x)
+{
+    return T{1}/std::sqrt(x);
+}
+
+template<typename T>
+static void bm_rsqrt(benchmark::State& state)
+{
+    auto input = static_cast<T>(numeric_limits<T>::max()/int8_t{5});
+    while (state.KeepRunning()) {
+        ESCAPE(input);
+        auto output = rsqrt(input);
+        ESCAPE(output);
+    }
+}
+
+template<typename T>
+static void bm_exp2(benchmark::State& state)
+{
+    auto input = static_cast<T>(2.5);
+    while (state.KeepRunning()) {
+        ESCAPE(input);
+        auto output = exp2(input);
+        ESCAPE(output);
+    }
+}
+
+template<typename T>
+static void bm_atan2(benchmark::State& state)
+{
+    auto y = static_cast<T>(numeric_limits<T>::max()/int8_t{5});
+    auto x = static_cast<T>(numeric_limits<T>::max()/int8_t{-3});
+    while (state.KeepRunning()) {
+        ESCAPE(y);
+        ESCAPE(x);
+        auto output = atan2(y, x);
+        ESCAPE(output);
+    }
+}
+
+// sigmoid curve evaluated by std::tanh or by a 256-interval sg14::lut_function
+struct tanh_curve {
+    double operator()(double x) const
+    {
+        return std::tanh(x);
+    }
+};
+
+template<typename T, class Interpolation, typename std::enable_if<std::is_floating_point<T>::value, int>::type Dummy = 0>
+static T sigmoid(T x)
+{
+    return std::tanh(x);
+}
+
+template<typename T, class Interpolation, typename std::enable_if<!std::is_floating_point<T>::value, int>::type Dummy = 0>
+static T sigmoid(T x)
+{
+    static const auto curve = sg14::make_lut_function<T, T, 8, Interpolation>(tanh_curve{});
+    return curve(x);
+}
+
+template<typename T, class Interpolation>
+static void bm_sigmoid(benchmark::State& state)
+{
+    auto input = static_cast<T>(.75);
+    while (state.KeepRunning()) {
+        ESCAPE(input);
+        auto output = sigmoid<T, Interpolation>(input);
+        ESCAPE(output);
+    }
+}
+
+// element-wise arithmetic over arrays, one element at a time or using sg14 batch functions
+#define BM_ARRAY_OPERATION(name, op, batch_fn) \
+    struct name { \
+        template<typename T> \
+        void operator()(const T* lhs, const T* rhs, T* result, std::size_t size, std::false_type) const \
+        { \
+            for (auto index = std::size_t{0}; index!=size; ++index) { \
+                result[index] = static_cast<T>(lhs[index] op rhs[index]); \
+            } \
+        } \
+        template<typename T> \
+        void operator()(const T* lhs, const T* rhs, T* result, std::size_t size, std::true_type) const \
+        { \
+            sg14::batch_fn(lhs, rhs, result, size); \
+        } \
+    };
+
+BM_ARRAY_OPERATION(array_add, +, add)
+BM_ARRAY_OPERATION(array_subtract, -, subtract)
+BM_ARRAY_OPERATION(array_multiply, *, multiply)
+BM_ARRAY_OPERATION(array_divide, /, divide)
+
+template<typename T, class Operation, bool Batch>
+static void bm_array(benchmark::State& state)
+{
+    constexpr auto size = std::size_t{1024};
+    std::vector<T> lhs(size, static_cast<T>(.5)), rhs(size, static_cast<T>(-.75)), result(size, static_cast<T>(0));
+    while (state.KeepRunning()) {
+        ESCAPE(lhs[0]);
+        ESCAPE(rhs[0]);
+        Operation{}(lhs.data(), rhs.data(), result.data(), size, std::integral_constant<bool, Batch>{});
+        ESCAPE(result[0]);
+    }
+    state.SetItemsProcessed(state.iterations()*size);
+}
+
+// element-wise arithmetic over arrays of sg14::integer, e.g. native_integer versus the checks of throwing_integer
+template<typename T, class Operation>
+static void bm_integer_array(benchmark::State& state)
+{
+    constexpr auto size = std::size_t{1024};
+    std::vector<T> lhs, rhs, result(size, T{0});
+    for (auto index = std::size_t{0}; index!=size; ++index) {
+        lhs.push_back(static_cast<T>(index*7919));
+        rhs.push_back(static_cast<T>(index%13+1));
+    }
+    while (state.KeepRunning()) {
+        ESCAPE(lhs[0]);
+        ESCAPE(rhs[0]);
+        Operation{}(lhs.data(), rhs.data(), result.data(), size, std::false_type{});
+        ESCAPE(result[0]);
+    }
+    state.SetItemsProcessed(state.iterations()*size);
+}
+
+// division of an array by a loop-invariant divisor, directly or through sg14::reciprocal
+template<typename T>
+static void normalize(const T* values, T* result, std::size_t size, T total, std::false_type)
+{
+    for (auto index = std::size_t{0}; index!=size; ++index) {
+        result[index] = static_cast<T>(values[index]/total);
+    }
+}
+
+template<typename T>
+static void normalize(const T* values, T* result, std::size_t size, T total, std::true_type)
+{
+    auto const divisor = sg14::reciprocal<T>{total};
+    for (auto index = std::size_t{0}; index!=size; ++index) {
+        result[index] = static_cast<T>(values[index]/divisor);
+    }
+}
+
+// the same with sg14::divide, whose quotient is not widened, so that 64-bit reps need no 128-bit integer
+template<typename T>
+static void normalize_lean(const T* values, T* result, std::size_t size, T total, std::false_type)
+{
+    for (auto index = std::size_t{0}; index!=size; ++index) {
+        result[index] = static_cast<T>(sg14::divide(values[index], total));
+    }
+}
+
+template<typename T>
+static void normalize_lean(const T* values, T* result, std::size_t size, T total, std::true_type)
+{
+    auto const divisor = sg14::reciprocal<T>{total};
+    for (auto index = std::size_t{0}; index!=size; ++index) {
+        result[index] = static_cast<T>(divisor.divide(values[index]));
+    }
+}
+
+template<typename T, bool Reciprocal>
+static void bm_normalize(benchmark::State& state)
+{
+    constexpr auto size = std::size_t{1024};
+    std::vector<T> values(size, static_cast<T>(.5)), result(size);
+    auto total = static_cast<T>(3.75);
+    while (state.KeepRunning()) {
+        ESCAPE(values[0]);
+        ESCAPE(total);
+        normalize(values.data(), result.data(), size, total, std::integral_constant<bool, Reciprocal>{});
+        ESCAPE(result[0]);
+    }
+    state.SetItemsProcessed(state.iterations()*size);
+}
+
+template<typename T, bool Reciprocal>
+static void bm_normalize_lean(benchmark::State& state)
+{
+    constexpr auto size = std::size_t{1024};
+    std::vector<T> values(size, static_cast<T>(.5)), result(size);
+    auto total = static_cast<T>(3.75);
+    while (state.KeepRunning()) {
+        ESCAPE(values[0]);
+        ESCAPE(total);
+        normalize_lean(values.data(), result.data(), size, total, std::integral_constant<bool, Reciprocal>{});
+        ESCAPE(result[0]);
+    }
+    state.SetItemsProcessed(state.iterations()*size);
+}
+
+// reading a sg14::packed_array one element at a time or with packed_array::unpack
+template<typename T, int Bits>
+static void unpack(sg14::packed_array<T, Bits> const& packed, T* result, std::false_type)
+{
+    for (auto index = std::size_t{0}; index!=packed.size(); ++index) {
+        result[index] = packed[index];
+    }
+}
+
+template<typename T, int Bits>
+static void unpack(sg14::packed_array<T, Bits> const& packed, T* result, std::true_type)
+{
+    packed.unpack(0, result, packed.size());
+}
+
+template<typename T, int Bits, bool Bulk>
+static void bm_unpack(benchmark::State& state)
+{
+    constexpr auto size = std::size_t{1024};
+    sg14::packed_array<T, Bits> packed(size);
+    std::vector<T> result(size);
+    while (state.KeepRunning()) {
+        ESCAPE(packed);
+        unpack(packed, result.data(), std::integral_constant<bool, Bulk>{});
+        ESCAPE(result[0]);
+    }
+    state.SetItemsProcessed(state.iterations()*size);
+}
+
+// conversion of an array of float, one element at a time or with sg14::convert
+template<typename T>
+static void quantize(const float* samples, T* result, std::size_t size, std::false_type)
+{
+    for (auto index = std::size_t{0}; index!=size; ++index) {
+        result[index] = T{samples[index], sg14::round_half_even{}};
+    }
+}
+
+template<typename T>
+static void quantize(const float* samples, T* result, std::size_t size, std::true_type)
+{
+    sg14::convert(samples, result, size, sg14::round_half_even{});
+}
+
+template<typename T, bool Batch>
+static void bm_quantize(benchmark::State& state)
+{
+    constexpr auto size = std::size_t{1024};
+    std::vector<float> samples(size);
+    for (auto index = std::size_t{0}; index!=size; ++index) {
+        samples[index] = static_cast<float>(index%97)/97.f-.5f;
+    }
+    std::vector<T> result(size);
+    while (state.KeepRunning()) {
+        ESCAPE(samples[0]);
+        quantize(samples.data(), result.data(), size, std::integral_constant<bool, Batch>{});
+        ESCAPE(result[0]);
+    }
+    state.SetItemsProcessed(state.iterations()*size);
+}
+
+// conversion between fixed-point arrays, one element at a time or with sg14::requantize
+template<typename From, typename To>
+static void requantize_array(const From* from, To* result, std::size_t size, std::false_type)
+{
+    for (auto index = std::size_t{0}; index!=size; ++index) {
+        result[index] = To{from[index], sg14::round_half_even{}};
+    }
+}
+
+template<typename From, typename To>
+static void requantize_array(const From* from, To* result, std::size_t size, std::true_type)
+{
+    sg14::requantize(from, result, size, sg14::round_half_even{});
+}
+
+template<typename From, typename To, bool Batch>
+static void bm_requantize(benchmark::State& state)
+{
+    constexpr auto size = std::size_t{1024};
+    std::vector<From> from(size);
+    for (auto index = std::size_t{0}; index!=size; ++index) {
+        from[index] = static_cast<From>(static_cast<double>(index%97)/97.-.5);
+    }
+    std::vector<To> result(size);
+    while (state.KeepRunning()) {
+        ESCAPE(from[0]);
+        requantize_array(from.data(), result.data(), size, std::integral_constant<bool, Batch>{});
+        ESCAPE(result[0]);
+    }
+    state.SetItemsProcessed(state.iterations()*size);
+}
+
+// exact dot product, one product at a time or with sg14::accumulator::dot
+template<typename T, std::uintmax_t MaxTerms>
+static void dot_array(sg14::accumulator<T, MaxTerms>& sum, const T* lhs, const T* rhs, std::size_t size, std::false_type)
+{
+    for (auto index = std::size_t{0}; index!=size; ++index) {
+        sum.mac(lhs[index], rhs[index]);
+    }
+}
+
+template<typename T, std::uintmax_t MaxTerms>
+static void dot_array(sg14::accumulator<T, MaxTerms>& sum, const T* lhs, const T* rhs, std::size_t size, std::true_type)
+{
+    sum.dot(lhs, rhs, size);
+}
+
+template<typename T, bool Batch>
+static void bm_dot(benchmark::State& state)
+{
+    constexpr auto size = std::size_t{1024};
+    std::vector<T> lhs(size), rhs(size);
+    for (auto index = std::size_t{0}; index!=size; ++index) {
+        lhs[index] = static_cast<T>(static_cast<double>(index%97)/97.-.5);
+        rhs[index] = static_cast<T>(static_cast<double>(index%89)/89.-.5);
+    }
+    while (state.KeepRunning()) {
+        ESCAPE(lhs[0]);
+        sg14::accumulator<T, size> sum;
+        dot_array(sum, lhs.data(), rhs.data(), size, std::integral_constant<bool, Batch>{});
+        auto result = sum.template result<T>(sg14::round_half_even{});
+        ESCAPE(result);
+    }
+    state.SetItemsProcessed(state.iterations()*size);
+}
+
+// square matrix multiplication, a hand-rolled triple loop or sg14::gemm, reporting operations as items
+template<typename T>
+static void gemm_array(const T* lhs, const T* rhs, T* result, std::size_t size, unsigned, std::false_type)
+{
+    for (auto row = std::size_t{0}; row!=size; ++row) {
+        for (auto column = std::size_t{0}; column!=size; ++column) {
+            sg14::accumulator<T, 1024> sum;
+            for (auto index = std::size_t{0}; index!=size; ++index) {
+                sum.mac(lhs[row*size+index], rhs[index*size+column]);
+            }
+            result[row*size+column] = sum.template result<T>(sg14::round_half_even{});
+        }
+    }
+}
+
+template<typename T>
+static void gemm_array(const T* lhs, const T* rhs, T* result, std::size_t size, unsigned threads, std::true_type)
+{
+    sg14::gemm(lhs, rhs, result, size, size, size, sg14::round_half_even{}, threads);
+}
+
+template<typename T, bool Batch, unsigned Threads = 1>
+static void bm_gemm(benchmark::State& state)
+{
+    constexpr auto size = std::size_t{256};
+    std::vector<T> lhs(size*size), rhs(size*size), result(size*size);
+    for (auto index = std::size_t{0}; index!=size*size; ++index) {
+        lhs[index] = static_cast<T>(static_cast<double>(index%97)/97.-.5);
+        rhs[index] = static_cast<T>(static_cast<double>(index%89)/89.-.5);
+    }
+    while (state.KeepRunning()) {
+        ESCAPE(lhs[0]);
+        gemm_array(lhs.data(), rhs.data(), result.data(), size, Threads, std::integral_constant<bool, Batch>{});
+        ESCAPE(result[0]);
+    }
+    state.SetItemsProcessed(state.iterations()*2*size*size*size);
+}
+
+// 64-tap filter, each tap with operator* and operator+ or with sg14::fir
+template<typename T>
+static void filter_array(sg14::fir<T>&, const T* coefficients, const T* input, T* output, std::size_t size,
+        std::false_type)
+{
+    for (auto index = std::size_t{63}; index!=size; ++index) {
+        auto sum = decltype(coefficients[0]*input[0]){0};
+        for (auto tap = std::size_t{0}; tap!=64; ++tap) {
+            sum = sum+coefficients[tap]*input[index-tap];
+        }
+        output[index] = static_cast<T>(sum);
+    }
+}
+
+template<typename T>
+static void filter_array(sg14::fir<T>& filter, const T*, const T* input, T* output, std::size_t size, std::true_type)
+{
+    filter.process(input, output, size);
+}
+
+template<typename T, bool Batch>
+static void bm_fir(benchmark::State& state)
+{
+    constexpr auto size = std::size_t{1024};
+    std::vector<T> coefficients(64), input(size), output(size);
+    for (auto tap = std::size_t{0}; tap!=64; ++tap) {
+        coefficients[tap] = static_cast<T>(static_cast<double>(tap%13)/256.-.02);
+    }
+    for (auto index = std::size_t{0}; index!=size; ++index) {
+        input[index] = static_cast<T>(static_cast<double>(index%97)/97.-.5);
+    }
+    sg14::fir<T> filter(coefficients.data(), 64);
+    while (state.KeepRunning()) {
+        ESCAPE(input[0]);
+        filter_array(filter, coefficients.data(), input.data(), output.data(), size,
+                std::integral_constant<bool, Batch>{});
+        ESCAPE(output[0]);
+    }
+    state.SetItemsProcessed(state.iterations()*size);
+}
+
+// cascade of 8 biquads with 32-bit state, sg14::multiply and operator+ per section or sg14::biquad_cascade
+using biquad_coefficient = make_fixed<1, 14>;
+using biquad_state = make_fixed<3, 28>;
+
+template<typename T>
+static void biquad_array(sg14::biquad_cascade<T, biquad_coefficient, biquad_state>&,
+        std::vector<sg14::biquad_coefficients<biquad_coefficient>> const& sections, biquad_state* history,
+        const T* input, T* output, std::size_t size, std::false_type)
+{
+    for (auto index = std::size_t{0}; index!=size; ++index) {
+        auto x0 = static_cast<biquad_state>(input[index]);
+        for (auto section = std::size_t{0}; section!=sections.size(); ++section) {
+            auto const& c = sections[section];
+            auto state = history+section*4;
+            auto y0 = static_cast<biquad_state>(
+                    sg14::multiply(c.b0, x0)+sg14::multiply(c.b1, state[0])+sg14::multiply(c.b2, state[1])
+                    -sg14::multiply(c.a1, state[2])-sg14::multiply(c.a2, state[3]));
+            state[1] = state[0];
+            state[0] = x0;
+            state[3] = state[2];
+            state[2] = y0;
+            x0 = y0;
+        }
+        output[index] = static_cast<T>(x0);
+    }
+}
+
+template<typename T>
+static void biquad_array(sg14::biquad_cascade<T, biquad_coefficient, biquad_state>& cascade,
+        std::vector<sg14::biquad_coefficients<biquad_coefficient>> const&, biquad_state*,
+        const T* input, T* output, std::size_t size, std::true_type)
+{
+    cascade.process(input, output, size);
+}
+
+template<typename T, bool Batch>
+static void bm_biquad(benchmark::State& state)
+{
+    constexpr auto size = std::size_t{1024};
+    std::vector<sg14::biquad_coefficients<biquad_coefficient>> sections;
+    for (auto section = 0; section!=8; ++section) {
+        auto radius = .9-section*.05, angle = .2+section*.3;
+        sections.push_back(sg14::biquad_coefficients<biquad_coefficient>{
+                biquad_coefficient{.25}, biquad_coefficient{.5}, biquad_coefficient{.25},
+                biquad_coefficient{-2*radius*std::cos(angle)}, biquad_coefficient{radius*radius}});
+    }
+    std::vector<biquad_state> history(sections.size()*4, biquad_state{0});
+    std::vector<T> input(size), output(size);
+    for (auto index = std::size_t{0}; index!=size; ++index) {
+        input[index] = static_cast<T>(static_cast<double>(index%97)/97.-.5);
+    }
+    sg14::biquad_cascade<T, biquad_coefficient, biquad_state> cascade(sections.data(), sections.size());
+    while (state.KeepRunning()) {
+        ESCAPE(input[0]);
+        biquad_array(cascade, sections, history.data(), input.data(), output.data(), size,
+                std::integral_constant<bool, Batch>{});
+        ESCAPE(output[0]);
+    }
+    state.SetItemsProcessed(state.iterations()*size);
+}
+
+// radix-2 transform of interleaved floating-point values; the baseline of bm_fft and its reference
+template<typename Float>
+static std::vector<Float> float_fft_twiddles(std::size_t size)
+{
+    std::vector<Float> twiddles;
+    for (auto index = std::size_t{0}; index!=size/2; ++index) {
+        auto angle = -2*3.14159265358979323846*static_cast<double>(index)/static_cast<double>(size);
+        twiddles.push_back(static_cast<Float>(std::cos(angle)));
+        twiddles.push_back(static_cast<Float>(std::sin(angle)));
+    }
+    return twiddles;
+}
+
+template<typename Float>
+static void float_fft(Float* data, std::size_t size, const Float* twiddles)
+{
+    for (auto index = std::size_t{1}, reversed = std::size_t{0}; index!=size; ++index) {
+        auto bit = size >> 1;
+        for (; reversed & bit; bit >>= 1) {
+            reversed ^= bit;
+        }
+        reversed ^= bit;
+        if (index<reversed) {
+            std::swap(data[2*index], data[2*reversed]);
+            std::swap(data[2*index+1], data[2*reversed+1]);
+        }
+    }
+    for (auto half = std::size_t{1}; half!=size; half *= 2) {
+        auto stride = size/(2*half);
+        for (auto first = std::size_t{0}; first!=size; first += 2*half) {
+            for (auto index = std::size_t{0}; index!=half; ++index) {
+                auto w_real = twiddles[2*index*stride], w_imag = twiddles[2*index*stride+1];
+                auto a = data+2*(first+index), b = a+2*half;
+                auto t_real = b[0]*w_real-b[1]*w_imag, t_imag = b[0]*w_imag+b[1]*w_real;
+                b[0] = a[0]-t_real;
+                b[1] = a[1]-t_imag;
+                a[0] += t_real;
+                a[1] += t_imag;
+            }
+        }
+    }
+}
+
+template<typename T>
+static int fft_array(sg14::fft<T> const& transform, std::vector<float> const&, T* data, std::size_t)
+{
+    return transform.forward(data);
+}
+
+static int fft_array(sg14::fft<float> const*, std::vector<float> const& twiddles, float* data, std::size_t size)
+{
+    float_fft(data, size, twiddles.data());
+    return 0;
+}
+
+template<typename T>
+static sg14::fft<T> make_fft(std::size_t size, T const*)
+{
+    return sg14::fft<T>(size);
+}
+
+static sg14::fft<float> const* make_fft(std::size_t, float const*)
+{
+    return nullptr;
+}
+
+// labelled with the signal-to-noise ratio of the spectrum relative to float_fft<double>
+template<typename T>
+static void bm_fft(benchmark::State& state)
+{
+    constexpr auto size = std::size_t{1024};
+    std::vector<T> input(2*size), data(2*size);
+    for (auto index = std::size_t{0}; index!=2*size; ++index) {
+        input[index] = static_cast<T>(.25*std::cos(.3*static_cast<double>(index))
+                                      +.5*static_cast<double>(index%97)/97.-.25);
+    }
+    auto twiddles = float_fft_twiddles<float>(size);
+    auto transform = make_fft(size, input.data());
+
+    auto reference = std::vector<double>(input.begin(), input.end());
+    float_fft(reference.data(), size, float_fft_twiddles<double>(size).data());
+    data = input;
+    auto exponent = fft_array(transform, twiddles, data.data(), size);
+    auto signal = 0., noise = 0.;
+    for (auto index = std::size_t{0}; index!=2*size; ++index) {
+        auto error = std::ldexp(static_cast<double>(data[index]), exponent)-reference[index];
+        signal += reference[index]*reference[index];
+        noise += error*error;
+    }
+    state.SetLabel(std::to_string(10*std::log10(signal/noise))+" dB");
+
+    while (state.KeepRunning()) {
+        std::copy(input.begin(), input.end(), data.begin());
+        ESCAPE(data[0]);
+        exponent = fft_array(transform, twiddles, data.data(), size);
+        ESCAPE(data[0]);
+        ESCAPE(exponent);
+    }
+    state.SetItemsProcessed(state.iterations()*size);
+}
+
+// batch geometry of 65536 objects, one call per object versus the sg14/auxiliary/geometry.h batch functions
+constexpr auto geometry_size = std::size_t{65536};
+
+template<typename T>
+static sg14::vec3_array<T> geometry_vectors(int seed)
+{
+    sg14::vec3_array<T> vectors(geometry_size);
+    for (auto index = std::size_t{0}; index!=geometry_size; ++index) {
+        vectors.set(index, sg14::vec3<T>{
+                static_cast<T>(static_cast<double>((index*7+seed)%97)/97.*8.-4.),
+                static_cast<T>(static_cast<double>((index*3+seed)%89)/89.*8.-4.),
+                static_cast<T>(static_cast<double>((index*5+seed)%83)/83.*8.-4.)});
+    }
+    return vectors;
+}
+
+template<typename T>
+static std::vector<T> geometry_radii(int seed)
+{
+    std::vector<T> radii(geometry_size);
+    for (auto index = std::size_t{0}; index!=geometry_size; ++index) {
+        radii[index] = static_cast<T>(static_cast<double>((index*11+seed)%79)/79.*2.);
+    }
+    return radii;
+}
+
+template<typename T>
+static void intersects_array(sg14::vec2_array<T> const& centres, const T* radii,
+        sg14::vec2_array<T> const& other_centres, const T* other_radii, bool* result, std::false_type)
+{
+    for (auto index = std::size_t{0}; index!=centres.size(); ++index) {
+        result[index] = circle_intersect_generic(centres.x[index], centres.y[index], radii[index],
+                other_centres.x[index], other_centres.y[index], other_radii[index]);
+    }
+}
+
+template<typename T>
+static void intersects_array(sg14::vec2_array<T> const& centres, const T* radii,
+        sg14::vec2_array<T> const& other_centres, const T* other_radii, bool* result, std::true_type)
+{
+    sg14::intersects(centres, radii, other_centres, other_radii, result);
+}
+
+template<typename T, bool Batch>
+static void bm_intersects(benchmark::State& state)
+{
+    auto centres = geometry_vectors<T>(0), other_centres = geometry_vectors<T>(1);
+    auto radii = geometry_radii<T>(0), other_radii = geometry_radii<T>(1);
+    sg14::vec2_array<T> circles, other_circles;
+    circles.x = centres.x;
+    circles.y = centres.y;
+    other_circles.x = other_centres.x;
+    other_circles.y = other_centres.y;
+    std::unique_ptr<bool[]> result(new bool[geometry_size]);
+    while (state.KeepRunning()) {
+        ESCAPE(circles.x[0]);
+        ESCAPE(other_circles.x[0]);
+        intersects_array(circles, radii.data(), other_circles, other_radii.data(), result.get(),
+                std::integral_constant<bool, Batch>{});
+        ESCAPE(result[0]);
+    }
+    state.SetItemsProcessed(state.iterations()*geometry_size);
+}
+
+template<typename T>
+static void bm_distance_squared(benchmark::State& state)
+{
+    auto lhs = geometry_vectors<T>(0), rhs = geometry_vectors<T>(1);
+    std::vector<decltype(sg14::distance_squared(lhs[0], rhs[0]))> result(geometry_size);
+    while (state.KeepRunning()) {
+        ESCAPE(lhs.x[0]);
+        ESCAPE(rhs.x[0]);
+        sg14::distance_squared(lhs, rhs, result.data());
+        ESCAPE(result[0]);
+    }
+    state.SetItemsProcessed(state.iterations()*geometry_size);
+}
+
+template<typename T>
+static void bm_vec3_dot(benchmark::State& state)
+{
+    auto lhs = geometry_vectors<T>(0), rhs = geometry_vectors<T>(1);
+    std::vector<decltype(sg14::dot(lhs[0], rhs[0]))> result(geometry_size);
+    while (state.KeepRunning()) {
+        ESCAPE(lhs.x[0]);
+        ESCAPE(rhs.x[0]);
+        sg14::dot(lhs, rhs, result.data());
+        ESCAPE(result[0]);
+    }
+    state.SetItemsProcessed(state.iterations()*geometry_size);
+}
+
+template<typename T>
+static void bm_vec3_cross(benchmark::State& state)
+{
+    auto lhs = geometry_vectors<T>(0), rhs = geometry_vectors<T>(1);
+    sg14::vec3_array<decltype(sg14::dot(sg14::vec2<T>{}, sg14::vec2<T>{}))> result;
+    while (state.KeepRunning()) {
+        ESCAPE(lhs.x[0]);
+        ESCAPE(rhs.x[0]);
+        sg14::cross(lhs, rhs, result);
+        ESCAPE(result.x[0]);
+    }
+    state.SetItemsProcessed(state.iterations()*geometry_size);
+}
+
+// sum of 16M elements, std::accumulate of float versus sg14::sum on the given number of threads
+constexpr auto reduce_size = std::size_t{1} << 24;
+
+static float sum_array(std::vector<float> const& values, unsigned)
+{
+    return std::accumulate(values.begin(), values.end(), 0.f);
+}
+
+template<typename T>
+static auto sum_array(std::vector<T> const& values, unsigned threads)
+-> decltype(sg14::sum(values.data(), values.size(), threads))
+{
+    return sg14::sum(values.data(), values.size(), threads);
+}
+
+template<typename T, unsigned Threads = 1, std::size_t Size = reduce_size>
+static void bm_sum(benchmark::State& state)
+{
+    std::vector<T> values(Size);
+    for (auto index = std::size_t{0}; index!=Size; ++index) {
+        values[index] = static_cast<T>(static_cast<double>(index%97)/97.-.5);
+    }
+    while (state.KeepRunning()) {
+        ESCAPE(values[0]);
+        auto result = sum_array(values, Threads);
+        ESCAPE(result);
+    }
+    state.SetItemsProcessed(state.iterations()*Size);
+    state.SetBytesProcessed(state.iterations()*Size*sizeof(T));
+}
+
+template<typename T, unsigned Threads = 1>
+static void bm_max(benchmark::State& state)
+{
+    std::vector<T> values(reduce_size);
+    for (auto index = std::size_t{0}; index!=reduce_size; ++index) {
+        values[index] = static_cast<T>(static_cast<double>(index%97)/97.-.5);
+    }
+    while (state.KeepRunning()) {
+        ESCAPE(values[0]);
+        auto result = sg14::max(values.data(), values.size(), Threads);
+        ESCAPE(result);
+    }
+    state.SetItemsProcessed(state.iterations()*reduce_size);
+    state.SetBytesProcessed(state.iterations()*reduce_size*sizeof(T));
+}
+
+// float baseline of bm_gemm; a loop order which the compiler vectorizes
+static void bm_sgemm(benchmark::State& state)
+{
+    constexpr auto size = std::size_t{256};
+    std::vector<float> lhs(size*size), rhs(size*size), result(size*size);
+    for (auto index = std::size_t{0}; index!=size*size; ++index) {
+        lhs[index] = static_cast<float>(index%97)/97.f-.5f;
+        rhs[index] = static_cast<float>(index%89)/89.f-.5f;
+    }
+    while (state.KeepRunning()) {
+        ESCAPE(lhs[0]);
+        for (auto row = std::size_t{0}; row!=size; ++row) {
+            auto destination = result.data()+row*size;
+            std::fill(destination, destination+size, 0.f);
+            for (auto index = std::size_t{0}; index!=size; ++index) {
+                auto factor = lhs[row*size+index];
+                auto source = rhs.data()+index*size;
+                for (auto column = std::size_t{0}; column!=size; ++column) {
+                    destination[column] += factor*source[column];
+                }
+            }
+        }
+        ESCAPE(result[0]);
+    }
+    state.SetItemsProcessed(state.iterations()*2*size*size*size);
+}
+
 template<typename T>
 static void bm_magnitude_squared(benchmark::State& state)
 {
@@ -192,6 +985,19 @@ using u16_16 = make_ufixed<16, 16>;
 using s15_16 = make_fixed<15, 16>;
 using u32_32 = make_ufixed<32, 32>;
 using s31_32 = make_fixed<31, 32>;
+using s3_12 = make_fixed<3, 12>;
+using q15 = make_fixed<0, 15>;
+using q31 = make_fixed<0, 31>;
+using saturated_q15 = sg14::fixed_point<sg14::saturated_integer<std::int16_t>, -15>;
+using saturated_s15_16 = sg14::fixed_point<sg14::saturated_integer<std::int32_t>, -16>;
+using counting_q15 = sg14::fixed_point<sg14::counting_integer<std::int16_t>, -15>;
+using sticky_q15 = sg14::fixed_point<sg14::sticky_integer<std::int16_t>, -15>;
+using native_int64 = sg14::native_integer<std::int64_t>;
+using throwing_int64 = sg14::throwing_integer<std::int64_t>;
+using wide_s127_128 = sg14::fixed_point<sg14::wide_integer<256>, -128>;
+#if defined(SG14_BOOST_ENABLED)
+using multiprecision_s127_128 = sg14::fixed_point<sg14::multiprecision<256>, -128>;
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 // multi-type benchmark macros
@@ -252,5 +1058,172 @@ FIXED_POINT_BENCHMARK_REAL(bm_magnitude_squared);
 
 FIXED_POINT_BENCHMARK_REAL(bm_circle_intersect_generic);
 
-// tests involving unoptimized math function, sg14::sqrt
+// tests involving math functions, sg14::sqrt, sg14::rsqrt and sg14::atan2;
+// sg14::rsqrt supports reps of up to 32 bits
 FIXED_POINT_BENCHMARK_REAL(bm_sqrt);
+FIXED_POINT_BENCHMARK_FLOAT(bm_rsqrt);
+BENCHMARK_TEMPLATE1(bm_rsqrt, u4_4);
+BENCHMARK_TEMPLATE1(bm_rsqrt, s3_4);
+BENCHMARK_TEMPLATE1(bm_rsqrt, u8_8);
+BENCHMARK_TEMPLATE1(bm_rsqrt, s7_8);
+BENCHMARK_TEMPLATE1(bm_rsqrt, u16_16);
+BENCHMARK_TEMPLATE1(bm_rsqrt, s15_16);
+FIXED_POINT_BENCHMARK_REAL(bm_atan2);
+
+// sg14::exp2 evaluates fewer polynomial terms for narrower types
+BENCHMARK_TEMPLATE1(bm_exp2, float);
+BENCHMARK_TEMPLATE1(bm_exp2, s3_4);
+BENCHMARK_TEMPLATE1(bm_exp2, s7_8);
+BENCHMARK_TEMPLATE1(bm_exp2, s15_16);
+
+// std::tanh versus sg14::lut_function
+BENCHMARK_TEMPLATE(bm_sigmoid, float, void);
+BENCHMARK_TEMPLATE(bm_sigmoid, s3_12, sg14::linear_interpolation);
+BENCHMARK_TEMPLATE(bm_sigmoid, s3_12, sg14::quadratic_interpolation);
+
+// division by a loop-invariant divisor versus sg14::reciprocal
+BENCHMARK_TEMPLATE(bm_normalize, s7_8, false);
+BENCHMARK_TEMPLATE(bm_normalize, s7_8, true);
+BENCHMARK_TEMPLATE(bm_normalize, s15_16, false);
+BENCHMARK_TEMPLATE(bm_normalize, s15_16, true);
+#if defined(SG14_INT128_ENABLED)
+BENCHMARK_TEMPLATE(bm_normalize, s31_32, false);
+BENCHMARK_TEMPLATE(bm_normalize, s31_32, true);
+#endif
+BENCHMARK_TEMPLATE(bm_normalize_lean, s15_16, false);
+BENCHMARK_TEMPLATE(bm_normalize_lean, s15_16, true);
+#if defined(__SIZEOF_INT128__)
+BENCHMARK_TEMPLATE(bm_normalize_lean, s31_32, false);
+BENCHMARK_TEMPLATE(bm_normalize_lean, s31_32, true);
+#endif
+
+// array arithmetic, scalar loop versus sg14::add, sg14::multiply and sg14::divide
+BENCHMARK_TEMPLATE(bm_array, float, array_multiply, false);
+BENCHMARK_TEMPLATE(bm_array, q15, array_add, false);
+BENCHMARK_TEMPLATE(bm_array, q15, array_add, true);
+BENCHMARK_TEMPLATE(bm_array, q15, array_multiply, false);
+BENCHMARK_TEMPLATE(bm_array, q15, array_multiply, true);
+BENCHMARK_TEMPLATE(bm_array, q15, array_divide, false);
+BENCHMARK_TEMPLATE(bm_array, q15, array_divide, true);
+BENCHMARK_TEMPLATE(bm_array, q31, array_multiply, false);
+BENCHMARK_TEMPLATE(bm_array, q31, array_multiply, true);
+
+// saturated_integer array arithmetic, scalar loop versus saturating vector instructions;
+// the scalar loop adds reps promoted to int and clamps each sum back to 16 bits, so it trails q15,
+// whose sums simply wrap, while sg14::add uses saturating 16-bit adds and keeps pace with it
+BENCHMARK_TEMPLATE(bm_array, saturated_q15, array_add, false);
+BENCHMARK_TEMPLATE(bm_array, saturated_q15, array_add, true);
+BENCHMARK_TEMPLATE(bm_array, saturated_q15, array_multiply, false);
+BENCHMARK_TEMPLATE(bm_array, saturated_q15, array_multiply, true);
+BENCHMARK_TEMPLATE(bm_array, saturated_s15_16, array_add, false);
+BENCHMARK_TEMPLATE(bm_array, saturated_s15_16, array_multiply, false);
+
+// the cost of counting the overflow of saturated_integer, element-wise
+BENCHMARK_TEMPLATE(bm_array, counting_q15, array_add, false);
+BENCHMARK_TEMPLATE(bm_array, counting_q15, array_multiply, false);
+
+// saturated_integer with a sticky overflow flag, element-wise versus sg14::add, which raises it once per array
+BENCHMARK_TEMPLATE(bm_array, sticky_q15, array_add, false);
+BENCHMARK_TEMPLATE(bm_array, sticky_q15, array_add, true);
+
+// 64-bit integer arithmetic, unchecked versus a check for overflow per operation
+BENCHMARK_TEMPLATE(bm_integer_array, native_int64, array_add);
+BENCHMARK_TEMPLATE(bm_integer_array, throwing_int64, array_add);
+BENCHMARK_TEMPLATE(bm_integer_array, native_int64, array_subtract);
+BENCHMARK_TEMPLATE(bm_integer_array, throwing_int64, array_subtract);
+BENCHMARK_TEMPLATE(bm_integer_array, native_int64, array_multiply);
+BENCHMARK_TEMPLATE(bm_integer_array, throwing_int64, array_multiply);
+BENCHMARK_TEMPLATE(bm_integer_array, native_int64, array_divide);
+BENCHMARK_TEMPLATE(bm_integer_array, throwing_int64, array_divide);
+
+// 256-bit fixed-point arithmetic, sg14::wide_integer versus Boost.Multiprecision
+BENCHMARK_TEMPLATE1(add, wide_s127_128);
+BENCHMARK_TEMPLATE1(bm_multiply, wide_s127_128);
+BENCHMARK_TEMPLATE1(bm_divide, wide_s127_128);
+#if defined(SG14_BOOST_ENABLED)
+BENCHMARK_TEMPLATE1(add, multiprecision_s127_128);
+BENCHMARK_TEMPLATE1(bm_multiply, multiprecision_s127_128);
+BENCHMARK_TEMPLATE1(bm_divide, multiprecision_s127_128);
+#endif
+
+// sg14::packed_array, element-wise versus bulk unpack
+BENCHMARK_TEMPLATE(bm_unpack, s3_12, 12, false);
+BENCHMARK_TEMPLATE(bm_unpack, s3_12, 12, true);
+BENCHMARK_TEMPLATE(bm_unpack, s15_16, 20, false);
+BENCHMARK_TEMPLATE(bm_unpack, s15_16, 20, true);
+
+// float to fixed-point with rounding, element-wise versus saturating sg14::convert
+BENCHMARK_TEMPLATE(bm_quantize, q15, false);
+BENCHMARK_TEMPLATE(bm_quantize, q15, true);
+BENCHMARK_TEMPLATE(bm_quantize, q31, false);
+BENCHMARK_TEMPLATE(bm_quantize, q31, true);
+
+// fixed-point to narrower fixed-point with rounding, element-wise versus saturating sg14::requantize
+BENCHMARK_TEMPLATE(bm_requantize, s15_16, s7_8, false);
+BENCHMARK_TEMPLATE(bm_requantize, s15_16, s7_8, true);
+BENCHMARK_TEMPLATE(bm_requantize, q15, s3_4, false);
+BENCHMARK_TEMPLATE(bm_requantize, q15, s3_4, true);
+
+// exact sum of products, element-wise sg14::accumulator::mac versus sg14::accumulator::dot
+BENCHMARK_TEMPLATE(bm_dot, q15, false);
+BENCHMARK_TEMPLATE(bm_dot, q15, true);
+
+// 256x256 matrix multiplication, operations per second versus float
+BENCHMARK(bm_sgemm);
+BENCHMARK_TEMPLATE(bm_gemm, s3_4, false);
+BENCHMARK_TEMPLATE(bm_gemm, s3_4, true);
+BENCHMARK_TEMPLATE(bm_gemm, s3_4, true, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_gemm, q15, false);
+BENCHMARK_TEMPLATE(bm_gemm, q15, true);
+BENCHMARK_TEMPLATE(bm_gemm, q15, true, 4)->UseRealTime();
+
+// 64-tap filter of a block of samples, operator* and operator+ per tap versus sg14::fir
+BENCHMARK_TEMPLATE(bm_fir, q15, false);
+BENCHMARK_TEMPLATE(bm_fir, q15, true);
+
+// 8-section biquad cascade with 32-bit state, sg14::multiply per product versus sg14::biquad_cascade
+BENCHMARK_TEMPLATE(bm_biquad, q15, false);
+BENCHMARK_TEMPLATE(bm_biquad, q15, true);
+
+// 1024-point complex transform, float versus sg14::fft, each labelled with its signal-to-noise ratio
+BENCHMARK_TEMPLATE(bm_fft, float);
+BENCHMARK_TEMPLATE(bm_fft, q15);
+BENCHMARK_TEMPLATE(bm_fft, q31);
+
+// batch geometry of 65536 objects per iteration, in objects per second
+BENCHMARK_TEMPLATE(bm_intersects, float, false);
+BENCHMARK_TEMPLATE(bm_intersects, float, true);
+BENCHMARK_TEMPLATE(bm_intersects, s3_4, false);
+BENCHMARK_TEMPLATE(bm_intersects, s3_4, true);
+BENCHMARK_TEMPLATE(bm_intersects, s7_8, false);
+BENCHMARK_TEMPLATE(bm_intersects, s7_8, true);
+BENCHMARK_TEMPLATE(bm_intersects, s15_16, false);
+BENCHMARK_TEMPLATE(bm_intersects, s15_16, true);
+BENCHMARK_TEMPLATE(bm_distance_squared, float);
+BENCHMARK_TEMPLATE(bm_distance_squared, s3_4);
+BENCHMARK_TEMPLATE(bm_distance_squared, s7_8);
+BENCHMARK_TEMPLATE(bm_vec3_dot, float);
+BENCHMARK_TEMPLATE(bm_vec3_dot, s3_4);
+BENCHMARK_TEMPLATE(bm_vec3_dot, s7_8);
+BENCHMARK_TEMPLATE(bm_vec3_cross, float);
+BENCHMARK_TEMPLATE(bm_vec3_cross, s3_4);
+BENCHMARK_TEMPLATE(bm_vec3_cross, s7_8);
+#if defined(SG14_INT128_ENABLED)
+BENCHMARK_TEMPLATE(bm_distance_squared, s15_16);
+#endif
+
+// sum and maximum of 16M elements, single-threaded float versus sg14/auxiliary/reduce.h on 1, 2 and 4 threads
+BENCHMARK_TEMPLATE(bm_sum, float);
+BENCHMARK_TEMPLATE(bm_sum, s7_8);
+BENCHMARK_TEMPLATE(bm_sum, s7_8, 2)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_sum, s7_8, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_sum, s15_16);
+BENCHMARK_TEMPLATE(bm_sum, s15_16, 4)->UseRealTime();
+
+// on 64 threads, the 16M elements of which are read in a few hundred microseconds by a 64-core host,
+// and on 1M elements, where the threads would otherwise take longer to start than to sum them
+BENCHMARK_TEMPLATE(bm_sum, s15_16, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_sum, s7_8, 64, std::size_t{1} << 20)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_sum, s7_8, 1, std::size_t{1} << 20);
+BENCHMARK_TEMPLATE(bm_max, s7_8);
+BENCHMARK_TEMPLATE(bm_max, s7_8, 4)->UseRealTime();
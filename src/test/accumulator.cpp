@@ -0,0 +1,141 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief tests of sg14::accumulator
+
+#include <sg14/auxiliary/accumulator.h>
+
+#include "random_common.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using sg14::accumulator;
+using sg14::fixed_point;
+
+namespace {
+    using q15 = fixed_point<std::int16_t, -15>;
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // width of the sum
+
+    static_assert(accumulator<q15, 1>::digits==31, "sg14::accumulator test failed");
+    static_assert(std::is_same<accumulator<q15, 1>::rep, std::int32_t>::value, "sg14::accumulator test failed");
+    static_assert(accumulator<q15, 2>::digits==32, "sg14::accumulator test failed");
+    static_assert(std::is_same<accumulator<q15, 2>::rep, std::int64_t>::value, "sg14::accumulator test failed");
+    static_assert(accumulator<q15, 1024>::digits==41, "sg14::accumulator test failed");
+    static_assert(accumulator<q15, 1025>::digits==42, "sg14::accumulator test failed");
+    static_assert(std::is_same<accumulator<q15, 1024>::value_type, fixed_point<std::int64_t, -30>>::value,
+            "sg14::accumulator test failed");
+    static_assert(std::is_same<accumulator<fixed_point<std::int8_t, -7>, 256>::rep, std::int32_t>::value,
+            "sg14::accumulator test failed");
+    static_assert(std::is_same<accumulator<fixed_point<std::uint16_t, -16>, 1>::rep, std::uint32_t>::value,
+            "sg14::accumulator test failed");
+    static_assert(std::is_same<accumulator<fixed_point<std::uint16_t, -16>, 2>::rep, std::uint64_t>::value,
+            "sg14::accumulator test failed");
+    static_assert(std::is_same<accumulator<fixed_point<std::int32_t, -16>, 1>::rep, std::int64_t>::value,
+            "sg14::accumulator test failed");
+
+    static_assert(accumulator<q15, 4>{}.value()==0, "sg14::accumulator test failed");
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // sums compared with a 64-bit reference
+
+    // random values, every seventh of which is the lowest
+    template<class T>
+    std::vector<T> test_values(std::size_t size, std::mt19937& generator)
+    {
+        auto values = random_values<T>(size, generator);
+        for (auto index = std::size_t{3}; index<size; index += 7) {
+            values[index] = std::numeric_limits<T>::lowest();
+        }
+        return values;
+    }
+
+    template<class T, std::uintmax_t MaxTerms>
+    void test_dot()
+    {
+        std::mt19937 generator(MaxTerms);
+        for (auto size = std::size_t{0}; size<MaxTerms && size<400; size += 1+size/8) {
+            auto lhs = test_values<T>(size, generator);
+            auto rhs = test_values<T>(size, generator);
+
+            auto expected = 0LL;
+            for (auto index = std::size_t{0}; index!=size; ++index) {
+                expected += static_cast<long long>(lhs[index].data())*rhs[index].data();
+            }
+
+            accumulator<T, MaxTerms> batch;
+            batch.dot(lhs.data(), rhs.data(), size);
+            ASSERT_EQ(static_cast<long long>(batch.value().data()), expected) << "size=" << size;
+
+            accumulator<T, MaxTerms> scalar;
+            for (auto index = std::size_t{0}; index!=size; ++index) {
+                scalar.mac(lhs[index], rhs[index]);
+            }
+            ASSERT_EQ(static_cast<long long>(scalar.value().data()), expected) << "size=" << size;
+        }
+    }
+}
+
+TEST(accumulator, dot)
+{
+    test_dot<q15, 1>();
+    test_dot<q15, 1000>();
+    test_dot<fixed_point<std::int16_t, 0>, 1000>();
+    test_dot<fixed_point<std::int8_t, -4>, 1000>();
+    test_dot<fixed_point<std::uint16_t, -8>, 1000>();
+    test_dot<fixed_point<std::int32_t, -16>, 1>();
+}
+
+TEST(accumulator, extremes)
+{
+    // every pair of products is 2^31, longer than one block of the vectorized sum
+    constexpr auto size = std::size_t{600000};
+    auto lowest = q15::from_data(std::numeric_limits<std::int16_t>::lowest());
+    std::vector<q15> values(size, lowest);
+
+    accumulator<q15, size> sum;
+    sum.dot(values.data(), values.data(), size);
+    ASSERT_EQ(sum.value().data(), std::int64_t{size} << 30);
+    ASSERT_EQ(sum.value(), size);
+
+    auto highest = q15::from_data(std::numeric_limits<std::int16_t>::max());
+    std::vector<q15> highs(size, highest);
+    sum.clear();
+    sum.dot(values.data(), highs.data(), size);
+    ASSERT_EQ(sum.value().data(), -std::int64_t{size}*32768*32767);
+}
+
+TEST(accumulator, result)
+{
+    // .25+.125-.03125 followed by zeros
+    std::vector<q15> values(100, q15{0}), weights(100, q15{0});
+    values[0] = .5;
+    values[1] = .25;
+    values[99] = -.125;
+    weights[0] = .5;
+    weights[1] = .5;
+    weights[99] = .25;
+
+    accumulator<q15, 101> sum;
+    sum.dot(values.data(), weights.data(), values.size());
+    ASSERT_EQ(sum.value(), .34375);
+    ASSERT_EQ(sum.result<q15>(), q15{.34375});
+
+    // a single rescale, rounded
+    using q3 = fixed_point<std::int8_t, -3>;
+    ASSERT_EQ(sum.result<q3>(), q3{.25});
+    ASSERT_EQ(sum.result<q3>(sg14::round_half_up{}), q3{.375});
+
+    sum.mac(q15{-.5}, q15{.5});
+    ASSERT_EQ(sum.value(), .09375);
+}
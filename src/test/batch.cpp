@@ -0,0 +1,441 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief tests of batch arithmetic over, and conversion of, arrays of sg14::fixed_point values
+
+#include <sg14/auxiliary/batch.h>
+
+#include "random_common.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using sg14::fixed_point;
+
+namespace {
+    // arrays of random values interspersed with extremes;
+    // shift narrows the range to avoid overflowing built-in arithmetic
+    template<class T>
+    std::vector<T> test_values(std::size_t size, std::mt19937& generator, int shift, bool nonzero)
+    {
+        using rep = typename T::rep;
+        auto values = random_values<T>(size, generator, shift);
+        for (auto index = std::size_t{0}; index!=size; ++index) {
+            switch (index%11) {
+            case 3:
+                values[index] = T::from_data(static_cast<rep>(std::numeric_limits<rep>::min() >> shift));
+                break;
+            case 7:
+                values[index] = T::from_data(static_cast<rep>(std::numeric_limits<rep>::max() >> shift));
+                break;
+            }
+            if (nonzero && values[index].data()==0) {
+                values[index] = T::from_data(rep{1});
+            }
+        }
+        return values;
+    }
+
+    template<class Lhs, class Rhs, class Result, class Batch, class Scalar>
+    void test_batch(Batch batch, Scalar scalar, int shift, bool nonzero)
+    {
+        std::mt19937 generator(42);
+        for (auto size = std::size_t{0}; size<200; size += 1+size/16) {
+            auto lhs = test_values<Lhs>(size, generator, shift, false);
+            auto rhs = test_values<Rhs>(size, generator, shift, nonzero);
+            std::vector<Result> result(size);
+            batch(lhs.data(), rhs.data(), result.data(), size);
+            for (auto index = std::size_t{0}; index!=size; ++index) {
+                ASSERT_EQ(result[index].data(), static_cast<Result>(scalar(lhs[index], rhs[index])).data())
+                        << "size=" << size << " lhs=" << lhs[index] << " rhs=" << rhs[index];
+            }
+        }
+    }
+
+    template<class Lhs, class Rhs, class Result>
+    void test_add(int shift = 0)
+    {
+        test_batch<Lhs, Rhs, Result>(
+                [](const Lhs* lhs, const Rhs* rhs, Result* result, std::size_t size) {
+                    sg14::add(lhs, rhs, result, size);
+                },
+                [](Lhs lhs, Rhs rhs) { return lhs+rhs; }, shift, false);
+        test_batch<Lhs, Rhs, Result>(
+                [](const Lhs* lhs, const Rhs* rhs, Result* result, std::size_t size) {
+                    sg14::subtract(lhs, rhs, result, size);
+                },
+                [](Lhs lhs, Rhs rhs) { return lhs-rhs; }, shift, false);
+    }
+
+    template<class Lhs, class Rhs, class Result>
+    void test_multiply()
+    {
+        test_batch<Lhs, Rhs, Result>(
+                [](const Lhs* lhs, const Rhs* rhs, Result* result, std::size_t size) {
+                    sg14::multiply(lhs, rhs, result, size);
+                },
+                [](Lhs lhs, Rhs rhs) { return lhs*rhs; }, 0, false);
+    }
+
+    template<class Lhs, class Rhs, class Result>
+    void test_divide()
+    {
+        test_batch<Lhs, Rhs, Result>(
+                [](const Lhs* lhs, const Rhs* rhs, Result* result, std::size_t size) {
+                    sg14::divide(lhs, rhs, result, size);
+                },
+                [](Lhs lhs, Rhs rhs) { return lhs/rhs; }, 0, true);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // saturated_integer
+
+    // batch arithmetic of saturated_integer reps compared with scalar arithmetic and with clamped int64_t
+    template<class Rep, int Exponent>
+    void test_saturated(bool multiply)
+    {
+        using plain = fixed_point<Rep, Exponent>;
+        using saturated = fixed_point<sg14::saturated_integer<Rep>, Exponent>;
+        auto clamp = [](std::int64_t value) {
+            return static_cast<Rep>(std::max<std::int64_t>(std::min<std::int64_t>(
+                    value, std::numeric_limits<Rep>::max()), std::numeric_limits<Rep>::lowest()));
+        };
+
+        std::mt19937 generator(7);
+        for (auto size = std::size_t{0}; size<200; size += 1+size/16) {
+            std::vector<saturated> lhs, rhs;
+            for (auto value : test_values<plain>(size, generator, 0, false)) {
+                lhs.push_back(saturated::from_data(sg14::saturated_integer<Rep>(value.data())));
+            }
+            for (auto value : test_values<plain>(size, generator, 0, false)) {
+                rhs.push_back(saturated::from_data(sg14::saturated_integer<Rep>(value.data())));
+            }
+            std::vector<saturated> sums(size, saturated{0}), differences(size, saturated{0});
+            std::vector<saturated> products(size, saturated{0});
+            sg14::add(lhs.data(), rhs.data(), sums.data(), size);
+            sg14::subtract(lhs.data(), rhs.data(), differences.data(), size);
+            if (multiply) {
+                sg14::multiply(lhs.data(), rhs.data(), products.data(), size);
+            }
+            for (auto index = std::size_t{0}; index!=size; ++index) {
+                auto l = std::int64_t{lhs[index].data().data()}, r = std::int64_t{rhs[index].data().data()};
+                ASSERT_EQ(sums[index].data(), static_cast<saturated>(lhs[index]+rhs[index]).data());
+                ASSERT_EQ(sums[index].data(), clamp(l+r)) << "l=" << l << " r=" << r;
+                ASSERT_EQ(differences[index].data(), static_cast<saturated>(lhs[index]-rhs[index]).data());
+                ASSERT_EQ(differences[index].data(), clamp(l-r)) << "l=" << l << " r=" << r;
+                if (multiply) {
+                    ASSERT_EQ(products[index].data(), static_cast<saturated>(lhs[index]*rhs[index]).data());
+                    ASSERT_EQ(products[index].data(), clamp(l*r/(std::int64_t{1} << std::max(-Exponent, 0))))
+                                                << "l=" << l << " r=" << r;
+                }
+            }
+        }
+    }
+
+    // batch add and subtract of sticky_integer reps raise the overflow flag iff any element overflows
+    template<class Rep, int Exponent>
+    void test_sticky()
+    {
+        using sticky = fixed_point<sg14::sticky_integer<Rep>, Exponent>;
+        auto from_data = [](std::int64_t value) {
+            return sticky::from_data(sg14::sticky_integer<Rep>(static_cast<Rep>(value)));
+        };
+        auto greatest = std::int64_t{std::numeric_limits<Rep>::max()};
+        auto lowest = std::int64_t{std::numeric_limits<Rep>::lowest()};
+
+        for (auto size : {std::size_t{1}, std::size_t{64}, std::size_t{67}, std::size_t{200}}) {
+            // the halves of the greatest value neither overflow when added nor when subtracted from it
+            std::vector<sticky> lhs(size, from_data(greatest)), rhs(size, from_data(greatest/2));
+            std::vector<sticky> result(size, from_data(0));
+            sg14::clear_overflow();
+            sg14::subtract(lhs.data(), rhs.data(), result.data(), size);
+            sg14::add(rhs.data(), rhs.data(), result.data(), size);
+            ASSERT_FALSE(sg14::test_overflow()) << "size=" << size;
+
+            // one overflow in any position is detected
+            for (auto position = std::size_t{0}; position<size; position += 1+position/4) {
+                lhs[position] = from_data(greatest/2+2);
+                sg14::clear_overflow();
+                sg14::add(lhs.data(), rhs.data(), result.data(), size);
+                ASSERT_TRUE(sg14::test_overflow()) << "size=" << size << " position=" << position;
+                ASSERT_EQ(result[position].data(), greatest) << "size=" << size << " position=" << position;
+
+                lhs[position] = from_data(lowest);
+                sg14::clear_overflow();
+                sg14::subtract(lhs.data(), rhs.data(), result.data(), size);
+                ASSERT_TRUE(sg14::test_overflow()) << "size=" << size << " position=" << position;
+                ASSERT_EQ(result[position].data(), lowest);
+                lhs[position] = from_data(greatest);
+            }
+        }
+        sg14::clear_overflow();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // conversion
+
+    // random floating-point values either side of the range of T
+    // interspersed with ties, extremes, infinities and NaN
+    template<class T, class Float>
+    std::vector<Float> random_floats(std::size_t size, std::mt19937& generator)
+    {
+        using rep = typename T::rep;
+        auto lowest = static_cast<Float>(std::numeric_limits<T>::lowest());
+        auto max = static_cast<Float>(std::numeric_limits<T>::max());
+        auto epsilon = static_cast<Float>(std::numeric_limits<T>::epsilon());
+        std::uniform_real_distribution<Float> distribution(lowest*Float(1.25)-1, max*Float(1.25)+1);
+        std::uniform_int_distribution<long long> ties(
+                std::numeric_limits<rep>::lowest()/2, std::numeric_limits<rep>::max()/2);
+        std::vector<Float> values;
+        for (auto index = std::size_t{0}; index!=size; ++index) {
+            auto value = distribution(generator);
+            switch (index%13) {
+            case 1:
+                value = (static_cast<Float>(ties(generator))+Float(.5))*epsilon;
+                break;
+            case 4:
+                value = std::numeric_limits<Float>::quiet_NaN();
+                break;
+            case 5:
+                value = (index%2) ? std::numeric_limits<Float>::infinity() : -std::numeric_limits<Float>::infinity();
+                break;
+            case 8:
+                value = (index%2) ? lowest : max;
+                break;
+            case 9:
+                value = (index%2) ? lowest-epsilon/2 : max+epsilon/2;
+                break;
+            case 11:
+                value = -epsilon/2;
+                break;
+            }
+            values.push_back(value);
+        }
+        return values;
+    }
+
+    // rounds and saturates in double precision
+    template<class T, class RoundingPolicy, class NanPolicy, class Float>
+    T reference_convert(Float from)
+    {
+        using rep = typename T::rep;
+        auto scaled = static_cast<double>(from)/static_cast<double>(std::numeric_limits<T>::epsilon());
+        if (std::isnan(scaled)) {
+            return T::from_data(NanPolicy::template value<rep>());
+        }
+        auto rounded = std::is_same<RoundingPolicy, sg14::round_toward_zero>::value
+                       ? std::trunc(scaled)
+                       : std::is_same<RoundingPolicy, sg14::round_half_up>::value
+                         ? std::floor(scaled+.5)
+                         : std::nearbyint(scaled);
+        auto clamped = std::min(std::max(rounded, static_cast<double>(std::numeric_limits<rep>::lowest())),
+                static_cast<double>(std::numeric_limits<rep>::max()));
+        return T::from_data(static_cast<rep>(clamped));
+    }
+
+    template<class T, class Float, class RoundingPolicy, class NanPolicy>
+    void test_convert()
+    {
+        std::mt19937 generator(7);
+        for (auto size = std::size_t{0}; size<200; size += 1+size/16) {
+            auto from = random_floats<T, Float>(size, generator);
+            std::vector<T> to(size);
+            sg14::convert(from.data(), to.data(), size, RoundingPolicy{}, NanPolicy{});
+            for (auto index = std::size_t{0}; index!=size; ++index) {
+                ASSERT_EQ(to[index].data(), (reference_convert<T, RoundingPolicy, NanPolicy>(from[index]).data()))
+                        << "size=" << size << " from=" << from[index];
+            }
+
+            std::vector<Float> back(size);
+            sg14::convert(to.data(), back.data(), size);
+            for (auto index = std::size_t{0}; index!=size; ++index) {
+                ASSERT_EQ(back[index], static_cast<Float>(to[index])) << "size=" << size;
+            }
+        }
+    }
+
+    template<class T, class Float>
+    void test_convert()
+    {
+        test_convert<T, Float, sg14::round_toward_zero, sg14::nan_to_zero>();
+        test_convert<T, Float, sg14::round_half_up, sg14::nan_to_zero>();
+        test_convert<T, Float, sg14::round_half_even, sg14::nan_to_lowest>();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // requantization
+
+    // value*2^-shift rounded and clamped using 64-bit integers
+    template<class To, class RoundingPolicy>
+    To reference_requantize(long long value, int shift)
+    {
+        using rep = typename To::rep;
+        if (shift<=0) {
+            auto scaled = static_cast<double>(value)*std::ldexp(1., -shift);
+            auto clamped = std::min(std::max(scaled, static_cast<double>(std::numeric_limits<rep>::lowest())),
+                    static_cast<double>(std::numeric_limits<rep>::max()));
+            return To::from_data(static_cast<rep>(clamped));
+        }
+        auto denominator = 1LL << shift;
+        auto floor = value/denominator-(value%denominator<0);
+        auto remainder = value-floor*denominator;
+        auto rounded = std::is_same<RoundingPolicy, sg14::round_toward_zero>::value
+                       ? value/denominator
+                       : std::is_same<RoundingPolicy, sg14::round_half_up>::value
+                         ? floor+(remainder*2>=denominator)
+                         : floor+(remainder*2>denominator || (remainder*2==denominator && (floor & 1)));
+        return To::from_data(static_cast<rep>(std::min<long long>(std::max<long long>(
+                rounded, std::numeric_limits<rep>::lowest()), std::numeric_limits<rep>::max())));
+    }
+
+    template<class From, class To, class RoundingPolicy>
+    void test_requantize()
+    {
+        constexpr int shift = To::exponent-From::exponent;
+        std::mt19937 generator(shift+64);
+        for (auto size = std::size_t{0}; size<200; size += 1+size/16) {
+            auto from = test_values<From>(size, generator, 0, false);
+            std::vector<To> to(size);
+            sg14::requantize(from.data(), to.data(), size, RoundingPolicy{});
+            for (auto index = std::size_t{0}; index!=size; ++index) {
+                ASSERT_EQ(to[index].data(),
+                        (reference_requantize<To, RoundingPolicy>(static_cast<long long>(from[index].data()), shift).data()))
+                        << "size=" << size << " from=" << from[index];
+            }
+        }
+    }
+
+    template<class From, class To>
+    void test_requantize()
+    {
+        test_requantize<From, To, sg14::round_toward_zero>();
+        test_requantize<From, To, sg14::round_half_up>();
+        test_requantize<From, To, sg14::round_half_even>();
+    }
+}
+
+TEST(batch, add)
+{
+    test_add<fixed_point<std::int8_t, -7>, fixed_point<std::int8_t, -7>, fixed_point<std::int8_t, -7>>();
+    test_add<fixed_point<std::uint8_t, -4>, fixed_point<std::uint8_t, -4>, fixed_point<std::uint8_t, -4>>();
+    test_add<fixed_point<std::int16_t, -15>, fixed_point<std::int16_t, -15>, fixed_point<std::int16_t, -15>>();
+    test_add<fixed_point<std::uint16_t, 2>, fixed_point<std::uint16_t, 2>, fixed_point<std::uint16_t, 2>>();
+    test_add<fixed_point<std::int32_t, -16>, fixed_point<std::int32_t, -16>, fixed_point<std::int32_t, -16>>(1);
+    test_add<fixed_point<std::uint32_t, -16>, fixed_point<std::uint32_t, -16>, fixed_point<std::uint32_t, -16>>();
+    test_add<fixed_point<std::int64_t, -32>, fixed_point<std::int64_t, -32>, fixed_point<std::int64_t, -32>>(1);
+
+    // mixed types take the scalar path
+    test_add<fixed_point<std::int16_t, -15>, fixed_point<std::int16_t, -7>, fixed_point<std::int32_t, -15>>();
+}
+
+TEST(batch, multiply)
+{
+    test_multiply<fixed_point<std::int16_t, -15>, fixed_point<std::int16_t, -15>, fixed_point<std::int16_t, -15>>();
+    test_multiply<fixed_point<std::int16_t, -16>, fixed_point<std::int16_t, -16>, fixed_point<std::int16_t, -16>>();
+    test_multiply<fixed_point<std::int16_t, -8>, fixed_point<std::int16_t, -8>, fixed_point<std::int16_t, -8>>();
+    test_multiply<fixed_point<std::int16_t, 0>, fixed_point<std::int16_t, 0>, fixed_point<std::int16_t, 0>>();
+    test_multiply<fixed_point<std::uint16_t, -16>, fixed_point<std::uint16_t, -16>, fixed_point<std::uint16_t, -16>>();
+    test_multiply<fixed_point<std::uint16_t, -5>, fixed_point<std::uint16_t, -5>, fixed_point<std::uint16_t, -5>>();
+    test_multiply<fixed_point<std::int32_t, -31>, fixed_point<std::int32_t, -31>, fixed_point<std::int32_t, -31>>();
+    test_multiply<fixed_point<std::int32_t, -32>, fixed_point<std::int32_t, -32>, fixed_point<std::int32_t, -32>>();
+    test_multiply<fixed_point<std::int32_t, -16>, fixed_point<std::int32_t, -16>, fixed_point<std::int32_t, -16>>();
+    test_multiply<fixed_point<std::uint32_t, -32>, fixed_point<std::uint32_t, -32>, fixed_point<std::uint32_t, -32>>();
+    test_multiply<fixed_point<std::uint32_t, 0>, fixed_point<std::uint32_t, 0>, fixed_point<std::uint32_t, 0>>();
+
+    // exact product
+    test_multiply<fixed_point<std::int16_t, -15>, fixed_point<std::int16_t, -15>, fixed_point<std::int32_t, -30>>();
+}
+
+TEST(batch, saturated)
+{
+    test_saturated<std::int8_t, -7>(false);
+    test_saturated<std::uint8_t, -4>(false);
+    test_saturated<std::int16_t, -15>(true);
+    test_saturated<std::int16_t, -16>(true);
+    test_saturated<std::int16_t, -8>(true);
+    test_saturated<std::int16_t, 0>(true);
+    test_saturated<std::uint16_t, 2>(false);
+    test_saturated<std::int32_t, -16>(true);
+}
+
+TEST(batch, sticky)
+{
+    test_sticky<std::int8_t, -7>();
+    test_sticky<std::uint8_t, 0>();
+    test_sticky<std::int16_t, -15>();
+    test_sticky<std::uint16_t, -8>();
+}
+
+TEST(batch, divide)
+{
+    test_divide<fixed_point<std::int16_t, -15>, fixed_point<std::int16_t, -15>, fixed_point<std::int16_t, -15>>();
+    test_divide<fixed_point<std::int16_t, -8>, fixed_point<std::int16_t, -8>, fixed_point<std::int16_t, -8>>();
+    test_divide<fixed_point<std::int16_t, 0>, fixed_point<std::int16_t, 0>, fixed_point<std::int16_t, 0>>();
+    test_divide<fixed_point<std::int32_t, -16>, fixed_point<std::int32_t, -16>, fixed_point<std::int32_t, -16>>();
+    test_divide<fixed_point<std::uint16_t, -8>, fixed_point<std::uint16_t, -8>, fixed_point<std::uint16_t, -8>>();
+}
+
+TEST(batch, in_place)
+{
+    using q15 = fixed_point<std::int16_t, -15>;
+    std::vector<q15> values(37, q15(-.5));
+    std::vector<q15> factors(37, q15(.25));
+    sg14::multiply(values.data(), factors.data(), values.data(), values.size());
+    for (auto value : values) {
+        ASSERT_EQ(value, q15(-.125));
+    }
+}
+
+TEST(batch, convert)
+{
+    test_convert<fixed_point<std::int8_t, -7>, float>();
+    test_convert<fixed_point<std::uint8_t, -4>, float>();
+    test_convert<fixed_point<std::int16_t, -15>, float>();
+    test_convert<fixed_point<std::int16_t, 3>, float>();
+    test_convert<fixed_point<std::uint16_t, -8>, float>();
+    test_convert<fixed_point<std::int32_t, -16>, float>();
+    test_convert<fixed_point<std::int32_t, -31>, float>();
+
+    // scalar path
+    test_convert<fixed_point<std::uint32_t, -16>, float>();
+    test_convert<fixed_point<std::int16_t, -15>, double>();
+    test_convert<fixed_point<std::int32_t, -24>, double>();
+}
+
+TEST(batch, requantize)
+{
+    // narrowing
+    test_requantize<fixed_point<std::int32_t, -16>, fixed_point<std::int16_t, -8>>();
+    test_requantize<fixed_point<std::int16_t, -15>, fixed_point<std::int8_t, -7>>();
+    test_requantize<fixed_point<std::int16_t, -15>, fixed_point<std::uint8_t, -8>>();
+    test_requantize<fixed_point<std::uint16_t, -8>, fixed_point<std::int8_t, -4>>();
+    test_requantize<fixed_point<std::int32_t, -31>, fixed_point<std::int8_t, 0>>();
+    test_requantize<fixed_point<std::int32_t, -24>, fixed_point<std::int16_t, -16>>();
+
+    // scaling up saturates
+    test_requantize<fixed_point<std::int16_t, -8>, fixed_point<std::int16_t, -12>>();
+    test_requantize<fixed_point<std::int32_t, -16>, fixed_point<std::int32_t, -20>>();
+    test_requantize<fixed_point<std::int8_t, -7>, fixed_point<std::int32_t, -24>>();
+    test_requantize<fixed_point<std::int8_t, 0>, fixed_point<std::int32_t, -31>>();
+    test_requantize<fixed_point<std::uint8_t, 0>, fixed_point<std::uint8_t, -1>>();
+
+    // widening and same exponent
+    test_requantize<fixed_point<std::int8_t, -7>, fixed_point<std::int16_t, -7>>();
+    test_requantize<fixed_point<std::int32_t, -8>, fixed_point<std::int16_t, -8>>();
+
+    // scalar path
+    test_requantize<fixed_point<std::int64_t, -32>, fixed_point<std::int16_t, -15>>();
+    test_requantize<fixed_point<std::int32_t, -16>, fixed_point<std::uint32_t, -8>>();
+    test_requantize<fixed_point<std::int16_t, -15>, fixed_point<std::uint16_t, -16>>();
+    test_requantize<fixed_point<std::int32_t, -40>, fixed_point<std::int8_t, 0>>();
+}
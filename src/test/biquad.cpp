@@ -0,0 +1,258 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief tests of sg14::biquad_cascade
+
+#include <sg14/auxiliary/biquad.h>
+
+#include "random_common.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using sg14::biquad_cascade;
+using sg14::biquad_coefficients;
+using sg14::fixed_point;
+using sg14::make_fixed;
+
+namespace {
+    using q15 = fixed_point<std::int16_t, -15>;
+    using s1_14 = make_fixed<1, 14>;
+    using s3_28 = make_fixed<3, 28>;
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // cascades compared with a direct form I summed in 64 bits
+
+    // a resonator with poles at radius*e^(+-j*angle) and zeros at +-1
+    template<class Coefficient>
+    biquad_coefficients<Coefficient> resonator(double gain, double radius, double angle)
+    {
+        return biquad_coefficients<Coefficient>{
+                Coefficient{gain}, Coefficient{0}, Coefficient{-gain},
+                Coefficient{-2*radius*std::cos(angle)}, Coefficient{radius*radius}};
+    }
+
+    template<class State, class RoundingPolicy, class Sample, class Coefficient>
+    std::vector<Sample> reference(std::vector<Sample> const& input, std::vector<biquad_coefficients<Coefficient>> const& sections)
+    {
+        using sum = fixed_point<std::int64_t, State::exponent+Coefficient::exponent>;
+        std::vector<State> signal(input.size());
+        sg14::requantize(input.data(), signal.data(), input.size(), RoundingPolicy{});
+        for (auto const& c : sections) {
+            auto x1 = std::int64_t{0}, x2 = std::int64_t{0}, y1 = std::int64_t{0}, y2 = std::int64_t{0};
+            for (auto& element : signal) {
+                auto x0 = std::int64_t{element.data()};
+                auto total = sum::from_data(c.b0.data()*x0+c.b1.data()*x1+c.b2.data()*x2
+                                            -c.a1.data()*y1-c.a2.data()*y2);
+                sg14::requantize(&total, &element, 1, RoundingPolicy{});
+                x2 = x1;
+                x1 = x0;
+                y2 = y1;
+                y1 = element.data();
+            }
+        }
+        std::vector<Sample> output(input.size());
+        sg14::requantize(signal.data(), output.data(), signal.size(), RoundingPolicy{});
+        return output;
+    }
+
+    // sizes of consecutive calls to process, some of which span blocks, followed by the remainder
+    const std::vector<std::size_t> chunks{1, 0, 7, 300, 256, 2, 513, 31};
+
+    template<class Sample, class Coefficient, class State, class Form, class RoundingPolicy>
+    std::vector<Sample> process(std::vector<Sample> input, std::vector<biquad_coefficients<Coefficient>> const& sections)
+    {
+        biquad_cascade<Sample, Coefficient, State, Form, RoundingPolicy> cascade(sections.data(), sections.size());
+        EXPECT_EQ(cascade.sections(), sections.size());
+        auto first = std::size_t{0};
+        for (auto chunk : chunks) {
+            cascade.process(input.data()+first, input.data()+first, chunk);
+            first += chunk;
+        }
+        cascade.process(input.data()+first, input.data()+first, input.size()-first);
+        return input;
+    }
+
+    template<class Sample, class Coefficient, class State, class RoundingPolicy = sg14::round_toward_zero>
+    void test_cascade(std::vector<biquad_coefficients<Coefficient>> const& sections)
+    {
+        std::mt19937 generator(static_cast<unsigned>(sections.size()));
+        auto input = random_values<Sample>(1110, generator);
+        auto expected = reference<State, RoundingPolicy>(input, sections);
+        ASSERT_EQ((process<Sample, Coefficient, State, sg14::direct_form_1, RoundingPolicy>(input, sections)),
+                expected);
+        ASSERT_EQ((process<Sample, Coefficient, State, sg14::transposed_direct_form_2, RoundingPolicy>(input, sections)),
+                expected);
+    }
+
+    // the largest magnitude of the last of size outputs given an impulse followed by silence
+    template<class Form, class State, class RoundingPolicy>
+    int ringing(biquad_coefficients<s1_14> const& section, std::size_t size)
+    {
+        std::vector<q15> signal(size*2, q15{0});
+        signal[0] = q15{.9};
+        biquad_cascade<q15, s1_14, State, Form, RoundingPolicy> cascade(&section, 1);
+        cascade.process(signal.data(), signal.data(), signal.size());
+        auto greatest = 0;
+        for (auto index = size; index!=signal.size(); ++index) {
+            greatest = std::max(greatest, std::abs(int{signal[index].data()}));
+        }
+        return greatest;
+    }
+}
+
+TEST(biquad, impulse)
+{
+    // y[n] = x[n]/2 + y[n-1]/2
+    const biquad_coefficients<s1_14> section{s1_14{.5}, s1_14{0}, s1_14{0}, s1_14{-.5}, s1_14{0}};
+    biquad_cascade<q15> cascade(&section, 1);
+    q15 signal[] = {q15{.5}, q15{0}, q15{0}, q15{0}};
+    cascade.process(signal, signal, 4);
+    ASSERT_EQ(signal[0], .25);
+    ASSERT_EQ(signal[1], .125);
+    ASSERT_EQ(signal[2], .0625);
+    ASSERT_EQ(signal[3], .03125);
+
+    // continued from the state of the previous call, until reset
+    q15 silence[] = {q15{0}};
+    cascade.process(silence, silence, 1);
+    ASSERT_EQ(silence[0], .015625);
+    cascade.reset();
+    cascade.process(silence, silence, 1);
+    ASSERT_EQ(silence[0], 0);
+}
+
+TEST(biquad, q15)
+{
+    test_cascade<q15, s1_14, q15>({resonator<s1_14>(.1, .9, .3)});
+    test_cascade<q15, s1_14, q15, sg14::round_half_even>({resonator<s1_14>(.1, .9, .3), resonator<s1_14>(.5, .5, 2.)});
+}
+
+TEST(biquad, state)
+{
+    auto sections = std::vector<biquad_coefficients<s1_14>>{
+            resonator<s1_14>(.05, .99, .05), resonator<s1_14>(.2, .95, 1.), resonator<s1_14>(.3, .7, 2.5)};
+    test_cascade<q15, s1_14, s3_28>(sections);
+    test_cascade<q15, s1_14, s3_28, sg14::round_half_up>(sections);
+    test_cascade<fixed_point<std::int8_t, -7>, s1_14, make_fixed<7, 16>, sg14::round_half_even>(sections);
+    test_cascade<q15, make_fixed<2, 13>, make_fixed<4, 27>>({resonator<make_fixed<2, 13>>(.01, .999, .01)});
+}
+
+TEST(biquad, groups)
+{
+    // a group of four sections, a pair and a last section
+    auto sections = std::vector<biquad_coefficients<s1_14>>();
+    for (auto section = 0; section!=7; ++section) {
+        sections.push_back(resonator<s1_14>(.4, .95-section*.05, .1+section*.4));
+    }
+    test_cascade<q15, s1_14, s3_28>(sections);
+    test_cascade<q15, s1_14, s3_28, sg14::round_half_even>(sections);
+}
+
+#if defined(SG14_INT128_ENABLED)
+TEST(biquad, wide_coefficients)
+{
+    // 32-bit coefficients and states are summed in 128 bits
+    using s1_30 = make_fixed<1, 30>;
+    using s0_31 = make_fixed<0, 31>;
+    const auto sections = std::vector<biquad_coefficients<s1_30>>{
+            resonator<s1_30>(.002, .99, .01), resonator<s1_30>(1., .5, 1.)};
+    std::mt19937 generator(1);
+    auto input = random_values<q15>(1110, generator);
+    auto df1 = process<q15, s1_30, s0_31, sg14::direct_form_1, sg14::round_half_even>(input, sections);
+    ASSERT_EQ((process<q15, s1_30, s0_31, sg14::transposed_direct_form_2, sg14::round_half_even>(input, sections)),
+            df1);
+
+    // compared with the same cascade in double precision
+    auto signal = std::vector<double>(input.begin(), input.end());
+    for (auto const& c : sections) {
+        auto x1 = 0., x2 = 0., y1 = 0., y2 = 0.;
+        for (auto& element : signal) {
+            auto y0 = static_cast<double>(c.b0)*element+static_cast<double>(c.b1)*x1+static_cast<double>(c.b2)*x2
+                      -static_cast<double>(c.a1)*y1-static_cast<double>(c.a2)*y2;
+            x2 = x1;
+            x1 = element;
+            y2 = y1;
+            y1 = y0;
+            element = y0;
+        }
+    }
+    for (auto index = std::size_t{0}; index!=signal.size(); ++index) {
+        ASSERT_NEAR(static_cast<double>(df1[index]), std::max(std::min(signal[index], 1.), -1.), 1./32768)
+                                    << "index=" << index;
+    }
+}
+#endif
+
+TEST(biquad, saturation)
+{
+    // gain of 1.5 followed by gain of .5
+    const biquad_coefficients<s1_14> sections[] = {
+            {s1_14{1.5}, s1_14{0}, s1_14{0}, s1_14{0}, s1_14{0}},
+            {s1_14{.5}, s1_14{0}, s1_14{0}, s1_14{0}, s1_14{0}}};
+    q15 signal[] = {q15{.75}, q15{-.75}};
+
+    // the state saturates between sections
+    biquad_cascade<q15> narrow(sections, 2);
+    narrow.process(signal, signal, 2);
+    ASSERT_EQ(signal[0], .5-1./32768);
+    ASSERT_EQ(signal[1], -.5);
+
+    // unless it has integer digits to spare
+    signal[0] = q15{.75};
+    signal[1] = q15{-.75};
+    biquad_cascade<q15, s1_14, s3_28> wide(sections, 2);
+    wide.process(signal, signal, 2);
+    ASSERT_EQ(signal[0], .5625);
+    ASSERT_EQ(signal[1], -.5625);
+}
+
+TEST(biquad, limit_cycles)
+{
+    // resonators whose response decays below 2^-15 well before 10000 samples
+    const auto low = resonator<s1_14>(.01, .99, .05);
+    const auto high = resonator<s1_14>(.01, .99, 2.);
+
+    // rounding to nearest to the precision of the output sustains oscillation
+    ASSERT_GT((ringing<sg14::direct_form_1, q15, sg14::round_half_even>(low, 10000)), 100);
+    ASSERT_GT((ringing<sg14::direct_form_1, q15, sg14::round_half_even>(high, 10000)), 0);
+
+    // which fractional digits of state keep below the precision of the output
+    ASSERT_EQ((ringing<sg14::direct_form_1, s3_28, sg14::round_half_even>(low, 10000)), 0);
+    ASSERT_EQ((ringing<sg14::direct_form_1, s3_28, sg14::round_half_even>(high, 10000)), 0);
+    ASSERT_EQ((ringing<sg14::transposed_direct_form_2, s3_28, sg14::round_half_even>(low, 10000)), 0);
+
+    // and which error feedback stops where poles are close to z=1
+    ASSERT_EQ((ringing<sg14::direct_form_1_error_feedback, q15, sg14::round_half_even>(low, 10000)), 0);
+
+    // as does rounding toward zero
+    ASSERT_EQ((ringing<sg14::direct_form_1, q15, sg14::round_toward_zero>(low, 10000)), 0);
+    ASSERT_EQ((ringing<sg14::direct_form_1, q15, sg14::round_toward_zero>(high, 10000)), 0);
+}
+
+TEST(biquad, error_feedback)
+{
+    // the sum of the outputs of a section with unity gain at DC equals that of its inputs to within a state LSB
+    const biquad_coefficients<s1_14> section{s1_14{.25}, s1_14{0}, s1_14{0}, s1_14{-.75}, s1_14{0}};
+    std::mt19937 generator(3);
+    auto input = random_values<q15>(4096, generator);
+    input.insert(input.end(), 100, q15{0});
+    auto output = process<q15, s1_14, q15, sg14::direct_form_1_error_feedback, sg14::round_toward_zero>(
+            input, {section});
+
+    auto input_sum = std::int64_t{0}, output_sum = std::int64_t{0};
+    for (auto index = std::size_t{0}; index!=input.size(); ++index) {
+        input_sum += input[index].data();
+        output_sum += output[index].data();
+    }
+    ASSERT_LE(std::abs(input_sum-output_sum), 1);
+}
@@ -0,0 +1,178 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief tests of sg14::fft
+
+#include <sg14/auxiliary/fft.h>
+
+#include "random_common.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using sg14::fixed_point;
+
+namespace {
+    using q15 = fixed_point<std::int16_t, -15>;
+    using q31 = fixed_point<std::int32_t, -31>;
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // transforms compared with a direct discrete Fourier transform in long double
+
+    template<class Element>
+    std::vector<std::complex<long double>> to_complex(std::vector<Element> const& values, int exponent)
+    {
+        std::vector<std::complex<long double>> result;
+        for (auto index = std::size_t{0}; index!=values.size(); index += 2) {
+            result.emplace_back(std::ldexp(static_cast<long double>(values[index]), exponent),
+                    std::ldexp(static_cast<long double>(values[index+1]), exponent));
+        }
+        return result;
+    }
+
+    // the discrete Fourier transform or, with sign 1, the inverse transform divided by size
+    std::vector<std::complex<long double>> dft(std::vector<std::complex<long double>> const& input, int sign)
+    {
+        auto size = input.size();
+        std::vector<std::complex<long double>> roots;
+        for (auto index = std::size_t{0}; index!=size; ++index) {
+            auto angle = sign*2*3.14159265358979323846264338327950288L*static_cast<long double>(index)/size;
+            roots.emplace_back(std::cos(angle), std::sin(angle));
+        }
+        std::vector<std::complex<long double>> output(size);
+        for (auto k = std::size_t{0}; k!=size; ++k) {
+            for (auto n = std::size_t{0}; n!=size; ++n) {
+                output[k] += input[n]*roots[(k*n)%size];
+            }
+            if (sign>0) {
+                output[k] /= static_cast<long double>(size);
+            }
+        }
+        return output;
+    }
+
+    // signal-to-noise ratio of actual in decibels, where expected is the signal
+    double snr(std::vector<std::complex<long double>> const& expected, std::vector<std::complex<long double>> const& actual)
+    {
+        auto signal = 0.L, noise = 0.L;
+        for (auto index = std::size_t{0}; index!=expected.size(); ++index) {
+            signal += std::norm(expected[index]);
+            noise += std::norm(actual[index]-expected[index]);
+        }
+        return static_cast<double>(10*std::log10(signal/noise));
+    }
+
+    // size complex values whose components are random to within shift bits of the range of Element
+    template<class Element>
+    void test_fft(std::size_t size, int shift, double minimum_snr)
+    {
+        std::mt19937 generator(static_cast<unsigned>(size));
+        auto data = random_values<Element>(2*size, generator, shift);
+        auto input = to_complex(data, 0);
+
+        sg14::fft<Element> transform(size);
+        ASSERT_EQ(transform.size(), size);
+        auto exponent = transform.forward(data.data());
+        auto spectrum = to_complex(data, exponent);
+        ASSERT_GT(snr(dft(input, -1), spectrum), minimum_snr) << "size=" << size;
+
+        // the inverse of the output, which is the spectrum scaled down
+        exponent += transform.inverse(data.data());
+        ASSERT_GT(snr(dft(spectrum, 1), to_complex(data, exponent)), minimum_snr) << "size=" << size;
+        ASSERT_GT(snr(input, to_complex(data, exponent)), minimum_snr-6) << "size=" << size;
+    }
+}
+
+TEST(fft, impulse)
+{
+    // a unit impulse at 0 has a flat spectrum
+    std::vector<q15> data(16, q15{0});
+    data[0] = q15{.5};
+    sg14::fft<q15> transform(8);
+    auto exponent = transform.forward(data.data());
+    for (auto index = std::size_t{0}; index!=8; ++index) {
+        ASSERT_EQ(std::ldexp(static_cast<double>(data[2*index]), exponent), .5);
+        ASSERT_EQ(data[2*index+1], 0);
+    }
+
+    // and back
+    exponent += transform.inverse(data.data());
+    ASSERT_EQ(std::ldexp(static_cast<double>(data[0]), exponent), .5);
+    for (auto index = std::size_t{1}; index!=16; ++index) {
+        ASSERT_EQ(data[index], 0);
+    }
+}
+
+TEST(fft, tone)
+{
+    // e^(2*pi*i*3*n/64) is all in bin 3
+    constexpr auto size = std::size_t{64};
+    std::vector<q15> data;
+    for (auto n = std::size_t{0}; n!=size; ++n) {
+        auto angle = 2*3.14159265358979323846*3*static_cast<double>(n)/size;
+        data.push_back(q15{.75*std::cos(angle)});
+        data.push_back(q15{.75*std::sin(angle)});
+    }
+    auto exponent = sg14::fft<q15>(size).forward(data.data());
+    for (auto k = std::size_t{0}; k!=size; ++k) {
+        auto expected = (k==3) ? .75*size : 0.;
+        ASSERT_NEAR(std::ldexp(static_cast<double>(data[2*k]), exponent), expected, .01*size) << "k=" << k;
+        ASSERT_NEAR(std::ldexp(static_cast<double>(data[2*k+1]), exponent), 0., .01*size) << "k=" << k;
+    }
+}
+
+TEST(fft, q15)
+{
+    test_fft<q15>(1, 0, 90);
+    test_fft<q15>(2, 0, 80);
+    test_fft<q15>(4, 0, 75);
+    test_fft<q15>(32, 1, 65);
+    test_fft<q15>(128, 0, 62);
+    test_fft<q15>(1024, 6, 58);
+    test_fft<fixed_point<std::int16_t, -8>>(512, 0, 60);
+}
+
+TEST(fft, q31)
+{
+    test_fft<q31>(2, 0, 170);
+    test_fft<q31>(64, 1, 158);
+    test_fft<q31>(2048, 0, 150);
+}
+
+TEST(fft, extremes)
+{
+    // the lowest value throughout sums to size times it in bin 0
+    constexpr auto size = std::size_t{256};
+    std::vector<q15> data(2*size, q15::from_data(std::numeric_limits<std::int16_t>::lowest()));
+    auto exponent = sg14::fft<q15>(size).forward(data.data());
+    ASSERT_EQ(std::ldexp(static_cast<double>(data[0]), exponent), -1.*size);
+    ASSERT_EQ(std::ldexp(static_cast<double>(data[1]), exponent), -1.*size);
+    for (auto index = std::size_t{2}; index!=2*size; ++index) {
+        ASSERT_EQ(data[index], 0);
+    }
+
+    // and zero is transformed without scaling
+    std::vector<q31> zeros(2*size, q31{0});
+    ASSERT_EQ(sg14::fft<q31>(size).forward(zeros.data()), 0);
+}
+
+#if defined(SG14_EXCEPTIONS_ENABLED)
+TEST(fft, invalid_size)
+{
+    ASSERT_THROW(sg14::fft<q15>(0), std::invalid_argument);
+    ASSERT_THROW(sg14::fft<q15>(3), std::invalid_argument);
+    ASSERT_THROW(sg14::fft<q31>(384), std::invalid_argument);
+    ASSERT_EQ(sg14::fft<q15>(1).size(), 1u);
+}
+#endif
@@ -0,0 +1,197 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief tests of sg14::fir, sg14::fir_decimator and sg14::fir_interpolator
+
+#include <sg14/auxiliary/fir.h>
+
+#include "random_common.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using sg14::fixed_point;
+
+namespace {
+    using q15 = fixed_point<std::int16_t, -15>;
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // filters compared with a direct convolution summed in 64 bits
+
+    // random samples, two in every eleven of which are the lowest
+    template<class T>
+    std::vector<T> random_samples(std::size_t size, std::mt19937& generator)
+    {
+        auto samples = random_values<T>(size, generator);
+        for (auto index = std::size_t{0}; index!=size; ++index) {
+            if (index%11<2) {
+                samples[index] = std::numeric_limits<T>::lowest();
+            }
+        }
+        return samples;
+    }
+
+    template<class RoundingPolicy, class Sample, class Coefficient>
+    std::vector<Sample> convolve(std::vector<Sample> const& input, std::vector<Coefficient> const& coefficients)
+    {
+        using sum = fixed_point<std::int64_t, Sample::exponent+Coefficient::exponent>;
+        std::vector<Sample> output(input.size());
+        for (auto index = std::size_t{0}; index!=input.size(); ++index) {
+            auto total = std::int64_t{0};
+            for (auto tap = std::size_t{0}; tap!=coefficients.size() && tap<=index; ++tap) {
+                total += std::int64_t{coefficients[tap].data()}*input[index-tap].data();
+            }
+            auto exact = sum::from_data(total);
+            sg14::requantize(&exact, &output[index], 1, RoundingPolicy{});
+        }
+        return output;
+    }
+
+    // sizes of consecutive calls to process, some of which span blocks
+    const std::vector<std::size_t> chunks{1, 0, 7, 300, 256, 2, 513, 31};
+
+    template<class Sample, class Coefficient, class RoundingPolicy = sg14::round_toward_zero>
+    void test_fir(std::size_t taps)
+    {
+        std::mt19937 generator(static_cast<unsigned>(taps));
+        auto coefficients = random_samples<Coefficient>(taps, generator);
+        auto input = random_samples<Sample>(1110, generator);
+        auto expected = convolve<RoundingPolicy>(input, coefficients);
+
+        sg14::fir<Sample, Coefficient, RoundingPolicy> filter(coefficients.data(), taps);
+        ASSERT_EQ(filter.taps(), taps);
+        std::vector<Sample> output(input.size());
+        auto first = std::size_t{0};
+        for (auto chunk : chunks) {
+            filter.process(input.data()+first, output.data()+first, chunk);
+            first += chunk;
+        }
+        ASSERT_EQ(first, input.size());
+        for (auto index = std::size_t{0}; index!=output.size(); ++index) {
+            ASSERT_EQ(output[index], expected[index]) << "taps=" << taps << " index=" << index;
+        }
+
+        // in place, after a reset
+        filter.reset();
+        filter.process(input.data(), input.data(), input.size());
+        ASSERT_EQ(input, expected);
+    }
+
+    template<class Sample, class Coefficient, class RoundingPolicy = sg14::round_toward_zero>
+    void test_decimator(std::size_t taps, std::size_t factor)
+    {
+        std::mt19937 generator(static_cast<unsigned>(taps*factor));
+        auto coefficients = random_samples<Coefficient>(taps, generator);
+        auto input = random_samples<Sample>(1110, generator);
+        auto filtered = convolve<RoundingPolicy>(input, coefficients);
+
+        sg14::fir_decimator<Sample, Coefficient, RoundingPolicy> filter(coefficients.data(), taps, factor);
+        std::vector<Sample> output(input.size());
+        auto first = std::size_t{0};
+        auto written = std::size_t{0};
+        for (auto chunk : chunks) {
+            auto count = filter.process(input.data()+first, output.data()+written, chunk);
+            ASSERT_LE(count, (chunk+factor-1)/factor);
+            first += chunk;
+            written += count;
+        }
+        ASSERT_EQ(written, (input.size()+factor-1)/factor);
+        for (auto index = std::size_t{0}; index!=written; ++index) {
+            ASSERT_EQ(output[index], filtered[index*factor]) << "factor=" << factor << " index=" << index;
+        }
+    }
+
+    template<class Sample, class Coefficient, class RoundingPolicy = sg14::round_toward_zero>
+    void test_interpolator(std::size_t taps, std::size_t factor)
+    {
+        std::mt19937 generator(static_cast<unsigned>(taps+factor));
+        auto coefficients = random_samples<Coefficient>(taps, generator);
+        auto input = random_samples<Sample>(1110, generator);
+
+        // the input with factor-1 zeros after each sample
+        std::vector<Sample> stuffed(input.size()*factor, Sample{0});
+        for (auto index = std::size_t{0}; index!=input.size(); ++index) {
+            stuffed[index*factor] = input[index];
+        }
+        auto expected = convolve<RoundingPolicy>(stuffed, coefficients);
+
+        sg14::fir_interpolator<Sample, Coefficient, RoundingPolicy> filter(coefficients.data(), taps, factor);
+        std::vector<Sample> output(stuffed.size());
+        auto first = std::size_t{0};
+        for (auto chunk : chunks) {
+            filter.process(input.data()+first, output.data()+first*factor, chunk);
+            first += chunk;
+        }
+        for (auto index = std::size_t{0}; index!=output.size(); ++index) {
+            ASSERT_EQ(output[index], expected[index]) << "factor=" << factor << " index=" << index;
+        }
+    }
+}
+
+TEST(fir, q15)
+{
+    test_fir<q15, q15>(1);
+    test_fir<q15, q15>(16);
+    test_fir<q15, q15, sg14::round_half_even>(31);
+    test_fir<q15, fixed_point<std::int16_t, -14>, sg14::round_half_up>(129);
+}
+
+TEST(fir, mixed)
+{
+    test_fir<fixed_point<std::int8_t, -7>, fixed_point<std::int8_t, -6>>(5);
+    test_fir<fixed_point<std::int8_t, -4>, q15, sg14::round_half_even>(40);
+    test_fir<fixed_point<std::int16_t, -8>, fixed_point<std::uint8_t, -8>>(17);
+}
+
+TEST(fir, decimator)
+{
+    test_decimator<q15, q15>(1, 1);
+    test_decimator<q15, q15, sg14::round_half_even>(24, 2);
+    test_decimator<q15, q15>(33, 3);
+    test_decimator<fixed_point<std::int8_t, -7>, fixed_point<std::int8_t, -7>>(9, 7);
+}
+
+TEST(fir, interpolator)
+{
+    test_interpolator<q15, q15>(1, 1);
+    test_interpolator<q15, q15, sg14::round_half_even>(24, 2);
+    test_interpolator<q15, q15>(31, 4);
+    test_interpolator<fixed_point<std::int8_t, -7>, fixed_point<std::int8_t, -7>>(2, 5);
+}
+
+TEST(fir, moving_average)
+{
+    // four taps of 1/4
+    const q15 quarter{.25};
+    const q15 coefficients[] = {quarter, quarter, quarter, quarter};
+    sg14::fir<q15> filter(coefficients, 4);
+
+    const q15 input[] = {q15{.5}, q15{.5}, q15{-.25}, q15{.75}, q15{0}};
+    q15 output[5];
+    filter.process(input, output, 5);
+    ASSERT_EQ(output[0], .125);
+    ASSERT_EQ(output[1], .25);
+    ASSERT_EQ(output[2], .1875);
+    ASSERT_EQ(output[3], .375);
+    ASSERT_EQ(output[4], .25);
+}
+
+#if defined(SG14_EXCEPTIONS_ENABLED)
+TEST(fir, invalid_arguments)
+{
+    const q15 coefficients[] = {q15{.5}, q15{.5}};
+    ASSERT_THROW(sg14::fir<q15>(coefficients, 0), std::invalid_argument);
+    ASSERT_THROW(sg14::fir_decimator<q15>(coefficients, 0, 2), std::invalid_argument);
+    ASSERT_THROW(sg14::fir_decimator<q15>(coefficients, 2, 0), std::invalid_argument);
+    ASSERT_THROW(sg14::fir_interpolator<q15>(coefficients, 0, 2), std::invalid_argument);
+    ASSERT_THROW(sg14::fir_interpolator<q15>(coefficients, 2, 0), std::invalid_argument);
+}
+#endif
@@ -15,3 +15,53 @@
 #include "fixed_point_math_Q15.cpp"
 #include "fixed_point_math_Q31.cpp"
 
+
+////////////////////////////////////////////////////////////////////////////////
+// polynomial degree of sg14::exp2 follows the digits of the representation
+
+namespace {
+    using sg14::fixed_point;
+    using sg14::_fixed_point_impl::poly_coeffs;
+
+    static_assert(poly_coeffs<fixed_point<std::uint8_t, -8>>::degree==2, "sg14::poly_coeffs test failed");
+    static_assert(poly_coeffs<fixed_point<std::uint16_t, -16>>::degree==4, "sg14::poly_coeffs test failed");
+    static_assert(poly_coeffs<fixed_point<std::uint32_t, -32>>::degree==7, "sg14::poly_coeffs test failed");
+    static_assert(poly_coeffs<fixed_point<std::uint64_t, -64>>::degree==13, "sg14::poly_coeffs test failed");
+    static_assert(poly_coeffs<fixed_point<std::uint32_t, -32>, 4>::degree==6, "sg14::poly_coeffs test failed");
+
+    // every input of a narrow type is within one LSB of the double result
+    template<class Rep, int Exponent, int ErrorBudget = 0>
+    void test_exp2_narrow(int max_error = 1)
+    {
+        using fp = fixed_point<Rep, Exponent>;
+        auto last = static_cast<double>(std::numeric_limits<fp>::digits+Exponent);
+        for (auto data = std::numeric_limits<Rep>::min(); ; ++data) {
+            auto x = fp::from_data(data);
+            if (static_cast<double>(x)<last) {
+                auto expected = static_cast<double>(fp{std::exp2(static_cast<double>(x))}.data());
+                auto actual = static_cast<double>(sg14::exp2<Rep, Exponent, ErrorBudget>(x).data());
+                EXPECT_LE(std::abs(actual-expected), max_error) << "exp2(" << x << ")";
+            }
+            if (data==std::numeric_limits<Rep>::max()) {
+                break;
+            }
+        }
+    }
+}
+
+TEST(fixed_point_math, exp2_narrow)
+{
+    test_exp2_narrow<std::int8_t, -4>();
+    test_exp2_narrow<std::int8_t, -6>();
+    test_exp2_narrow<std::uint8_t, -4>();
+    test_exp2_narrow<std::int16_t, -8>();
+    test_exp2_narrow<std::int16_t, -12>();
+    test_exp2_narrow<std::int16_t, -14>();
+    test_exp2_narrow<std::uint16_t, -8>();
+
+    // a looser error budget evaluates fewer terms
+    test_exp2_narrow<std::int16_t, -12, 4>(3);
+
+    // the rep and exponent may be given explicitly
+    EXPECT_EQ((sg14::exp2<std::int16_t, -8>(fixed_point<std::int16_t, -8>{3})), 8);
+}
@@ -0,0 +1,160 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief tests of sg14::gemm
+
+#include <sg14/auxiliary/gemm.h>
+
+#include "random_common.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using sg14::fixed_point;
+
+namespace {
+    ////////////////////////////////////////////////////////////////////////////////
+    // products compared with a triple loop summed in 64 bits
+
+    // random values, and the lowest value in runs long enough to fill pairs of pairs
+    template<class T>
+    std::vector<T> random_matrix(std::size_t size, std::mt19937& generator)
+    {
+        auto values = random_values<T>(size, generator);
+        for (auto index = std::size_t{0}; index!=size; ++index) {
+            if (index%23<4) {
+                values[index] = std::numeric_limits<T>::lowest();
+            }
+        }
+        return values;
+    }
+
+    template<class Result, class RoundingPolicy, class Lhs, class Rhs>
+    std::vector<Result> reference_gemm(
+            std::vector<Lhs> const& lhs, std::vector<Rhs> const& rhs,
+            std::size_t rows, std::size_t depth, std::size_t columns)
+    {
+        using sum = fixed_point<std::int64_t, Lhs::exponent+Rhs::exponent>;
+        std::vector<Result> result(rows*columns);
+        for (auto row = std::size_t{0}; row!=rows; ++row) {
+            for (auto column = std::size_t{0}; column!=columns; ++column) {
+                auto total = std::int64_t{0};
+                for (auto index = std::size_t{0}; index!=depth; ++index) {
+                    total += std::int64_t{lhs[row*depth+index].data()}*rhs[index*columns+column].data();
+                }
+                auto exact = sum::from_data(total);
+                sg14::requantize(&exact, &result[row*columns+column], 1, RoundingPolicy{});
+            }
+        }
+        return result;
+    }
+
+    template<class Lhs, class Rhs, class Result, class RoundingPolicy = sg14::round_toward_zero>
+    void test_gemm(std::size_t rows, std::size_t depth, std::size_t columns, unsigned threads = 1)
+    {
+        std::mt19937 generator(static_cast<unsigned>(rows*depth+columns));
+        auto lhs = random_matrix<Lhs>(rows*depth, generator);
+        auto rhs = random_matrix<Rhs>(depth*columns, generator);
+        auto expected = reference_gemm<Result, RoundingPolicy>(lhs, rhs, rows, depth, columns);
+
+        std::vector<Result> result(rows*columns);
+        sg14::gemm(lhs.data(), rhs.data(), result.data(), rows, depth, columns, RoundingPolicy{}, threads);
+        for (auto index = std::size_t{0}; index!=result.size(); ++index) {
+            ASSERT_EQ(result[index], expected[index])
+                                << rows << 'x' << depth << 'x' << columns << " row=" << index/columns
+                                << " column=" << index%columns;
+        }
+    }
+}
+
+TEST(gemm, int8)
+{
+    using s0_7 = fixed_point<std::int8_t, -7>;
+    using s3_4 = fixed_point<std::int8_t, -4>;
+
+    // exact
+    test_gemm<s0_7, s0_7, fixed_point<std::int32_t, -14>>(5, 3, 7);
+    test_gemm<s0_7, s3_4, fixed_point<std::int32_t, -11>>(1, 1, 1);
+    test_gemm<s0_7, s3_4, fixed_point<std::int32_t, -11>>(73, 300, 257);
+
+    // rounded and saturated
+    test_gemm<s0_7, s0_7, s0_7, sg14::round_half_even>(13, 9, 40);
+    test_gemm<s3_4, s3_4, s3_4, sg14::round_half_up>(80, 513, 33);
+    test_gemm<s3_4, s3_4, fixed_point<std::int16_t, -4>>(6, 1000, 16);
+}
+
+TEST(gemm, int16)
+{
+    using q15 = fixed_point<std::int16_t, -15>;
+    using s7_8 = fixed_point<std::int16_t, -8>;
+
+    // exact
+    test_gemm<q15, q15, fixed_point<std::int64_t, -30>>(5, 3, 7);
+    test_gemm<q15, s7_8, fixed_point<std::int64_t, -23>>(73, 300, 257);
+
+    // rounded and saturated
+    test_gemm<q15, q15, q15, sg14::round_half_even>(13, 9, 40);
+    test_gemm<s7_8, q15, s7_8, sg14::round_half_up>(80, 513, 33);
+    test_gemm<q15, q15, fixed_point<std::int32_t, -20>>(6, 1000, 16);
+}
+
+TEST(gemm, extremes)
+{
+    // every pair of products is 2^31
+    using q15 = fixed_point<std::int16_t, -15>;
+    using sum = fixed_point<std::int64_t, -30>;
+    constexpr auto rows = std::size_t{7}, depth = std::size_t{600}, columns = std::size_t{19};
+    auto lowest = q15::from_data(std::numeric_limits<std::int16_t>::lowest());
+    std::vector<q15> lhs(rows*depth, lowest), rhs(depth*columns, lowest);
+    std::vector<sum> result(rows*columns);
+    sg14::gemm(lhs.data(), rhs.data(), result.data(), rows, depth, columns);
+    for (auto const& element : result) {
+        ASSERT_EQ(element, depth);
+    }
+
+    // and with 8-bit reps, the deepest matrices which cannot overflow
+    using s0_7 = fixed_point<std::int8_t, -7>;
+    auto lowest8 = s0_7::from_data(std::numeric_limits<std::int8_t>::lowest());
+    constexpr auto deep = std::size_t{131071};
+    std::vector<s0_7> column(deep, lowest8);
+    fixed_point<std::int32_t, -14> product;
+    sg14::gemm(column.data(), column.data(), &product, 1, deep, 1);
+    ASSERT_EQ(product, deep);
+}
+
+#if defined(SG14_EXCEPTIONS_ENABLED)
+TEST(gemm, too_deep)
+{
+    using s0_7 = fixed_point<std::int8_t, -7>;
+    constexpr auto deep = std::size_t{131072};
+    std::vector<s0_7> column(deep);
+    fixed_point<std::int32_t, -14> product;
+    ASSERT_THROW(sg14::gemm(column.data(), column.data(), &product, 1, deep, 1), std::invalid_argument);
+}
+#endif
+
+TEST(gemm, threads)
+{
+    using s0_7 = fixed_point<std::int8_t, -7>;
+    test_gemm<s0_7, s0_7, s0_7, sg14::round_half_even>(300, 70, 600, 3);
+    test_gemm<s0_7, s0_7, s0_7>(2, 2, 2, 8);
+
+    using q15 = fixed_point<std::int16_t, -15>;
+    test_gemm<q15, q15, q15>(150, 64, 520, 4);
+}
+
+TEST(gemm, empty)
+{
+    using s0_7 = fixed_point<std::int8_t, -7>;
+    test_gemm<s0_7, s0_7, s0_7>(0, 5, 5);
+    test_gemm<s0_7, s0_7, s0_7>(5, 0, 5);
+    test_gemm<s0_7, s0_7, s0_7>(5, 5, 0, 2);
+}
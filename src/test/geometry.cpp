@@ -0,0 +1,264 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief tests of sg14/auxiliary/geometry.h
+
+#include <sg14/auxiliary/geometry.h>
+
+#include "random_common.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+using sg14::fixed_point;
+using sg14::make_fixed;
+using sg14::make_ufixed;
+using sg14::vec2;
+using sg14::vec2_array;
+using sg14::vec3;
+using sg14::vec3_array;
+
+namespace {
+    using s3_4 = make_fixed<3, 4>;
+    using u4_4 = make_ufixed<4, 4>;
+    using s7_8 = make_fixed<7, 8>;
+    using q15 = make_fixed<0, 15>;
+    using s15_16 = make_fixed<15, 16>;
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // exact result types
+
+    static_assert(std::is_same<decltype(dot(vec2<s3_4>{}, vec2<s3_4>{})), fixed_point<std::int32_t, -8>>::value, "");
+    static_assert(std::is_same<decltype(cross(vec2<s3_4>{}, vec2<s3_4>{})), fixed_point<std::int32_t, -8>>::value, "");
+    static_assert(std::is_same<decltype(distance_squared(vec3<s3_4>{}, vec3<s3_4>{})),
+            fixed_point<std::int32_t, -8>>::value, "");
+    static_assert(std::is_same<decltype(dot(vec2<s7_8>{}, vec2<s7_8>{})), fixed_point<std::int64_t, -16>>::value, "");
+    static_assert(std::is_same<decltype(cross(vec3<q15>{}, vec3<q15>{})),
+            vec3<fixed_point<std::int64_t, -30>>>::value, "");
+    static_assert(std::is_same<decltype(distance_squared(vec2<float>{}, vec2<float>{})), float>::value, "");
+
+    static_assert(dot(vec2<s7_8>{s7_8{2}, s7_8{-3}}, vec2<s7_8>{s7_8{.5}, s7_8{4}})==-11, "");
+    static_assert(intersects(vec2<s7_8>{s7_8{0}, s7_8{0}}, s7_8{3}, vec2<s7_8>{s7_8{3}, s7_8{4}}, s7_8{2}), "");
+    static_assert(!intersects(vec2<s7_8>{s7_8{0}, s7_8{0}}, s7_8{3}, vec2<s7_8>{s7_8{3}, s7_8{4}}, s7_8{1.75}), "");
+
+    // sums of products of 32-bit coordinates require a 128-bit integer;
+    // the widest coordinates whose sums of products fit in 64 bits have 16-bit reps
+    static_assert(std::is_same<decltype(distance_squared(vec3<q15>{}, vec3<q15>{})),
+            fixed_point<std::int64_t, -30>>::value, "");
+#if defined(SG14_INT128_ENABLED)
+    static_assert(std::is_same<decltype(dot(vec2<s15_16>{}, vec2<s15_16>{})), fixed_point<SG14_INT128, -32>>::value, "");
+    static_assert(std::is_same<decltype(cross(vec2<s15_16>{}, vec2<s15_16>{})), fixed_point<SG14_INT128, -32>>::value, "");
+    static_assert(std::is_same<decltype(distance_squared(vec3<s15_16>{}, vec3<s15_16>{})),
+            fixed_point<SG14_INT128, -32>>::value, "");
+#endif
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // batch functions compared with double for coordinates of up to 16 bits
+
+    // coordinates including the extremes of T
+    template<class T>
+    vec3_array<T> random_vectors(std::size_t size, std::mt19937& generator)
+    {
+        vec3_array<T> vectors;
+        vectors.push_back(vec3<T>{std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(),
+                                  std::numeric_limits<T>::lowest()});
+        vectors.push_back(vec3<T>{std::numeric_limits<T>::max(), std::numeric_limits<T>::max(),
+                                  std::numeric_limits<T>::max()});
+        vectors.push_back(vec3<T>{std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max(),
+                                  std::numeric_limits<T>::lowest()});
+        auto coordinates = random_values<T>(3*(size-vectors.size()), generator);
+        for (auto index = std::size_t{0}; index!=coordinates.size(); index += 3) {
+            vectors.push_back(vec3<T>{coordinates[index], coordinates[index+1], coordinates[index+2]});
+        }
+        return vectors;
+    }
+
+    template<class T>
+    vec2_array<T> to_vec2(vec3_array<T> const& vectors)
+    {
+        vec2_array<T> result;
+        result.x = vectors.x;
+        result.y = vectors.y;
+        return result;
+    }
+
+    template<class T>
+    void test_geometry(std::size_t size)
+    {
+        std::mt19937 generator(static_cast<unsigned>(size));
+        auto lhs3 = random_vectors<T>(size, generator);
+        auto rhs3 = random_vectors<T>(size, generator);
+        std::reverse(rhs3.x.begin(), rhs3.x.end());
+        auto lhs2 = to_vec2(lhs3), rhs2 = to_vec2(rhs3);
+        auto radii = random_values<T>(size, generator), other_radii = random_values<T>(size, generator);
+        for (auto index = std::size_t{0}; index!=size; ++index) {
+            radii[index] = static_cast<T>(std::abs(static_cast<double>(radii[index])));
+            other_radii[index] = static_cast<T>(std::abs(static_cast<double>(other_radii[index])));
+        }
+
+        using dot2 = decltype(dot(lhs2[0], rhs2[0]));
+        using dot3 = decltype(dot(lhs3[0], rhs3[0]));
+        using distance2 = decltype(distance_squared(lhs2[0], rhs2[0]));
+        using distance3 = decltype(distance_squared(lhs3[0], rhs3[0]));
+        std::vector<dot2> dots2(size), crosses2(size);
+        std::vector<dot3> dots3(size);
+        std::vector<distance2> distances2(size);
+        std::vector<distance3> distances3(size);
+        vec3_array<dot2> crosses3;
+        std::unique_ptr<bool[]> intersections2(new bool[size]), intersections3(new bool[size]);
+        std::unique_ptr<bool[]> hits2(new bool[size]), hits3(new bool[size]);
+
+        dot(lhs2, rhs2, dots2.data());
+        dot(lhs3, rhs3, dots3.data());
+        cross(lhs2, rhs2, crosses2.data());
+        cross(lhs3, rhs3, crosses3);
+        distance_squared(lhs2, rhs2, distances2.data());
+        distance_squared(lhs3, rhs3, distances3.data());
+        intersects(lhs2, radii.data(), rhs2, other_radii.data(), intersections2.get());
+        intersects(lhs3, radii.data(), rhs3, other_radii.data(), intersections3.get());
+        intersects(lhs2[0], radii[0], rhs2, other_radii.data(), hits2.get());
+        intersects(lhs3[0], radii[0], rhs3, other_radii.data(), hits3.get());
+
+        ASSERT_EQ(crosses3.size(), size);
+        for (auto index = std::size_t{0}; index!=size; ++index) {
+            auto lx = static_cast<double>(lhs3.x[index]), ly = static_cast<double>(lhs3.y[index]);
+            auto lz = static_cast<double>(lhs3.z[index]);
+            auto rx = static_cast<double>(rhs3.x[index]), ry = static_cast<double>(rhs3.y[index]);
+            auto rz = static_cast<double>(rhs3.z[index]);
+            ASSERT_EQ(static_cast<double>(dots2[index]), lx*rx+ly*ry) << "index=" << index;
+            ASSERT_EQ(static_cast<double>(dots3[index]), lx*rx+ly*ry+lz*rz) << "index=" << index;
+            ASSERT_EQ(static_cast<double>(crosses2[index]), lx*ry-ly*rx) << "index=" << index;
+            ASSERT_EQ(static_cast<double>(crosses3.x[index]), ly*rz-lz*ry) << "index=" << index;
+            ASSERT_EQ(static_cast<double>(crosses3.y[index]), lz*rx-lx*rz) << "index=" << index;
+            ASSERT_EQ(static_cast<double>(crosses3.z[index]), lx*ry-ly*rx) << "index=" << index;
+
+            auto dx = lx-rx, dy = ly-ry, dz = lz-rz;
+            ASSERT_EQ(static_cast<double>(distances2[index]), dx*dx+dy*dy) << "index=" << index;
+            ASSERT_EQ(static_cast<double>(distances3[index]), dx*dx+dy*dy+dz*dz) << "index=" << index;
+
+            auto touch = static_cast<double>(radii[index])+static_cast<double>(other_radii[index]);
+            ASSERT_EQ(intersections2[index], dx*dx+dy*dy<=touch*touch) << "index=" << index;
+            ASSERT_EQ(intersections3[index], dx*dx+dy*dy+dz*dz<=touch*touch) << "index=" << index;
+
+            // one against many
+            auto hx = static_cast<double>(lhs3.x[0])-rx, hy = static_cast<double>(lhs3.y[0])-ry;
+            auto hz = static_cast<double>(lhs3.z[0])-rz;
+            auto hit = static_cast<double>(radii[0])+static_cast<double>(other_radii[index]);
+            ASSERT_EQ(hits2[index], hx*hx+hy*hy<=hit*hit) << "index=" << index;
+            ASSERT_EQ(hits3[index], hx*hx+hy*hy+hz*hz<=hit*hit) << "index=" << index;
+        }
+    }
+
+    // batch intersects compared with intersects of individual circles given negative radii,
+    // whose sums may wrap when squared
+    template<class T>
+    void test_negative_radii(std::size_t size)
+    {
+        std::mt19937 generator(static_cast<unsigned>(size));
+        auto centres = to_vec2(random_vectors<T>(size, generator));
+        auto other_centres = to_vec2(random_vectors<T>(size, generator));
+        auto radii = random_values<T>(size, generator);
+        for (auto index = std::size_t{0}; index<size; index += 2) {
+            radii[index] = std::numeric_limits<T>::lowest();
+        }
+        std::vector<T> other_radii(size, std::numeric_limits<T>::lowest());
+        std::unique_ptr<bool[]> intersections(new bool[size]);
+        intersects(centres, radii.data(), other_centres, other_radii.data(), intersections.get());
+        for (auto index = std::size_t{0}; index!=size; ++index) {
+            ASSERT_EQ(intersections[index], intersects(centres[index], radii[index],
+                    other_centres[index], other_radii[index])) << "index=" << index;
+        }
+    }
+}
+
+TEST(geometry, vec2_array)
+{
+    vec2_array<s7_8> vectors(2);
+    vectors.set(1, vec2<s7_8>{s7_8{1.5}, s7_8{-2}});
+    vectors.push_back(vec2<s7_8>{s7_8{3}, s7_8{4}});
+    ASSERT_EQ(vectors.size(), 3u);
+    ASSERT_EQ(vectors[1].x, 1.5);
+    ASSERT_EQ(vectors[1].y, -2);
+    ASSERT_EQ(vectors.y[2], 4);
+}
+
+TEST(geometry, cross)
+{
+    // the cross product of the x and y axes is the z axis
+    auto x = vec3<q15>{q15{.5}, q15{0}, q15{0}};
+    auto y = vec3<q15>{q15{0}, q15{.5}, q15{0}};
+    auto z = cross(x, y);
+    ASSERT_EQ(z.x, 0);
+    ASSERT_EQ(z.y, 0);
+    ASSERT_EQ(z.z, .25);
+    ASSERT_EQ(cross(y, x).z, -.25);
+}
+
+TEST(geometry, int8)
+{
+    test_geometry<s3_4>(1000);
+    test_geometry<u4_4>(1000);
+}
+
+TEST(geometry, negative_radii)
+{
+    test_negative_radii<s3_4>(200);
+    test_negative_radii<s7_8>(200);
+}
+
+TEST(geometry, int16)
+{
+    test_geometry<s7_8>(1000);
+    test_geometry<q15>(1001);
+    test_geometry<make_ufixed<8, 8>>(999);
+}
+
+TEST(geometry, int32)
+{
+#if defined(SG14_INT128_ENABLED)
+    // the dot product of the lowest values exceeds 64 bits
+    auto lowest = std::numeric_limits<s15_16>::lowest();
+    ASSERT_TRUE(dot(vec2<s15_16>{lowest, lowest}, vec2<s15_16>{lowest, lowest}).data()==SG14_INT128{1} << 63);
+#endif
+
+    // circles of 32-bit coordinates are compared in 64 bits, e.g. those which only just touch
+    auto centre = vec2<s15_16>{s15_16::from_data(-1200000000), s15_16::from_data(-1600000000)};
+    auto other_centre = vec2<s15_16>{s15_16::from_data(1200000000), s15_16::from_data(1600000000)};
+    auto radius = s15_16::from_data(2000000000);
+    ASSERT_TRUE(intersects(centre, radius, other_centre, radius));
+    ASSERT_FALSE(intersects(centre, radius, other_centre, s15_16::from_data(1999999999)));
+
+    auto centre3 = vec3<s15_16>{centre.x, centre.y, std::numeric_limits<s15_16>::lowest()};
+    auto other_centre3 = vec3<s15_16>{other_centre.x, other_centre.y, std::numeric_limits<s15_16>::lowest()};
+    ASSERT_TRUE(intersects(centre3, radius, other_centre3, radius));
+    other_centre3.z = s15_16::from_data(std::numeric_limits<std::int32_t>::lowest()+1);
+    ASSERT_FALSE(intersects(centre3, radius, other_centre3, radius));
+}
+
+TEST(geometry, float)
+{
+    vec2_array<float> centres;
+    centres.push_back(vec2<float>{3.f, 4.f});
+    centres.push_back(vec2<float>{-6.f, 8.f});
+    const std::vector<float> radii(2, 1.f);
+    bool hits[2];
+    intersects(vec2<float>{0.f, 0.f}, 4.f, centres, radii.data(), hits);
+    ASSERT_TRUE(hits[0]);
+    ASSERT_FALSE(hits[1]);
+
+    float distances[2];
+    distance_squared(centres, centres, distances);
+    ASSERT_EQ(distances[1], 0.f);
+}
@@ -6,6 +6,8 @@
 
 #include "sg14/auxiliary/integer.h"
 
+#include <gtest/gtest.h>
+
 using sg14::_impl::is_integer_or_float;
 using sg14::_integer_impl::is_integer_class;
 using sg14::_integer_impl::is_negative_overflow;
@@ -15,6 +17,7 @@ using sg14::is_signed;
 using sg14::is_unsigned;
 using sg14::make_signed;
 using sg14::make_unsigned;
+using sg14::native_integer;
 using sg14::saturated_integer;
 using std::declval;
 using std::is_same;
@@ -294,6 +297,37 @@ static_assert(int16_t(31)/saturated_integer<int8_t>(-2)==-15, "sg14::saturated_i
 
 static_assert(is_same<decltype(declval<saturated_integer<>>() / declval<double>()), double>::value, "");
 
+// arithmetic which overflows the promoted type saturates in it
+static_assert(saturated_integer<int32_t>(numeric_limits<int32_t>::max())+saturated_integer<int32_t>(1)
+        ==numeric_limits<int32_t>::max(), "sg14::saturated_integer test failed");
+static_assert(saturated_integer<int32_t>(numeric_limits<int32_t>::lowest())+saturated_integer<int32_t>(-1)
+        ==numeric_limits<int32_t>::lowest(), "sg14::saturated_integer test failed");
+static_assert(saturated_integer<int32_t>(-2)-saturated_integer<int32_t>(numeric_limits<int32_t>::max())
+        ==numeric_limits<int32_t>::lowest(), "sg14::saturated_integer test failed");
+static_assert(saturated_integer<int32_t>(2)-saturated_integer<int32_t>(numeric_limits<int32_t>::lowest())
+        ==numeric_limits<int32_t>::max(), "sg14::saturated_integer test failed");
+static_assert(saturated_integer<uint32_t>(1)-saturated_integer<uint32_t>(2)==0u, "sg14::saturated_integer test failed");
+static_assert(saturated_integer<int64_t>(INT64_C(-4294967296))*saturated_integer<int64_t>(INT64_C(4294967296))
+        ==numeric_limits<int64_t>::lowest(), "sg14::saturated_integer test failed");
+static_assert(saturated_integer<int64_t>(INT64_C(-4294967296))*saturated_integer<int64_t>(INT64_C(-4294967296))
+        ==numeric_limits<int64_t>::max(), "sg14::saturated_integer test failed");
+static_assert(saturated_integer<uint64_t>(UINT64_C(4294967296))*saturated_integer<uint64_t>(UINT64_C(4294967296))
+        ==numeric_limits<uint64_t>::max(), "sg14::saturated_integer test failed");
+static_assert(saturated_integer<int64_t>(INT64_C(-3037000499))*saturated_integer<int64_t>(INT64_C(3037000499))
+        ==INT64_C(-9223372030926249001), "sg14::saturated_integer test failed");
+static_assert(saturated_integer<int32_t>(numeric_limits<int32_t>::max())+1==numeric_limits<int32_t>::max(),
+        "sg14::saturated_integer test failed");
+static_assert(-1*saturated_integer<int32_t>(numeric_limits<int32_t>::lowest())==numeric_limits<int32_t>::max(),
+        "sg14::saturated_integer test failed");
+static_assert(-saturated_integer<int64_t>(numeric_limits<int64_t>::lowest())==numeric_limits<int64_t>::max(),
+        "sg14::saturated_integer test failed");
+static_assert(-saturated_integer<int16_t>(numeric_limits<int16_t>::lowest())==numeric_limits<int16_t>::max(),
+        "sg14::saturated_integer test failed");
+
+// native_integer arithmetic is that of its rep
+static_assert(native_integer<uint32_t>(1)-native_integer<uint32_t>(2)==numeric_limits<uint32_t>::max(),
+        "sg14::native_integer test failed");
+
 ////////////////////////////////////////////////////////////////////////////////
 // traits
 
@@ -386,3 +420,168 @@ static_assert(is_same<make_unsigned<saturated_integer<int64_t>>::type, saturated
         "sg14::make_unsigned<sg14::saturated_integer<>> test failed");
 static_assert(is_same<make_unsigned<saturated_integer<uint64_t>>::type, saturated_integer<uint64_t>>::value,
         "sg14::make_unsigned<sg14::saturated_integer<>> test failed");
+
+////////////////////////////////////////////////////////////////////////////////
+// compound assignment
+
+// x OP= y is x = static_cast<decltype(x)>(x OP y) so that the result of the promoted operation
+// is converted back to the rep of x according to its overflow policy, rather than truncated
+TEST(integer, compound_assignment)
+{
+    // saturated_integer saturates
+    auto value = saturated_integer<int16_t>(30000);
+    value += saturated_integer<int16_t>(30000);
+    ASSERT_EQ(value, numeric_limits<int16_t>::max());
+    value -= 70000;
+    ASSERT_EQ(value, numeric_limits<int16_t>::lowest());
+    value *= -2;
+    ASSERT_EQ(value, numeric_limits<int16_t>::max());
+    value /= -1;
+    ASSERT_EQ(value, -numeric_limits<int16_t>::max());
+
+    auto wide = saturated_integer<int64_t>(numeric_limits<int64_t>::max()/3);
+    wide *= 4;
+    ASSERT_EQ(wide, numeric_limits<int64_t>::max());
+
+    auto small = saturated_integer<uint8_t>(10);
+    small -= 20;
+    ASSERT_EQ(small, 0);
+    small += 300.5;
+    ASSERT_EQ(small, numeric_limits<uint8_t>::max());
+
+    // as do fixed_point values with saturated_integer reps
+    using saturated_q15 = sg14::fixed_point<saturated_integer<int16_t>, -15>;
+    auto sample = saturated_q15(.75);
+    sample += saturated_q15(.75);
+    ASSERT_EQ(sample.data(), numeric_limits<int16_t>::max());
+
+    // native_integer wraps as the built-in compound assignment operators do
+    auto wrapped = native_integer<uint8_t>(200);
+    wrapped += native_integer<uint8_t>(100);
+    ASSERT_EQ(wrapped, 44);
+    wrapped -= 45;
+    ASSERT_EQ(wrapped, 255);
+
+    // and the result is the value assigned
+    auto chained = saturated_integer<int8_t>(100);
+    ASSERT_EQ(chained += 100, numeric_limits<int8_t>::max());
+    ASSERT_EQ((chained -= 27) *= 2, numeric_limits<int8_t>::max());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// sg14::sticky_integer arithmetic
+
+// results which do not overflow are constant expressions
+static_assert(sg14::sticky_integer<int64_t>(numeric_limits<int64_t>::max()-1)+1==numeric_limits<int64_t>::max(),
+        "sg14::sticky_integer test failed");
+static_assert(sg14::sticky_integer<int8_t>(-128)==-128, "sg14::sticky_integer test failed");
+static_assert((sg14::sticky_integer<int32_t>(1) << 30)==1 << 30, "sg14::sticky_integer test failed");
+
+TEST(integer, sticky_arithmetic)
+{
+    using sg14::sticky_integer;
+    using wrapping_int32 = sg14::integer<int32_t, sg14::sticky_overflow_policy<sg14::native_overflow_policy>>;
+
+    // the flag is raised by overflow and stays raised until it is cleared
+    sg14::clear_overflow();
+    auto sample = sticky_integer<int16_t>(20000);
+    sample += sample;
+    ASSERT_TRUE(sg14::test_overflow());
+    ASSERT_EQ(sample, numeric_limits<int16_t>::max());
+    sample = sticky_integer<int16_t>(100);
+    ASSERT_TRUE(sg14::test_overflow());
+    sg14::clear_overflow();
+    ASSERT_FALSE(sg14::test_overflow());
+
+    auto lowest = sticky_integer<int64_t>(numeric_limits<int64_t>::lowest());
+    ASSERT_EQ(lowest+numeric_limits<int64_t>::max(), -1);
+    ASSERT_EQ(lowest/1, numeric_limits<int64_t>::lowest());
+    ASSERT_FALSE(sg14::test_overflow());
+    ASSERT_EQ(lowest-1, numeric_limits<int64_t>::lowest());
+    ASSERT_TRUE(sg14::test_overflow());
+    sg14::clear_overflow();
+    ASSERT_EQ(lowest*lowest, numeric_limits<int64_t>::max());
+    ASSERT_TRUE(sg14::test_overflow());
+    sg14::clear_overflow();
+    ASSERT_EQ(lowest/-1, numeric_limits<int64_t>::max());
+    ASSERT_TRUE(sg14::test_overflow());
+    sg14::clear_overflow();
+    ASSERT_EQ(-lowest, numeric_limits<int64_t>::max());
+    ASSERT_TRUE(sg14::test_overflow());
+
+    // as is that of left shifts
+    sg14::clear_overflow();
+    ASSERT_EQ(sticky_integer<int32_t>(-1) << 31, numeric_limits<int32_t>::lowest());
+    ASSERT_EQ(sticky_integer<int32_t>(1) >> 31, 0);
+    ASSERT_FALSE(sg14::test_overflow());
+    ASSERT_EQ(sticky_integer<int32_t>(1) << 31, numeric_limits<int32_t>::max());
+    ASSERT_TRUE(sg14::test_overflow());
+    sg14::clear_overflow();
+    ASSERT_EQ(lowest << 64, numeric_limits<int64_t>::lowest());
+    ASSERT_TRUE(sg14::test_overflow());
+
+    // or the result wraps
+    sg14::clear_overflow();
+    ASSERT_EQ(wrapping_int32(numeric_limits<int32_t>::max())+1, numeric_limits<int32_t>::lowest());
+    ASSERT_TRUE(sg14::test_overflow());
+    sg14::clear_overflow();
+    ASSERT_EQ(wrapping_int32(3) << 31, numeric_limits<int32_t>::lowest());
+    ASSERT_TRUE(sg14::test_overflow());
+    sg14::clear_overflow();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// sg14::throwing_integer arithmetic
+
+#if defined(SG14_EXCEPTIONS_ENABLED)
+
+static_assert(sg14::throwing_integer<int64_t>(numeric_limits<int64_t>::max()-1)+1==numeric_limits<int64_t>::max(),
+        "sg14::throwing_integer test failed");
+static_assert(sg14::throwing_integer<int64_t>(numeric_limits<int64_t>::lowest()+1)-1==numeric_limits<int64_t>::lowest(),
+        "sg14::throwing_integer test failed");
+static_assert(sg14::throwing_integer<int32_t>(-65536)*32768==numeric_limits<int32_t>::lowest(),
+        "sg14::throwing_integer test failed");
+static_assert((sg14::throwing_integer<int32_t>(-1) << 31)==numeric_limits<int32_t>::lowest(),
+        "sg14::throwing_integer test failed");
+
+TEST(integer, throwing_arithmetic)
+{
+    using sg14::throwing_integer;
+    using int64 = throwing_integer<int64_t>;
+    using uint64 = throwing_integer<uint64_t>;
+    auto greatest = int64(numeric_limits<int64_t>::max());
+    auto lowest = int64(numeric_limits<int64_t>::lowest());
+
+    ASSERT_THROW(greatest+int64(1), std::overflow_error);
+    ASSERT_THROW(lowest+int64(-1), std::overflow_error);
+    ASSERT_THROW(lowest-1, std::overflow_error);
+    ASSERT_THROW(greatest-int64(-1), std::overflow_error);
+    ASSERT_THROW(uint64(0u)-1u, std::overflow_error);
+    ASSERT_THROW(int64(1) << 63, std::overflow_error);
+    ASSERT_THROW(int64(int64_t{1} << 32)*int64(int64_t{1} << 31), std::overflow_error);
+    ASSERT_THROW(lowest*-1, std::overflow_error);
+    ASSERT_THROW(lowest/int64(-1), std::overflow_error);
+    ASSERT_THROW(-int64(numeric_limits<int64_t>::lowest()), std::overflow_error);
+    ASSERT_THROW(-throwing_integer<int32_t>(numeric_limits<int32_t>::lowest()), std::overflow_error);
+    ASSERT_THROW(-throwing_integer<int16_t>(numeric_limits<int16_t>::lowest()), std::overflow_error);
+    ASSERT_THROW(-uint64(1u), std::overflow_error);
+    ASSERT_THROW(greatest/int64(0), std::domain_error);
+    ASSERT_THROW(int64(1) << -1, std::domain_error);
+    ASSERT_THROW(int64(1) >> 64, std::domain_error);
+
+    // the results which are in range are those of the built-in operators
+    ASSERT_EQ(greatest+lowest, -1);
+    ASSERT_EQ(lowest/int64(1), numeric_limits<int64_t>::lowest());
+    ASSERT_EQ(int64(-3) << 61, int64_t{-3}*(int64_t{1} << 61));
+    ASSERT_EQ(lowest >> 63, -1);
+    ASSERT_EQ(-greatest, numeric_limits<int64_t>::lowest()+1);
+    ASSERT_EQ(-uint64(0u), 0u);
+    ASSERT_EQ(uint64(numeric_limits<uint64_t>::max())*1u, numeric_limits<uint64_t>::max());
+
+    // narrower operands are promoted, and only the conversion back can overflow
+    auto narrow = throwing_integer<int16_t>(30000);
+    ASSERT_EQ(narrow+narrow, 60000);
+    ASSERT_THROW(narrow += narrow, std::overflow_error);
+}
+
+#endif
@@ -0,0 +1,119 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief tests of sg14::lut_function
+
+#include <sg14/auxiliary/lut.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using sg14::fixed_point;
+using sg14::make_fixed;
+using sg14::make_ufixed;
+using sg14::make_lut_function;
+using sg14::quadratic_interpolation;
+
+namespace {
+    struct square {
+        constexpr double operator()(double x) const
+        {
+            return x*x;
+        }
+    };
+
+    struct gamma_curve {
+        double operator()(double x) const
+        {
+            return std::pow(x, 2.2);
+        }
+    };
+
+    struct sigmoid {
+        double operator()(double x) const
+        {
+            return std::tanh(x);
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // compile-time tables
+
+    constexpr auto square_linear = make_lut_function<make_fixed<3, 4>, make_fixed<7, 8>, 3>(square{});
+    static_assert(decltype(square_linear)::table_size==9, "sg14::lut_function test failed");
+
+    // samples are exact
+    static_assert(square_linear(make_fixed<3, 4>{-8})==64, "sg14::lut_function test failed");
+    static_assert(square_linear(make_fixed<3, 4>{-4})==16, "sg14::lut_function test failed");
+    static_assert(square_linear(make_fixed<3, 4>{0})==0, "sg14::lut_function test failed");
+    static_assert(square_linear(make_fixed<3, 4>{6})==36, "sg14::lut_function test failed");
+
+    // linear interpolation overestimates a convex function
+    static_assert(square_linear(make_fixed<3, 4>{1})==2, "sg14::lut_function test failed");
+    static_assert(square_linear(make_fixed<3, 4>{-3})==10, "sg14::lut_function test failed");
+
+    // quadratic interpolation reproduces a parabola
+    constexpr auto square_quadratic = make_lut_function<
+            make_fixed<3, 4>, make_fixed<7, 8>, 3, quadratic_interpolation>(square{});
+    static_assert(decltype(square_quadratic)::table_size==10, "sg14::lut_function test failed");
+    static_assert(square_quadratic(make_fixed<3, 4>{1})==1, "sg14::lut_function test failed");
+    static_assert(square_quadratic(make_fixed<3, 4>{-3})==9, "sg14::lut_function test failed");
+    static_assert(square_quadratic(make_fixed<3, 4>{2.5})==6.25, "sg14::lut_function test failed");
+
+    // results outside the range of the output saturate
+    constexpr auto square_saturated = make_lut_function<make_fixed<3, 4>, make_fixed<3, 4>, 4>(square{});
+    static_assert(square_saturated(make_fixed<3, 4>{-8})==std::numeric_limits<make_fixed<3, 4>>::max(),
+            "sg14::lut_function test failed");
+    static_assert(square_saturated(make_fixed<3, 4>{2})==4, "sg14::lut_function test failed");
+
+    // a table with one entry per input
+    constexpr auto square_exhaustive = make_lut_function<make_ufixed<8, 0>, make_ufixed<16, 0>, 8>(square{});
+    static_assert(square_exhaustive(make_ufixed<8, 0>{13})==169, "sg14::lut_function test failed");
+}
+
+TEST(lut, max_error)
+{
+    // an exact table has no error
+    ASSERT_EQ(square_exhaustive.max_error(), 0);
+    ASSERT_EQ(square_quadratic.max_error(), 0);
+    ASSERT_GT(square_linear.max_error(), 0);
+
+    // error diminishes with table size and interpolation order
+    auto coarse = make_lut_function<make_fixed<3, 12>, make_fixed<1, 14>, 5>(sigmoid{});
+    auto fine = make_lut_function<make_fixed<3, 12>, make_fixed<1, 14>, 8>(sigmoid{});
+    auto fine_quadratic = make_lut_function<make_fixed<3, 12>, make_fixed<1, 14>, 8, quadratic_interpolation>(
+            sigmoid{});
+    EXPECT_GT(coarse.max_error(), fine.max_error());
+    EXPECT_GT(fine.max_error(), fine_quadratic.max_error());
+    EXPECT_LE(fine_quadratic.max_error(), 2);
+}
+
+TEST(lut, evaluate)
+{
+    // a 64-entry table of a transfer curve is as accurate as a 1024-entry one
+    auto coarse = make_lut_function<make_ufixed<0, 16>, make_ufixed<1, 15>, 6>(gamma_curve{});
+    auto curve = make_lut_function<make_ufixed<0, 16>, make_ufixed<1, 15>, 6, quadratic_interpolation>(gamma_curve{});
+    EXPECT_GT(coarse.max_error(), 1);
+    EXPECT_LE(curve.max_error(), 1);
+    for (auto x = 0.; x<1; x += .0625) {
+        auto input = make_ufixed<0, 16>{x};
+        EXPECT_NEAR(static_cast<double>(curve(input)), gamma_curve{}(static_cast<double>(input)), .0001) << x;
+    }
+
+    // 32-bit input and output
+    auto wide = make_lut_function<fixed_point<std::int32_t, -24>, fixed_point<std::int32_t, -28>, 12,
+            quadratic_interpolation>(sigmoid{});
+    EXPECT_LE(wide.max_error(), 1 << 14);
+    EXPECT_NEAR(static_cast<double>(wide(fixed_point<std::int32_t, -24>{.75})), std::tanh(.75), 1e-4);
+
+    // functions which are not literal types can be captured
+    auto scale = 3.;
+    auto lambda = make_lut_function<make_fixed<7, 8>, make_fixed<15, 16>, 6>([scale](double x) { return x*scale; });
+    EXPECT_EQ(lambda(make_fixed<7, 8>{-5.5}), -16.5);
+    EXPECT_EQ(lambda.max_error(), 0);
+}
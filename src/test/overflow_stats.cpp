@@ -0,0 +1,146 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief tests of sg14/auxiliary/overflow_stats.h
+
+#include <sg14/auxiliary/overflow_stats.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+using sg14::counting_integer;
+using sg14::counting_overflow_policy;
+using sg14::fixed_point;
+using sg14::overflow_stats;
+using operation = overflow_stats::operation;
+using direction = overflow_stats::direction;
+
+namespace {
+    using wrapping_int32 = sg14::integer<std::int32_t, counting_overflow_policy<sg14::native_overflow_policy>>;
+
+    // results which do not overflow are constant expressions
+    static_assert(counting_integer<std::int16_t>(30000)+counting_integer<std::int16_t>(30000)==60000, "");
+    static_assert(counting_integer<std::int8_t>(100)==100, "");
+    static_assert(wrapping_int32(-65536)*32768==std::numeric_limits<std::int32_t>::lowest(), "");
+    static_assert((counting_integer<std::int32_t>(1) << 30)==1 << 30, "");
+}
+
+TEST(overflow_stats, saturate)
+{
+    overflow_stats::reset();
+
+    // 16-bit operands are promoted so their sum only overflows when converted back
+    auto sample = counting_integer<std::int16_t>(30000);
+    sample += sample;
+    ASSERT_EQ(sample, std::numeric_limits<std::int16_t>::max());
+    sample = counting_integer<std::int16_t>(-70000);
+    ASSERT_EQ(sample, std::numeric_limits<std::int16_t>::lowest());
+
+    auto wide = counting_integer<std::int64_t>(std::numeric_limits<std::int64_t>::max());
+    ASSERT_EQ(wide+1, std::numeric_limits<std::int64_t>::max());
+    ASSERT_EQ(-wide-2, std::numeric_limits<std::int64_t>::lowest());
+    ASSERT_EQ(wide*-3, std::numeric_limits<std::int64_t>::lowest());
+    ASSERT_EQ((-wide-1)/-1, std::numeric_limits<std::int64_t>::max());
+    ASSERT_EQ(-(-wide-1), std::numeric_limits<std::int64_t>::max());
+    ASSERT_EQ(counting_integer<std::uint32_t>(0u)-1u, 0u);
+
+    auto stats = overflow_stats::snapshot();
+    ASSERT_EQ(stats.count<std::int16_t>(operation::conversion, direction::positive), 1u);
+    ASSERT_EQ(stats.count<std::int16_t>(operation::conversion, direction::negative), 1u);
+    ASSERT_EQ(stats.count<std::int16_t>(operation::addition), 0u);
+    ASSERT_EQ(stats.count<std::int32_t>(operation::addition), 0u);
+    ASSERT_EQ(stats.count<std::int64_t>(operation::addition, direction::positive), 1u);
+    ASSERT_EQ(stats.count<std::int64_t>(operation::subtraction, direction::negative), 1u);
+    ASSERT_EQ(stats.count<std::int64_t>(operation::subtraction, direction::positive), 1u);
+    ASSERT_EQ(stats.count<std::int64_t>(operation::multiplication, direction::negative), 1u);
+    ASSERT_EQ(stats.count<std::int64_t>(operation::division, direction::positive), 1u);
+    ASSERT_EQ(stats.count<std::uint32_t>(operation::subtraction, direction::negative), 1u);
+    ASSERT_EQ(stats.total(), 8u);
+
+    // left shifts which lose bits other than copies of the sign bit
+    overflow_stats::reset();
+    ASSERT_EQ(counting_integer<std::int32_t>(1) << 31, std::numeric_limits<std::int32_t>::max());
+    ASSERT_EQ(counting_integer<std::int32_t>(-1) << 31, std::numeric_limits<std::int32_t>::lowest());
+    ASSERT_EQ(counting_integer<std::int32_t>(-2) << 31, std::numeric_limits<std::int32_t>::lowest());
+    ASSERT_EQ(wide << 64, std::numeric_limits<std::int64_t>::max());
+    ASSERT_EQ(counting_integer<std::int64_t>(0) << 64, 0);
+    ASSERT_EQ(counting_integer<std::uint32_t>(3u) << 31, std::numeric_limits<std::uint32_t>::max());
+    ASSERT_EQ(counting_integer<std::int32_t>(1) >> 31, 0);
+    stats = overflow_stats::snapshot();
+    ASSERT_EQ(stats.count<std::int32_t>(operation::shift_left, direction::positive), 1u);
+    ASSERT_EQ(stats.count<std::int32_t>(operation::shift_left, direction::negative), 1u);
+    ASSERT_EQ(stats.count<std::int64_t>(operation::shift_left, direction::positive), 1u);
+    ASSERT_EQ(stats.count<std::uint32_t>(operation::shift_left, direction::positive), 1u);
+    ASSERT_EQ(stats.total(), 4u);
+
+    overflow_stats::reset();
+    ASSERT_EQ(overflow_stats::snapshot().total(), 0u);
+}
+
+TEST(overflow_stats, wrap)
+{
+    overflow_stats::reset();
+    auto greatest = wrapping_int32(std::numeric_limits<std::int32_t>::max());
+    ASSERT_EQ(greatest+1, std::numeric_limits<std::int32_t>::lowest());
+    ASSERT_EQ(greatest*2, -2);
+    ASSERT_EQ(wrapping_int32(std::numeric_limits<std::int32_t>::lowest())/-1, std::numeric_limits<std::int32_t>::lowest());
+    ASSERT_EQ(wrapping_int32(3) << 31, std::numeric_limits<std::int32_t>::lowest());
+    ASSERT_EQ(wrapping_int32(-1) << 31, std::numeric_limits<std::int32_t>::lowest());
+    ASSERT_EQ(wrapping_int32(1) << 32, 0);
+
+    auto stats = overflow_stats::snapshot();
+    ASSERT_EQ(stats.count<std::int32_t>(operation::addition, direction::positive), 1u);
+    ASSERT_EQ(stats.count<std::int32_t>(operation::multiplication, direction::positive), 1u);
+    ASSERT_EQ(stats.count<std::int32_t>(operation::division, direction::positive), 1u);
+    ASSERT_EQ(stats.count<std::int32_t>(operation::shift_left, direction::positive), 2u);
+    ASSERT_EQ(stats.total(), 5u);
+}
+
+TEST(overflow_stats, fixed_point)
+{
+    // clipping of Q15 audio samples
+    using q15 = fixed_point<counting_integer<std::int16_t>, -15>;
+    overflow_stats::reset();
+    auto sum = q15(.75)+q15(.5);
+    ASSERT_EQ(q15(sum), std::numeric_limits<q15>::max());
+    ASSERT_EQ(q15(-.75*2), -1);
+    ASSERT_EQ(q15(.25)+q15(.5), .75);
+    ASSERT_EQ(overflow_stats::snapshot().count<std::int16_t>(operation::conversion), 2u);
+}
+
+TEST(overflow_stats, threads)
+{
+    // counts of threads which are running and of threads which have exited are summed
+    overflow_stats::reset();
+    constexpr auto num_threads = 4;
+    constexpr auto num_overflows = 10000;
+    auto clip = [] {
+        for (auto index = 0; index!=num_overflows; ++index) {
+            auto sample = counting_integer<std::int8_t>(index%2 ? 200 : -200);
+            ASSERT_EQ(sample, index%2 ? 127 : -128);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (auto thread = 0; thread!=num_threads; ++thread) {
+        threads.emplace_back(clip);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    clip();
+
+    auto stats = overflow_stats::snapshot();
+    ASSERT_EQ(stats.count<std::int8_t>(operation::conversion, direction::positive),
+            std::uint64_t{(num_threads+1)*num_overflows/2});
+    ASSERT_EQ(stats.count<std::int8_t>(operation::conversion, direction::negative),
+            std::uint64_t{(num_threads+1)*num_overflows/2});
+    ASSERT_EQ(stats.total(), std::uint64_t{(num_threads+1)*num_overflows});
+}
@@ -0,0 +1,121 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief tests of sg14::packed_array
+
+#include <sg14/auxiliary/packed_array.h>
+#include <sg14/auxiliary/elastic.h>
+
+#include "random_common.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using sg14::elastic;
+using sg14::fixed_point;
+using sg14::packed_array;
+
+namespace {
+    ////////////////////////////////////////////////////////////////////////////////
+    // element widths
+
+    static_assert(packed_array<elastic<7, 4>>::bits==12, "sg14::packed_array test failed");
+    static_assert(packed_array<elastic<12, 8, unsigned>>::bits==20, "sg14::packed_array test failed");
+    static_assert(packed_array<fixed_point<std::int16_t, -8>>::bits==16, "sg14::packed_array test failed");
+    static_assert(packed_array<fixed_point<std::int16_t, -8>, 12>::bits==12, "sg14::packed_array test failed");
+
+    template<class T, int Bits = sg14::width<typename T::rep>::value>
+    void test_packed_array()
+    {
+        // random values which fit in the given number of bits
+        constexpr int shift = sg14::width<typename T::rep>::value-Bits;
+        std::mt19937 generator(Bits);
+        for (auto size : {std::size_t{0}, std::size_t{1}, std::size_t{7}, std::size_t{8}, std::size_t{67}, std::size_t{1000}}) {
+            auto expected = random_values<T>(size, generator, shift);
+            packed_array<T, Bits> array(size);
+            ASSERT_EQ(array.size(), size);
+            ASSERT_EQ(array.size_in_bytes(), (size*Bits+7)/8);
+
+            // element-wise via proxies, in an order which interleaves neighbours
+            for (auto index = std::size_t{0}; index<size; index += 2) {
+                array[index] = expected[index];
+            }
+            for (auto index = std::size_t{1}; index<size; index += 2) {
+                array[index] = expected[index];
+            }
+            for (auto index = std::size_t{0}; index!=size; ++index) {
+                ASSERT_EQ(static_cast<T>(array[index]), expected[index]) << "size=" << size << " index=" << index;
+            }
+
+            // bulk unpack of ranges with unaligned ends
+            for (auto first = std::size_t{0}; first<size; first += 1+first*2) {
+                auto count = size-first-(size-first)/3;
+                std::vector<T> unpacked(count, T{0});
+                array.unpack(first, unpacked.data(), count);
+                for (auto index = std::size_t{0}; index!=count; ++index) {
+                    ASSERT_EQ(unpacked[index], expected[first+index]) << "first=" << first << " index=" << index;
+                }
+            }
+
+            // bulk pack of a range leaves its neighbours untouched
+            if (size>2) {
+                auto replacement = random_values<T>(size-2, generator, shift);
+                array.pack(1, replacement.data(), replacement.size());
+                std::copy(std::begin(replacement), std::end(replacement), std::begin(expected)+1);
+                auto const& constant = array;
+                for (auto index = std::size_t{0}; index!=size; ++index) {
+                    ASSERT_EQ(constant[index], expected[index]) << "size=" << size << " index=" << index;
+                }
+            }
+
+            // copy between elements
+            if (size>1) {
+                array[0] = array[size-1];
+                ASSERT_EQ(static_cast<T>(array[0]), expected[size-1]);
+            }
+        }
+    }
+}
+
+TEST(packed_array, elastic)
+{
+    test_packed_array<elastic<7, 4>>();
+    test_packed_array<elastic<12, 8, unsigned>>();
+    test_packed_array<elastic<0, 1, unsigned>>();
+    test_packed_array<elastic<20, 11>>();
+}
+
+TEST(packed_array, built_in)
+{
+    test_packed_array<fixed_point<std::int16_t, -8>, 12>();
+    test_packed_array<fixed_point<std::uint16_t, -8>, 12>();
+    test_packed_array<fixed_point<std::int32_t, -16>, 20>();
+    test_packed_array<fixed_point<std::int8_t, 0>, 1>();
+    test_packed_array<fixed_point<std::uint8_t, 0>, 8>();
+    test_packed_array<fixed_point<std::int64_t, -32>, 56>();
+}
+
+TEST(packed_array, resize)
+{
+    using s3_8 = fixed_point<std::int16_t, -8>;
+    packed_array<s3_8, 12> array(20);
+    for (auto index = 0; index!=20; ++index) {
+        array[index] = s3_8{-1};
+    }
+
+    // elements removed and restored are zero
+    array.resize(5);
+    array.resize(30);
+    for (auto index = 0; index!=30; ++index) {
+        ASSERT_EQ(static_cast<s3_8>(array[index]), s3_8{(index<5) ? -1 : 0}) << index;
+    }
+}
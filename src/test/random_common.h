@@ -0,0 +1,42 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief like fixed_point_common.h this file contains test code which is
+/// shared between different .cpp files; here, random fixed-point values.
+
+#if !defined(SG14_RANDOM_COMMON_H)
+#define SG14_RANDOM_COMMON_H 1
+
+#include <sg14/type_traits.h>
+
+#include <cstddef>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+// size values of fixed-point type T whose reps are drawn uniformly
+// from the range of the rep shifted right by shift bits
+template<class T, class Generator>
+std::vector<T> random_values(std::size_t size, Generator& generator, int shift = 0)
+{
+    using rep = typename T::rep;
+    constexpr bool is_signed = sg14::is_signed<rep>::value;
+    using distribution_type = typename std::conditional<is_signed, long long, unsigned long long>::type;
+
+    // the number of value bits which remain after shifting, of which there are up to 64
+    auto digits = static_cast<int>(sg14::width<rep>::value)-int{is_signed}-shift;
+    auto max = static_cast<distribution_type>(digits ? ~0ULL >> (64-digits) : 0ULL);
+    std::uniform_int_distribution<distribution_type> distribution(is_signed ? -max-1 : 0, max);
+
+    std::vector<T> values;
+    for (auto index = std::size_t{0}; index!=size; ++index) {
+        values.push_back(T::from_data(static_cast<rep>(distribution(generator))));
+    }
+    return values;
+}
+
+#endif  // SG14_RANDOM_COMMON_H
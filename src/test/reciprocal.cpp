@@ -0,0 +1,175 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief tests of sg14::reciprocal
+
+#include <sg14/auxiliary/reciprocal.h>
+
+#include "random_common.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using sg14::fixed_point;
+using sg14::reciprocal;
+
+namespace {
+    // random values of the given rep interspersed with extremes, powers of two and small values
+    template<class Rep>
+    std::vector<Rep> random_reps(std::size_t size, std::mt19937_64& generator)
+    {
+        auto values = random_values<fixed_point<Rep, 0>>(size, generator);
+        std::vector<Rep> reps;
+        for (auto index = std::size_t{0}; index!=size; ++index) {
+            auto rep = values[index].data();
+            switch (index%7) {
+            case 0:
+                rep = std::numeric_limits<Rep>::min();
+                break;
+            case 1:
+                rep = std::numeric_limits<Rep>::max();
+                break;
+            case 2:
+                rep = static_cast<Rep>(Rep{1} << (index%std::numeric_limits<Rep>::digits));
+                break;
+            case 3:
+                rep = static_cast<Rep>(rep >> (index%std::numeric_limits<Rep>::digits));
+                break;
+            case 4:
+                rep = static_cast<Rep>(index%3);
+                break;
+            }
+            reps.push_back(rep);
+        }
+        return reps;
+    }
+
+    template<class Dividend, class Divisor>
+    void test_divide(Dividend dividend, Divisor divisor, reciprocal<Divisor, Dividend> const& r, std::true_type)
+    {
+        // the quotient of the built-in division operator overflows
+        if (std::is_signed<typename Dividend::rep>::value
+            && dividend.data()==std::numeric_limits<typename Dividend::rep>::min()
+            && divisor.data()==static_cast<typename Divisor::rep>(-1)) {
+            return;
+        }
+
+        auto expected = sg14::divide(dividend, divisor);
+        auto actual = r.divide(dividend);
+        static_assert(std::is_same<decltype(expected), decltype(actual)>::value, "sg14::reciprocal test failed");
+        ASSERT_EQ(expected.data(), actual.data()) << "divide(" << dividend << ", " << divisor << ")";
+    }
+
+    // reciprocal::divide is unavailable where the divisor would be converted to unsigned
+    template<class Dividend, class Divisor>
+    void test_divide(Dividend, Divisor, reciprocal<Divisor, Dividend> const&, std::false_type)
+    {
+    }
+
+    template<class Dividend, class Divisor>
+    void test_operator(Dividend dividend, Divisor divisor, reciprocal<Divisor, Dividend> const& r, std::true_type)
+    {
+        auto expected = dividend/divisor;
+        auto actual = dividend/r;
+        static_assert(std::is_same<decltype(expected), decltype(actual)>::value, "sg14::reciprocal test failed");
+        ASSERT_EQ(expected.data(), actual.data()) << dividend << " / " << divisor;
+    }
+
+    // operator/ is unavailable where no integer is wide enough for the quotient
+    template<class Dividend, class Divisor>
+    void test_operator(Dividend, Divisor, reciprocal<Divisor, Dividend> const&, std::false_type)
+    {
+    }
+
+    template<class Dividend, class Divisor, bool Lean = true>
+    void test_reciprocal()
+    {
+        using dividend_rep = typename Dividend::rep;
+        using divisor_rep = typename Divisor::rep;
+
+        std::mt19937_64 generator(42);
+        auto dividends = random_reps<dividend_rep>(1000, generator);
+        for (auto divisor_data : random_reps<divisor_rep>(100, generator)) {
+            if (divisor_data==0) {
+                continue;
+            }
+            auto divisor = Divisor::from_data(divisor_data);
+            auto r = reciprocal<Divisor, Dividend>{divisor};
+            ASSERT_EQ(r.divisor(), divisor);
+
+            for (auto dividend_data : dividends) {
+                auto dividend = Dividend::from_data(dividend_data);
+
+                test_operator(dividend, divisor, r, std::integral_constant<bool,
+                        !std::is_void<typename reciprocal<Divisor, Dividend>::result_type>::value>{});
+                test_divide(dividend, divisor, r, std::integral_constant<bool, Lean>{});
+            }
+        }
+    }
+}
+
+TEST(reciprocal, narrow)
+{
+    test_reciprocal<fixed_point<std::int8_t, -4>, fixed_point<std::int8_t, -4>>();
+    test_reciprocal<fixed_point<std::uint8_t, -8>, fixed_point<std::uint8_t, -4>>();
+    test_reciprocal<fixed_point<std::int16_t, -15>, fixed_point<std::int16_t, -15>>();
+    test_reciprocal<fixed_point<std::uint16_t, -8>, fixed_point<std::int16_t, -8>>();
+    test_reciprocal<fixed_point<std::int8_t, 0>, fixed_point<std::int32_t, -16>>();
+}
+
+TEST(reciprocal, wide)
+{
+    test_reciprocal<fixed_point<std::int32_t, -16>, fixed_point<std::int32_t, -16>>();
+    test_reciprocal<fixed_point<std::int32_t, -31>, fixed_point<std::int16_t, -4>>();
+    test_reciprocal<fixed_point<std::uint32_t, -16>, fixed_point<std::int32_t, -16>, false>();
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST(reciprocal, int64)
+{
+    // the quotients of 32-bit unsigned divisors need a 128-bit magic constant
+    test_reciprocal<fixed_point<std::int32_t, -16>, fixed_point<std::uint32_t, -16>, false>();
+    test_reciprocal<fixed_point<std::uint32_t, -16>, fixed_point<std::uint32_t, -32>>();
+
+    // as do those of 64-bit reps, whose operator/ requires SG14_INT128_ENABLED
+    test_reciprocal<fixed_point<std::int64_t, -32>, fixed_point<std::int64_t, -32>>();
+    test_reciprocal<fixed_point<std::int64_t, -32>, fixed_point<std::int16_t, -8>>();
+    test_reciprocal<fixed_point<std::int8_t, 0>, fixed_point<std::int64_t, -32>>();
+#if !defined(SG14_INT128_ENABLED)
+    static_assert(std::is_void<reciprocal<fixed_point<std::int64_t, -32>>::result_type>::value,
+            "sg14::reciprocal test failed");
+#endif
+}
+
+TEST(reciprocal, multiply_shift_64)
+{
+    // the quotient of operator/ of 64-bit reps, (dividend << Rhs::digits)/divisor, checked in 128 bits
+    using sg14::_reciprocal_impl::wide_product;
+    constexpr auto digits = std::numeric_limits<std::int64_t>::digits;
+
+    std::mt19937_64 generator(64);
+    auto dividends = random_reps<std::int64_t>(1000, generator);
+    for (auto divisor : random_reps<std::int64_t>(100, generator)) {
+        if (divisor==0) {
+            continue;
+        }
+        auto divisor_magnitude = sg14::_reciprocal_impl::magnitude(divisor);
+        auto shift = std::max(digits+sg14::_impl::ceil_log2(divisor_magnitude), 64);
+        auto magic = sg14::_reciprocal_impl::ceil_pow2_quotient<wide_product>(digits+shift, divisor_magnitude);
+        for (auto dividend : dividends) {
+            auto dividend_magnitude = sg14::_reciprocal_impl::magnitude(dividend);
+            auto expected = (wide_product{dividend_magnitude} << digits)/divisor_magnitude;
+            auto actual = sg14::_reciprocal_impl::multiply_shift<64>::apply(dividend_magnitude, magic, shift);
+            ASSERT_TRUE(expected==actual) << dividend << " / " << divisor;
+        }
+    }
+}
+#endif
@@ -0,0 +1,190 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief tests of sg14/auxiliary/reduce.h
+
+#include <sg14/auxiliary/reduce.h>
+
+#include "random_common.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using sg14::fixed_point;
+using sg14::make_fixed;
+using sg14::make_ufixed;
+
+namespace {
+    using q15 = make_fixed<0, 15>;
+    using s3_4 = make_fixed<3, 4>;
+    using s15_16 = make_fixed<15, 16>;
+    using u8_8 = make_ufixed<8, 8>;
+
+    static_assert(std::is_same<decltype(sg14::sum(std::declval<q15*>(), 0)), fixed_point<std::int64_t, -15>>::value,
+            "sg14::sum test failed");
+    static_assert(std::is_same<decltype(sg14::sum(std::declval<s15_16*>(), 0)), fixed_point<std::int64_t, -16>>::value,
+            "sg14::sum test failed");
+    static_assert(std::is_same<decltype(sg14::sum(std::declval<u8_8*>(), 0)), fixed_point<std::int64_t, -8>>::value,
+            "sg14::sum test failed");
+#if defined(SG14_INT128_ENABLED)
+    static_assert(std::is_same<decltype(sg14::sum(std::declval<fixed_point<std::uint32_t, -16>*>(), 0)),
+            fixed_point<SG14_INT128, -16>>::value, "sg14::sum test failed");
+#endif
+    static_assert(std::is_same<decltype(sg14::sum_of_squares(std::declval<q15*>(), 0)),
+            fixed_point<std::int64_t, -30>>::value, "sg14::sum_of_squares test failed");
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // reductions compared with a single-threaded loop for any number of threads
+
+    template<class T>
+    void test_reduce(std::vector<T> const& values)
+    {
+        auto total = std::int64_t{0};
+        auto least = std::numeric_limits<T>::max(), greatest = std::numeric_limits<T>::lowest();
+        for (auto const& value : values) {
+            total += value.data();
+            least = (value<least) ? value : least;
+            greatest = (value>greatest) ? value : greatest;
+        }
+
+        for (auto threads = 1u; threads!=10; ++threads) {
+            ASSERT_EQ(sg14::sum(values.data(), values.size(), threads).data(), total) << "threads=" << threads;
+            ASSERT_EQ(sg14::min(values.data(), values.size(), threads), least) << "threads=" << threads;
+            ASSERT_EQ(sg14::max(values.data(), values.size(), threads), greatest) << "threads=" << threads;
+            ASSERT_EQ(sg14::mean(values.data(), values.size(), threads, sg14::round_toward_zero{}).data(),
+                    values.empty() ? 0 : total/static_cast<std::int64_t>(values.size())) << "threads=" << threads;
+
+            // sums of doubles whose terms are exact are associative
+            auto exact = sg14::reduce(values.data(), values.size(), 0., [](double lhs, double rhs) { return lhs+rhs; },
+                    threads);
+            ASSERT_EQ(exact, std::ldexp(static_cast<double>(total), T::exponent)) << "threads=" << threads;
+        }
+    }
+}
+
+TEST(reduce, q15)
+{
+    std::mt19937 generator(1);
+    for (auto size : {std::size_t{0}, std::size_t{1}, std::size_t{4095}, std::size_t{4096}, std::size_t{4097},
+                      std::size_t{100003}}) {
+        test_reduce(random_values<q15>(size, generator));
+    }
+}
+
+TEST(reduce, widths)
+{
+    std::mt19937 generator(2);
+    test_reduce(random_values<s3_4>(50000, generator));
+    test_reduce(random_values<u8_8>(50000, generator));
+    test_reduce(random_values<s15_16>(50000, generator));
+}
+
+TEST(reduce, extremes)
+{
+    // sums of the lowest and greatest values which overflow a 32-bit sum
+    std::vector<s15_16> lowest(20000, std::numeric_limits<s15_16>::lowest());
+    ASSERT_EQ(sg14::sum(lowest.data(), lowest.size(), 3).data(), std::int64_t{-20000}*(std::int64_t{1} << 31));
+    ASSERT_EQ(sg14::mean(lowest.data(), lowest.size(), 3, sg14::round_half_even{}),
+            std::numeric_limits<s15_16>::lowest());
+
+    std::vector<q15> greatest(70000, std::numeric_limits<q15>::max());
+    ASSERT_EQ(sg14::sum_of_squares(greatest.data(), greatest.size(), 5).data(), std::int64_t{70000}*32767*32767);
+    std::vector<q15> lowest_q15(70000, std::numeric_limits<q15>::lowest());
+    ASSERT_EQ(sg14::sum_of_squares(lowest_q15.data(), lowest_q15.size(), 5).data(), std::int64_t{70000} << 30);
+}
+
+TEST(reduce, sum_of_squares)
+{
+    std::mt19937 generator(3);
+    auto values = random_values<q15>(30000, generator);
+    auto total = std::int64_t{0};
+    for (auto const& value : values) {
+        total += std::int64_t{value.data()}*value.data();
+    }
+    for (auto threads = 1u; threads!=10; ++threads) {
+        ASSERT_EQ(sg14::sum_of_squares(values.data(), values.size(), threads).data(), total);
+    }
+}
+
+TEST(reduce, mean)
+{
+    // means of 1.5, 2.5 and -1.5 LSBs
+    using s7_0 = fixed_point<std::int8_t, 0>;
+    const s7_0 three_halves[] = {s7_0{1}, s7_0{2}};
+    const s7_0 five_halves[] = {s7_0{1}, s7_0{4}};
+    const s7_0 negative[] = {s7_0{-1}, s7_0{-2}};
+    ASSERT_EQ(sg14::mean(three_halves, 2), 1);
+    ASSERT_EQ(sg14::mean(three_halves, 2, 1, sg14::round_half_up{}), 2);
+    ASSERT_EQ(sg14::mean(three_halves, 2, 1, sg14::round_half_even{}), 2);
+    ASSERT_EQ(sg14::mean(five_halves, 2), 2);
+    ASSERT_EQ(sg14::mean(five_halves, 2, 1, sg14::round_half_up{}), 3);
+    ASSERT_EQ(sg14::mean(five_halves, 2, 1, sg14::round_half_even{}), 2);
+    ASSERT_EQ(sg14::mean(negative, 2), -1);
+    ASSERT_EQ(sg14::mean(negative, 2, 1, sg14::round_half_up{}), -1);
+    ASSERT_EQ(sg14::mean(negative, 2, 1, sg14::round_half_even{}), -2);
+    ASSERT_EQ(sg14::mean(negative, 0), 0);
+}
+
+TEST(reduce, reduce)
+{
+    // the results of the ranges are combined in order
+    std::vector<s3_4> values;
+    for (auto index = 0; index!=10000; ++index) {
+        values.push_back(s3_4::from_data(static_cast<std::int8_t>(index%7)));
+    }
+    auto last = [](s15_16, s15_16 rhs) { return rhs; };
+    for (auto threads = 1u; threads!=5; ++threads) {
+        ASSERT_EQ(sg14::reduce(values.data(), values.size(), s15_16{-1}, last, threads), values.back())
+                << "threads=" << threads;
+    }
+
+    // and, for an associative operation, the result does not depend on the number of threads
+    auto greatest = [](s15_16 lhs, s15_16 rhs) { return (lhs>rhs) ? lhs : rhs; };
+    for (auto threads = 1u; threads!=5; ++threads) {
+        ASSERT_EQ(sg14::reduce(values.data(), values.size(), std::numeric_limits<s15_16>::lowest(), greatest, threads),
+                .375) << "threads=" << threads;
+    }
+    ASSERT_EQ(sg14::reduce(values.data(), 0, s15_16{-1}, greatest, 4), -1);
+}
+
+TEST(reduce, concurrent)
+{
+    // threads which persist between reductions are shared by reductions on several threads
+    std::mt19937 generator(4);
+    auto values = random_values<q15>(100000, generator);
+    auto total = sg14::sum(values.data(), values.size()).data();
+    std::vector<std::int64_t> totals(6);
+    std::vector<std::thread> callers;
+    for (auto caller = std::size_t{0}; caller!=totals.size(); ++caller) {
+        callers.emplace_back([&, caller] {
+            for (auto repeat = 0; repeat!=20; ++repeat) {
+                totals[caller] = sg14::sum(values.data(), values.size(), static_cast<unsigned>(caller+2)).data();
+            }
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    for (auto caller_total : totals) {
+        ASSERT_EQ(caller_total, total);
+    }
+
+    // and by reductions nested in those of other reductions
+    auto part = sg14::sum(values.data(), 5*4096).data();
+    auto count = [&](std::int64_t lhs, std::int64_t rhs) {
+        return lhs+rhs+(sg14::sum(values.data(), 5*4096, 8).data()==part);
+    };
+    std::vector<fixed_point<std::int32_t, 0>> zeros(3*4096, fixed_point<std::int32_t, 0>{0});
+    ASSERT_EQ(sg14::reduce(zeros.data(), zeros.size(), std::int64_t{0}, count, 3), 3*4096);
+}
@@ -0,0 +1,266 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief tests of rounding conversion, multiplication and division of sg14::fixed_point values
+
+#include <sg14/fixed_point.h>
+
+#include "random_common.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+
+using sg14::fixed_point;
+using sg14::round_half_even;
+using sg14::round_half_up;
+using sg14::round_toward_zero;
+
+namespace {
+    ////////////////////////////////////////////////////////////////////////////////
+    // rounding of constant values
+
+    using q4_3 = fixed_point<std::int8_t, -3>;
+    using q4_1 = fixed_point<std::int8_t, -1>;
+
+    static_assert(q4_1{q4_3{1.25}, round_toward_zero{}}==1., "sg14::round_toward_zero test failed");
+    static_assert(q4_1{q4_3{-1.25}, round_toward_zero{}}==-1., "sg14::round_toward_zero test failed");
+    static_assert(q4_1{q4_3{1.25}, round_half_up{}}==1.5, "sg14::round_half_up test failed");
+    static_assert(q4_1{q4_3{-1.25}, round_half_up{}}==-1., "sg14::round_half_up test failed");
+    static_assert(q4_1{q4_3{-1.375}, round_half_up{}}==-1.5, "sg14::round_half_up test failed");
+    static_assert(q4_1{q4_3{1.25}, round_half_even{}}==1., "sg14::round_half_even test failed");
+    static_assert(q4_1{q4_3{1.75}, round_half_even{}}==2., "sg14::round_half_even test failed");
+    static_assert(q4_1{q4_3{-1.75}, round_half_even{}}==-2., "sg14::round_half_even test failed");
+    static_assert(q4_1{q4_3{-1.625}, round_half_even{}}==-1.5, "sg14::round_half_even test failed");
+
+    static_assert(fixed_point<int, 2>{6, round_half_up{}}==8, "sg14::round_half_up test failed");
+    static_assert(fixed_point<int, 2>{-6, round_half_up{}}==-4, "sg14::round_half_up test failed");
+    static_assert(fixed_point<int, 2>{6, round_half_even{}}==8, "sg14::round_half_even test failed");
+    static_assert(fixed_point<int, 2>{10, round_half_even{}}==8, "sg14::round_half_even test failed");
+
+    static_assert(q4_1{.75, round_half_up{}}==1., "sg14::round_half_up test failed");
+    static_assert(q4_1{-.75, round_half_up{}}==-.5, "sg14::round_half_up test failed");
+    static_assert(q4_1{-.75, round_half_even{}}==-1., "sg14::round_half_even test failed");
+    static_assert(q4_1{-.8, round_half_even{}}==-1., "sg14::round_half_even test failed");
+
+    // rounding one half LSB above the highest value or below the lowest value does not wrap
+    using q3_4 = fixed_point<std::int8_t, -4>;
+    static_assert(q3_4{7.99, round_half_up{}}.data()==127, "sg14::round_half_up test failed");
+    static_assert(q3_4{7.96875, round_half_up{}}.data()==127, "sg14::round_half_up test failed");
+    static_assert(q3_4{7.96875, round_half_even{}}.data()==127, "sg14::round_half_even test failed");
+    static_assert(q3_4{-8.05, round_half_up{}}.data()==-128, "sg14::round_half_up test failed");
+    static_assert(q3_4{-8.05, round_half_even{}}.data()==-128, "sg14::round_half_even test failed");
+    static_assert(q3_4{fixed_point<std::int16_t, -5>{7.96875}, round_half_up{}}.data()==127,
+            "sg14::round_half_up test failed");
+    static_assert(q3_4{fixed_point<std::int16_t, -5>{7.96875}, round_half_even{}}.data()==127,
+            "sg14::round_half_even test failed");
+    static_assert(fixed_point<std::int8_t, 1>{255, round_half_up{}}.data()==127, "sg14::round_half_up test failed");
+    static_assert(sg14::divide<q3_4>(fixed_point<std::int16_t, -8>{7.99}, 1, round_half_up{}).data()==127,
+            "sg14::divide test failed");
+    static_assert(sg14::divide<q3_4>(fixed_point<std::int16_t, -8>{-8.05}, 1, round_half_up{}).data()==-128,
+            "sg14::divide test failed");
+
+    static_assert(sg14::divide<q4_1>(q4_3{1}, 3, round_half_up{})==.5, "sg14::divide test failed");
+    static_assert(sg14::divide<q4_1>(q4_3{-1}, 4, round_half_up{})==0, "sg14::divide test failed");
+    static_assert(sg14::divide<q4_1>(q4_3{-1}, 4, round_half_even{})==0, "sg14::divide test failed");
+    static_assert(sg14::divide<q4_1>(q4_3{-3}, 4, round_half_even{})==-1, "sg14::divide test failed");
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // reference rounding using 64-bit integers
+
+    enum class mode {
+        toward_zero, half_up, half_even
+    };
+
+    // rounds the quotient of numerator and positive denominator
+    std::int64_t reference(std::int64_t numerator, std::int64_t denominator, mode m)
+    {
+        auto floor = numerator/denominator-(numerator%denominator<0);
+        auto remainder = numerator-floor*denominator;
+        switch (m) {
+        case mode::toward_zero:
+            return numerator/denominator;
+        case mode::half_up:
+            return floor+(remainder*2>=denominator);
+        case mode::half_even:
+            return floor+(remainder*2>denominator || (remainder*2==denominator && (floor & 1)));
+        }
+        return 0;
+    }
+
+    template<class Rep>
+    bool in_range(std::int64_t value)
+    {
+        return value>=std::numeric_limits<Rep>::min() && value<=std::numeric_limits<Rep>::max();
+    }
+
+    // the rounded quotient or, where rounding carries it out of the range of Rep, the truncated quotient
+    template<class Rep>
+    std::int64_t reference(std::int64_t numerator, std::int64_t denominator, mode m)
+    {
+        auto rounded = reference(numerator, denominator, m);
+        auto truncated = reference(numerator, denominator, mode::toward_zero);
+        return (in_range<Rep>(truncated) && !in_range<Rep>(rounded)) ? truncated : rounded;
+    }
+
+    template<class RoundingPolicy>
+    struct mode_of;
+
+    template<>
+    struct mode_of<round_toward_zero> : std::integral_constant<mode, mode::toward_zero> {
+    };
+
+    template<>
+    struct mode_of<round_half_up> : std::integral_constant<mode, mode::half_up> {
+    };
+
+    template<>
+    struct mode_of<round_half_even> : std::integral_constant<mode, mode::half_even> {
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // exhaustive and random tests
+
+    template<class Result, class Input, class RoundingPolicy>
+    void test_convert(Input input)
+    {
+        constexpr int shift = Result::exponent-Input::exponent;
+        static_assert(shift>0 && shift<32, "test requires a narrowing conversion");
+        auto expected = reference<typename Result::rep>(input.data(), std::int64_t{1} << shift, mode_of<RoundingPolicy>::value);
+        if (in_range<typename Result::rep>(expected)) {
+            ASSERT_EQ(Result(input, RoundingPolicy{}).data(), expected) << input;
+        }
+    }
+
+    template<class Result, class Input>
+    void test_convert(Input input)
+    {
+        test_convert<Result, Input, round_toward_zero>(input);
+        test_convert<Result, Input, round_half_up>(input);
+        test_convert<Result, Input, round_half_even>(input);
+
+        // truncation is the default
+        ASSERT_EQ(Result(input, round_toward_zero{}), Result(input));
+    }
+
+    template<class Result, class Lhs, class Rhs, class RoundingPolicy>
+    void test_multiply(Lhs lhs, Rhs rhs)
+    {
+        constexpr int shift = Result::exponent-Lhs::exponent-Rhs::exponent;
+        static_assert(shift>0 && shift<63, "test requires a narrowing multiply");
+        auto product = std::int64_t{lhs.data()}*rhs.data();
+        auto expected = reference<typename Result::rep>(product, std::int64_t{1} << shift, mode_of<RoundingPolicy>::value);
+        if (in_range<typename Result::rep>(expected)) {
+            ASSERT_EQ(sg14::multiply<Result>(lhs, rhs, RoundingPolicy{}).data(), expected) << lhs << '*' << rhs;
+        }
+    }
+
+    template<class Result, class Lhs, class Rhs, class RoundingPolicy>
+    void test_divide(Lhs lhs, Rhs rhs)
+    {
+        constexpr int shift = Lhs::exponent-Rhs::exponent-Result::exponent;
+        static_assert(shift>=0 && shift<31, "test scales the dividend");
+        auto numerator = (std::int64_t{lhs.data()} << shift)*((rhs.data()<0) ? -1 : 1);
+        auto denominator = (rhs.data()<0) ? -std::int64_t{rhs.data()} : std::int64_t{rhs.data()};
+        auto expected = reference<typename Result::rep>(numerator, denominator, mode_of<RoundingPolicy>::value);
+        if (in_range<typename Result::rep>(expected)) {
+            ASSERT_EQ(sg14::divide<Result>(lhs, rhs, RoundingPolicy{}).data(), expected) << lhs << '/' << rhs;
+        }
+    }
+
+    template<class Result, class Lhs, class Rhs>
+    void test_arithmetic(Lhs lhs, Rhs rhs)
+    {
+        test_multiply<Result, Lhs, Rhs, round_toward_zero>(lhs, rhs);
+        test_multiply<Result, Lhs, Rhs, round_half_up>(lhs, rhs);
+        test_multiply<Result, Lhs, Rhs, round_half_even>(lhs, rhs);
+        if (rhs.data()!=0) {
+            test_divide<Result, Lhs, Rhs, round_toward_zero>(lhs, rhs);
+            test_divide<Result, Lhs, Rhs, round_half_up>(lhs, rhs);
+            test_divide<Result, Lhs, Rhs, round_half_even>(lhs, rhs);
+        }
+    }
+}
+
+TEST(rounding, convert)
+{
+    for (auto n = 0; n!=1 << 16; ++n) {
+        auto data = static_cast<std::int16_t>(n);
+        test_convert<fixed_point<std::int8_t, -2>>(fixed_point<std::int16_t, -8>::from_data(data));
+        test_convert<fixed_point<std::int16_t, -7>>(fixed_point<std::int16_t, -8>::from_data(data));
+        test_convert<fixed_point<std::uint8_t, 0>>(fixed_point<std::int16_t, -8>::from_data(data));
+        test_convert<fixed_point<std::int32_t, 12>>(fixed_point<std::int16_t, 0>::from_data(data));
+        test_convert<fixed_point<std::int8_t, 0>>(fixed_point<std::uint16_t, -8>::from_data(static_cast<std::uint16_t>(n)));
+    }
+
+    std::mt19937 generator(42);
+    for (auto input : random_values<fixed_point<std::int32_t, -31>>(100000, generator)) {
+        test_convert<fixed_point<std::int16_t, -16>>(input);
+        test_convert<fixed_point<std::int32_t, -8>>(input);
+        test_convert<fixed_point<std::int64_t, -30>>(input);
+    }
+}
+
+TEST(rounding, convert_floating_point)
+{
+    using q7_8 = fixed_point<std::int16_t, -8>;
+    for (auto n = -(1 << 19); n!=1 << 19; ++n) {
+        // every multiple of 2^-12 in range
+        auto value = n/4096.;
+        auto input = fixed_point<std::int32_t, -12>::from_data(n);
+        ASSERT_EQ(q7_8(value, round_toward_zero{}), q7_8(input, round_toward_zero{})) << value;
+        ASSERT_EQ(q7_8(value, round_half_up{}), q7_8(input, round_half_up{})) << value;
+        ASSERT_EQ(q7_8(value, round_half_even{}), q7_8(input, round_half_even{})) << value;
+        ASSERT_EQ(q7_8(static_cast<float>(value), round_half_even{}), q7_8(input, round_half_even{})) << value;
+    }
+}
+
+TEST(rounding, narrow)
+{
+    using q7 = fixed_point<std::int8_t, -7>;
+    using uq8 = fixed_point<std::uint8_t, -8>;
+    for (auto l = 0; l!=1 << 8; ++l) {
+        for (auto r = 0; r!=1 << 8; ++r) {
+            auto lhs = q7::from_data(static_cast<std::int8_t>(l));
+            auto rhs = q7::from_data(static_cast<std::int8_t>(r));
+            test_arithmetic<q7>(lhs, rhs);
+            test_arithmetic<fixed_point<std::int16_t, -12>>(lhs, rhs);
+            test_arithmetic<fixed_point<std::int8_t, -3>>(lhs, rhs);
+            test_arithmetic<uq8>(uq8::from_data(static_cast<std::uint8_t>(l)), uq8::from_data(static_cast<std::uint8_t>(r)));
+            test_arithmetic<q7>(lhs, uq8::from_data(static_cast<std::uint8_t>(r)));
+        }
+    }
+}
+
+TEST(rounding, wide)
+{
+    using q15 = fixed_point<std::int16_t, -15>;
+    using s15_16 = fixed_point<std::int32_t, -16>;
+    std::mt19937 generator(42);
+    auto lhs_values = random_values<s15_16>(100000, generator);
+    auto rhs_values = random_values<s15_16>(100000, generator);
+    auto q15_lhs_values = random_values<q15>(100000, generator);
+    auto q15_rhs_values = random_values<q15>(100000, generator);
+    for (auto n = 0; n!=100000; ++n) {
+        auto lhs = lhs_values[n];
+        auto rhs = s15_16::from_data(rhs_values[n].data() >> (n%31));
+        test_multiply<s15_16, s15_16, s15_16, round_half_up>(lhs, rhs);
+        test_multiply<s15_16, s15_16, s15_16, round_half_even>(lhs, rhs);
+        test_multiply<fixed_point<std::int64_t, -1>, s15_16, s15_16, round_half_even>(lhs, rhs);
+
+        auto q15_lhs = q15_lhs_values[n];
+        auto q15_rhs = q15_rhs_values[n];
+        test_arithmetic<q15>(q15_lhs, q15_rhs);
+        test_arithmetic<fixed_point<std::int32_t, -20>>(q15_lhs, q15_rhs);
+        if (q15_rhs.data()!=0) {
+            test_divide<fixed_point<std::int32_t, -8>, s15_16, q15, round_half_even>(lhs, q15_rhs);
+            test_divide<fixed_point<std::int32_t, -8>, s15_16, q15, round_half_up>(lhs, q15_rhs);
+        }
+    }
+}
@@ -5,7 +5,22 @@
 //          http://www.boost.org/LICENSE_1_0.txt)
 
 #include <sg14/fixed_point.h>
+#include <sg14/auxiliary/accumulator.h>
+#include <sg14/auxiliary/batch.h>
+#include <sg14/auxiliary/biquad.h>
 #include <sg14/auxiliary/elastic.h>
+#include <sg14/auxiliary/fft.h>
+#include <sg14/auxiliary/fir.h>
+#include <sg14/auxiliary/geometry.h>
+#include <sg14/auxiliary/lut.h>
+#include <sg14/auxiliary/packed_array.h>
+#include <sg14/auxiliary/reciprocal.h>
+#include <sg14/auxiliary/reduce.h>
+#include <sg14/auxiliary/wide_integer.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
 
 using namespace sg14;
 
@@ -58,6 +73,188 @@ static_assert(std::is_same<new_type, fixed_point<int32_t>>::value, "failed to re
 //! [use set_width 3]
 }
 
+namespace convert_with_rounding {
+//! [convert with rounding]
+constexpr auto n = fixed_point<int, -8>{2.625};
+
+// the fractional bits which are discarded are rounded to nearest
+constexpr auto rounded = fixed_point<int, -2>{n, round_half_up{}};
+static_assert(rounded==2.75, "failed to round to nearest");
+
+// by default, they are truncated
+static_assert(fixed_point<int, -2>{n}==2.5, "failed to truncate");
+//! [convert with rounding]
+}
+
+namespace multiply_with_rounding {
+//! [multiply with rounding]
+using q15 = fixed_point<std::int16_t, -15>;
+
+// the 30 fractional bits of the product are rounded to 15 with a single add
+constexpr auto product = multiply<q15>(q15{.75}, q15::from_data(3), round_half_even{});
+static_assert(product.data()==2, "failed to round 2.25 LSBs to nearest");
+//! [multiply with rounding]
+}
+
+namespace define_a_lut_function {
+//! [define a lut_function]
+struct smoothstep {
+    constexpr double operator()(double x) const { return x*x*(3.-2.*x); }
+};
+
+// 16 intervals of an 8-bit input, sampled at compile time
+constexpr auto curve = make_lut_function<make_ufixed<0, 8>, make_ufixed<0, 8>, 4>(smoothstep{});
+static_assert(curve(make_ufixed<0, 8>{.5})==.5, "failed to approximate smoothstep with a lut_function");
+//! [define a lut_function]
+}
+
+namespace define_a_packed_array {
+//! [define a packed_array]
+// an elastic type with 7 integer digits, 4 fractional digits and a sign bit
+using sample = elastic<7, 4>;
+
+// 1000 samples stored in 1500 bytes rather than the 4000 occupied by an array of sample
+auto samples = packed_array<sample>(1000);
+//! [define a packed_array]
+}
+
+namespace divide_by_a_reciprocal {
+//! [divide by a reciprocal]
+template<class FixedPoint>
+void normalize(FixedPoint* values, int size, FixedPoint total)
+{
+    // one division's worth of work up front...
+    auto const divisor = reciprocal<FixedPoint>{total};
+
+    for (auto index = 0; index!=size; ++index) {
+        // ...then each quotient costs a multiply, with the same result as values[index]/total
+        values[index] = static_cast<FixedPoint>(values[index]/divisor);
+    }
+}
+//! [divide by a reciprocal]
+}
+
+namespace convert_an_array_of_float_to_q15 {
+//! [convert an array of float to Q15]
+template<class FixedPoint>
+void quantize(const float* samples, FixedPoint* quantized, std::size_t size)
+{
+    // with FixedPoint = fixed_point<int16_t, -15>, samples are rounded to the nearest multiple of 2^-15;
+    // those outside [-1, 1) are clamped and NaN becomes zero
+    convert(samples, quantized, size, round_half_even{});
+}
+
+//! [convert an array of float to Q15]
+}
+
+namespace accumulate_a_dot_product {
+//! [accumulate a dot product]
+template<class Q15>
+Q15 correlate(const Q15* signal, const Q15* kernel)
+{
+    // the 64 products of Q15 values are summed exactly in a fixed_point<int64_t, -30>...
+    accumulator<Q15, 64> sum;
+    sum.dot(signal, kernel, 64);
+
+    // ...and rounded back to Q15 once, at the end
+    return sum.template result<Q15>(round_half_even{});
+}
+//! [accumulate a dot product]
+}
+
+namespace filter_a_block_of_samples {
+//! [filter a block of samples]
+template<class Q15>
+void smooth(const Q15* samples, Q15* smoothed, std::size_t size)
+{
+    // each output is the mean of the last four input samples, rounded once
+    const Q15 coefficients[] = {Q15{.25}, Q15{.25}, Q15{.25}, Q15{.25}};
+    fir<Q15, Q15, round_half_even> moving_average(coefficients, 4);
+    moving_average.process(samples, smoothed, size);
+}
+//! [filter a block of samples]
+}
+
+namespace filter_with_a_biquad_cascade {
+//! [filter with a biquad cascade]
+template<class Q15>
+void equalize(Q15* samples, std::size_t size)
+{
+    // coefficients in (-4, 4) with 13 fractional bits; 28 fractional bits of state
+    using coefficient = make_fixed<2, 13>;
+    using state = make_fixed<3, 28>;
+
+    // two sections of an equalizer
+    const biquad_coefficients<coefficient> sections[] = {
+            {coefficient{1.0320}, coefficient{-1.8781}, coefficient{.8631}, coefficient{-1.8781}, coefficient{.8951}},
+            {coefficient{1.0071}, coefficient{-1.9665}, coefficient{.9603}, coefficient{-1.9669}, coefficient{.9671}}};
+    biquad_cascade<Q15, coefficient, state> equalizer(sections, 2);
+    equalizer.process(samples, samples, size);
+}
+//! [filter with a biquad cascade]
+}
+
+namespace transform_a_block_of_samples {
+//! [transform a block of samples]
+template<class Q15>
+std::vector<double> power_spectrum(std::vector<Q15> samples)
+{
+    // samples holds 256 complex values as interleaved real and imaginary parts
+    fft<Q15> transform(256);
+    auto exponent = transform.forward(samples.data());
+
+    // the spectrum is the transformed values scaled by 2^exponent
+    std::vector<double> power;
+    for (auto index = std::size_t{0}; index!=samples.size(); index += 2) {
+        auto real = std::ldexp(static_cast<double>(samples[index]), exponent);
+        auto imag = std::ldexp(static_cast<double>(samples[index+1]), exponent);
+        power.push_back(real*real+imag*imag);
+    }
+    return power;
+}
+//! [transform a block of samples]
+}
+
+namespace test_circles_for_intersection {
+//! [test circles for intersection]
+template<class S7_8>
+std::size_t count_hits(vec2_array<S7_8> const& targets, std::vector<S7_8> const& target_radii,
+        vec2_array<S7_8> const& projectiles, std::vector<S7_8> const& projectile_radii)
+{
+    // the squares of the distances are compared exactly in 64 bits, many pairs at a time
+    std::unique_ptr<bool[]> hits(new bool[targets.size()]);
+    intersects(targets, target_radii.data(), projectiles, projectile_radii.data(), hits.get());
+    return static_cast<std::size_t>(std::count(hits.get(), hits.get()+targets.size(), true));
+}
+//! [test circles for intersection]
+}
+
+namespace calculate_the_mean_and_variance_of_samples {
+//! [calculate the mean and variance of samples]
+template<class Q15>
+std::pair<Q15, double> mean_and_variance(std::vector<Q15> const& samples, unsigned threads)
+{
+    // the sums are exact in 64 bits so the results are the same for any number of threads
+    auto average = mean(samples.data(), samples.size(), threads, round_half_even{});
+    auto total = static_cast<double>(sum(samples.data(), samples.size(), threads));
+    auto square_total = static_cast<double>(sum_of_squares(samples.data(), samples.size(), threads));
+    auto count = static_cast<double>(samples.size());
+    return std::make_pair(average, square_total/count-(total/count)*(total/count));
+}
+//! [calculate the mean and variance of samples]
+}
+
+namespace define_a_fixed_point_value_with_a_wide_integer_rep {
+//! [define a fixed_point value with a wide_integer rep]
+// 127 integer digits and 128 fractional digits in four 64-bit limbs
+using s127_128 = fixed_point<wide_integer<256>, -128>;
+const auto pi = s127_128{3.141592653589793};
+
+// the product is calculated in 512 bits with 256 fractional digits
+const auto pi_squared = pi*pi;
+//! [define a fixed_point value with a wide_integer rep]
+}
+
 namespace use_make_fixed {
 //! [use make_fixed]
 static_assert(std::is_same<make_fixed<7, 8, signed>, fixed_point<int16_t, -8>>::value, "failed to use make_fixed");
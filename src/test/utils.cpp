@@ -9,30 +9,407 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+
 using sg14::fixed_point;
 using sg14::make_fixed;
 using sg14::make_ufixed;
 
+template<class Rep, int Exponent>
+void test_sqrt_accuracy(std::int64_t first, std::int64_t last, std::int64_t step)
+{
+    using fp = fixed_point<Rep, Exponent>;
+    for (auto data = first; data<=last; data += step) {
+        // result is floor(sqrt(n)) where n is the input as an integer of Exponent*2
+        auto n = static_cast<std::uint64_t>(data) << -Exponent;
+        auto r = static_cast<std::uint64_t>(sqrt(fp::from_data(static_cast<Rep>(data))).data());
+        EXPECT_LE(r*r, n) << "sqrt(" << fp::from_data(static_cast<Rep>(data)) << ")";
+        EXPECT_GT((r+1)*(r+1), n) << "sqrt(" << fp::from_data(static_cast<Rep>(data)) << ")";
+    }
+}
+
+TEST(utils_tests, sqrt_accuracy)
+{
+    test_sqrt_accuracy<std::uint8_t, -4>(0, 255, 1);
+    test_sqrt_accuracy<std::int16_t, -8>(0, 32767, 1);
+    test_sqrt_accuracy<std::uint16_t, -16>(0, 65535, 1);
+    test_sqrt_accuracy<std::int32_t, -16>(0, 2147483647, 9973);
+    test_sqrt_accuracy<std::int32_t, -30>(2147400000, 2147483647, 1);
+    test_sqrt_accuracy<std::uint32_t, 0>(0, 4294967295, 65521);
+    test_sqrt_accuracy<std::int32_t, -24>(0, 2147483647, 65537);
+}
+
+// r*r > upper*2^64+lower
+static bool square_exceeds(std::uint64_t r, std::uint64_t upper, std::uint64_t lower)
+{
+    auto cross = (r >> 32)*(r & 0xffffffffu);
+    auto low = (r & 0xffffffffu)*(r & 0xffffffffu);
+    auto square_lower = low+(cross << 33);
+    auto square_upper = (r >> 32)*(r >> 32)+(cross >> 31)+(square_lower<low);
+    return square_upper>upper || (square_upper==upper && square_lower>lower);
+}
+
+template<class Rep, int Exponent>
+void test_wide_sqrt_accuracy(std::uint64_t first, std::uint64_t step, int count)
+{
+    static_assert(Exponent<=0 && Exponent>-64, "n is formed from a shift of data by fewer than 64 bits");
+    using fp = fixed_point<Rep, Exponent>;
+    auto data = first;
+    for (auto i = 0; i!=count; ++i, data = (data+step) & std::numeric_limits<Rep>::max()) {
+        // result is floor(sqrt(n)) where n is the input as a 128-bit integer of Exponent*2
+        auto upper = (Exponent<0) ? data >> (64+Exponent) : 0;
+        auto lower = data << -Exponent;
+        auto r = static_cast<std::uint64_t>(sqrt(fp::from_data(static_cast<Rep>(data))).data());
+        EXPECT_FALSE(square_exceeds(r, upper, lower)) << "sqrt(" << fp::from_data(static_cast<Rep>(data)) << ")";
+        EXPECT_TRUE(square_exceeds(r+1, upper, lower)) << "sqrt(" << fp::from_data(static_cast<Rep>(data)) << ")";
+    }
+}
+
+TEST(utils_tests, wide_sqrt_accuracy)
+{
+    test_wide_sqrt_accuracy<std::int64_t, 0>(0, 0x9e3779b97f4a7c15u, 100000);
+    test_wide_sqrt_accuracy<std::uint64_t, 0>(0xfffffffffffffff0u, 0x9e3779b97f4a7c15u, 100000);
+    test_wide_sqrt_accuracy<std::int64_t, -32>(1, 0x9e3779b97f4a7c15u, 100000);
+    test_wide_sqrt_accuracy<std::uint64_t, -63>(0xfffffffffffffff0u, 0x9e3779b97f4a7c15u, 100000);
+}
+
+TEST(utils_tests, rsqrt)
+{
+    ASSERT_EQ(rsqrt(fixed_point<std::int32_t, -16>(4)), .5);
+    ASSERT_EQ(rsqrt(fixed_point<std::uint16_t, -8>(.25)), 2);
+    ASSERT_EQ(rsqrt(fixed_point<std::int32_t, -28>(2)), (fixed_point<std::int32_t, -28>::from_data(189812531)));
+    ASSERT_EQ(rsqrt(fixed_point<std::int32_t, -16>(.0001)), (fixed_point<std::int32_t, -16>::from_data(6849269)));
+    ASSERT_EQ(rsqrt(fixed_point<std::uint8_t, -4>(2)), .6875);
+
+    // results which exceed the range of the type saturate
+    ASSERT_EQ(rsqrt(fixed_point<std::int16_t, -14>(.0625)), (std::numeric_limits<fixed_point<std::int16_t, -14>>::max()));
+
+#if defined(SG14_FIXED_POINT_EXCEPTIONS_ENABLED)
+    ASSERT_THROW(rsqrt(fixed_point<std::int32_t, -16>(0)), std::invalid_argument);
+    ASSERT_THROW(rsqrt(fixed_point<std::int32_t, -16>(-1)), std::invalid_argument);
+#endif
+}
+
 TEST(utils_tests, sin)
 {
     ASSERT_EQ(sin(fixed_point<std::uint8_t, -6>(0)), 0);
-    ASSERT_EQ(sin(fixed_point<std::int16_t, -13>(3.1415926)), 0.f);
+    ASSERT_EQ(sin(fixed_point<std::int16_t, -13>(3.1415926)), (fixed_point<std::int16_t, -13>::from_data(1)));
     ASSERT_EQ(sin(fixed_point<std::uint16_t, -14>(3.1415926/2)), 1);
     ASSERT_EQ(sin(fixed_point<std::int32_t, -24>(3.1415926*7./2.)), -1);
     ASSERT_EQ(sin(fixed_point<std::int32_t, -28>(3.1415926/4)), .707106769f);
-    ASSERT_EQ(sin(fixed_point<std::int16_t, -10>(-3.1415926/3)), -.865234375);
+    ASSERT_EQ(sin(fixed_point<std::int16_t, -10>(-3.1415926/3)), -.8662109375);
 }
 
 TEST(utils_tests, cos)
 {
     ASSERT_EQ(cos(fixed_point<std::uint8_t, -6>(0)), 1.f);
     ASSERT_EQ(cos(fixed_point<std::int16_t, -13>(3.1415926)), -1);
-    ASSERT_EQ(cos(fixed_point<std::uint16_t, -14>(3.1415926/2)), 0.L);
+    ASSERT_EQ(cos(fixed_point<std::uint16_t, -14>(3.1415926/2)), (fixed_point<std::uint16_t, -14>::from_data(1)));
     ASSERT_EQ(cos(fixed_point<std::int32_t, -20>(3.1415926*7./2.)), 0.f);
-    ASSERT_EQ(cos(fixed_point<std::int32_t, -28>(3.1415926/4)), .707106829f);
+    ASSERT_EQ(cos(fixed_point<std::int32_t, -28>(3.1415926/4)), .707106769f);
     ASSERT_EQ(cos(fixed_point<std::int16_t, -10>(-3.1415926/3)), .5L);
 }
 
+TEST(utils_tests, tan)
+{
+    ASSERT_EQ(tan(fixed_point<std::uint8_t, -6>(0)), 0);
+    ASSERT_EQ(tan(fixed_point<std::int16_t, -10>(3.1415926/4)), 1);
+    ASSERT_EQ(tan(fixed_point<std::int32_t, -16>(-3.1415926/4)), (fixed_point<std::int32_t, -16>::from_data(-65534)));
+    ASSERT_EQ(tan(fixed_point<std::int32_t, -24>(3.1415926/3)), (fixed_point<std::int32_t, -24>::from_data(29058988)));
+    ASSERT_EQ(tan(fixed_point<std::int16_t, -8>(3.1415926/2)), (std::numeric_limits<fixed_point<std::int16_t, -8>>::max()));
+}
+
+TEST(utils_tests, sincos)
+{
+    auto x = fixed_point<std::int32_t, -16>(-3.1415926/3);
+    auto sc = sincos(x);
+    ASSERT_EQ(sc.first, sin(x));
+    ASSERT_EQ(sc.second, cos(x));
+}
+
+template<class Rep, int Exponent>
+void test_trig_accuracy(double first, double last)
+{
+    using fp = fixed_point<Rep, Exponent>;
+    auto lsb = static_cast<long double>(std::numeric_limits<fp>::epsilon());
+    for (auto n = 0; n<=1000; ++n) {
+        auto x = fp{first+(last-first)*n/1000};
+        auto exact = static_cast<long double>(x);
+        EXPECT_LE(std::abs(static_cast<long double>(sin(x))-std::sin(exact)), lsb) << "sin(" << x << ")";
+        EXPECT_LE(std::abs(static_cast<long double>(cos(x))-std::cos(exact)), lsb) << "cos(" << x << ")";
+    }
+}
+
+TEST(utils_tests, trig_accuracy)
+{
+    test_trig_accuracy<std::int8_t, -5>(-3.9, 3.9);
+    test_trig_accuracy<std::int16_t, -13>(-3.9, 3.9);
+    test_trig_accuracy<std::int32_t, -16>(-30000, 30000);
+    test_trig_accuracy<std::int32_t, -28>(-7.9, 7.9);
+    test_trig_accuracy<std::int64_t, -32>(-1000000, 1000000);
+    test_trig_accuracy<std::int64_t, -56>(-100, 100);
+}
+
+TEST(utils_tests, atan)
+{
+    ASSERT_EQ(atan(fixed_point<std::uint8_t, -6>(0)), 0);
+    ASSERT_EQ(atan(fixed_point<std::int32_t, -28>(.5)), (fixed_point<std::int32_t, -28>::from_data(124459457)));
+    ASSERT_EQ(atan(fixed_point<std::int32_t, -16>(1000)), (fixed_point<std::int32_t, -16>::from_data(102878)));
+    ASSERT_EQ(atan(fixed_point<std::int32_t, -16>(-1000)), (fixed_point<std::int32_t, -16>::from_data(-102878)));
+    ASSERT_EQ(atan(fixed_point<std::int16_t, 4>(32000)), (fixed_point<std::int16_t, 4>(0)));
+
+    // result type may differ from argument type
+    ASSERT_EQ((sg14::atan<fixed_point<std::int16_t, -14>>(fixed_point<std::int32_t, -16>(1000))),
+            (fixed_point<std::int16_t, -14>::from_data(25720)));
+}
+
+TEST(utils_tests, atan2)
+{
+    using fp = fixed_point<std::int32_t, -16>;
+    ASSERT_EQ(atan2(fp(0), fp(0)), 0);
+    ASSERT_EQ(atan2(fp(0), fp(5)), 0);
+    ASSERT_EQ(atan2(fp(0), fp(-5)), (fp::from_data(205887)));
+    ASSERT_EQ(atan2(fp(3), fp(0)), (fp::from_data(102944)));
+    ASSERT_EQ(atan2(fp(-3), fp(0)), (fp::from_data(-102944)));
+    ASSERT_EQ(atan2(fp(-1), fp(-1)), (fp::from_data(-154416)));
+    ASSERT_EQ((sg14::atan2<fixed_point<std::int16_t, -13>>(fp(-1), fp(-1))), (fixed_point<std::int16_t, -13>::from_data(-19302)));
+}
+
+TEST(utils_tests, asin_acos)
+{
+    ASSERT_EQ(asin(fixed_point<std::int32_t, -16>(.5)), (fixed_point<std::int32_t, -16>::from_data(34315)));
+    ASSERT_EQ(asin(fixed_point<std::int16_t, -14>(1)), (fixed_point<std::int16_t, -14>::from_data(25736)));
+    ASSERT_EQ(asin(fixed_point<std::int16_t, -14>(-1)), (fixed_point<std::int16_t, -14>::from_data(-25736)));
+    ASSERT_EQ(acos(fixed_point<std::int32_t, -16>(1)), 0);
+    ASSERT_EQ(acos(fixed_point<std::int32_t, -16>(-.5)), (fixed_point<std::int32_t, -16>::from_data(137258)));
+
+#if defined(SG14_FIXED_POINT_EXCEPTIONS_ENABLED)
+    ASSERT_THROW(asin(fixed_point<std::int32_t, -16>(1.01)), std::invalid_argument);
+    ASSERT_THROW(acos(fixed_point<std::int32_t, -16>(-2)), std::invalid_argument);
+#endif
+}
+
+template<class Rep, int Exponent>
+void test_inverse_trig_accuracy(double first, double last)
+{
+    using fp = fixed_point<Rep, Exponent>;
+    auto lsb = static_cast<long double>(std::numeric_limits<fp>::epsilon());
+    for (auto n = 0; n<=1000; ++n) {
+        auto y = fp{first+(last-first)*n/1000};
+        auto x = fp{last-(last-first)*(n*7%1000)/1000};
+        auto exact_y = static_cast<long double>(y);
+        auto exact_x = static_cast<long double>(x);
+        EXPECT_LE(std::abs(static_cast<long double>(atan(y))-std::atan(exact_y)), lsb) << "atan(" << y << ")";
+        EXPECT_LE(std::abs(static_cast<long double>(atan2(y, x))-std::atan2(exact_y, exact_x)), lsb)
+                            << "atan2(" << y << ", " << x << ")";
+
+        auto u = fp{-1+2.*n/1000};
+        auto exact_u = static_cast<long double>(u);
+        EXPECT_LE(std::abs(static_cast<long double>(asin(u))-std::asin(exact_u)), lsb) << "asin(" << u << ")";
+        EXPECT_LE(std::abs(static_cast<long double>(acos(u))-std::acos(exact_u)), lsb) << "acos(" << u << ")";
+    }
+}
+
+TEST(utils_tests, inverse_trig_accuracy)
+{
+    test_inverse_trig_accuracy<std::int8_t, -5>(-3.9, 3.9);
+    test_inverse_trig_accuracy<std::int16_t, -13>(-3.9, 3.9);
+    test_inverse_trig_accuracy<std::int32_t, -16>(-30000, 30000);
+    test_inverse_trig_accuracy<std::int32_t, -29>(-3.9, 3.9);
+    test_inverse_trig_accuracy<std::int64_t, -32>(-1000000, 1000000);
+    test_inverse_trig_accuracy<std::int64_t, -56>(-100, 100);
+}
+
+TEST(utils_tests, log)
+{
+    ASSERT_EQ(log2(fixed_point<std::uint8_t, -4>(8)), 3);
+    ASSERT_EQ(log2(fixed_point<std::int16_t, -8>(.25)), -2);
+    ASSERT_EQ(log2(fixed_point<std::int32_t, -16>(1000)), (fixed_point<std::int32_t, -16>::from_data(653118)));
+    ASSERT_EQ(log(fixed_point<std::int16_t, -8>(10)), (fixed_point<std::int16_t, -8>::from_data(589)));
+    ASSERT_EQ(log(fixed_point<std::int32_t, -28>(3)), (fixed_point<std::int32_t, -28>::from_data(294906491)));
+    ASSERT_EQ(log10(fixed_point<std::int32_t, -16>(1000)), 3);
+    ASSERT_EQ(log10(fixed_point<std::int64_t, -32>(1024)), (fixed_point<std::int64_t, -32>::from_data(12929139865)));
+
+    // results which cannot be represented saturate
+    ASSERT_EQ(log2(fixed_point<std::uint8_t, -4>(.25)), 0);
+#if defined(SG14_EXCEPTIONS_ENABLED)
+    ASSERT_THROW(log(fixed_point<std::int32_t, -16>(0)), std::invalid_argument);
+    ASSERT_THROW(log2(fixed_point<std::int32_t, -16>(-1)), std::invalid_argument);
+#endif
+}
+
+TEST(utils_tests, exp)
+{
+    ASSERT_EQ(exp(fixed_point<std::uint8_t, -4>(0)), 1);
+    ASSERT_EQ(exp(fixed_point<std::int16_t, -8>(-1)), (fixed_point<std::int16_t, -8>::from_data(94)));
+    ASSERT_EQ(exp(fixed_point<std::int32_t, -16>(1)), (fixed_point<std::int32_t, -16>::from_data(178145)));
+    ASSERT_EQ(exp(fixed_point<std::int32_t, -24>(.5)), (fixed_point<std::int32_t, -24>::from_data(27660953)));
+    ASSERT_EQ(exp(fixed_point<std::int32_t, -16>(11)), (std::numeric_limits<fixed_point<std::int32_t, -16>>::max()));
+    ASSERT_EQ(exp(fixed_point<std::int32_t, -16>(-20)), 0);
+}
+
+TEST(utils_tests, expm1)
+{
+    ASSERT_EQ(expm1(fixed_point<std::int16_t, -8>(0)), 0);
+    ASSERT_EQ(expm1(fixed_point<std::int16_t, -8>(1)), (fixed_point<std::int16_t, -8>::from_data(440)));
+    ASSERT_EQ(expm1(fixed_point<std::int32_t, -30>::from_data(1)), (fixed_point<std::int32_t, -30>::from_data(1)));
+    ASSERT_EQ(expm1(fixed_point<std::int32_t, -30>::from_data(-1)), (fixed_point<std::int32_t, -30>::from_data(-1)));
+    ASSERT_EQ(expm1(fixed_point<std::int32_t, -16>(-20)), -1);
+}
+
+TEST(utils_tests, pow)
+{
+    ASSERT_EQ(pow(fixed_point<std::int32_t, -16>(1.5), 3), 3.375);
+    ASSERT_EQ(pow(fixed_point<std::int32_t, -16>(2), -3), .125);
+    ASSERT_EQ(pow(fixed_point<std::int32_t, -16>(-2), 5), -32);
+    ASSERT_EQ(pow(fixed_point<std::int32_t, -24>(1.1), 10), (fixed_point<std::int32_t, -24>::from_data(43515763)));
+    ASSERT_EQ(pow(fixed_point<std::int32_t, -16>(2), fixed_point<std::int32_t, -16>(.5)),
+            (fixed_point<std::int32_t, -16>::from_data(92682)));
+    ASSERT_EQ(pow(fixed_point<std::int32_t, -16>(10), fixed_point<std::int32_t, -16>(-1.5)),
+            (fixed_point<std::int32_t, -16>::from_data(2072)));
+    ASSERT_EQ(pow(fixed_point<std::int16_t, -14>(.75), fixed_point<std::int16_t, -8>(2.5)),
+            (fixed_point<std::int16_t, -14>::from_data(7981)));
+    ASSERT_EQ(pow(fixed_point<std::int32_t, -28>(2), fixed_point<std::uint8_t, -4>(.25)),
+            (fixed_point<std::int32_t, -28>::from_data(319225354)));
+
+    // integer-valued exponents of negative bases
+    ASSERT_EQ(pow(fixed_point<std::int32_t, -16>(-2), fixed_point<std::int32_t, -16>(3)), -8);
+
+    // results which cannot be represented saturate
+    ASSERT_EQ(pow(fixed_point<std::uint8_t, -4>(3), 3), (std::numeric_limits<fixed_point<std::uint8_t, -4>>::max()));
+    ASSERT_EQ(pow(fixed_point<std::int32_t, -16>(0), -1), (std::numeric_limits<fixed_point<std::int32_t, -16>>::max()));
+#if defined(SG14_EXCEPTIONS_ENABLED)
+    ASSERT_THROW(pow(fixed_point<std::int32_t, -16>(-2), fixed_point<std::int32_t, -16>(.5)), std::invalid_argument);
+#endif
+}
+
+template<class Rep, int Exponent>
+void test_pow_accuracy(double first, double last, int max_n)
+{
+    using fp = fixed_point<Rep, Exponent>;
+    using exponent = fixed_point<std::int32_t, -16>;
+    auto lsb = static_cast<long double>(std::numeric_limits<fp>::epsilon());
+    auto lowest = static_cast<long double>(std::numeric_limits<fp>::lowest());
+    auto max = static_cast<long double>(std::numeric_limits<fp>::max());
+    auto error = [&](fp actual, long double expected) {
+        return std::abs(static_cast<long double>(actual)-std::max(lowest, std::min(expected, max)));
+    };
+    for (auto n = 0; n<=1000; ++n) {
+        auto x = fp{first+(last-first)*n/1000};
+        auto exact = static_cast<long double>(x);
+        if (exact==0) {
+            continue;
+        }
+        auto i = n%(max_n*2+1)-max_n;
+        EXPECT_LE(error(pow(x, i), std::pow(exact, i)), lsb) << "pow(" << x << ", " << i << ")";
+        if (exact>0) {
+            auto y = exponent{i+n%16/16.};
+            EXPECT_LE(error(pow(x, y), std::pow(exact, static_cast<long double>(y))), lsb)
+                                << "pow(" << x << ", " << y << ")";
+        }
+    }
+}
+
+TEST(utils_tests, pow_accuracy)
+{
+    test_pow_accuracy<std::int8_t, -4>(-7.9, 7.9, 8);
+    test_pow_accuracy<std::uint8_t, -7>(0, 1.99, 8);
+    test_pow_accuracy<std::int16_t, -8>(-127, 127, 8);
+    test_pow_accuracy<std::int16_t, -14>(-1.99, 1.99, 20);
+    test_pow_accuracy<std::int32_t, -16>(-100, 100, 10);
+    test_pow_accuracy<std::int32_t, -28>(-7.9, 7.9, 20);
+}
+
+template<class Rep, int Exponent>
+void test_log_exp_accuracy(double first, double last)
+{
+    using fp = fixed_point<Rep, Exponent>;
+    auto lsb = static_cast<long double>(std::numeric_limits<fp>::epsilon());
+    auto lowest = static_cast<long double>(std::numeric_limits<fp>::lowest());
+    auto max = static_cast<long double>(std::numeric_limits<fp>::max());
+    auto error = [&](fp actual, long double expected) {
+        return std::abs(static_cast<long double>(actual)-std::max(lowest, std::min(expected, max)));
+    };
+    for (auto n = 0; n<=1000; ++n) {
+        auto x = fp{first+(last-first)*n/1000};
+        auto exact = static_cast<long double>(x);
+        if (exact>0) {
+            EXPECT_LE(error(log2(x), std::log2(exact)), lsb) << "log2(" << x << ")";
+            EXPECT_LE(error(log(x), std::log(exact)), lsb) << "log(" << x << ")";
+            EXPECT_LE(error(log10(x), std::log10(exact)), lsb) << "log10(" << x << ")";
+        }
+        EXPECT_LE(error(exp(x), std::exp(exact)), lsb) << "exp(" << x << ")";
+        EXPECT_LE(error(expm1(x), std::expm1(exact)), lsb) << "expm1(" << x << ")";
+    }
+}
+
+TEST(utils_tests, log_exp_accuracy)
+{
+    test_log_exp_accuracy<std::int8_t, -4>(-7.9, 7.9);
+    test_log_exp_accuracy<std::uint8_t, -7>(0, 1.99);
+    test_log_exp_accuracy<std::int16_t, -8>(-127, 127);
+    test_log_exp_accuracy<std::int16_t, -14>(-1.99, 1.99);
+    test_log_exp_accuracy<std::int32_t, -16>(-30000, 30000);
+    test_log_exp_accuracy<std::int32_t, -28>(-7.9, 7.9);
+    test_log_exp_accuracy<std::int64_t, -32>(-40, 40);
+    test_log_exp_accuracy<std::int64_t, -48>(-30, 30);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// sg14::sqrt, sg14::rsqrt
+
+static_assert(sqrt(make_fixed<15, 16>(2))==make_fixed<15, 16>::from_data(92681), "sg14::sqrt test failed");
+static_assert(sqrt(make_ufixed<0, 16>(.25))==.5, "sg14::sqrt test failed");
+static_assert(sqrt(make_fixed<31, 0>(2147395600))==46340, "sg14::sqrt test failed");
+static_assert(rsqrt(make_fixed<15, 16>(4))==.5, "sg14::rsqrt test failed");
+static_assert(rsqrt(make_ufixed<8, 8>(.25))==2, "sg14::rsqrt test failed");
+
+// results which exceed the range of the type saturate
+static_assert(rsqrt(make_fixed<1, 14>(.0625))==std::numeric_limits<make_fixed<1, 14>>::max(), "sg14::rsqrt test failed");
+
+////////////////////////////////////////////////////////////////////////////////
+// sg14::sin, sg14::cos, sg14::tan
+
+static_assert(sin(make_fixed<3, 12>(0))==0, "sg14::sin test failed");
+static_assert(sin(make_fixed<3, 12>(-1.5707963267948966))==-1, "sg14::sin test failed");
+static_assert(cos(make_ufixed<2, 14>(0))==make_ufixed<2, 14>(1), "sg14::cos test failed");
+static_assert(cos(make_fixed<15, 16>(3.141592653589793))==-1, "sg14::cos test failed");
+static_assert(tan(make_fixed<7, 8>(0.7853981633974483))==1, "sg14::tan test failed");
+static_assert(sin(make_fixed<0, 15>(.5))==make_fixed<0, 15>::from_data(15710), "sg14::sin test failed");
+static_assert(cos(make_fixed<0, 7>(.5))==make_fixed<0, 7>(0.875), "sg14::cos test failed");
+
+// results which exceed the range of the type saturate
+static_assert(cos(make_fixed<0, 15>(0))==std::numeric_limits<make_fixed<0, 15>>::max(), "sg14::cos test failed");
+
+////////////////////////////////////////////////////////////////////////////////
+// sg14::atan, sg14::atan2, sg14::asin, sg14::acos
+
+static_assert(atan(make_fixed<15, 16>(0))==0, "sg14::atan test failed");
+static_assert(atan(make_fixed<7, 8>(1))==make_fixed<7, 8>::from_data(201), "sg14::atan test failed");
+static_assert(atan2(make_fixed<15, 16>(-2), make_fixed<15, 16>(0))==make_fixed<15, 16>::from_data(-102944), "sg14::atan2 test failed");
+static_assert(asin(make_fixed<1, 14>(0))==0, "sg14::asin test failed");
+static_assert(acos(make_fixed<3, 12>(0))==make_fixed<3, 12>::from_data(6434), "sg14::acos test failed");
+
+////////////////////////////////////////////////////////////////////////////////
+// sg14::log2, sg14::log, sg14::log10, sg14::exp, sg14::expm1, sg14::pow
+
+static_assert(log2(make_fixed<7, 8>(.125))==-3, "sg14::log2 test failed");
+static_assert(log2(make_ufixed<16, 16>(1024))==10, "sg14::log2 test failed");
+static_assert(log(make_fixed<15, 16>(1))==0, "sg14::log test failed");
+static_assert(log10(make_fixed<31, 32>(100000))==5, "sg14::log10 test failed");
+static_assert(exp(make_fixed<15, 16>(0))==1, "sg14::exp test failed");
+static_assert(exp(make_fixed<3, 4>(2))==make_fixed<3, 4>(7.375), "sg14::exp test failed");
+static_assert(expm1(make_fixed<7, 24>(0))==0, "sg14::expm1 test failed");
+
+static_assert(pow(make_fixed<15, 16>(3), 4)==81, "sg14::pow test failed");
+static_assert(pow(make_fixed<15, 16>(-.5), -3)==-8, "sg14::pow test failed");
+static_assert(pow(make_ufixed<8, 8>(4), make_ufixed<8, 8>(.5))==2, "sg14::pow test failed");
+static_assert(pow(make_fixed<0, 15>(.5), 0)==std::numeric_limits<make_fixed<0, 15>>::max(), "sg14::pow test failed");
+
+// results which exceed the range of the type saturate
+static_assert(exp(make_fixed<7, 8>(5))==std::numeric_limits<make_fixed<7, 8>>::max(), "sg14::exp test failed");
+static_assert(expm1(make_fixed<7, 8>(-10))==-1, "sg14::expm1 test failed");
+
 ////////////////////////////////////////////////////////////////////////////////
 // sg14::abs
 
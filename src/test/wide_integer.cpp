@@ -0,0 +1,236 @@
+
+//          Copyright John McFarlane 2015 - 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file ../../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file
+/// \brief tests of sg14/auxiliary/wide_integer.h
+
+#include <sg14/auxiliary/wide_integer.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+using sg14::fixed_point;
+using sg14::wide_integer;
+
+namespace {
+    using int256 = wide_integer<256>;
+    using uint256 = wide_integer<256, unsigned>;
+    using int512 = wide_integer<512>;
+    using s127_128 = fixed_point<int256, -128>;
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // type traits
+
+    static_assert(sizeof(int256)==32, "sg14::wide_integer test failed");
+    static_assert(std::is_trivially_copyable<int256>::value, "sg14::wide_integer test failed");
+    static_assert(std::is_trivially_destructible<uint256>::value, "sg14::wide_integer test failed");
+
+    static_assert(sg14::width<int256>::value==256, "sg14::wide_integer test failed");
+    static_assert(sg14::is_integral<int256>::value, "sg14::wide_integer test failed");
+    static_assert(sg14::is_signed<int256>::value, "sg14::wide_integer test failed");
+    static_assert(sg14::is_unsigned<uint256>::value, "sg14::wide_integer test failed");
+    static_assert(std::is_same<sg14::make_signed<uint256>::type, int256>::value, "sg14::wide_integer test failed");
+    static_assert(std::is_same<sg14::make_unsigned<int256>::type, uint256>::value, "sg14::wide_integer test failed");
+    static_assert(std::is_same<sg14::set_width_t<int256, 511>, int512>::value, "sg14::wide_integer test failed");
+    static_assert(std::is_same<sg14::set_width_t<uint256, 65>, wide_integer<128, unsigned>>::value,
+            "sg14::wide_integer test failed");
+    static_assert(std::is_same<sg14::set_width_t<int256, 1>, wide_integer<64>>::value,
+            "sg14::wide_integer test failed");
+
+    static_assert(std::numeric_limits<int256>::is_integer, "sg14::wide_integer test failed");
+    static_assert(std::numeric_limits<int256>::digits==255, "sg14::wide_integer test failed");
+    static_assert(std::numeric_limits<uint256>::digits==256, "sg14::wide_integer test failed");
+    static_assert(std::numeric_limits<int256>::digits10==76, "sg14::wide_integer test failed");
+
+    static_assert(s127_128::integer_digits==127, "sg14::wide_integer test failed");
+    static_assert(std::is_same<decltype(s127_128{}*s127_128{}), fixed_point<int512, -256>>::value,
+            "sg14::wide_integer test failed");
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // constant expressions
+
+    // construction from built-in integers and comparison are constexpr in C++11
+    static_assert(int256{-1}<int256{0}, "sg14::wide_integer test failed");
+    static_assert(uint256{-1}>uint256{0}, "sg14::wide_integer test failed");
+    static_assert(int256{INT64_MIN}<int256{INT64_MAX}, "sg14::wide_integer test failed");
+    static_assert(int256{1000}==1000, "sg14::wide_integer test failed");
+    static_assert(static_cast<int>(int256{-1000})==-1000, "sg14::wide_integer test failed");
+    static_assert(std::numeric_limits<int256>::lowest()<std::numeric_limits<int256>::max(),
+            "sg14::wide_integer test failed");
+    static_assert(int512{std::numeric_limits<int256>::lowest()}<int512{0}, "sg14::wide_integer test failed");
+    static_assert(int512{std::numeric_limits<int256>::lowest()}>std::numeric_limits<int512>::lowest(),
+            "sg14::wide_integer test failed");
+    static_assert(static_cast<bool>(uint256{1}) && !static_cast<bool>(uint256{0}), "sg14::wide_integer test failed");
+
+#if (__cplusplus >= 201402L)
+    // and so are arithmetic and conversion to and from floating-point types from C++14 onwards
+    static_assert((int256{1} << 200) > (int256{1} << 199), "sg14::wide_integer test failed");
+    static_assert((int256{-1} << 255)==std::numeric_limits<int256>::lowest(), "sg14::wide_integer test failed");
+    static_assert(std::numeric_limits<int256>::max()+1==std::numeric_limits<int256>::lowest(),
+            "sg14::wide_integer test failed");
+    static_assert((int256{1} << 200)*(int256{1} << 50)==int256{1} << 250, "sg14::wide_integer test failed");
+    static_assert((int256{-1} << 200)/(int256{1} << 150)==int256{-1} << 50, "sg14::wide_integer test failed");
+    static_assert(int256{-7}/2==-3 && int256{-7}%2==-1, "sg14::wide_integer test failed");
+    static_assert(int256{1.6069380442589903e60}==int256{1} << 200, "sg14::wide_integer test failed");
+    static_assert(static_cast<double>(-(int256{1} << 200))==-1.6069380442589903e60, "sg14::wide_integer test failed");
+    static_assert(s127_128{1.5}*s127_128{-2.5}==s127_128{-3.75}, "sg14::wide_integer test failed");
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// sg14::wide_integer arithmetic
+
+TEST(wide_integer, add)
+{
+    auto carried = uint256{UINT64_MAX}+1;
+    ASSERT_EQ(carried, uint256{1} << 64);
+    ASSERT_EQ((uint256{1} << 255)+(uint256{1} << 255), 0);
+    ASSERT_EQ(int256{-1}+1, 0);
+    ASSERT_EQ(std::numeric_limits<uint256>::max()+1, 0);
+}
+
+TEST(wide_integer, subtract)
+{
+    auto borrowed = (uint256{1} << 192)-1;
+    ASSERT_EQ(borrowed >> 128, uint256{UINT64_MAX});
+    ASSERT_EQ(uint256{0}-1, std::numeric_limits<uint256>::max());
+    ASSERT_EQ(int256{0}-std::numeric_limits<int256>::max()-1, std::numeric_limits<int256>::lowest());
+}
+
+TEST(wide_integer, multiply)
+{
+    // 2^128-1 squared is 2^256-2^129+1
+    auto factor = (uint256{1} << 128)-1;
+    ASSERT_EQ(factor*factor, uint256{0}-(uint256{1} << 129)+1);
+
+    // signed products are truncated, as are built-in integer products
+    ASSERT_EQ(int256{-3}*int256{INT64_MAX}, int256{INT64_MAX}*-3);
+    ASSERT_EQ(int256{-1}*-1, 1);
+    ASSERT_EQ(std::numeric_limits<int256>::lowest()*-1, std::numeric_limits<int256>::lowest());
+
+    // widened operands, as in the product of two fixed_point values
+    auto narrow = -(int256{1} << 200)+12345;
+    auto product = int512{narrow}*int512{narrow};
+    ASSERT_EQ(product/narrow, narrow);
+    ASSERT_EQ(product%narrow, 0);
+}
+
+TEST(wide_integer, karatsuba)
+{
+    // products of more than 512 bits are calculated using Karatsuba's method
+    using int2048 = wide_integer<2048>;
+    auto x = (int2048{0x123456789abcdefLL} << 900)-(int2048{0x7edcba987654321LL} << 400)+0x55555555;
+    ASSERT_EQ((x+1)*(x-1), x*x-1);
+    ASSERT_EQ((x*x)/x, x);
+
+    auto y = (int2048{1} << 1000)+(int2048{1} << 500)+1;
+    ASSERT_EQ(y*y, (int2048{1} << 2000)+(int2048{1} << 1501)+(int2048{3} << 1000)+(int2048{1} << 501)+1);
+}
+
+TEST(wide_integer, divide)
+{
+    auto dividend = (uint256{1} << 250)+(uint256{0xfedcba9876543210ULL} << 100)+12345;
+    auto divisor = (uint256{1} << 130)+0xabcdef;
+    auto quotient = dividend/divisor;
+    auto remainder = dividend%divisor;
+    ASSERT_LT(remainder, divisor);
+    ASSERT_EQ(quotient*divisor+remainder, dividend);
+
+    // dividends less than divisors of the same number of limbs
+    ASSERT_EQ(divisor/(divisor+1), 0);
+    ASSERT_EQ(divisor%(divisor+1), divisor);
+
+    // single-limb divisors
+    ASSERT_EQ(dividend/1, dividend);
+    ASSERT_EQ((uint256{1} << 255)/(uint256{1} << 63), uint256{1} << 192);
+    ASSERT_EQ(((uint256{1} << 200)+7)%10, ((uint256{1} << 200)%10+7)%10);
+
+    // division is truncated toward zero
+    ASSERT_EQ(int256{-7}/int256{2}, -3);
+    ASSERT_EQ(int256{7}/int256{-2}, -3);
+    ASSERT_EQ(int256{-7}/int256{-2}, 3);
+    ASSERT_EQ(int256{-7}%int256{2}, -1);
+    ASSERT_EQ(int256{7}%int256{-2}, 1);
+}
+
+TEST(wide_integer, shift)
+{
+    ASSERT_EQ(int256{1} << 0, 1);
+    ASSERT_EQ((int256{3} << 127) >> 126, 6);
+    ASSERT_EQ((int256{-1} << 200) >> 200, -1);
+    ASSERT_EQ((uint256{0}-1) >> 255, 1);
+    ASSERT_EQ((int256{0}-1) >> 255, -1);
+}
+
+TEST(wide_integer, bitwise)
+{
+    auto ones = std::numeric_limits<uint256>::max();
+    ASSERT_EQ(~ones, 0);
+    ASSERT_EQ(ones & (uint256{1} << 200), uint256{1} << 200);
+    ASSERT_EQ((uint256{1} << 200) | 1, (uint256{1} << 200)+1);
+    ASSERT_EQ(ones ^ 1, ones-1);
+}
+
+TEST(wide_integer, conversion)
+{
+    // to and from built-in integers
+    ASSERT_EQ(static_cast<std::int64_t>(int256{INT64_MIN}), INT64_MIN);
+    ASSERT_EQ(static_cast<std::uint8_t>(uint256{0x1234}), 0x34);
+    ASSERT_EQ(static_cast<std::int32_t>(int256{-2} << 100), 0);
+
+    // to and from wide_integers
+    ASSERT_EQ(int512{int256{-5}}, -5);
+    ASSERT_EQ(int256{int512{-5} << 300}, 0);
+    using uint512 = wide_integer<512, unsigned>;
+    ASSERT_EQ(uint512{uint256{0}-1}, (uint512{1} << 256)-1);
+
+    // to and from floating-point types
+    ASSERT_EQ(static_cast<double>(int256{1} << 200), 1.6069380442589903e60);
+    ASSERT_EQ(static_cast<float>(-(int256{1} << 100)), -1.2676506e30f);
+    ASSERT_EQ(int256{-1.6069380442589903e60}, -(int256{1} << 200));
+    ASSERT_EQ(int256{2.75}, 2);
+    ASSERT_EQ(int256{-2.75}, -2);
+    ASSERT_EQ(uint256{1.8446744073709552e19}, uint256{1} << 64);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// sg14::fixed_point<sg14::wide_integer<>> arithmetic
+
+TEST(fixed_point_wide_integer, add)
+{
+    auto sum = s127_128{1e30}+s127_128{.25};
+    ASSERT_EQ(static_cast<double>(sum-s127_128{1e30}), .25);
+}
+
+TEST(fixed_point_wide_integer, multiply)
+{
+    auto factor = s127_128{-1.5e20};
+    auto product = factor*factor;
+    ASSERT_EQ(static_cast<double>(product), 2.25e40);
+
+    // the product of the smallest values is exact
+    using s255_256 = fixed_point<int512, -256>;
+    auto smallest = std::numeric_limits<s127_128>::min();
+    ASSERT_EQ(smallest*smallest, std::numeric_limits<s255_256>::min());
+}
+
+TEST(fixed_point_wide_integer, divide)
+{
+    auto quotient = s127_128{1}/s127_128{3};
+    ASSERT_EQ(static_cast<double>(quotient), 1./3);
+    ASSERT_EQ(static_cast<double>(quotient*s127_128{3}), 1.);
+    ASSERT_LT(quotient*s127_128{3}, s127_128{1});
+}
+
+TEST(fixed_point_wide_integer, snippet)
+{
+    // the value of pi squared, as in the documentation
+    auto pi = s127_128{3.141592653589793};
+    ASSERT_EQ(static_cast<double>(pi*pi), 9.869604401089358);
+}